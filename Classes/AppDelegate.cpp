@@ -3,9 +3,23 @@
 #include "FlappyBirdLayer.h"
 #include "WelcomeScene.h"
 
+// the armature converter is a desktop tool, only the Windows and Linux projects link cocostudio
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32 || CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+#define FLAPPY_ARMATURE_CONVERTER 1
+#include "cocostudio/CCDataReaderHelper.h"
+#endif
+
 USING_NS_CC;
 USING_NAGA;
 
+// the scene a recorded run was played in
+static Scene* createRecordedScene(RecordedScene recordedScene)
+{
+    if (recordedScene == RECORDED_SCENE_GAME)
+        return GameLayer::createScene();
+    return FlappyBirdLayer::createScene();
+}
+
 AppDelegate::AppDelegate() {
 
 }
@@ -17,8 +31,14 @@ AppDelegate::~AppDelegate()
 bool AppDelegate::applicationDidFinishLaunching() 
 {
     // initialize director
+    // FLAPPY_HEADLESS runs without a window nor a GPU, to benchmark a replay
     auto director = Director::getInstance();
     auto eglview = director->getOpenGLView();
+    bool headless = getenv("FLAPPY_HEADLESS") != nullptr;
+    if(!eglview && headless) {
+        eglview = GLView::createHeadless("flappy bird", Size(480, 480*1.775));
+        director->setOpenGLView(eglview);
+    }
     if(!eglview) {
         eglview = GLView::create("flappy bird");
         eglview->setFrameSize(480, 480*1.775);
@@ -32,8 +52,117 @@ bool AppDelegate::applicationDidFinishLaunching()
     // set FPS. the default value is 1.0/60 if you don't call this
     director->setAnimationInterval(1.0 / 60);
 
-    // create a scene. it's an autorelease object    
-    auto scene = CreateScene<WelcomeScene>();
+    // FLAPPY_BUILD_ASSET_PACK=<pack> packs the resources and quits, FLAPPY_ASSET_PACK=<pack> loads them from a pack
+    auto fileUtils = FileUtils::getInstance();
+    const char* buildAssetPack = getenv("FLAPPY_BUILD_ASSET_PACK");
+    const char* assetPack = getenv("FLAPPY_ASSET_PACK");
+    if (!buildAssetPack && assetPack && !fileUtils->addAssetPack(assetPack))
+    {
+        log("can't load the asset pack %s", assetPack);
+    }
+
+    // FLAPPY_TEXTURE_BUDGET=<MB> evicts the textures not drawn lately once they take more video memory
+    const char* textureBudget = getenv("FLAPPY_TEXTURE_BUDGET");
+    if (textureBudget && atoi(textureBudget) > 0)
+    {
+        director->getTextureCache()->setResidentBudget((ssize_t)atoi(textureBudget) * 1024 * 1024);
+    }
+
+    // FLAPPY_RECORD=<log> records the runs, FLAPPY_REPLAY=<log> replays them
+    // FLAPPY_REPLAY_SPEED times faster than real time and quits
+    Scene* scene = nullptr;
+    auto recorder = InputRecorder::InstancePtr();
+    const char* replayPath = getenv("FLAPPY_REPLAY");
+    const char* recordPath = getenv("FLAPPY_RECORD");
+    const char* replaySpeed = getenv("FLAPPY_REPLAY_SPEED");
+#if FLAPPY_ARMATURE_CONVERTER
+    // FLAPPY_CONVERT_ARMATURE=<config> writes the binary (.csab) version of an armature xml or json file next to it and quits
+    const char* convertArmature = getenv("FLAPPY_CONVERT_ARMATURE");
+#endif
+    // FLAPPY_CONVERT_SPRITE_SHEET=<plist> writes the binary index (.ccsf) of a sprite sheet next to it and quits
+    const char* convertSpriteSheet = getenv("FLAPPY_CONVERT_SPRITE_SHEET");
+    // FLAPPY_LABEL_BENCHMARK=<labels> profiles that many score labels changing every frame and quits
+    const char* labelBenchmark = getenv("FLAPPY_LABEL_BENCHMARK");
+    // FLAPPY_CONVERT_BENCHMARK=<runs> times the texture format conversions of a 2048x2048 image and quits
+    const char* convertBenchmark = getenv("FLAPPY_CONVERT_BENCHMARK");
+    // FLAPPY_SORT_BENCHMARK=<runs> times the sort of 10000 render commands and quits
+    const char* sortBenchmark = getenv("FLAPPY_SORT_BENCHMARK");
+    if (buildAssetPack)
+    {
+        bool built = FileUtils::buildAssetPack(fileUtils->getSearchPaths().front(), buildAssetPack);
+        log("%s %s", built ? "built" : "failed to build", buildAssetPack);
+        scene = Scene::create();
+        director->end();
+    }
+    else if (convertSpriteSheet)
+    {
+        std::string plistPath = fileUtils->fullPathForFilename(convertSpriteSheet);
+        std::string binaryPath = plistPath.substr(0, plistPath.find_last_of('.')) + ".ccsf";
+        bool converted = SpriteFrameCache::convertToBinaryFile(plistPath, binaryPath);
+        log("%s %s", converted ? "converted" : "failed to convert", binaryPath.c_str());
+        scene = Scene::create();
+        director->end();
+    }
+#if FLAPPY_ARMATURE_CONVERTER
+    else if (convertArmature)
+    {
+        std::string configPath = fileUtils->fullPathForFilename(convertArmature);
+        std::string binaryPath = configPath.substr(0, configPath.find_last_of('.')) + ".csab";
+        bool converted = cocostudio::DataReaderHelper::convertToBinaryFile(configPath, binaryPath);
+        log("%s %s", converted ? "converted" : "failed to convert", binaryPath.c_str());
+        scene = Scene::create();
+        director->end();
+    }
+#endif
+    else if (sortBenchmark)
+    {
+        int runs = atoi(sortBenchmark);
+        SortBenchmark::run(10000, runs > 0 ? runs : 100);
+        scene = Scene::create();
+        director->end();
+    }
+    else if (convertBenchmark)
+    {
+        int runs = atoi(convertBenchmark);
+        ConvertBenchmark::run(2048, runs > 0 ? runs : 10);
+        scene = Scene::create();
+        director->end();
+    }
+    else if (labelBenchmark)
+    {
+        int labels = atoi(labelBenchmark);
+        scene = LabelBenchmark::createScene(labels > 0 ? labels : 1000, 600);
+    }
+    else if (replayPath && recorder->replay(replayPath, replaySpeed ? (float)atof(replaySpeed) : 1.0f))
+    {
+        auto profiler = std::make_shared<FrameProfiler>();
+        if (headless)
+            profiler->start();
+
+        recorder->setFinishedCallback([=](){
+            log("replayed %u ticks of %s", recorder->getTick(), replayPath);
+            if (recorder->hasNextRun())
+            {
+                Director::getInstance()->replaceScene(createRecordedScene(recorder->getNextScene()));
+                return;
+            }
+            log("%ld KB of resident textures", (long)Director::getInstance()->getTextureCache()->getResidentBytes() / 1024);
+            profiler->stop();
+            profiler->report();
+            Director::getInstance()->end();
+        });
+        scene = createRecordedScene(recorder->getScene());
+    }
+    else
+    {
+        if (recordPath)
+        {
+            recorder->record(recordPath, (unsigned int)time(nullptr));
+        }
+
+        // create a scene. it's an autorelease object    
+        scene = CreateScene<WelcomeScene>();
+    }
 
     // run
     director->runWithScene(scene);
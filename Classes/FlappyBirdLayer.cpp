@@ -22,6 +22,8 @@ Scene* FlappyBirdLayer::createScene()
     if (world)
     {
         world->setGravity(Vect(0,-700));
+        // step the physics at 60 Hz whatever the frame rate, the sprites are interpolated in between
+        world->setFixedTimeStep(1.0f / 60.0f);
 #ifdef _DEBUG
         world->setDebugDrawMask(PhysicsWorld::DEBUGDRAW_ALL);
 #endif 
@@ -45,6 +47,10 @@ void FlappyBirdLayer::onEnter()
     Layer::onEnter();
     auto size = Director::getInstance()->getVisibleSize();
 
+    // the run begins, the randomizers are seeded from here when recording or replaying
+    InputRecorder::InstancePtr()->begin(RECORDED_SCENE_FLAPPY_BIRD, CC_CALLBACK_1(FlappyBirdLayer::onInput, this));
+    mRandom.seed(next_random_seed());
+
     // create background 
     auto bkg = Sprite::create(bird_bg);
     this->addChild(bkg,DEPTH_SKY, TAG_SKY);
@@ -103,6 +109,12 @@ void FlappyBirdLayer::onEnter()
     status = GAME_STATUS_RESTART;
 }
 
+void FlappyBirdLayer::onExit()
+{
+    InputRecorder::InstancePtr()->end();
+    Layer::onExit();
+}
+
 /// <description>
 /// Get the Hero bird
 /// </description>
@@ -242,7 +254,7 @@ void FlappyBirdLayer::addObstacle(float tm)
     int offsetY = spriteSize.height / 4;
 	int maxUpY = size.height + offsetY;
     int minUpY = size.height - offsetY;
-	int y1 = CCRANDOM_0_1()*(maxUpY - minUpY) + minUpY;
+	int y1 = mRandom()*(maxUpY - minUpY) + minUpY;
     
     /// the gap is the distance between up obstacle and down obstacle
     int gap= spriteSize.height/3;
@@ -329,12 +341,36 @@ void FlappyBirdLayer::gameOver()
     this->unscheduleUpdate();
     
     setScore(score/2);
+    auto recorder = InputRecorder::InstancePtr();
+    if (recorder->getMode() != InputRecorder::MODE_LIVE)
+    {
+        log("game over at tick %u, score %d", recorder->getTick(), score/2);
+    }
     /// show the gameover flag
     this->getChildByTag(TAG_GAMEOVER)->setVisible(true);
 }
 
 void FlappyBirdLayer::onTouchesBegan(const vector<Touch*>& touches, Event* event)
 {
+    InputRecorder::InstancePtr()->push(INPUT_TOUCH_BEGAN);
+}
+
+void FlappyBirdLayer::onTouchesEnded(const vector<Touch*>& touches, Event* event)
+{
+    InputRecorder::InstancePtr()->push(INPUT_TOUCH_ENDED);
+}
+
+void FlappyBirdLayer::onInput(InputType input)
+{
+    if (input == INPUT_TOUCH_ENDED)
+    {
+        if (status == GAME_STATUS_PLAYING)
+        {
+            isFlying = false;
+        }
+        return;
+    }
+
     if (status == GAME_STATUS_RESTART)
     {
         gameStart();
@@ -350,14 +386,6 @@ void FlappyBirdLayer::onTouchesBegan(const vector<Touch*>& touches, Event* event
 	}
 }
 
-void FlappyBirdLayer::onTouchesEnded(const vector<Touch*>& touches, Event* event)
-{
-	if (status == GAME_STATUS_PLAYING)
-	{
-		isFlying = false;
-	}
-}
-
 bool FlappyBirdLayer::onContactBegin(PhysicsContact& contact)
 {
    Node* pNodeA = contact.getShapeA()->getBody()->getNode();
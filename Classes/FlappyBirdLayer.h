@@ -17,11 +17,15 @@ public:
 	virtual void update(float time) override;
     /// when the node is added into 
     virtual void onEnter() override;
+    /// when the node is removed from the stage
+    virtual void onExit() override;
 
     /// event reactions
 	virtual void onTouchesEnded(const vector<Touch*>& touches, Event* event) override;
 	virtual void onTouchesBegan(const vector<Touch*>& touches, Event* event) override;
     virtual bool onContactBegin(PhysicsContact& contact);
+    /// the touches handed back by the InputRecorder at the beginning of a tick
+    void onInput(InputType input);
 
 protected:
     /// <description>
@@ -82,4 +86,6 @@ private:
 	int     status;
 	int     score;
 	float   gravity;
+    /// the heights of the obstacles, seeded by the InputRecorder
+    randomizer<float> mRandom;
 };
@@ -3,6 +3,7 @@
 
 #include "cocos2d.h"
 #include "ccUtils.h"
+#include <chrono>
 #include "NAGA/NagaLib.h"
 #include "NagaAdapter.h"
 
@@ -10,6 +11,11 @@ USING_NS_CC;
 USING_NAGA;
 
 #include "Util/PhysicsHelper.h"
+#include "Util/InputRecorder.h"
+#include "Util/FrameProfiler.h"
+#include "Util/LabelBenchmark.h"
+#include "Util/ConvertBenchmark.h"
+#include "Util/SortBenchmark.h"
 #include "Objects/Random.h"
 #include "Objects/VertexBuffer.h"
 #include "Scenes/GameLayer.h"
@@ -57,8 +57,47 @@ namespace detail
         static inline /*const_expr*/ result_type Min() { return 0.0f; }
         static inline /*const_expr*/ result_type Max() { return 1.0f; }
     };
+
+    /// the engine handing out the seeds, only used once set_random_seed is called
+    inline std::mt19937*& seed_engine() 
+    {
+        static std::mt19937* engine = nullptr;
+        return engine;
+    }
 };
 
+/// <description>
+/// make every randomizer created from now on draw its seed from `seed`, so
+/// that the same sequence of randomizers gives the same numbers on every run
+/// </description>
+inline void set_random_seed(unsigned int seed) 
+{
+    std::mt19937*& engine = detail::seed_engine();
+    if (engine == nullptr)
+        engine = new std::mt19937(seed);
+    else
+        engine->seed(seed);
+}
+
+/// <description>
+/// go back to seeding the randomizers from the random device
+/// </description>
+inline void clear_random_seed() 
+{
+    std::mt19937*& engine = detail::seed_engine();
+    delete engine;
+    engine = nullptr;
+}
+
+/// <description>
+/// the seed for the next randomizer
+/// </description>
+inline unsigned int next_random_seed() 
+{
+    std::mt19937* engine = detail::seed_engine();
+    return engine ? (*engine)() : std::random_device()();
+}
+
 template <typename _Ty>
     class randomizer 
     {       
@@ -71,11 +110,16 @@ template <typename _Ty>
         distribution_type dist;
     public:
         randomizer(_Ty m=Traits::Min(), _Ty n=Traits::Max()) 
-            : engine(std::random_device()()), dist(m,n){}
+            : engine(next_random_seed()), dist(m,n){}
 
         inline result_type operator() () {
             return dist(engine);
         }
+
+        inline void seed(unsigned int s) {
+            engine.seed(s);
+            dist.reset();
+        }
     };
 
 template <>
@@ -92,7 +136,13 @@ template <>
 
     public:
         randomizer() 
-            : engine(std::random_device()()), dist(0,256){}
+            : engine(next_random_seed()), dist(0,256){}
+
+        inline void seed(unsigned int s) 
+        {
+            engine.seed(s);
+            dist.reset();
+        }
 
         inline result_type operator() () 
         {
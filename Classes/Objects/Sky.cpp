@@ -52,6 +52,9 @@ bool Sky::init()
         return false;
 
     this->addChild(sprite, DEPTH_SKY, TAG_SKY);
+
+    /// the sky is static, replay its render commands instead of visiting it every frame
+    this->setRenderCacheEnabled(true);
     return true;
 }
 		
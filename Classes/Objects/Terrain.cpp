@@ -46,6 +46,10 @@ Terrain::Terrain()
     , mBorderVerticeCount(0)
     , mFromKeyPointI(-1)
     , mToKeyPointI(-1)
+    , mPrevFromKeyPointI(-1)
+    , mPrevToKeyPointI(-1)
+    , mVerticesDirty(false)
+    , mVerticesComputed(false)
 {    
     /// generate "theme" color and other colors generated will be close to it 
     mThemeColor = randomColor();
@@ -64,6 +68,7 @@ Terrain::~Terrain()
 bool Terrain::init() 
 {
     mTextureSize = 1024;      
+    mWinSize = Director::getInstance()->getWinSize();
     this->mStripes = this->generateStripesSprite();
     if (!mStripes)
         return false;
@@ -82,6 +87,7 @@ bool Terrain::init()
     /// force to reset the offset
     this->mOffsetX = -1.0f;
     setOffsetX(0.f);
+    resetHillVertices();
    
     return true;
 }
@@ -108,6 +114,9 @@ int Terrain::textureSize()
 void Terrain::onEnter() 
 {
     Node::onEnter();
+
+    // the hills are tessellated on the JobPool while the other nodes update
+    this->scheduleParallelUpdate();
 }
 
 /// <description>
@@ -118,16 +127,33 @@ void Terrain::onEnter()
 /// </description>
 void Terrain::onExit() 
 {
+    this->unscheduleUpdate();
     Node::onExit();
 
 }
 
 /// <description>
-/// Update method will be called automatically every frame if "scheduleUpdate" is called, and the node is "live"
+/// build the hill vertices of the new offset, called on a worker thread every frame
 /// </description>
-void Terrain::update(float delta) 
+void Terrain::computeUpdate(float delta) 
 {
+    if (mVerticesDirty)
+    {
+        mVerticesDirty = false;
+        mVerticesComputed = computeHillVertices();
+    }
+}
 
+/// <description>
+/// upload the vertices built by computeUpdate, called on the cocos2d thread
+/// </description>
+void Terrain::applyUpdate(float delta) 
+{
+    if (mVerticesComputed)
+    {
+        mVerticesComputed = false;
+        uploadHillVertices();
+    }
 }
 
 /// <description>
@@ -280,20 +306,29 @@ bool Terrain::createPhysicsBody()
 }
 
 /// <description>
-/// regenerate the hill vertices
+/// regenerate the hill vertices right away
 /// </description>
 void Terrain::resetHillVertices()
 {
-	static int prevFromKeyPointI = -1;
-	static int prevToKeyPointI = -1;
-	
+    mVerticesDirty = false;
+    mVerticesComputed = false;
+    if (computeHillVertices())
+        uploadHillVertices();
+}
+
+/// <description>
+/// build the hill vertices of the visible key points in memory, 
+/// returns false when the visible key points didn't change
+/// it doesn't touch GL nor the node, so it can run on a worker thread
+/// </description>
+bool Terrain::computeHillVertices()
+{
 	// key points interval for drawing
-    Size size = Director::getInstance()->getWinSize();
-    int screenW = size.width;
-    int screenH = size.height;
+    int screenW = mWinSize.width;
 
 	float leftSideX = mOffsetX -screenW/8.0f/this->mScale;
-	float rightSideX= mOffsetX+screenW*7.f/8.0f/this->mScale;
+	// the vertices are drawn a frame after the offset changed, keep a margin on the scrolling side
+	float rightSideX= mOffsetX+screenW/this->mScale;
 	
 	// adjust position for retina
 	leftSideX  *= CC_CONTENT_SCALE_FACTOR();
@@ -318,57 +353,67 @@ void Terrain::resetHillVertices()
 		}
 	}
 	
-	if (prevFromKeyPointI != mFromKeyPointI || prevToKeyPointI != mToKeyPointI) 
-    {        
-        VectList borderVertices;
-		// vertices for visible area
-        mHillVertices.Update(GL_WRITE_ONLY, [&](V2F_T2F* hillVertices)
+	if (mPrevFromKeyPointI == mFromKeyPointI && mPrevToKeyPointI == mToKeyPointI) 
+        return false;
+
+    // vertices for visible area
+    mHillVertexData.clear();
+    mBorderVertexData.clear();
+    Vertex2F p0, p1, pt0, pt1;
+    p0 = mHillKeyPoints[mFromKeyPointI];
+    for (int i=mFromKeyPointI+1; i<mToKeyPointI+1; i++) 
+    {
+        p1 = mHillKeyPoints[i];
+        // triangle strip between p0 and p1
+        int hSegments = floorf((p1.x-p0.x)/kHillSegmentWidth);
+        int vSegments = 1;
+        float dx = (p1.x - p0.x) / hSegments;
+        float da = M_PI / hSegments;
+        float ymid = (p0.y + p1.y) / 2;
+        float ampl = (p0.y - p1.y) / 2;                
+        pt0 = p0;
+        mBorderVertexData.push_back(pt0);
+        for (int j=1; j<hSegments+1; j++) 
         {
-            nHillVertices = 0;
-            Vertex2F p0, p1, pt0, pt1;
-            p0 = mHillKeyPoints[mFromKeyPointI];
-            for (int i=mFromKeyPointI+1; i<mToKeyPointI+1; i++) 
+            pt1.x = p0.x + j*dx;
+            pt1.y = ymid + ampl * cosf(da*j);
+            for (int k=0; k<vSegments+1; k++) 
             {
-                p1 = mHillKeyPoints[i];
-                // triangle strip between p0 and p1
-                int hSegments = floorf((p1.x-p0.x)/kHillSegmentWidth);
-                int vSegments = 1;
-                float dx = (p1.x - p0.x) / hSegments;
-                float da = M_PI / hSegments;
-                float ymid = (p0.y + p1.y) / 2;
-                float ampl = (p0.y - p1.y) / 2;                
-                pt0 = p0;
-                borderVertices.push_back(pt0);
-                for (int j=1; j<hSegments+1; j++) 
-                {
-                    pt1.x = p0.x + j*dx;
-                    pt1.y = ymid + ampl * cosf(da*j);
-                    for (int k=0; k<vSegments+1; k++) 
-                    {
-                        hillVertices[nHillVertices].vertices    = Vertex2F(pt0.x, pt0.y-(float)mTextureSize/vSegments*k);
-                        hillVertices[nHillVertices++].texCoords = Tex2F(pt0.x/(float)mTextureSize, 1.0f - (float)(k)/vSegments);
-                        hillVertices[nHillVertices].vertices    = Vertex2F(pt1.x, pt1.y-(float)mTextureSize/vSegments*k);
-                        hillVertices[nHillVertices++].texCoords = Tex2F(pt1.x/(float)mTextureSize, 1.0f - (float)(k)/vSegments);
-                    }
-                    pt0 = pt1;
-                    borderVertices.push_back(pt1);
-                }			
-                p0 = p1;
+                V2F_T2F v0, v1;
+                v0.vertices    = Vertex2F(pt0.x, pt0.y-(float)mTextureSize/vSegments*k);
+                v0.texCoords   = Tex2F(pt0.x/(float)mTextureSize, 1.0f - (float)(k)/vSegments);
+                v1.vertices    = Vertex2F(pt1.x, pt1.y-(float)mTextureSize/vSegments*k);
+                v1.texCoords   = Tex2F(pt1.x/(float)mTextureSize, 1.0f - (float)(k)/vSegments);
+                mHillVertexData.push_back(v0);
+                mHillVertexData.push_back(v1);
             }
-        });
+            pt0 = pt1;
+            mBorderVertexData.push_back(pt1);
+        }			
+        p0 = p1;
+    }
 
-        mBorderVerticeCount = 0;
-        mBorderVertices.Update(GL_WRITE_ONLY, [&](Vertex2F* vertices)
-        {
-            std::for_each(borderVertices.begin(), borderVertices.end(), [&](const Vertex2F& v)
-                {
-                    vertices[mBorderVerticeCount++] = v;
-                });            
-        });	
-
-		prevFromKeyPointI = mFromKeyPointI;
-		prevToKeyPointI = mToKeyPointI;        
-	}
+    mPrevFromKeyPointI = mFromKeyPointI;
+    mPrevToKeyPointI = mToKeyPointI;        
+    return true;
+}
+
+/// <description>
+/// copy the vertices built by computeHillVertices to the vertex buffers
+/// </description>
+void Terrain::uploadHillVertices()
+{
+    nHillVertices = MIN((int)mHillVertexData.size(), (int)kMaxHillVertices);
+    mHillVertices.Update(GL_WRITE_ONLY, [&](V2F_T2F* hillVertices)
+    {
+        std::copy(mHillVertexData.begin(), mHillVertexData.begin() + nHillVertices, hillVertices);
+    });
+
+    mBorderVerticeCount = MIN((int)mBorderVertexData.size(), (int)kMaxBorderVertices);
+    mBorderVertices.Update(GL_WRITE_ONLY, [&](Vertex2F* vertices)
+    {
+        std::copy(mBorderVertexData.begin(), mBorderVertexData.begin() + mBorderVerticeCount, vertices);
+    });	
 }
 
 /// <description>
@@ -444,7 +489,8 @@ void Terrain::setOffsetX(float offsetX)
         int screenH = size.height;
 
 		this->setPosition(screenW/8- mOffsetX * mScale, 0);
-		this->resetHillVertices();
+		// the vertices are rebuilt by the next computeUpdate
+		mVerticesDirty = true;
 	}
 }
 
@@ -462,4 +508,7 @@ void Terrain::reset()
 	this->mStripes = this->generateStripesSprite();	
 	mFromKeyPointI = 0;
 	mToKeyPointI = 0;
+	mPrevFromKeyPointI = -1;
+	mPrevToKeyPointI = -1;
+	mVerticesDirty = true;
 }
@@ -51,9 +51,14 @@ public:
     virtual void onEnter() override;
 
     /// <description>
-    /// Update method will be called automatically every frame if "scheduleUpdate" is called, and the node is "live"
+    /// build the hill vertices of the new offset, called on a worker thread every frame
     /// </description>
-    virtual void update(float delta) override;
+    virtual void computeUpdate(float delta) override;
+
+    /// <description>
+    /// upload the vertices built by computeUpdate, called on the cocos2d thread
+    /// </description>
+    virtual void applyUpdate(float delta) override;
 
     /// <description>
     /// Event callback that is invoked every time the Node leaves the 'stage'.
@@ -112,6 +117,8 @@ protected:
     void generateBorderVertices();
     bool createPhysicsBody();
     void resetHillVertices();
+    bool computeHillVertices();
+    void uploadHillVertices();
     Color4F randomColor();
 
 private:    
@@ -125,6 +132,14 @@ private:
     int mBorderVerticeCount;
     int mFromKeyPointI;
     int mToKeyPointI;
+    int mPrevFromKeyPointI;
+    int mPrevToKeyPointI;
+
+    /// vertices built off the cocos2d thread, uploaded in applyUpdate
+    std::vector<V2F_T2F> mHillVertexData;
+    VectList mBorderVertexData;
+    bool mVerticesDirty;
+    bool mVerticesComputed;
 
     Color4F mThemeColor;
 
@@ -133,6 +148,7 @@ private:
     float mScale;
     float mOffsetX;
     int mTextureSize;  
+    Size mWinSize;
 
     /// custom command object for terrain sprite rendering
     CustomCommand mCustomCommand,mRenderCommand;
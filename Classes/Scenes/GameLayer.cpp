@@ -33,6 +33,7 @@ Scene* GameLayer::createScene()
 {
     auto scene = Scene::createWithPhysics();
     auto world = scene->getPhysicsWorld();
+    world->setFixedTimeStep(1.0f / 60.0f);
 
 #ifdef _DEBUG
     world->setDebugDrawMask(PhysicsWorld::DEBUGDRAW_ALL);
@@ -60,6 +61,8 @@ bool GameLayer::init()
     if (!Layer::init()) 
         return false;    
 
+    mOffset = 0.0f;
+
     return true;
 }
 
@@ -94,10 +97,7 @@ void GameLayer::onTouchesBegan(const std::vector<Touch*>& touches, Event*)
     if (touches.empty())
         return;
 
-    cocos2d::Touch* touch = touches[0];
-    Point location = touch->getLocation();
-
-    Hero::InstancePtr()->setDiving(true); 
+    InputRecorder::InstancePtr()->push(INPUT_TOUCH_BEGAN);
 }
 
 /// <description>
@@ -108,9 +108,15 @@ void GameLayer::onTouchesEnded(const std::vector<cocos2d::Touch*>& touches, coco
     if (touches.empty())
         return;
 
-    cocos2d::Touch* touch = touches[0];
-    Point location = touch->getLocation();
-    Hero::InstancePtr()->setDiving(false);
+    InputRecorder::InstancePtr()->push(INPUT_TOUCH_ENDED);
+}
+
+/// <description>
+/// the touches handed back by the InputRecorder at the beginning of a tick
+/// </description>
+void GameLayer::onInput(InputType input)
+{
+    Hero::InstancePtr()->setDiving(input == INPUT_TOUCH_BEGAN);
 }
 
 /// <description>
@@ -136,6 +142,10 @@ void GameLayer::onEnter()
     Size screenSize = Director::getInstance()->getWinSize();
     float width = screenSize.width, height = screenSize.height;
 
+    // the run begins, the randomizers are seeded from here when recording or replaying
+    InputRecorder::InstancePtr()->begin(RECORDED_SCENE_GAME, CC_CALLBACK_1(GameLayer::onInput, this));
+    mOffset = 0.0f;
+
     //auto sky = Sky::InstancePtr();
     //this->addChild(sky);
 
@@ -164,6 +174,7 @@ Terrain* GameLayer::getTerrain()
 /// </description>
 void GameLayer::onExit()
 {
+    InputRecorder::InstancePtr()->end();
     Layer::onExit();
 
 }
@@ -184,11 +195,10 @@ void GameLayer::update(float dt)
         height = minHeight;
     }
     
-    static float offset = 0.0f;
-    offset += 100.f * dt;
+    mOffset += 100.f * dt;
     float scale = minHeight / height;
     getTerrain()->setScale(scale);
-    getTerrain()->setOffsetX(pos.x + offset);
+    getTerrain()->setOffsetX(pos.x + mOffset);
 }
 
 /// <description>
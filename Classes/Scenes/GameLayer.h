@@ -103,6 +103,11 @@ protected:
     /// </description>
     void onTouchesBegan(const std::vector<cocos2d::Touch*>&, cocos2d::Event*);
     void onTouchesEnded(const std::vector<cocos2d::Touch*>&, cocos2d::Event*);
+
+    /// <description>
+    /// the touches handed back by the InputRecorder at the beginning of a tick
+    /// </description>
+    void onInput(InputType input);
     
     /// <description>
     /// init the UI layouts / need another layer?
@@ -113,6 +118,12 @@ protected:
     /// get the terrain object
     /// </description>
     Terrain* getTerrain();
+
+private:
+    /// <description>
+    /// the distance the terrain scrolled since the layer entered
+    /// </description>
+    float mOffset;
 };
 
 #endif // __Game_Scene_H__
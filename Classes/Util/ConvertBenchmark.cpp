@@ -0,0 +1,88 @@
+/*
+    Copyright 2012 NAGA.  All Rights Reserved.
+
+    The source code contained or described herein and all documents related
+    to the source code ("Material") are owned by NAGA or its suppliers or 
+	licensors.  Title to the Material remains with NAGA or its suppliers and 
+	licensors.  The Material is protected by worldwide copyright laws and 
+	treaty provisions.  No part of the Material may be used, copied, reproduced, 
+	modified, published, uploaded, posted, transmitted, distributed, or 
+	disclosed in any way without NAGA's prior express written permission.
+
+    No license under any patent, copyright, trade secret or other
+    intellectual property right is granted to or conferred upon you by
+    disclosure or delivery of the Materials, either expressly, by
+    implication, inducement, estoppel or otherwise.  Any license under such
+    intellectual property rights must be express and approved by NAGA in
+    writing.
+*/
+
+/*
+	Author		:	Yu Li
+	Description	:	Benchmarks the pixel format conversions of textures
+	History		:	2014, Initial implementation.
+*/
+#include "Impl.h"
+
+USING_NS_CC;
+
+namespace
+{
+    struct Conversion
+    {
+        const char*             name;
+        Texture2D::PixelFormat  from;
+        Texture2D::PixelFormat  to;
+    };
+
+    const Conversion conversions[] =
+    {
+        { "RGBA8888 -> RGBA4444", Texture2D::PixelFormat::RGBA8888, Texture2D::PixelFormat::RGBA4444 },
+        { "RGBA8888 -> RGB5A1", Texture2D::PixelFormat::RGBA8888, Texture2D::PixelFormat::RGB5A1 },
+        { "RGBA8888 -> RGB565", Texture2D::PixelFormat::RGBA8888, Texture2D::PixelFormat::RGB565 },
+        { "RGBA8888 -> RGB888", Texture2D::PixelFormat::RGBA8888, Texture2D::PixelFormat::RGB888 },
+        { "RGBA8888 -> AI88", Texture2D::PixelFormat::RGBA8888, Texture2D::PixelFormat::AI88 },
+        { "RGBA8888 -> I8", Texture2D::PixelFormat::RGBA8888, Texture2D::PixelFormat::I8 },
+        { "RGBA8888 -> A8", Texture2D::PixelFormat::RGBA8888, Texture2D::PixelFormat::A8 },
+        { "RGB888 -> RGBA8888", Texture2D::PixelFormat::RGB888, Texture2D::PixelFormat::RGBA8888 },
+        { "RGB888 -> RGB565", Texture2D::PixelFormat::RGB888, Texture2D::PixelFormat::RGB565 },
+        { "RGB888 -> RGBA4444", Texture2D::PixelFormat::RGB888, Texture2D::PixelFormat::RGBA4444 },
+        { "AI88 -> RGBA8888", Texture2D::PixelFormat::AI88, Texture2D::PixelFormat::RGBA8888 },
+        { "I8 -> RGBA8888", Texture2D::PixelFormat::I8, Texture2D::PixelFormat::RGBA8888 },
+    };
+}
+
+/// <description>
+/// convert a size x size image to every format `runs` times and log the mean times
+/// </description>
+void ConvertBenchmark::run(int size, int runs)
+{
+    typedef std::chrono::high_resolution_clock Clock;
+
+    // the same noise on every run, one buffer large enough for every source format
+    const ssize_t pixels = (ssize_t)size * size;
+    std::vector<unsigned char> source(pixels * 4);
+    std::mt19937 engine(2014);
+    for (auto& component : source)
+        component = (unsigned char)engine();
+
+    log("converting %dx%d images %d times", size, size, runs);
+    for (const auto& conversion : conversions)
+    {
+        auto info = Texture2D::getPixelFormatInfoMap().find(conversion.from);
+        const ssize_t dataLen = pixels * info->second.bpp / 8;
+
+        double total = 0;
+        for (int i = 0; i < runs; ++i)
+        {
+            unsigned char* outData = nullptr;
+            ssize_t outDataLen = 0;
+            auto begin = Clock::now();
+            Texture2D::convertDataToFormat(source.data(), dataLen, conversion.from, conversion.to, &outData, &outDataLen);
+            total += std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+            if (outData != source.data())
+                free(outData);
+        }
+        log("%-20s %8.3f ms", conversion.name, total / runs);
+    }
+}
@@ -0,0 +1,42 @@
+/*
+    Copyright 2012 NAGA.  All Rights Reserved.
+
+    The source code contained or described herein and all documents related
+    to the source code ("Material") are owned by NAGA or its suppliers or 
+	licensors.  Title to the Material remains with NAGA or its suppliers and 
+	licensors.  The Material is protected by worldwide copyright laws and 
+	treaty provisions.  No part of the Material may be used, copied, reproduced, 
+	modified, published, uploaded, posted, transmitted, distributed, or 
+	disclosed in any way without NAGA's prior express written permission.
+
+    No license under any patent, copyright, trade secret or other
+    intellectual property right is granted to or conferred upon you by
+    disclosure or delivery of the Materials, either expressly, by
+    implication, inducement, estoppel or otherwise.  Any license under such
+    intellectual property rights must be express and approved by NAGA in
+    writing.
+*/
+
+/*
+	Author		:	Yu Li
+	Description	:	Benchmarks the pixel format conversions of textures
+	History		:	2014, Initial implementation.
+*/
+#ifndef __KOGO_ConvertBenchmark_H__
+#define __KOGO_ConvertBenchmark_H__
+
+/// <description>
+/// ConvertBenchmark converts a noisy square image to the pixel formats Texture2D
+/// converts decoded images to before uploading them, and logs how long each
+/// conversion takes. It runs on the CPU only, without any scene.
+/// </description>
+class ConvertBenchmark
+{
+public:
+    /// <description>
+    /// convert a size x size image to every format `runs` times and log the mean times
+    /// </description>
+    static void run(int size, int runs);
+};
+
+#endif // __KOGO_ConvertBenchmark_H__
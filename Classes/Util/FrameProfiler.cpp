@@ -0,0 +1,128 @@
+/*
+    Copyright 2012 NAGA.  All Rights Reserved.
+
+    The source code contained or described herein and all documents related
+    to the source code ("Material") are owned by NAGA or its suppliers or 
+	licensors.  Title to the Material remains with NAGA or its suppliers and 
+	licensors.  The Material is protected by worldwide copyright laws and 
+	treaty provisions.  No part of the Material may be used, copied, reproduced, 
+	modified, published, uploaded, posted, transmitted, distributed, or 
+	disclosed in any way without NAGA's prior express written permission.
+
+    No license under any patent, copyright, trade secret or other
+    intellectual property right is granted to or conferred upon you by
+    disclosure or delivery of the Materials, either expressly, by
+    implication, inducement, estoppel or otherwise.  Any license under such
+    intellectual property rights must be express and approved by NAGA in
+    writing.
+*/
+
+/*
+	Author		:	Yu Li
+	Description	:	Times the update, visit and render phases of the frames
+	History		:	2014, Initial implementation.
+*/
+#include "Impl.h"
+
+USING_NS_CC;
+
+/// <description>
+/// constructor
+/// </description>
+FrameProfiler::FrameProfiler()
+: mAfterUpdate(nullptr)
+, mAfterVisit(nullptr)
+, mAfterDraw(nullptr)
+, mFrames(0)
+, mUpdateTime(0)
+, mVisitTime(0)
+, mRenderTime(0)
+{
+    memset(&mStats, 0, sizeof(mStats));
+}
+
+/// <description>
+/// destructor
+/// </description>
+FrameProfiler::~FrameProfiler()
+{
+    stop();
+}
+
+/// <description>
+/// a frame is timed from the end of the previous one, its update phase includes
+/// the events polling and the scheduler
+/// </description>
+void FrameProfiler::start()
+{
+    stop();
+
+    auto dispatcher = Director::getInstance()->getEventDispatcher();
+    mAfterUpdate = dispatcher->addCustomEventListener(Director::EVENT_AFTER_UPDATE, [this](EventCustom*){ onAfterUpdate(); });
+    mAfterVisit = dispatcher->addCustomEventListener(Director::EVENT_AFTER_VISIT, [this](EventCustom*){ onAfterVisit(); });
+    mAfterDraw = dispatcher->addCustomEventListener(Director::EVENT_AFTER_DRAW, [this](EventCustom*){ onAfterDraw(); });
+    mLast = Clock::now();
+}
+
+void FrameProfiler::stop()
+{
+    if (!mAfterDraw)
+        return;
+
+    auto dispatcher = Director::getInstance()->getEventDispatcher();
+    dispatcher->removeEventListener(mAfterUpdate);
+    dispatcher->removeEventListener(mAfterVisit);
+    dispatcher->removeEventListener(mAfterDraw);
+    mAfterUpdate = mAfterVisit = mAfterDraw = nullptr;
+}
+
+/// <description>
+/// log the average time of the phases and the renderer stats per frame
+/// </description>
+void FrameProfiler::report() const
+{
+    if (mFrames == 0)
+        return;
+
+    double frames = mFrames;
+    log("frames: %u, update: %.3f ms, visit: %.3f ms, render: %.3f ms",
+        mFrames, mUpdateTime / frames, mVisitTime / frames, mRenderTime / frames);
+    log("per frame: commands: %.1f, batches: %.1f, vertices: %.1f, quads: %.1f, material changes: %.1f, custom commands: %.1f",
+        mStats.commands / frames, mStats.drawnBatches / frames, mStats.drawnVertices / frames,
+        mStats.quads / frames, mStats.materialChanges / frames, mStats.customCommands / frames);
+}
+
+void FrameProfiler::onAfterUpdate()
+{
+    mUpdateTime += elapsed(mLast);
+}
+
+void FrameProfiler::onAfterVisit()
+{
+    mVisitTime += elapsed(mLast);
+}
+
+void FrameProfiler::onAfterDraw()
+{
+    mRenderTime += elapsed(mLast);
+
+    auto& stats = Director::getInstance()->getRenderer()->getStats();
+    mStats.commands += stats.commands;
+    mStats.drawnBatches += stats.drawnBatches;
+    mStats.drawnVertices += stats.drawnVertices;
+    mStats.quads += stats.quads;
+    mStats.materialChanges += stats.materialChanges;
+    mStats.customCommands += stats.customCommands;
+    ++mFrames;
+}
+
+/// <description>
+/// milliseconds since `last`, which becomes now
+/// </description>
+double FrameProfiler::elapsed(Clock::time_point& last)
+{
+    auto now = Clock::now();
+    double ms = std::chrono::duration<double, std::milli>(now - last).count();
+    last = now;
+    return ms;
+}
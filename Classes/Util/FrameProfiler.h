@@ -0,0 +1,70 @@
+/*
+    Copyright 2012 NAGA.  All Rights Reserved.
+
+    The source code contained or described herein and all documents related
+    to the source code ("Material") are owned by NAGA or its suppliers or 
+	licensors.  Title to the Material remains with NAGA or its suppliers and 
+	licensors.  The Material is protected by worldwide copyright laws and 
+	treaty provisions.  No part of the Material may be used, copied, reproduced, 
+	modified, published, uploaded, posted, transmitted, distributed, or 
+	disclosed in any way without NAGA's prior express written permission.
+
+    No license under any patent, copyright, trade secret or other
+    intellectual property right is granted to or conferred upon you by
+    disclosure or delivery of the Materials, either expressly, by
+    implication, inducement, estoppel or otherwise.  Any license under such
+    intellectual property rights must be express and approved by NAGA in
+    writing.
+*/
+
+/*
+	Author		:	Yu Li
+	Description	:	Times the update, visit and render phases of the frames
+	History		:	2014, Initial implementation.
+*/
+#ifndef __KOGO_FrameProfiler_H__
+#define __KOGO_FrameProfiler_H__
+
+/// <description>
+/// FrameProfiler listens to the Director events to time the phases of every frame
+/// and sums up what the renderer processed. Together with a headless view and a
+/// replayed log, it benchmarks the game scenes on a machine without a GPU.
+/// </description>
+class FrameProfiler
+{
+public:
+    FrameProfiler();
+    ~FrameProfiler();
+
+public:
+    void start();
+    void stop();
+
+    /// <description>
+    /// log the average time of the phases and the renderer stats per frame
+    /// </description>
+    void report() const;
+
+    unsigned int getFrames() const { return mFrames; }
+
+private:
+    typedef std::chrono::high_resolution_clock Clock;
+
+    void onAfterUpdate();
+    void onAfterVisit();
+    void onAfterDraw();
+
+    double elapsed(Clock::time_point& last);
+
+    cocos2d::EventListenerCustom*   mAfterUpdate;
+    cocos2d::EventListenerCustom*   mAfterVisit;
+    cocos2d::EventListenerCustom*   mAfterDraw;
+    Clock::time_point   mLast;
+    unsigned int        mFrames;
+    double              mUpdateTime;
+    double              mVisitTime;
+    double              mRenderTime;
+    cocos2d::RendererStats mStats;
+};
+
+#endif // __KOGO_FrameProfiler_H__
@@ -0,0 +1,396 @@
+/*
+    Copyright 2012 NAGA.  All Rights Reserved.
+
+    The source code contained or described herein and all documents related
+    to the source code ("Material") are owned by NAGA or its suppliers or 
+	licensors.  Title to the Material remains with NAGA or its suppliers and 
+	licensors.  The Material is protected by worldwide copyright laws and 
+	treaty provisions.  No part of the Material may be used, copied, reproduced, 
+	modified, published, uploaded, posted, transmitted, distributed, or 
+	disclosed in any way without NAGA's prior express written permission.
+
+    No license under any patent, copyright, trade secret or other
+    intellectual property right is granted to or conferred upon you by
+    disclosure or delivery of the Materials, either expressly, by
+    implication, inducement, estoppel or otherwise.  Any license under such
+    intellectual property rights must be express and approved by NAGA in
+    writing.
+*/
+
+/*
+	Author		:	Yu Li
+	Description	:	Records the game inputs to replay a run deterministically
+	History		:	2014, Initial implementation.
+*/
+#include "Impl.h"
+
+USING_NS_CC;
+
+/// <description>
+/// the log is "FBRP", a version byte, the seed, the fixed delta time and the
+/// number of runs, then every run as its scene byte, its length in ticks and
+/// its number of events, followed by every event as the ticks elapsed since
+/// the previous one and the input. Integers are little endian, counts and
+/// ticks are variable length (7 bits per byte). A version 1 log is a single
+/// run of the flappy bird layer, without the run count nor the scene byte
+/// </description>
+static const char kLogMagic[4] = { 'F', 'B', 'R', 'P' };
+static const unsigned char kLogVersion = 2;
+
+static void writeUInt32(std::vector<unsigned char>& out, unsigned int value)
+{
+    for (int i = 0; i < 4; ++i)
+        out.push_back((unsigned char)(value >> (i * 8)));
+}
+
+static void writeVarUInt(std::vector<unsigned char>& out, unsigned int value)
+{
+    while (value >= 0x80) 
+    {
+        out.push_back((unsigned char)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((unsigned char)value);
+}
+
+static bool readUInt32(const unsigned char*& in, const unsigned char* end, unsigned int& value)
+{
+    if (end - in < 4)
+        return false;
+
+    value = 0;
+    for (int i = 0; i < 4; ++i)
+        value |= (unsigned int)*in++ << (i * 8);
+    return true;
+}
+
+static bool readVarUInt(const unsigned char*& in, const unsigned char* end, unsigned int& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 32 && in < end; shift += 7) 
+    {
+        unsigned char byte = *in++;
+        value |= (unsigned int)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+/// <description>
+/// constructor
+/// </description>
+InputRecorder::InputRecorder()
+    : mMode(MODE_LIVE)
+    , mRunning(false)
+    , mSeed(0)
+    , mFixedDelta(0.0f)
+    , mSpeed(1.0f)
+    , mAnimationInterval(0.0)
+    , mTick(0)
+    , mLength(0)
+    , mNextEvent(0)
+    , mRun(0)
+{
+}
+
+/// <description>
+/// destructor
+/// </description>
+InputRecorder::~InputRecorder()
+{
+    end();
+}
+
+/// <description>
+/// record the coming runs
+/// </description>
+void InputRecorder::record(const std::string& path, unsigned int seed, float fixedDelta /*= 1.0f / 60.0f*/)
+{
+    CCASSERT(!mRunning, "can't start recording during a run");
+    mMode = MODE_RECORD;
+    mPath = path;
+    mSeed = seed;
+    mFixedDelta = fixedDelta;
+    mSpeed = 1.0f;
+    mRun = 0;
+    mRuns.clear();
+}
+
+/// <description>
+/// replay a log in the coming runs
+/// </description>
+bool InputRecorder::replay(const std::string& path, float speed /*= 1.0f*/)
+{
+    CCASSERT(!mRunning, "can't start replaying during a run");
+    if (!load(path)) 
+    {
+        log("InputRecorder: can't replay %s", path.c_str());
+        mMode = MODE_LIVE;
+        return false;
+    }
+
+    mMode = MODE_REPLAY;
+    mPath.clear();
+    mRun = 0;
+    mSpeed = speed > 0 ? speed : 1.0f;
+    return true;
+}
+
+/// <description>
+/// a run begins
+/// </description>
+void InputRecorder::begin(RecordedScene scene, const InputHandler& handler)
+{
+    end();
+
+    mHandler = handler;
+    mRunning = true;
+    mTick = 0;
+    mNextEvent = 0;
+    mPending.clear();
+
+    auto director = Director::getInstance();
+    if (mMode != MODE_LIVE) 
+    {
+        // the run only depends on the inputs from now on
+        set_random_seed(mSeed);
+        director->setFixedDeltaTime(mFixedDelta);
+
+        mAnimationInterval = director->getAnimationInterval();
+        if (mMode == MODE_REPLAY) 
+        {
+            director->setAnimationInterval(mFixedDelta / mSpeed);
+
+            // a run past the end of the log, or in another layer, replays nothing
+            mLength = 0;
+            if (mRun < mRuns.size() && mRuns[mRun].scene == scene)
+                mLength = mRuns[mRun].length;
+            else
+                log("InputRecorder: run %u of the log isn't played in this scene", (unsigned int)mRun);
+        }
+        else 
+        {
+            Run run = { scene, 0 };
+            mRuns.push_back(run);
+            mRun = mRuns.size() - 1;
+        }
+    }
+
+    // before any other update, so the inputs are seen by the whole tick
+    director->getScheduler()->scheduleUpdate(this, Scheduler::PRIORITY_NON_SYSTEM_MIN, false);
+}
+
+/// <description>
+/// a run ends
+/// </description>
+void InputRecorder::end()
+{
+    if (!mRunning)
+        return;
+
+    mRunning = false;
+    mHandler = nullptr;
+
+    auto director = Director::getInstance();
+    director->getScheduler()->unscheduleUpdate(this);
+
+    if (mMode != MODE_LIVE) 
+    {
+        clear_random_seed();
+        director->setFixedDeltaTime(0.0f);
+        director->setAnimationInterval(mAnimationInterval);
+    }
+
+    if (mMode == MODE_RECORD) 
+    {
+        mRuns[mRun].length = mTick;
+        if (!mPath.empty() && !save(mPath))
+            log("InputRecorder: can't save %s", mPath.c_str());
+    }
+    else if (mMode == MODE_REPLAY) 
+    {
+        ++mRun;
+    }
+}
+
+/// <description>
+/// the game layer of the current run
+/// </description>
+RecordedScene InputRecorder::getScene() const
+{
+    return mRun < mRuns.size() ? mRuns[mRun].scene : RECORDED_SCENE_FLAPPY_BIRD;
+}
+
+/// <description>
+/// the game layer of the next run to replay
+/// </description>
+RecordedScene InputRecorder::getNextScene() const
+{
+    return mRun + 1 < mRuns.size() ? mRuns[mRun + 1].scene : RECORDED_SCENE_FLAPPY_BIRD;
+}
+
+/// <description>
+/// feed a touch input
+/// </description>
+void InputRecorder::push(InputType input)
+{
+    if (mMode != MODE_REPLAY)
+        mPending.push_back(input);
+}
+
+/// <description>
+/// hand the inputs of the tick to the game layer
+/// </description>
+void InputRecorder::update(float dt)
+{
+    if (mMode == MODE_REPLAY) 
+    {
+        if (mTick >= mLength) 
+        {
+            // a run with nothing to replay is over right away
+            if (mLength == 0 && mTick++ == 0 && mFinishedCallback)
+                mFinishedCallback();
+            return;
+        }
+
+        const auto& events = mRuns[mRun].events;
+        while (mNextEvent < events.size() && events[mNextEvent].tick == mTick) 
+        {
+            if (mHandler)
+                mHandler(events[mNextEvent].input);
+            ++mNextEvent;
+        }
+    }
+    else 
+    {
+        // the handler may push new inputs, they belong to the next tick
+        std::vector<InputType> inputs;
+        inputs.swap(mPending);
+        for (auto input : inputs) 
+        {
+            if (mMode == MODE_RECORD) 
+            {
+                Event event = { mTick, input };
+                mRuns[mRun].events.push_back(event);
+            }
+            if (mHandler)
+                mHandler(input);
+        }
+    }
+
+    ++mTick;
+
+    if (isFinished() && mFinishedCallback)
+        mFinishedCallback();
+}
+
+/// <description>
+/// save the inputs of the runs recorded so far
+/// </description>
+bool InputRecorder::save(const std::string& path) const
+{
+    std::vector<unsigned char> data;
+    data.insert(data.end(), kLogMagic, kLogMagic + sizeof(kLogMagic));
+    data.push_back(kLogVersion);
+    writeUInt32(data, mSeed);
+
+    unsigned int delta;
+    memcpy(&delta, &mFixedDelta, sizeof(delta));
+    writeUInt32(data, delta);
+
+    writeVarUInt(data, (unsigned int)mRuns.size());
+    for (size_t i = 0; i < mRuns.size(); ++i) 
+    {
+        const Run& run = mRuns[i];
+        data.push_back((unsigned char)run.scene);
+        writeVarUInt(data, mRunning && i == mRun ? mTick : run.length);
+        writeVarUInt(data, (unsigned int)run.events.size());
+        unsigned int tick = 0;
+        for (const auto& event : run.events) 
+        {
+            writeVarUInt(data, event.tick - tick);
+            data.push_back((unsigned char)event.input);
+            tick = event.tick;
+        }
+    }
+
+    FILE* fp = fopen(path.c_str(), "wb");
+    if (!fp)
+        return false;
+
+    size_t written = fwrite(data.data(), 1, data.size(), fp);
+    fclose(fp);
+    return written == data.size();
+}
+
+/// <description>
+/// load a log to replay
+/// </description>
+bool InputRecorder::load(const std::string& path)
+{
+    Data data = FileUtils::getInstance()->getDataFromFile(path);
+    const unsigned char* in = data.getBytes();
+    const unsigned char* end = in + data.getSize();
+
+    if (data.getSize() < sizeof(kLogMagic) + 1 
+        || memcmp(in, kLogMagic, sizeof(kLogMagic)) != 0 
+        || (in[sizeof(kLogMagic)] != kLogVersion && in[sizeof(kLogMagic)] != 1))
+        return false;
+    unsigned char version = in[sizeof(kLogMagic)];
+    in += sizeof(kLogMagic) + 1;
+
+    // parse into locals, the current log is only replaced by a valid one
+    unsigned int seed, delta, runCount = 1;
+    if (!readUInt32(in, end, seed) 
+        || !readUInt32(in, end, delta)
+        || (version != 1 && !readVarUInt(in, end, runCount)))
+        return false;
+
+    float fixedDelta;
+    memcpy(&fixedDelta, &delta, sizeof(delta));
+    if (!(fixedDelta > 0))
+        return false;
+
+    // every run takes at least 2 bytes, don't trust a count the file can't hold
+    if (runCount == 0 || runCount > (size_t)(end - in) / 2)
+        return false;
+
+    std::vector<Run> runs(runCount);
+    for (auto& run : runs) 
+    {
+        run.scene = RECORDED_SCENE_FLAPPY_BIRD;
+        if (version != 1) 
+        {
+            if (in == end)
+                return false;
+            run.scene = (RecordedScene)*in++;
+        }
+
+        unsigned int count;
+        if (!readVarUInt(in, end, run.length) || !readVarUInt(in, end, count))
+            return false;
+
+        // every event takes at least 2 bytes
+        if (count > (size_t)(end - in) / 2)
+            return false;
+
+        run.events.reserve(count);
+        unsigned int tick = 0;
+        for (unsigned int i = 0; i < count; ++i) 
+        {
+            unsigned int elapsed;
+            if (!readVarUInt(in, end, elapsed) || in == end)
+                return false;
+
+            tick += elapsed;
+            Event event = { tick, (InputType)*in++ };
+            run.events.push_back(event);
+        }
+    }
+
+    mSeed = seed;
+    mFixedDelta = fixedDelta;
+    mRuns.swap(runs);
+    return true;
+}
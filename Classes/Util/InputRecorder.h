@@ -0,0 +1,154 @@
+/*
+    Copyright 2012 NAGA.  All Rights Reserved.
+
+    The source code contained or described herein and all documents related
+    to the source code ("Material") are owned by NAGA or its suppliers or 
+	licensors.  Title to the Material remains with NAGA or its suppliers and 
+	licensors.  The Material is protected by worldwide copyright laws and 
+	treaty provisions.  No part of the Material may be used, copied, reproduced, 
+	modified, published, uploaded, posted, transmitted, distributed, or 
+	disclosed in any way without NAGA's prior express written permission.
+
+    No license under any patent, copyright, trade secret or other
+    intellectual property right is granted to or conferred upon you by
+    disclosure or delivery of the Materials, either expressly, by
+    implication, inducement, estoppel or otherwise.  Any license under such
+    intellectual property rights must be express and approved by NAGA in
+    writing.
+*/
+
+/*
+	Author		:	Yu Li
+	Description	:	Records the game inputs to replay a run deterministically
+	History		:	2014, Initial implementation.
+*/
+#ifndef __KOGO_InputRecorder_H__
+#define __KOGO_InputRecorder_H__
+
+/// <description>
+/// the inputs the game layers react to
+/// </description>
+enum InputType 
+{
+    INPUT_TOUCH_BEGAN   = 1,
+    INPUT_TOUCH_ENDED   = 2
+};
+
+/// <description>
+/// the game layers a run is recorded in, a replay creates the scene of each run
+/// </description>
+enum RecordedScene 
+{
+    RECORDED_SCENE_FLAPPY_BIRD  = 1,
+    RECORDED_SCENE_GAME         = 2
+};
+
+/// <description>
+/// InputRecorder sits between the touch events and the game layers.
+/// The layers push their touches and react to the inputs handed back at the
+/// beginning of every tick. When recording or replaying, the Director and the
+/// physics run at a fixed delta time and the randomizers are seeded, so a run
+/// only depends on the inputs and the tick they arrived at: the log made of
+/// them replays the same run, as fast as the main loop can go. Every run of
+/// a session is kept in the log, with the game layer it was played in.
+/// A log only replays the same way with the same build on the same platform.
+/// </description>
+class InputRecorder : public NAGA Singleton<InputRecorder>
+{
+public:
+    enum Mode 
+    {
+        MODE_LIVE,
+        MODE_RECORD,
+        MODE_REPLAY
+    };
+
+    typedef std::function<void(InputType)> InputHandler;
+
+    InputRecorder();
+    virtual ~InputRecorder();
+
+public:
+    /// <description>
+    /// record the coming runs, stepped by `fixedDelta` and seeded with `seed`,
+    /// the log of all the runs so far is saved to `path` when a run ends
+    /// </description>
+    void record(const std::string& path, unsigned int seed, float fixedDelta = 1.0f / 60.0f);
+
+    /// <description>
+    /// replay the log at `path` in the coming runs, `speed` times faster than real time
+    /// </description>
+    bool replay(const std::string& path, float speed = 1.0f);
+
+    /// <description>
+    /// called back once a run has been replayed, the next run of the log
+    /// is replayed when a game layer enters the stage again
+    /// </description>
+    void setFinishedCallback(const std::function<void()>& callback) { mFinishedCallback = callback; }
+
+    /// <description>
+    /// a run begins when the game layer `scene` enters the stage, it ends when the layer exits
+    /// </description>
+    void begin(RecordedScene scene, const InputHandler& handler);
+    void end();
+
+    /// <description>
+    /// feed a touch input, ignored while replaying
+    /// </description>
+    void push(InputType input);
+
+    /// <description>
+    /// hand the inputs of the tick to the game layer, called first every frame
+    /// </description>
+    void update(float dt);
+
+    /// <description>
+    /// save the inputs of the runs recorded so far
+    /// </description>
+    bool save(const std::string& path) const;
+
+    Mode getMode() const { return mMode; }
+    unsigned int getTick() const { return mTick; }
+
+    /// <description>
+    /// the game layers of the current run and of the next one to replay
+    /// </description>
+    RecordedScene getScene() const;
+    RecordedScene getNextScene() const;
+    bool isFinished() const { return mMode == MODE_REPLAY && mTick >= mLength; }
+    bool hasNextRun() const { return mMode == MODE_REPLAY && mRun + 1 < mRuns.size(); }
+
+private:
+    struct Event 
+    {
+        unsigned int tick;
+        InputType input;
+    };
+
+    struct Run 
+    {
+        RecordedScene scene;
+        unsigned int length;
+        std::vector<Event> events;
+    };
+
+    bool load(const std::string& path);
+
+    Mode                mMode;
+    bool                mRunning;
+    std::string         mPath;
+    unsigned int        mSeed;
+    float               mFixedDelta;
+    float               mSpeed;
+    double              mAnimationInterval;
+    unsigned int        mTick;
+    unsigned int        mLength;
+    size_t              mNextEvent;
+    size_t              mRun;
+    std::vector<Run>    mRuns;
+    std::vector<InputType> mPending;
+    InputHandler        mHandler;
+    std::function<void()> mFinishedCallback;
+};
+
+#endif // __KOGO_InputRecorder_H__
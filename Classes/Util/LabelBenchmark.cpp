@@ -0,0 +1,130 @@
+/*
+    Copyright 2012 NAGA.  All Rights Reserved.
+
+    The source code contained or described herein and all documents related
+    to the source code ("Material") are owned by NAGA or its suppliers or 
+	licensors.  Title to the Material remains with NAGA or its suppliers and 
+	licensors.  The Material is protected by worldwide copyright laws and 
+	treaty provisions.  No part of the Material may be used, copied, reproduced, 
+	modified, published, uploaded, posted, transmitted, distributed, or 
+	disclosed in any way without NAGA's prior express written permission.
+
+    No license under any patent, copyright, trade secret or other
+    intellectual property right is granted to or conferred upon you by
+    disclosure or delivery of the Materials, either expressly, by
+    implication, inducement, estoppel or otherwise.  Any license under such
+    intellectual property rights must be express and approved by NAGA in
+    writing.
+*/
+
+/*
+	Author		:	Yu Li
+	Description	:	Benchmarks labels whose strings change every frame
+	History		:	2014, Initial implementation.
+*/
+#include "Impl.h"
+
+USING_NS_CC;
+
+/// <description>
+/// create the scene holding the benchmark layer
+/// </description>
+Scene* LabelBenchmark::createScene(int labels, unsigned int frames)
+{
+    auto scene = Scene::create();
+    auto layer = LabelBenchmark::create(labels, frames);
+    if (layer)
+    {
+        scene->addChild(layer);
+    }
+    return scene;
+}
+
+LabelBenchmark* LabelBenchmark::create(int labels, unsigned int frames)
+{
+    auto layer = new LabelBenchmark();
+    if (layer && layer->init(labels, frames))
+    {
+        layer->autorelease();
+        return layer;
+    }
+    CC_SAFE_DELETE(layer);
+    return nullptr;
+}
+
+/// <description>
+/// constructor
+/// </description>
+LabelBenchmark::LabelBenchmark()
+: mFrame(0)
+, mFrames(0)
+{
+}
+
+/// <description>
+/// lay the labels out on a grid covering the visible area
+/// </description>
+bool LabelBenchmark::init(int labels, unsigned int frames)
+{
+    if (!Layer::init())
+        return false;
+
+    mFrames = frames;
+
+    auto origin = Director::getInstance()->getVisibleOrigin();
+    auto size = Director::getInstance()->getVisibleSize();
+    int columns = (int)ceilf(sqrtf((float)labels));
+    int rows = (labels + columns - 1) / columns;
+
+    mLabels.reserve(labels);
+    for (int i = 0; i < labels; ++i)
+    {
+        auto label = LabelBMFont::create("0", score_font);
+        label->setScale(0.25f);
+        label->setPosition(origin.x + size.width * (i % columns + 0.5f) / columns,
+                           origin.y + size.height * (i / columns + 0.5f) / rows);
+        addChild(label);
+        mLabels.push_back(label);
+    }
+    return true;
+}
+
+void LabelBenchmark::onEnter()
+{
+    Layer::onEnter();
+    scheduleUpdate();
+    mProfiler.start();
+}
+
+void LabelBenchmark::onExit()
+{
+    mProfiler.stop();
+    unscheduleUpdate();
+    Layer::onExit();
+}
+
+/// <description>
+/// set the next string on every label, quit once all the frames are profiled
+/// </description>
+void LabelBenchmark::update(float delta)
+{
+    if (mFrame == mFrames)
+    {
+        mProfiler.stop();
+        log("%u labels updated every frame", (unsigned int)mLabels.size());
+        mProfiler.report();
+        Director::getInstance()->end();
+        ++mFrame;
+        return;
+    }
+    if (mFrame > mFrames)
+        return;
+
+    char text[16];
+    for (size_t i = 0; i < mLabels.size(); ++i)
+    {
+        snprintf(text, sizeof(text), "%u", (unsigned int)(mFrame * 7 + i) % 100000);
+        mLabels[i]->setString(text);
+    }
+    ++mFrame;
+}
@@ -0,0 +1,59 @@
+/*
+    Copyright 2012 NAGA.  All Rights Reserved.
+
+    The source code contained or described herein and all documents related
+    to the source code ("Material") are owned by NAGA or its suppliers or 
+	licensors.  Title to the Material remains with NAGA or its suppliers and 
+	licensors.  The Material is protected by worldwide copyright laws and 
+	treaty provisions.  No part of the Material may be used, copied, reproduced, 
+	modified, published, uploaded, posted, transmitted, distributed, or 
+	disclosed in any way without NAGA's prior express written permission.
+
+    No license under any patent, copyright, trade secret or other
+    intellectual property right is granted to or conferred upon you by
+    disclosure or delivery of the Materials, either expressly, by
+    implication, inducement, estoppel or otherwise.  Any license under such
+    intellectual property rights must be express and approved by NAGA in
+    writing.
+*/
+
+/*
+	Author		:	Yu Li
+	Description	:	Benchmarks labels whose strings change every frame
+	History		:	2014, Initial implementation.
+*/
+#ifndef __KOGO_LabelBenchmark_H__
+#define __KOGO_LabelBenchmark_H__
+
+/// <description>
+/// LabelBenchmark fills the screen with score labels like the HUD's and sets a new
+/// string on every one of them each frame. It profiles a fixed number of frames,
+/// logs the report and quits, so it runs unattended with a headless view.
+/// </description>
+class LabelBenchmark : public cocos2d::Layer
+{
+public:
+    static cocos2d::Scene* createScene(int labels, unsigned int frames);
+    static LabelBenchmark* create(int labels, unsigned int frames);
+
+protected:
+    LabelBenchmark();
+
+    bool init(int labels, unsigned int frames);
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+
+    /// <description>
+    /// set the next string on every label, quit once all the frames are profiled
+    /// </description>
+    virtual void update(float delta) override;
+
+private:
+    std::vector<cocos2d::LabelBMFont*>  mLabels;
+    unsigned int    mFrame;
+    unsigned int    mFrames;
+    FrameProfiler   mProfiler;
+};
+
+#endif // __KOGO_LabelBenchmark_H__
@@ -0,0 +1,110 @@
+/*
+    Copyright 2012 NAGA.  All Rights Reserved.
+
+    The source code contained or described herein and all documents related
+    to the source code ("Material") are owned by NAGA or its suppliers or 
+	licensors.  Title to the Material remains with NAGA or its suppliers and 
+	licensors.  The Material is protected by worldwide copyright laws and 
+	treaty provisions.  No part of the Material may be used, copied, reproduced, 
+	modified, published, uploaded, posted, transmitted, distributed, or 
+	disclosed in any way without NAGA's prior express written permission.
+
+    No license under any patent, copyright, trade secret or other
+    intellectual property right is granted to or conferred upon you by
+    disclosure or delivery of the Materials, either expressly, by
+    implication, inducement, estoppel or otherwise.  Any license under such
+    intellectual property rights must be express and approved by NAGA in
+    writing.
+*/
+
+/*
+	Author		:	Yu Li
+	Description	:	Benchmarks the sort of the render queue
+	History		:	2014, Initial implementation.
+*/
+#include "Impl.h"
+
+USING_NS_CC;
+
+namespace
+{
+    enum Distribution
+    {
+        DISTRIBUTION_FLAT,
+        DISTRIBUTION_LAYERS,
+        DISTRIBUTION_RANDOM,
+    };
+
+    struct Scenario
+    {
+        const char*     name;
+        Distribution    distribution;
+    };
+
+    const Scenario scenarios[] =
+    {
+        { "flat (z = 0)", DISTRIBUTION_FLAT },
+        { "4 layers", DISTRIBUTION_LAYERS },
+        { "random z", DISTRIBUTION_RANDOM },
+    };
+
+    bool isOrderLess(RenderCommand* a, RenderCommand* b)
+    {
+        return a->getGlobalOrder() < b->getGlobalOrder();
+    }
+}
+
+/// <description>
+/// push and sort `commands` commands `runs` times for every Z distribution and log the mean times
+/// </description>
+void SortBenchmark::run(int commands, int runs)
+{
+    typedef std::chrono::high_resolution_clock Clock;
+
+    log("sorting %d render commands %d times", commands, runs);
+    for (const auto& scenario : scenarios)
+    {
+        // the same orders on every run
+        std::mt19937 engine(2014);
+        std::uniform_int_distribution<int> layer(-1, 2);
+        std::uniform_real_distribution<float> order(-100.0f, 100.0f);
+        std::vector<CustomCommand> customCommands(commands);
+        for (auto& command : customCommands)
+        {
+            switch (scenario.distribution)
+            {
+            case DISTRIBUTION_FLAT:
+                command.init(0);
+                break;
+            case DISTRIBUTION_LAYERS:
+                command.init((float)layer(engine));
+                break;
+            case DISTRIBUTION_RANDOM:
+                command.init(order(engine));
+                break;
+            }
+        }
+
+        RenderQueue queue;
+        std::vector<RenderCommand*> pointers;
+        pointers.reserve(commands);
+        double queueTotal = 0, stableSortTotal = 0;
+        for (int i = 0; i < runs; ++i)
+        {
+            auto begin = Clock::now();
+            queue.clear();
+            for (auto& command : customCommands)
+                queue.push_back(&command);
+            queue.sort();
+            queueTotal += std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+
+            begin = Clock::now();
+            pointers.clear();
+            for (auto& command : customCommands)
+                pointers.push_back(&command);
+            std::stable_sort(pointers.begin(), pointers.end(), isOrderLess);
+            stableSortTotal += std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+        }
+        log("%-14s RenderQueue %8.3f ms, std::stable_sort %8.3f ms", scenario.name, queueTotal / runs, stableSortTotal / runs);
+    }
+}
@@ -0,0 +1,43 @@
+/*
+    Copyright 2012 NAGA.  All Rights Reserved.
+
+    The source code contained or described herein and all documents related
+    to the source code ("Material") are owned by NAGA or its suppliers or 
+	licensors.  Title to the Material remains with NAGA or its suppliers and 
+	licensors.  The Material is protected by worldwide copyright laws and 
+	treaty provisions.  No part of the Material may be used, copied, reproduced, 
+	modified, published, uploaded, posted, transmitted, distributed, or 
+	disclosed in any way without NAGA's prior express written permission.
+
+    No license under any patent, copyright, trade secret or other
+    intellectual property right is granted to or conferred upon you by
+    disclosure or delivery of the Materials, either expressly, by
+    implication, inducement, estoppel or otherwise.  Any license under such
+    intellectual property rights must be express and approved by NAGA in
+    writing.
+*/
+
+/*
+	Author		:	Yu Li
+	Description	:	Benchmarks the sort of the render queue
+	History		:	2014, Initial implementation.
+*/
+#ifndef __KOGO_SortBenchmark_H__
+#define __KOGO_SortBenchmark_H__
+
+/// <description>
+/// SortBenchmark fills a RenderQueue with custom commands spread over a few
+/// kinds of global Z orders, and logs how long pushing and sorting them takes,
+/// next to a std::stable_sort of the same commands. It runs on the CPU only,
+/// without any scene.
+/// </description>
+class SortBenchmark
+{
+public:
+    /// <description>
+    /// push and sort `commands` commands `runs` times for every Z distribution and log the mean times
+    /// </description>
+    static void run(int commands, int runs);
+};
+
+#endif // __KOGO_SortBenchmark_H__
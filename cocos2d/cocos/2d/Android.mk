@@ -118,6 +118,7 @@ platform/CCSAXParser.cpp \
 platform/CCThread.cpp \
 platform/CCImage.cpp \
 renderer/CCCustomCommand.cpp \
+renderer/CCFrameArena.cpp \
 renderer/CCFrustum.cpp \
 renderer/CCGroupCommand.cpp \
 renderer/CCMaterialManager.cpp \
@@ -135,6 +136,7 @@ renderer/CCRenderMaterial.cpp \
 ../base/CCDataVisitor.cpp \
 ../base/CCDictionary.cpp \
 ../base/CCGeometry.cpp \
+../base/CCJobPool.cpp \
 ../base/CCNS.cpp \
 ../base/CCRef.cpp \
 ../base/CCSet.cpp \
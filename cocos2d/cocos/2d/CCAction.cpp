@@ -40,6 +40,7 @@ Action::Action()
 :_originalTarget(nullptr)
 ,_target(nullptr)
 ,_tag(Action::INVALID_TAG)
+,_tweenIndex(-1)
 {
 }
 
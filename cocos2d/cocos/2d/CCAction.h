@@ -112,8 +112,11 @@ protected:
     Node    *_target;
     /** The action tag. An identifier of the action */
     int     _tag;
+    /** The slot of the action in the tweens of the ActionManager, -1 when the action is stepped */
+    ssize_t _tweenIndex;
 
 private:
+    friend class ActionManager;
     CC_DISALLOW_COPY_AND_ASSIGN(Action);
 };
 
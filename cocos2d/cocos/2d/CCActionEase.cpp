@@ -33,6 +33,7 @@ THE SOFTWARE.
 
 #include "CCActionEase.h"
 #include "CCTweenFunction.h"
+#include <typeinfo>
 
 NS_CC_BEGIN
 
@@ -81,6 +82,16 @@ void ActionEase::update(float time)
     _inner->update(time);
 }
 
+bool ActionEase::describeEasedTween(IntervalTween &tween, int easing) const
+{
+    if (_inner->describeTween(tween) && tween.easing == tweenfunc::Linear)
+    {
+        tween.easing = easing;
+        return true;
+    }
+    return false;
+}
+
 ActionInterval* ActionEase::getInnerAction()
 {
     return _inner;
@@ -262,6 +273,11 @@ void EaseExponentialIn::update(float time)
     _inner->update(tweenfunc::expoEaseIn(time));
 }
 
+bool EaseExponentialIn::describeTween(IntervalTween &tween) const
+{
+    return typeid(*this) == typeid(EaseExponentialIn) && describeEasedTween(tween, tweenfunc::Expo_EaseIn);
+}
+
 ActionEase * EaseExponentialIn::reverse() const
 {
     return EaseExponentialOut::create(_inner->reverse());
@@ -302,6 +318,11 @@ void EaseExponentialOut::update(float time)
     _inner->update(tweenfunc::expoEaseOut(time));
 }
 
+bool EaseExponentialOut::describeTween(IntervalTween &tween) const
+{
+    return typeid(*this) == typeid(EaseExponentialOut) && describeEasedTween(tween, tweenfunc::Expo_EaseOut);
+}
+
 ActionEase* EaseExponentialOut::reverse() const
 {
     return EaseExponentialIn::create(_inner->reverse());
@@ -343,6 +364,11 @@ void EaseExponentialInOut::update(float time)
     _inner->update(tweenfunc::expoEaseInOut(time));
 }
 
+bool EaseExponentialInOut::describeTween(IntervalTween &tween) const
+{
+    return typeid(*this) == typeid(EaseExponentialInOut) && describeEasedTween(tween, tweenfunc::Expo_EaseInOut);
+}
+
 EaseExponentialInOut* EaseExponentialInOut::reverse() const
 {
     return EaseExponentialInOut::create(_inner->reverse());
@@ -384,6 +410,11 @@ void EaseSineIn::update(float time)
     _inner->update(tweenfunc::sineEaseIn(time));
 }
 
+bool EaseSineIn::describeTween(IntervalTween &tween) const
+{
+    return typeid(*this) == typeid(EaseSineIn) && describeEasedTween(tween, tweenfunc::Sine_EaseIn);
+}
+
 ActionEase* EaseSineIn::reverse() const
 {
     return EaseSineOut::create(_inner->reverse());
@@ -425,6 +456,11 @@ void EaseSineOut::update(float time)
     _inner->update(tweenfunc::sineEaseOut(time));
 }
 
+bool EaseSineOut::describeTween(IntervalTween &tween) const
+{
+    return typeid(*this) == typeid(EaseSineOut) && describeEasedTween(tween, tweenfunc::Sine_EaseOut);
+}
+
 ActionEase* EaseSineOut::reverse(void) const
 {
     return EaseSineIn::create(_inner->reverse());
@@ -466,6 +502,11 @@ void EaseSineInOut::update(float time)
     _inner->update(tweenfunc::sineEaseInOut(time));
 }
 
+bool EaseSineInOut::describeTween(IntervalTween &tween) const
+{
+    return typeid(*this) == typeid(EaseSineInOut) && describeEasedTween(tween, tweenfunc::Sine_EaseInOut);
+}
+
 EaseSineInOut* EaseSineInOut::reverse() const
 {
     return EaseSineInOut::create(_inner->reverse());
@@ -664,6 +705,11 @@ void EaseBounceIn::update(float time)
     _inner->update(tweenfunc::bounceEaseIn(time));
 }
 
+bool EaseBounceIn::describeTween(IntervalTween &tween) const
+{
+    return typeid(*this) == typeid(EaseBounceIn) && describeEasedTween(tween, tweenfunc::Bounce_EaseIn);
+}
+
 EaseBounce* EaseBounceIn::reverse() const
 {
     return EaseBounceOut::create(_inner->reverse());
@@ -705,6 +751,11 @@ void EaseBounceOut::update(float time)
     _inner->update(tweenfunc::bounceEaseOut(time));
 }
 
+bool EaseBounceOut::describeTween(IntervalTween &tween) const
+{
+    return typeid(*this) == typeid(EaseBounceOut) && describeEasedTween(tween, tweenfunc::Bounce_EaseOut);
+}
+
 EaseBounce* EaseBounceOut::reverse() const
 {
     return EaseBounceIn::create(_inner->reverse());
@@ -746,6 +797,11 @@ void EaseBounceInOut::update(float time)
     _inner->update(tweenfunc::bounceEaseInOut(time));
 }
 
+bool EaseBounceInOut::describeTween(IntervalTween &tween) const
+{
+    return typeid(*this) == typeid(EaseBounceInOut) && describeEasedTween(tween, tweenfunc::Bounce_EaseInOut);
+}
+
 EaseBounceInOut* EaseBounceInOut::reverse() const
 {
     return EaseBounceInOut::create(_inner->reverse());
@@ -787,6 +843,11 @@ void EaseBackIn::update(float time)
     _inner->update(tweenfunc::backEaseIn(time));
 }
 
+bool EaseBackIn::describeTween(IntervalTween &tween) const
+{
+    return typeid(*this) == typeid(EaseBackIn) && describeEasedTween(tween, tweenfunc::Back_EaseIn);
+}
+
 ActionEase* EaseBackIn::reverse() const
 {
     return EaseBackOut::create(_inner->reverse());
@@ -828,6 +889,11 @@ void EaseBackOut::update(float time)
     _inner->update(tweenfunc::backEaseOut(time));
 }
 
+bool EaseBackOut::describeTween(IntervalTween &tween) const
+{
+    return typeid(*this) == typeid(EaseBackOut) && describeEasedTween(tween, tweenfunc::Back_EaseOut);
+}
+
 ActionEase* EaseBackOut::reverse() const
 {
     return EaseBackIn::create(_inner->reverse());
@@ -869,6 +935,11 @@ void EaseBackInOut::update(float time)
     _inner->update(tweenfunc::backEaseInOut(time));
 }
 
+bool EaseBackInOut::describeTween(IntervalTween &tween) const
+{
+    return typeid(*this) == typeid(EaseBackInOut) && describeEasedTween(tween, tweenfunc::Back_EaseInOut);
+}
+
 EaseBackInOut* EaseBackInOut::reverse() const
 {
     return EaseBackInOut::create(_inner->reverse());
@@ -60,6 +60,8 @@ protected:
     virtual ~ActionEase();
     /** initializes the action */
     bool initWithAction(ActionInterval *action);
+    /** describes the inner action eased with a tweenfunc::TweenType, when the inner action is a linear tween */
+    bool describeEasedTween(IntervalTween &tween, int easing) const;
 
     /** The inner action */
     ActionInterval *_inner;
@@ -178,6 +180,7 @@ public:
 
     // Overrides
     virtual void update(float time) override;
+    virtual bool describeTween(IntervalTween &tween) const override;
 	virtual EaseExponentialIn* clone() const override;
 	virtual ActionEase* reverse() const override;
 
@@ -201,6 +204,7 @@ public:
 
     // Overrides
     virtual void update(float time) override;
+    virtual bool describeTween(IntervalTween &tween) const override;
 	virtual EaseExponentialOut* clone() const override;
 	virtual ActionEase* reverse() const override;
 
@@ -224,6 +228,7 @@ public:
 
     // Overrides
     virtual void update(float time) override;
+    virtual bool describeTween(IntervalTween &tween) const override;
 	virtual EaseExponentialInOut* clone() const override;
 	virtual EaseExponentialInOut* reverse() const override;
 
@@ -247,6 +252,7 @@ public:
 
     // Overrides
     virtual void update(float time) override;
+    virtual bool describeTween(IntervalTween &tween) const override;
 	virtual EaseSineIn* clone() const override;
 	virtual ActionEase* reverse() const override;
 
@@ -270,6 +276,7 @@ public:
 
     // Overrides
     virtual void update(float time) override;
+    virtual bool describeTween(IntervalTween &tween) const override;
 	virtual EaseSineOut* clone() const override;
 	virtual ActionEase* reverse() const override;
 
@@ -293,6 +300,7 @@ public:
 
     // Overrides
     virtual void update(float time) override;
+    virtual bool describeTween(IntervalTween &tween) const override;
 	virtual EaseSineInOut* clone() const override;
 	virtual EaseSineInOut* reverse() const override;
 
@@ -450,6 +458,7 @@ public:
 
     // Overrides
     virtual void update(float time) override;
+    virtual bool describeTween(IntervalTween &tween) const override;
 	virtual EaseBounceIn* clone() const override;
 	virtual EaseBounce* reverse() const override;
 
@@ -475,6 +484,7 @@ public:
 
     // Overrides
     virtual void update(float time) override;
+    virtual bool describeTween(IntervalTween &tween) const override;
 	virtual EaseBounceOut* clone() const override;
 	virtual EaseBounce* reverse() const override;
 
@@ -500,6 +510,7 @@ public:
 
     // Overrides
     virtual void update(float time) override;
+    virtual bool describeTween(IntervalTween &tween) const override;
 	virtual EaseBounceInOut* clone() const override;
 	virtual EaseBounceInOut* reverse() const override;
 
@@ -525,6 +536,7 @@ public:
 
     // Overrides
     virtual void update(float time) override;
+    virtual bool describeTween(IntervalTween &tween) const override;
 	virtual EaseBackIn* clone() const override;
 	virtual ActionEase* reverse() const override;
 
@@ -550,6 +562,7 @@ public:
 
     // Overrides
     virtual void update(float time) override;
+    virtual bool describeTween(IntervalTween &tween) const override;
 	virtual EaseBackOut* clone() const override;
 	virtual ActionEase* reverse() const override;
 
@@ -575,6 +588,7 @@ public:
 
     // Overrides
     virtual void update(float time) override;
+    virtual bool describeTween(IntervalTween &tween) const override;
 	virtual EaseBackInOut* clone() const override;
 	virtual EaseBackInOut* reverse() const override;
 
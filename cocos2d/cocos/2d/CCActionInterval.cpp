@@ -30,7 +30,9 @@ THE SOFTWARE.
 #include "CCNode.h"
 #include "CCStdC.h"
 #include "CCActionInstant.h"
+#include "CCTweenFunction.h"
 #include <stdarg.h>
+#include <typeinfo>
 
 NS_CC_BEGIN
 
@@ -1000,6 +1002,26 @@ void MoveBy::update(float t)
     }
 }
 
+bool MoveBy::describeTween(IntervalTween &tween) const
+{
+    //MoveTo only differs in startWithTarget
+    if (typeid(*this) != typeid(MoveBy) && typeid(*this) != typeid(MoveTo))
+    {
+        return false;
+    }
+
+    tween.property = IntervalTween::Property::POSITION;
+    tween.start[0] = _startPosition.x;
+    tween.start[1] = _startPosition.y;
+    tween.delta[0] = _positionDelta.x;
+    tween.delta[1] = _positionDelta.y;
+    tween.previous[0] = _previousPosition.x;
+    tween.previous[1] = _previousPosition.y;
+    tween.relative = CC_ENABLE_STACKABLE_ACTIONS != 0;
+    tween.easing = tweenfunc::Linear;
+    return true;
+}
+
 //
 // MoveTo
 //
@@ -1551,6 +1573,25 @@ void ScaleTo::update(float time)
     }
 }
 
+bool ScaleTo::describeTween(IntervalTween &tween) const
+{
+    //ScaleBy only differs in startWithTarget
+    if (typeid(*this) != typeid(ScaleTo) && typeid(*this) != typeid(ScaleBy))
+    {
+        return false;
+    }
+
+    tween.property = IntervalTween::Property::SCALE;
+    tween.start[0] = _startScaleX;
+    tween.start[1] = _startScaleY;
+    tween.delta[0] = _deltaX;
+    tween.delta[1] = _deltaY;
+    tween.previous[0] = tween.previous[1] = 0;
+    tween.relative = false;
+    tween.easing = tweenfunc::Linear;
+    return true;
+}
+
 //
 // ScaleBy
 //
@@ -1820,6 +1861,24 @@ void FadeTo::update(float time)
     /*_target->setOpacity((GLubyte)(_fromOpacity + (_toOpacity - _fromOpacity) * time));*/
 }
 
+bool FadeTo::describeTween(IntervalTween &tween) const
+{
+    //FadeIn and FadeOut only differ in startWithTarget
+    if (typeid(*this) != typeid(FadeTo) && typeid(*this) != typeid(FadeIn) && typeid(*this) != typeid(FadeOut))
+    {
+        return false;
+    }
+
+    tween.property = IntervalTween::Property::OPACITY;
+    tween.start[0] = _fromOpacity;
+    tween.delta[0] = (float)(_toOpacity - _fromOpacity);
+    tween.start[1] = tween.delta[1] = 0;
+    tween.previous[0] = tween.previous[1] = 0;
+    tween.relative = false;
+    tween.easing = tweenfunc::Linear;
+    return true;
+}
+
 //
 // TintTo
 //
@@ -43,6 +43,27 @@ NS_CC_BEGIN
  * @{
  */
 
+/** @brief A node property changing linearly over the eased time of an action: start + delta * time.
+ With relative set, what changed the property between two updates is added to start,
+ which lets several of them move a node concurrently.
+ */
+struct CC_DLL IntervalTween
+{
+    enum class Property
+    {
+        POSITION,
+        SCALE,
+        OPACITY,
+    };
+
+    Property property;
+    float start[2];
+    float delta[2];
+    float previous[2];  //! the value written by the last update, for relative tweens
+    bool relative;
+    int easing;         //! a tweenfunc::TweenType
+};
+
 /** 
 @brief An interval action is an action that takes place within a certain period of time.
 It has an start time, and a finish time. The finish time is the parameter
@@ -66,6 +87,11 @@ public:
     /** how many seconds had elapsed since the actions started to run. */
     inline float getElapsed(void) { return _elapsed; }
 
+    /** Describes the started action as a single IntervalTween, so the ActionManager can run it
+     along with the other tweens instead of stepping it. Actions that need their own update() return false.
+     */
+    virtual bool describeTween(IntervalTween &tween) const { return false; }
+
     //extension in GridAction
     void setAmplitudeRate(float amp);
     float getAmplitudeRate(void);
@@ -85,6 +111,8 @@ protected:
 
     float _elapsed;
     bool   _firstTick;
+
+    friend class ActionManager;
 };
 
 /** @brief Runs actions sequentially, one after another
@@ -373,6 +401,7 @@ public:
 	virtual MoveBy* reverse(void) const  override;
     virtual void startWithTarget(Node *target) override;
     virtual void update(float time) override;
+    virtual bool describeTween(IntervalTween &tween) const override;
 
 protected:
     MoveBy() {}
@@ -629,6 +658,7 @@ public:
 	virtual ScaleTo* reverse(void) const override;
     virtual void startWithTarget(Node *target) override;
     virtual void update(float time) override;
+    virtual bool describeTween(IntervalTween &tween) const override;
 
 protected:
     ScaleTo() {}
@@ -724,6 +754,7 @@ public:
 	virtual FadeTo* reverse(void) const override;
     virtual void startWithTarget(Node *target) override;
     virtual void update(float time) override;
+    virtual bool describeTween(IntervalTween &tween) const override;
 
 protected:
     FadeTo() {}
@@ -33,6 +33,9 @@ THE SOFTWARE.
 #include "ccCArray.h"
 #include "uthash.h"
 #include "CCSet.h"
+#include "CCTweenFunction.h"
+#include <float.h>
+#include <algorithm>
 
 NS_CC_BEGIN
 //
@@ -46,13 +49,15 @@ typedef struct _hashElement
     Action                    *currentAction;
     bool                        currentActionSalvaged;
     bool                        paused;
+    int                tweens;
     UT_hash_handle                hh;
 } tHashElement;
 
 ActionManager::ActionManager(void)
 : _targets(nullptr),
   _currentTarget(nullptr),
-  _currentTargetSalvaged(false)
+  _currentTargetSalvaged(false),
+  _freeTweens(0)
 {
 
 }
@@ -98,6 +103,7 @@ void ActionManager::removeActionAtIndex(ssize_t index, tHashElement *element)
         element->currentActionSalvaged = true;
     }
 
+    removeTween(action, element);
     ccArrayRemoveObjectAtIndex(element->actions, index, true);
 
     // update actionIndex in case we are in tick. looping over the actions
@@ -190,6 +196,74 @@ void ActionManager::addAction(Action *action, Node *target, bool paused)
      ccArrayAppendObject(element->actions, action);
  
      action->startWithTarget(target);
+     addTween(action, element);
+}
+
+void ActionManager::addTween(Action *action, tHashElement *element)
+{
+    auto interval = dynamic_cast<ActionInterval*>(action);
+    IntervalTween tween;
+    if (interval == nullptr || ! interval->describeTween(tween))
+    {
+        return;
+    }
+
+    action->_tweenIndex = _tweenActions.size();
+    _tweenActions.push_back(interval);
+    _tweenElements.push_back(element);
+    _tweens.push_back(tween);
+    _tweenElapsed.push_back(interval->_elapsed);
+    _tweenDuration.push_back(interval->getDuration());
+    _tweenFirstTick.push_back(interval->_firstTick);
+    _tweenTimes.push_back(0);
+    element->tweens++;
+}
+
+void ActionManager::removeTween(Action *action, tHashElement *element)
+{
+    if (action == nullptr || action->_tweenIndex < 0)
+    {
+        return;
+    }
+
+    _tweenActions[action->_tweenIndex] = nullptr;
+    _tweenElements[action->_tweenIndex] = nullptr;
+    action->_tweenIndex = -1;
+    element->tweens--;
+    _freeTweens++;
+}
+
+void ActionManager::compactTweens()
+{
+    size_t live = 0;
+    for (size_t i = 0; i < _tweenActions.size(); ++i)
+    {
+        if (_tweenActions[i] == nullptr)
+        {
+            continue;
+        }
+
+        if (i != live)
+        {
+            _tweenActions[live] = _tweenActions[i];
+            _tweenElements[live] = _tweenElements[i];
+            _tweens[live] = _tweens[i];
+            _tweenElapsed[live] = _tweenElapsed[i];
+            _tweenDuration[live] = _tweenDuration[i];
+            _tweenFirstTick[live] = _tweenFirstTick[i];
+            _tweenActions[live]->_tweenIndex = live;
+        }
+        live++;
+    }
+
+    _tweenActions.resize(live);
+    _tweenElements.resize(live);
+    _tweens.resize(live);
+    _tweenElapsed.resize(live);
+    _tweenDuration.resize(live);
+    _tweenFirstTick.resize(live);
+    _tweenTimes.resize(live);
+    _freeTweens = 0;
 }
 
 // remove
@@ -222,6 +296,10 @@ void ActionManager::removeAllActionsFromTarget(Node *target)
             element->currentActionSalvaged = true;
         }
 
+        for (ssize_t i = 0; i < element->actions->num; ++i)
+        {
+            removeTween((Action*)element->actions->arr[i], element);
+        }
         ccArrayRemoveAllObjects(element->actions);
         if (_currentTarget == element)
         {
@@ -345,17 +423,19 @@ void ActionManager::update(float dt)
         _currentTarget = elt;
         _currentTargetSalvaged = false;
 
-        if (! _currentTarget->paused)
+        if (! _currentTarget->paused && _currentTarget->tweens < _currentTarget->actions->num)
         {
             // The 'actions' MutableArray may change while inside this loop.
             for (_currentTarget->actionIndex = 0; _currentTarget->actionIndex < _currentTarget->actions->num;
                 _currentTarget->actionIndex++)
             {
-                _currentTarget->currentAction = (Action*)_currentTarget->actions->arr[_currentTarget->actionIndex];
-                if (_currentTarget->currentAction == nullptr)
+                Action *current = (Action*)_currentTarget->actions->arr[_currentTarget->actionIndex];
+                // tweens are run by updateTweens()
+                if (current == nullptr || current->_tweenIndex >= 0)
                 {
                     continue;
                 }
+                _currentTarget->currentAction = current;
 
                 _currentTarget->currentActionSalvaged = false;
 
@@ -395,6 +475,114 @@ void ActionManager::update(float dt)
 
     // issue #635
     _currentTarget = nullptr;
+
+    updateTweens(dt);
+}
+
+void ActionManager::updateTweens(float dt)
+{
+    if (_freeTweens > 0)
+    {
+        compactTweens();
+    }
+
+    // actions added from a node setter below start next frame
+    const size_t count = _tweenActions.size();
+
+    // advance, as ActionInterval::step() does
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (_tweenElements[i]->paused)
+        {
+            continue;
+        }
+
+        if (_tweenFirstTick[i])
+        {
+            _tweenFirstTick[i] = false;
+            _tweenElapsed[i] = 0;
+        }
+        else
+        {
+            _tweenElapsed[i] += dt;
+        }
+        // elapsed could be negative for rewinds, duration could be 0
+        _tweenTimes[i] = std::max(0.0f, std::min(1.0f, _tweenElapsed[i] / std::max(_tweenDuration[i], FLT_EPSILON)));
+    }
+
+    // ease
+    for (size_t i = 0; i < count; ++i)
+    {
+        const int easing = _tweens[i].easing;
+        if (easing != tweenfunc::Linear && ! _tweenElements[i]->paused)
+        {
+            _tweenTimes[i] = tweenfunc::tweenTo(_tweenTimes[i], (tweenfunc::TweenType)easing, nullptr);
+        }
+    }
+
+    // apply. Setters may add or remove actions, so nothing in the arrays is referenced across them
+    for (size_t i = 0; i < count; ++i)
+    {
+        ActionInterval *action = _tweenActions[i];
+        if (action == nullptr || _tweenElements[i]->paused)
+        {
+            continue;
+        }
+
+        Node *target = _tweenElements[i]->target;
+        const float time = _tweenTimes[i];
+        const IntervalTween tween = _tweens[i];
+        action->_elapsed = _tweenElapsed[i];
+        action->_firstTick = false;
+
+        switch (tween.property)
+        {
+            case IntervalTween::Property::POSITION:
+            {
+                float x = tween.start[0];
+                float y = tween.start[1];
+                if (tween.relative)
+                {
+                    // keep what moved the node since the last update
+                    const Point& current = target->getPosition();
+                    x += current.x - tween.previous[0];
+                    y += current.y - tween.previous[1];
+                    _tweens[i].start[0] = x;
+                    _tweens[i].start[1] = y;
+                }
+                const Point position(x + tween.delta[0] * time, y + tween.delta[1] * time);
+                _tweens[i].previous[0] = position.x;
+                _tweens[i].previous[1] = position.y;
+                target->setPosition(position);
+                break;
+            }
+            case IntervalTween::Property::SCALE:
+                target->setScaleX(tween.start[0] + tween.delta[0] * time);
+                target->setScaleY(tween.start[1] + tween.delta[1] * time);
+                break;
+            case IntervalTween::Property::OPACITY:
+                target->setOpacity((GLubyte)(tween.start[0] + tween.delta[0] * time));
+                break;
+        }
+
+        if (_tweenActions[i] == action && _tweenElapsed[i] >= _tweenDuration[i])
+        {
+            action->retain();
+            _finishedTweens.push_back(action);
+        }
+    }
+
+    // finish, as update() does for the other actions
+    for (auto action : _finishedTweens)
+    {
+        if (action->_tweenIndex >= 0)
+        {
+            action->stop();
+            removeAction(action);
+        }
+        action->release();
+    }
+    _finishedTweens.clear();
 }
 
 NS_CC_END
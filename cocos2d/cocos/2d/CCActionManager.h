@@ -30,8 +30,10 @@ THE SOFTWARE.
 #define __ACTION_CCACTION_MANAGER_H__
 
 #include "CCAction.h"
+#include "CCActionInterval.h"
 #include "CCVector.h"
 #include "CCRef.h"
+#include <vector>
 
 NS_CC_BEGIN
 
@@ -51,6 +53,11 @@ struct _hashElement;
     - When you want to run an action where the target is different from a Node. 
     - When you want to pause / resume the actions
  
+ Interval actions which can describe themselves as an IntervalTween (MoveBy, MoveTo, ScaleTo, ScaleBy,
+ FadeTo, FadeIn, FadeOut and their Sine, Exponential, Back and Bounce eases) are not stepped one by one:
+ they are kept in flat arrays and advanced, eased and applied together after the other actions.
+ The classes are matched exactly, so subclasses of these actions, which may override update(), are stepped as usual.
+
  @since v0.8
  */
 class CC_DLL ActionManager : public Ref
@@ -131,10 +138,29 @@ protected:
     void deleteHashElement(struct _hashElement *element);
     void actionAllocWithHashElement(struct _hashElement *element);
 
+    /** runs the started action as a tween when it can be described as one */
+    void addTween(Action *action, struct _hashElement *element);
+    /** frees the tween slot of the action, if any. The slot is reused after the next compaction */
+    void removeTween(Action *action, struct _hashElement *element);
+    void compactTweens();
+    void updateTweens(float dt);
+
 protected:
     struct _hashElement    *_targets;
     struct _hashElement    *_currentTarget;
     bool            _currentTargetSalvaged;
+
+    //tweens, one slot per running tween action. A removed action leaves a null slot until compaction
+    std::vector<ActionInterval*> _tweenActions;
+    std::vector<struct _hashElement*> _tweenElements;
+    std::vector<IntervalTween> _tweens;
+    std::vector<float> _tweenElapsed;
+    std::vector<float> _tweenDuration;
+    std::vector<bool> _tweenFirstTick;
+    //eased time of the current update, per slot
+    std::vector<float> _tweenTimes;
+    ssize_t _freeTweens;
+    std::vector<Action*> _finishedTweens;
 };
 
 // end of actions group
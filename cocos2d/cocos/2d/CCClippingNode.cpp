@@ -35,6 +35,7 @@
 #include "renderer/CCRenderer.h"
 #include "renderer/CCGroupCommand.h"
 #include "renderer/CCCustomCommand.h"
+#include "platform/CCGLHeadless.h"
 
 NS_CC_BEGIN
 
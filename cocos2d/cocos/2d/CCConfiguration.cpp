@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include "CCInteger.h"
 #include "CCBool.h"
 #include "platform/CCFileUtils.h"
+#include "platform/CCGLHeadless.h"
 
 using namespace std;
 
@@ -52,6 +53,7 @@ Configuration::Configuration()
 , _supportsBGRA8888(false)
 , _supportsDiscardFramebuffer(false)
 , _supportsShareableVAO(false)
+, _supportsMapBufferRange(false)
 , _maxSamplesAllowed(0)
 , _maxTextureUnits(0)
 , _glExtensions(nullptr)
@@ -106,6 +108,34 @@ std::string Configuration::getInfo() const
 
 void Configuration::gatherGPUInfo()
 {
+    // no current GL context, eg: a headless GLView. Assume a common desktop GPU
+    if (glGetString(GL_VERSION) == nullptr)
+    {
+        _valueDict["gl.vendor"] = Value("none");
+        _valueDict["gl.renderer"] = Value("none");
+        _valueDict["gl.version"] = Value("none");
+
+        _glExtensions = nullptr;
+        _maxTextureSize = 4096;
+        _valueDict["gl.max_texture_size"] = Value((int)_maxTextureSize);
+        _maxTextureUnits = 8;
+        _valueDict["gl.max_texture_units"] = Value((int)_maxTextureUnits);
+
+        _supportsETC1 = _supportsS3TC = _supportsATITC = _supportsPVRTC = false;
+        _supportsNPOT = true;
+        _supportsBGRA8888 = _supportsDiscardFramebuffer = _supportsShareableVAO = _supportsMapBufferRange = false;
+        _valueDict["gl.supports_ETC1"] = Value(_supportsETC1);
+        _valueDict["gl.supports_S3TC"] = Value(_supportsS3TC);
+        _valueDict["gl.supports_ATITC"] = Value(_supportsATITC);
+        _valueDict["gl.supports_PVRTC"] = Value(_supportsPVRTC);
+        _valueDict["gl.supports_NPOT"] = Value(_supportsNPOT);
+        _valueDict["gl.supports_BGRA8888"] = Value(_supportsBGRA8888);
+        _valueDict["gl.supports_discard_framebuffer"] = Value(_supportsDiscardFramebuffer);
+        _valueDict["gl.supports_vertex_array_object"] = Value(_supportsShareableVAO);
+        _valueDict["gl.supports_map_buffer_range"] = Value(_supportsMapBufferRange);
+        return;
+    }
+
 	_valueDict["gl.vendor"] = Value((const char*)glGetString(GL_VENDOR));
 	_valueDict["gl.renderer"] = Value((const char*)glGetString(GL_RENDERER));
 	_valueDict["gl.version"] = Value((const char*)glGetString(GL_VERSION));
@@ -147,6 +177,9 @@ void Configuration::gatherGPUInfo()
     _supportsShareableVAO = checkForGLExtension("vertex_array_object");
 	_valueDict["gl.supports_vertex_array_object"] = Value(_supportsShareableVAO);
 
+    _supportsMapBufferRange = checkForGLExtension("GL_ARB_map_buffer_range") && checkForGLExtension("GL_ARB_sync");
+    _valueDict["gl.supports_map_buffer_range"] = Value(_supportsMapBufferRange);
+
     CHECK_GL_ERROR_DEBUG();
 }
 
@@ -252,6 +285,15 @@ bool Configuration::supportsShareableVAO() const
 #endif
 }
 
+bool Configuration::supportsMapBufferRange() const
+{
+#if CC_RENDERER_USE_MAP_BUFFER_RANGE
+    return _supportsMapBufferRange;
+#else
+    return false;
+#endif
+}
+
 //
 // generic getters for properties
 //
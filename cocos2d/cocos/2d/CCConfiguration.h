@@ -111,6 +111,11 @@ public:
      */
 	bool supportsShareableVAO() const;
 
+    /** Whether or not glMapBufferRange and sync objects can be used to stream vertices
+     @since v3.0
+     */
+    bool supportsMapBufferRange() const;
+
     /** returns whether or not an OpenGL is supported */
     bool checkForGLExtension(const std::string &searchName) const;
 
@@ -147,6 +152,7 @@ protected:
     bool            _supportsBGRA8888;
     bool            _supportsDiscardFramebuffer;
     bool            _supportsShareableVAO;
+    bool            _supportsMapBufferRange;
     GLint           _maxSamplesAllowed;
     GLint           _maxTextureUnits;
     char *          _glExtensions;
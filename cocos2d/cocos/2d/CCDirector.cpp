@@ -61,6 +61,7 @@ THE SOFTWARE.
 #include "renderer/CCRenderer.h"
 #include "renderer/CCFrustum.h"
 #include "CCConsole.h"
+#include "CCJobPool.h"
 
 #include "kazmath/kazmath.h"
 #include "kazmath/GL/matrix.h"
@@ -123,6 +124,7 @@ bool Director::init(void)
     _FPSLabel = _drawnBatchesLabel = _drawnVerticesLabel = nullptr;
     _totalFrames = _frames = 0;
     _lastUpdate = new struct timeval;
+    _fixedDeltaTime = 0.0f;
 
     // paused ?
     _paused = false;
@@ -156,6 +158,7 @@ bool Director::init(void)
     //init TextureCache
     initTextureCache();
 
+    _jobPool = new JobPool;
     _renderer = new Renderer;
     _console = new Console;
 
@@ -183,6 +186,7 @@ Director::~Director(void)
 
     delete _renderer;
     delete _console;
+    delete _jobPool;
 
     // clean auto release pool
     PoolManager::destroyInstance();
@@ -281,7 +285,6 @@ void Director::drawScene()
     if (_runningScene)
     {
         _runningScene->visit(_renderer, identity, false);
-        _eventDispatcher->dispatchEvent(_eventAfterVisit);
     }
 
     // draw the notifications node
@@ -295,6 +298,9 @@ void Director::drawScene()
         showStats();
     }
 
+    // every node has been visited, nothing else gets queued before rendering
+    _eventDispatcher->dispatchEvent(_eventAfterVisit);
+
     _renderer->render();
     _eventDispatcher->dispatchEvent(_eventAfterDraw);
 
@@ -345,6 +351,11 @@ void Director::calculateDeltaTime()
     }
 #endif
 
+    if (_fixedDeltaTime > 0)
+    {
+        _deltaTime = _fixedDeltaTime;
+    }
+
     *_lastUpdate = now;
 }
 float Director::getDeltaTime() const
@@ -377,6 +388,8 @@ void Director::setOpenGLView(GLView *openGLView)
             setGLDefaultValues();
         }
 
+        // a headless view has no GL context, the renderer must not touch GL
+        _renderer->setHeadless(_openGLView->isHeadless());
         _renderer->initGLView();
 
         CHECK_GL_ERROR_DEBUG();
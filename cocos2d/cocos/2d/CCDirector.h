@@ -60,6 +60,7 @@ class EventListenerCustom;
 class TextureCache;
 class Renderer;
 class Console;
+class JobPool;
 
 /**
 @brief Class that creates and handles the main Window and manages how
@@ -370,8 +371,20 @@ public:
      */
     Console* getConsole() const { return _console; }
 
+    /** Returns the JobPool used to spread data-parallel work across the cores
+     @since v3.0
+     */
+    JobPool* getJobPool() const { return _jobPool; }
+
     /* Gets delta time since last tick to main loop */
 	float getDeltaTime() const;
+
+    /** Makes every tick of the main loop advance the game by `delta` seconds, whatever the time that really passed.
+     Together with a fixed physics time step, it makes the simulation reproducible. 0 goes back to the real time.
+     @since v3.0
+     */
+    void setFixedDeltaTime(float delta) { _fixedDeltaTime = delta; }
+    float getFixedDeltaTime() const { return _fixedDeltaTime; }
     
     /**
      *  get Frame Rate
@@ -414,6 +427,9 @@ protected:
         
     /* delta time since last tick to main loop */
 	float _deltaTime;
+
+    /* delta time used by every tick when it is greater than 0 */
+    float _fixedDeltaTime;
     
     /* The GLView, where everything is rendered */
     GLView *_openGLView;
@@ -479,6 +495,9 @@ protected:
 
     /* Console for the director */
     Console *_console;
+
+    /* Worker threads shared by the renderer and the other subsystems */
+    JobPool *_jobPool;
     
     // GLViewProtocol will recreate stats labels to fit visible rect
     friend class GLViewProtocol;
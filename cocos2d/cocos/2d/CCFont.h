@@ -42,6 +42,10 @@ public:
     virtual  FontAtlas *createFontAtlas() = 0;
 
     virtual int* getHorizontalKerningForTextUTF16(unsigned short *text, int &outNumLetters) const = 0;
+    /** Writes the kernings of the letters [begin, end) of the text at the same indices of outKernings, without allocating.
+     * The kerning of a letter depends on the letters around it, so the whole text is given.
+     */
+    virtual void computeHorizontalKerningForTextUTF16(const unsigned short *text, int numLetters, int begin, int end, int *outKernings) const = 0;
     virtual const char* getCurrentGlyphCollection() const;
     
     virtual unsigned char * getGlyphBitmap(unsigned short theChar, int &outWidth, int &outHeight) const { return 0; }
@@ -31,18 +31,26 @@
 #include "CCEventDispatcher.h"
 #include "CCEventType.h"
 
+#include <algorithm>
+
 NS_CC_BEGIN
 
 const int FontAtlas::CacheTextureWidth = 1024;
 const int FontAtlas::CacheTextureHeight = 1024;
+const int FontAtlas::CacheTextureMaxCount = 4;
 const char* FontAtlas::EVENT_PURGE_TEXTURES = "__cc_FontAtlasPurgeTextures";
 
 FontAtlas::FontAtlas(Font &theFont) 
 : _font(&theFont)
 , _currentPageData(nullptr)
+, _dirtyTop(CacheTextureHeight)
+, _dirtyBottom(0)
+, _maxTextureCount(CacheTextureMaxCount)
+, _pendingPurge(false)
 , _fontAscender(0)
 , _toForegroundListener(nullptr)
 , _toBackgroundListener(nullptr)
+, _afterVisitListener(nullptr)
 {
     _font->retain();
 
@@ -51,10 +59,7 @@ FontAtlas::FontAtlas(Font &theFont)
     {
         _commonLineHeight = _font->getFontMaxHeight();
         _fontAscender = fontTTf->getFontAscender();
-        auto texture = new Texture2D;
         _currentPage = 0;
-        _currentPageOrigX = 0;
-        _currentPageOrigY = 0;
         _letterPadding = 0;
 
         if(fontTTf->isDistanceFieldEnabled())
@@ -68,11 +73,13 @@ FontAtlas::FontAtlas(Font &theFont)
         }    
 
         _currentPageData = new unsigned char[_currentPageDataSize];
-        memset(_currentPageData, 0, _currentPageDataSize);  
-        addTexture(texture,0);
-        texture->release();
-#if CC_ENABLE_CACHE_TEXTURE_DATA
+        openPage(0);
+
         auto eventDispatcher = Director::getInstance()->getEventDispatcher();
+        //New glyphs are uploaded once per frame, after all the labels have been visited
+        _afterVisitListener = EventListenerCustom::create(Director::EVENT_AFTER_VISIT, CC_CALLBACK_1(FontAtlas::listenToAfterVisit, this));
+        eventDispatcher->addEventListenerWithFixedPriority(_afterVisitListener, 1);
+#if CC_ENABLE_CACHE_TEXTURE_DATA
         _toBackgroundListener = EventListenerCustom::create(EVENT_COME_TO_BACKGROUND, CC_CALLBACK_1(FontAtlas::listenToBackground, this));
         eventDispatcher->addEventListenerWithFixedPriority(_toBackgroundListener, 1);
         _toForegroundListener = EventListenerCustom::create(EVENT_COME_TO_FOREGROUND, CC_CALLBACK_1(FontAtlas::listenToForeground, this));
@@ -83,6 +90,11 @@ FontAtlas::FontAtlas(Font &theFont)
 
 FontAtlas::~FontAtlas()
 {
+    if (_afterVisitListener)
+    {
+        Director::getInstance()->getEventDispatcher()->removeEventListener(_afterVisitListener);
+        _afterVisitListener = nullptr;
+    }
 #if CC_ENABLE_CACHE_TEXTURE_DATA
     FontFreeType* fontTTf = dynamic_cast<FontFreeType*>(_font);
     if (fontTTf)
@@ -131,12 +143,10 @@ void FontAtlas::purgeTexturesAtlas()
         auto temp = _atlasTextures[0];
         _atlasTextures.clear();
         _atlasTextures[0] = temp;
+        _texturesLastUsed.resize(1);
 
         _fontLetterDefinitions.clear();
-        memset(_currentPageData,0,_currentPageDataSize);
-        _currentPage = 0;
-        _currentPageOrigX = 0;
-        _currentPageOrigY = 0;
+        openPage(0);
 
         auto eventDispatcher = Director::getInstance()->getEventDispatcher();
         eventDispatcher->dispatchCustomEvent(EVENT_PURGE_TEXTURES,this);
@@ -159,12 +169,16 @@ void FontAtlas::listenToBackground(EventCustom *event)
         auto temp = _atlasTextures[0];
         _atlasTextures.clear();
         _atlasTextures[0] = temp;
+        _texturesLastUsed.resize(1);
 
         _fontLetterDefinitions.clear();
         memset(_currentPageData,0,_currentPageDataSize);
         _currentPage = 0;
-        _currentPageOrigX = 0;
-        _currentPageOrigY = 0;
+        _skyline.clear();
+        SkylineLevel level = { 0, 0, CacheTextureWidth };
+        _skyline.push_back(level);
+        _dirtyTop = CacheTextureHeight;
+        _dirtyBottom = 0;
     }
 #endif
 }
@@ -175,7 +189,7 @@ void FontAtlas::listenToForeground(EventCustom *event)
     FontFreeType* fontTTf = dynamic_cast<FontFreeType*>(_font);
     if (fontTTf)
     {
-        if (_currentPageOrigX == 0 && _currentPageOrigY == 0)
+        if (_skyline.size() == 1 && _skyline[0].y == 0)
         {
             auto eventDispatcher = Director::getInstance()->getEventDispatcher();
             eventDispatcher->dispatchCustomEvent(EVENT_PURGE_TEXTURES,this);
@@ -186,11 +200,25 @@ void FontAtlas::listenToForeground(EventCustom *event)
             auto  pixelFormat = fontTTf->getOutlineSize() > 0 ? Texture2D::PixelFormat::AI88 : Texture2D::PixelFormat::A8;
 
             _atlasTextures[_currentPage]->initWithData(_currentPageData, _currentPageDataSize, pixelFormat, CacheTextureWidth, CacheTextureHeight, contentSize );
+            _dirtyTop = CacheTextureHeight;
+            _dirtyBottom = 0;
         }
     }
 #endif
 }
 
+void FontAtlas::listenToAfterVisit(EventCustom *event)
+{
+    //Labels showing glyphs of a reused texture lay their letters out again, which may add glyphs too
+    while (_pendingPurge)
+    {
+        _pendingPurge = false;
+        Director::getInstance()->getEventDispatcher()->dispatchCustomEvent(EVENT_PURGE_TEXTURES,this);
+    }
+
+    updateTexture();
+}
+
 void FontAtlas::addLetterDefinition(const FontLetterDefinition &letterDefinition)
 {
     _fontLetterDefinitions[letterDefinition.letteCharUTF16] = letterDefinition;
@@ -212,6 +240,174 @@ bool FontAtlas::getLetterDefinitionForChar(unsigned short  letteCharUTF16, FontL
     }
 }
 
+int FontAtlas::findPosition(int width, int height, int &outX, int &outY) const
+{
+    int bestIndex = -1;
+    int bestY = CacheTextureHeight;
+    int bestWidth = CacheTextureWidth + 1;
+
+    int count = static_cast<int>(_skyline.size());
+    for (int i = 0; i < count; ++i)
+    {
+        int x = _skyline[i].x;
+        if (x + width > CacheTextureWidth)
+        {
+            break;
+        }
+
+        //the glyph rests on the highest level it spans
+        int y = 0;
+        int remaining = width;
+        for (int j = i; remaining > 0; ++j)
+        {
+            y = std::max(y, _skyline[j].y);
+            remaining -= _skyline[j].width;
+        }
+
+        if (y + height > CacheTextureHeight)
+        {
+            continue;
+        }
+
+        //lowest first, then the tightest level to keep the skyline flat
+        if (y < bestY || (y == bestY && _skyline[i].width < bestWidth))
+        {
+            bestIndex = i;
+            bestY = y;
+            bestWidth = _skyline[i].width;
+            outX = x;
+            outY = y;
+        }
+    }
+
+    return bestIndex;
+}
+
+void FontAtlas::addSkylineLevel(int index, int x, int y, int width, int height)
+{
+    SkylineLevel level = { x, y + height, width };
+    _skyline.insert(_skyline.begin() + index, level);
+
+    //shrink or remove the levels now covered by the new one
+    int right = x + width;
+    for (int i = index + 1; i < static_cast<int>(_skyline.size()); )
+    {
+        int covered = right - _skyline[i].x;
+        if (covered <= 0)
+        {
+            break;
+        }
+
+        _skyline[i].x += covered;
+        _skyline[i].width -= covered;
+        if (_skyline[i].width > 0)
+        {
+            break;
+        }
+        _skyline.erase(_skyline.begin() + i);
+    }
+
+    //merge the neighbours at the same height
+    for (int i = 0; i + 1 < static_cast<int>(_skyline.size()); )
+    {
+        if (_skyline[i].y == _skyline[i + 1].y)
+        {
+            _skyline[i].width += _skyline[i + 1].width;
+            _skyline.erase(_skyline.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+void FontAtlas::openPage(int page)
+{
+    FontFreeType* fontTTf = static_cast<FontFreeType*>(_font);
+    auto  pixelFormat = fontTTf->getOutlineSize() > 0 ? Texture2D::PixelFormat::AI88 : Texture2D::PixelFormat::A8;
+
+    memset(_currentPageData, 0, _currentPageDataSize);
+    _currentPage = page;
+
+    _skyline.clear();
+    SkylineLevel level = { 0, 0, CacheTextureWidth };
+    _skyline.push_back(level);
+
+    _dirtyTop = CacheTextureHeight;
+    _dirtyBottom = 0;
+
+    unsigned int frame = Director::getInstance()->getTotalFrames();
+    if (page >= static_cast<int>(_texturesLastUsed.size()))
+    {
+        auto texture = new Texture2D;
+        texture->initWithData(_currentPageData, _currentPageDataSize, pixelFormat, CacheTextureWidth, CacheTextureHeight, Size(CacheTextureWidth,CacheTextureHeight) );
+        addTexture(texture, page);
+        texture->release();
+        _texturesLastUsed.push_back(frame);
+    }
+    else
+    {
+        //clear the glyphs left by the previous use of the texture
+        _atlasTextures[page]->updateWithData(_currentPageData, 0, 0, CacheTextureWidth, CacheTextureHeight);
+        _texturesLastUsed[page] = frame;
+    }
+}
+
+void FontAtlas::switchPage(unsigned int frame)
+{
+    //the page data is about to be cleared
+    updateTexture();
+
+    int page = static_cast<int>(_texturesLastUsed.size());
+    if (page >= _maxTextureCount)
+    {
+        int oldest = -1;
+        for (int i = 0; i < page; ++i)
+        {
+            if (i != _currentPage && _texturesLastUsed[i] != frame && (oldest < 0 || _texturesLastUsed[i] < _texturesLastUsed[oldest]))
+            {
+                oldest = i;
+            }
+        }
+
+        if (oldest >= 0)
+        {
+            page = oldest;
+
+            for (auto it = _fontLetterDefinitions.begin(); it != _fontLetterDefinitions.end(); )
+            {
+                if (it->second.textureID == page && it->second.width > 0)
+                {
+                    it = _fontLetterDefinitions.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+            _pendingPurge = true;
+        }
+    }
+
+    openPage(page);
+}
+
+void FontAtlas::updateTexture()
+{
+    if (_dirtyTop >= _dirtyBottom)
+    {
+        return;
+    }
+
+    //whole rows, so the uploaded data is contiguous in the page
+    int bytesPerRow = _currentPageDataSize / CacheTextureHeight;
+    _atlasTextures[_currentPage]->updateWithData(_currentPageData + _dirtyTop * bytesPerRow, 0, _dirtyTop, CacheTextureWidth, _dirtyBottom - _dirtyTop);
+
+    _dirtyTop = CacheTextureHeight;
+    _dirtyBottom = 0;
+}
+
 bool FontAtlas::prepareLetterDefinitions(unsigned short *utf16String)
 {
     FontFreeType* fontTTf = dynamic_cast<FontFreeType*>(_font);
@@ -226,81 +422,91 @@ bool FontAtlas::prepareLetterDefinitions(unsigned short *utf16String)
     Rect tempRect;
     FontLetterDefinition tempDef;
 
-    auto contentSize = Size(CacheTextureWidth,CacheTextureHeight);
     auto scaleFactor = CC_CONTENT_SCALE_FACTOR();
-    auto  pixelFormat = fontTTf->getOutlineSize() > 0 ? Texture2D::PixelFormat::AI88 : Texture2D::PixelFormat::A8; 
+    unsigned int frame = Director::getInstance()->getTotalFrames();
 
-    bool existNewLetter = false;
     for (int i = 0; i < length; ++i)
     {
         auto outIterator = _fontLetterDefinitions.find(utf16String[i]);
 
-        if (outIterator == _fontLetterDefinitions.end())
-        {  
-            existNewLetter = true;
+        if (outIterator != _fontLetterDefinitions.end())
+        {
+            if (outIterator->second.width > 0)
+            {
+                _texturesLastUsed[outIterator->second.textureID] = frame;
+            }
+            continue;
+        }
+
+        auto bitmap = fontTTf->getGlyphBitmap(utf16String[i],bitmapWidth,bitmapHeight,tempRect,tempDef.xAdvance);
+        int posX = 0;
+        int posY = 0;
+        int level = -1;
+        if (bitmap)
+        {
+            tempDef.width            = tempRect.size.width + _letterPadding;
+            tempDef.height           = tempRect.size.height + _letterPadding;
+
+            //one pixel between the glyphs, so they don't bleed into each other
+            int glyphWidth = static_cast<int>(ceilf(tempDef.width)) + 1;
+            int glyphHeight = static_cast<int>(ceilf(tempDef.height)) + 1;
 
-            auto bitmap = fontTTf->getGlyphBitmap(utf16String[i],bitmapWidth,bitmapHeight,tempRect,tempDef.xAdvance);
-            if (bitmap)
+            level = findPosition(glyphWidth, glyphHeight, posX, posY);
+            if (level < 0)
             {
-                tempDef.validDefinition = true;
-                tempDef.letteCharUTF16   = utf16String[i];
-                tempDef.width            = tempRect.size.width + _letterPadding;
-                tempDef.height           = tempRect.size.height + _letterPadding;
-                tempDef.offsetX          = tempRect.origin.x + offsetAdjust;
-                tempDef.offsetY          = _fontAscender + tempRect.origin.y - offsetAdjust;
+                switchPage(frame);
+                level = findPosition(glyphWidth, glyphHeight, posX, posY);
+            }
 
-                if (_currentPageOrigX + tempDef.width > CacheTextureWidth)
-                {
-                    _currentPageOrigY += _commonLineHeight;
-                    _currentPageOrigX = 0;
-                    if(_currentPageOrigY + _commonLineHeight >= CacheTextureHeight)
-                    {             
-                        _atlasTextures[_currentPage]->initWithData(_currentPageData, _currentPageDataSize, pixelFormat, CacheTextureWidth, CacheTextureHeight, contentSize );
-                        _currentPageOrigY = 0;
-                        memset(_currentPageData, 0, _currentPageDataSize);
-                        _currentPage++;
-                        auto tex = new Texture2D;
-                        addTexture(tex,_currentPage);
-                        tex->release();
-                    }  
-                }
-                fontTTf->renderCharAt(_currentPageData,_currentPageOrigX,_currentPageOrigY,bitmap,bitmapWidth,bitmapHeight);
-
-                tempDef.U                = _currentPageOrigX;
-                tempDef.V                = _currentPageOrigY;
-                tempDef.textureID        = _currentPage;
-                _currentPageOrigX        += tempDef.width + 1;
-                // take from pixels to points
-                tempDef.width  =    tempDef.width  / scaleFactor;
-                tempDef.height =    tempDef.height / scaleFactor;      
-                tempDef.U      =    tempDef.U      / scaleFactor;
-                tempDef.V      =    tempDef.V      / scaleFactor;
+            if (level >= 0)
+            {
+                addSkylineLevel(level, posX, posY, glyphWidth, glyphHeight);
+                _dirtyTop = std::min(_dirtyTop, posY);
+                _dirtyBottom = std::min(std::max(_dirtyBottom, posY + glyphHeight), CacheTextureHeight);
             }
-            else{
-                if(tempDef.xAdvance)
-                    tempDef.validDefinition = true;
-                else
-                    tempDef.validDefinition = false;
-
-                tempDef.letteCharUTF16   = utf16String[i];
-                tempDef.width            = 0;
-                tempDef.height           = 0;
-                tempDef.U                = 0;
-                tempDef.V                = 0;
-                tempDef.offsetX          = 0;
-                tempDef.offsetY          = 0;
-                tempDef.textureID        = 0;
-                _currentPageOrigX += 1;
+            else
+            {
+                CCLOG("cocos2d: FontAtlas: the glyph %d doesn't fit in a texture", utf16String[i]);
             }
+        }
 
-            _fontLetterDefinitions[tempDef.letteCharUTF16] = tempDef;
-        }       
-    }
+        if (level >= 0)
+        {
+            fontTTf->renderCharAt(_currentPageData,posX,posY,bitmap,bitmapWidth,bitmapHeight);
+
+            tempDef.validDefinition = true;
+            tempDef.letteCharUTF16   = utf16String[i];
+            tempDef.offsetX          = tempRect.origin.x + offsetAdjust;
+            tempDef.offsetY          = _fontAscender + tempRect.origin.y - offsetAdjust;
+            tempDef.U                = posX;
+            tempDef.V                = posY;
+            tempDef.textureID        = _currentPage;
+            _texturesLastUsed[_currentPage] = frame;
+            // take from pixels to points
+            tempDef.width  =    tempDef.width  / scaleFactor;
+            tempDef.height =    tempDef.height / scaleFactor;      
+            tempDef.U      =    tempDef.U      / scaleFactor;
+            tempDef.V      =    tempDef.V      / scaleFactor;
+        }
+        else{
+            if(tempDef.xAdvance)
+                tempDef.validDefinition = true;
+            else
+                tempDef.validDefinition = false;
+
+            tempDef.letteCharUTF16   = utf16String[i];
+            tempDef.width            = 0;
+            tempDef.height           = 0;
+            tempDef.U                = 0;
+            tempDef.V                = 0;
+            tempDef.offsetX          = 0;
+            tempDef.offsetY          = 0;
+            tempDef.textureID        = 0;
+        }
 
-    if(existNewLetter)
-    {
-        _atlasTextures[_currentPage]->initWithData(_currentPageData, _currentPageDataSize, pixelFormat, CacheTextureWidth, CacheTextureHeight, contentSize );
+        _fontLetterDefinitions[tempDef.letteCharUTF16] = tempDef;
     }
+
     return true;
 }
 
@@ -330,4 +536,23 @@ const Font * FontAtlas::getFont() const
     return _font;
 }
 
+void FontAtlas::setMaxTextureCount(int count)
+{
+    CCASSERT(count > 0, "the font atlas needs at least one texture");
+    _maxTextureCount = count;
+}
+
+int FontAtlas::getMaxTextureCount() const
+{
+    return _maxTextureCount;
+}
+
+void FontAtlas::markTextureUsed(int slot)
+{
+    if (slot >= 0 && slot < static_cast<int>(_texturesLastUsed.size()))
+    {
+        _texturesLastUsed[slot] = Director::getInstance()->getTotalFrames();
+    }
+}
+
 NS_CC_END
@@ -26,6 +26,7 @@
 #define _CCFontAtlas_h_
 
 #include <unordered_map>
+#include <vector>
 #include "CCPlatformMacros.h"
 #include "CCRef.h"
 
@@ -56,6 +57,7 @@ class CC_DLL FontAtlas : public Ref
 public:
     static const int CacheTextureWidth;
     static const int CacheTextureHeight;
+    static const int CacheTextureMaxCount;
     static const char* EVENT_PURGE_TEXTURES;
     /**
      * @js ctor
@@ -95,9 +97,42 @@ public:
      */
     void purgeTexturesAtlas();
 
+    /** Sets how many textures the glyphs of a dynamic font may use, CacheTextureMaxCount by default.
+     Once they are all full, the texture whose glyphs were used the least recently is cleared and reused,
+     and the labels showing them lay their letters out again. A texture used during the current frame is never reused,
+     so a frame that needs more glyphs than the budget still gets new textures.
+     */
+    void setMaxTextureCount(int count);
+    int getMaxTextureCount() const;
+
+    /** Marks the texture at the slot as used during the current frame, so it isn't reused before the labels drawing it are laid out again.
+     Labels call it when they draw glyphs from the texture.
+     */
+    void markTextureUsed(int slot);
+
 private:
+    //! A level of the skyline of the current page, the area above y is free from x to x + width
+    struct SkylineLevel
+    {
+        int x;
+        int y;
+        int width;
+    };
 
     void relaseTextures();
+
+    //! Finds the lowest place of the current page that fits the size, returns the index of its skyline level or -1
+    int findPosition(int width, int height, int &outX, int &outY) const;
+    void addSkylineLevel(int index, int x, int y, int width, int height);
+
+    //! Clears the page data and starts filling the texture at the slot, creating it if needed
+    void openPage(int page);
+    //! Moves to a new page or to the least recently used one when the budget is reached
+    void switchPage(unsigned int frame);
+    //! Uploads the rows of the current page written since the last upload
+    void updateTexture();
+    void listenToAfterVisit(EventCustom *event);
+
     std::unordered_map<int, Texture2D*> _atlasTextures;
     std::unordered_map<unsigned short, FontLetterDefinition> _fontLetterDefinitions;
     float _commonLineHeight;
@@ -107,14 +142,19 @@ private:
     int _currentPage;
     unsigned char *_currentPageData;
     int _currentPageDataSize;
-    float _currentPageOrigX;
-    float _currentPageOrigY;
+    std::vector<SkylineLevel> _skyline;
+    int _dirtyTop;
+    int _dirtyBottom;
+    std::vector<unsigned int> _texturesLastUsed;   //! The frame each texture's glyphs were last used
+    int _maxTextureCount;
+    bool _pendingPurge;
     float _letterPadding;
     bool  _makeDistanceMap;
 
     int _fontAscender;
     EventListenerCustom* _toBackgroundListener;
     EventListenerCustom* _toForegroundListener;
+    EventListenerCustom* _afterVisitListener;
 };
 
 
@@ -113,12 +113,16 @@ int * FontCharMap::getHorizontalKerningForTextUTF16(unsigned short *text, int &o
     if (!sizes)
         return 0;
     
-    for (int c = 0; c < outNumLetters; ++c)
+    computeHorizontalKerningForTextUTF16(text, outNumLetters, 0, outNumLetters, sizes);
+    return sizes;
+}
+
+void FontCharMap::computeHorizontalKerningForTextUTF16(const unsigned short *text, int numLetters, int begin, int end, int *outKernings) const
+{
+    for (int c = begin; c < end; ++c)
     {
-        sizes[c] = 0;
+        outKernings[c] = 0;
     }
-    
-    return sizes;
 }
 
 FontAtlas * FontCharMap::createFontAtlas()
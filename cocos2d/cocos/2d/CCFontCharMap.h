@@ -38,6 +38,7 @@ public:
     static FontCharMap * create(const std::string& plistFile);
     
     virtual int* getHorizontalKerningForTextUTF16(unsigned short *text, int &outNumLetters) const override;
+    virtual void computeHorizontalKerningForTextUTF16(const unsigned short *text, int numLetters, int begin, int end, int *outKernings) const override;
     virtual FontAtlas *createFontAtlas() override;
     
 protected:    
@@ -725,15 +725,19 @@ int * FontFNT::getHorizontalKerningForTextUTF16(unsigned short *text, int &outNu
     if (!sizes)
         return 0;
     
-    for (int c = 0; c < outNumLetters; ++c)
+    computeHorizontalKerningForTextUTF16(text, outNumLetters, 0, outNumLetters, sizes);
+    return sizes;
+}
+
+void FontFNT::computeHorizontalKerningForTextUTF16(const unsigned short *text, int numLetters, int begin, int end, int *outKernings) const
+{
+    for (int c = begin; c < end; ++c)
     {
-        if (c < (outNumLetters-1))
-            sizes[c] = getHorizontalKerningForChars(text[c], text[c+1]);
+        if (c < (numLetters-1))
+            outKernings[c] = getHorizontalKerningForChars(text[c], text[c+1]);
         else
-            sizes[c] = 0;
+            outKernings[c] = 0;
     }
-    
-    return sizes;
 }
 
 int  FontFNT::getHorizontalKerningForChars(unsigned short firstChar, unsigned short secondChar) const
@@ -43,6 +43,7 @@ public:
     */
     static void purgeCachedData();
     virtual int* getHorizontalKerningForTextUTF16(unsigned short *text, int &outNumLetters) const override;
+    virtual void computeHorizontalKerningForTextUTF16(const unsigned short *text, int numLetters, int begin, int end, int *outKernings) const override;
     virtual FontAtlas *createFontAtlas() override;
     
 protected:
@@ -173,18 +173,21 @@ int * FontFreeType::getHorizontalKerningForTextUTF16(unsigned short *text, int &
     int *sizes = new int[outNumLetters];
     if (!sizes)
         return nullptr;
-    memset(sizes,0,outNumLetters * sizeof(int));
 
-    bool hasKerning = FT_HAS_KERNING( _fontRef ) != 0;
-    if (hasKerning)
+    computeHorizontalKerningForTextUTF16(text, outNumLetters, 0, outNumLetters, sizes);
+    return sizes;
+}
+
+void FontFreeType::computeHorizontalKerningForTextUTF16(const unsigned short *text, int numLetters, int begin, int end, int *outKernings) const
+{
+    bool hasKerning = _fontRef && FT_HAS_KERNING( _fontRef ) != 0;
+    for (int c = begin; c < end; ++c)
     {
-        for (int c = 1; c < outNumLetters; ++c)
-        {
-            sizes[c] = getHorizontalKerningForChars(text[c-1], text[c]);
-        }
+        if (hasKerning && c > 0)
+            outKernings[c] = getHorizontalKerningForChars(text[c-1], text[c]);
+        else
+            outKernings[c] = 0;
     }
-    
-    return sizes;
 }
 
 int  FontFreeType::getHorizontalKerningForChars(unsigned short firstChar, unsigned short secondChar) const
@@ -26,6 +26,7 @@ THE SOFTWARE.
 #include "CCGrabber.h"
 #include "ccMacros.h"
 #include "CCTexture2D.h"
+#include "platform/CCGLHeadless.h"
 
 NS_CC_BEGIN
 
@@ -23,6 +23,8 @@
  THE SOFTWARE.
  ****************************************************************************/
 
+#include <algorithm>
+
 #include "CCLabel.h"
 #include "CCFontAtlasCache.h"
 #include "CCLabelTextFormatter.h"
@@ -32,6 +34,7 @@
 #include "CCSpriteFrame.h"
 #include "CCDirector.h"
 #include "renderer/CCRenderer.h"
+#include "renderer/CCQuadCommand.h"
 #include "CCFont.h"
 #include "CCEventListenerCustom.h"
 #include "CCEventDispatcher.h"
@@ -257,8 +260,7 @@ bool Label::setCharMap(const std::string& charMapFile, int itemWidth, int itemHe
 
 Label::Label(FontAtlas *atlas /* = nullptr */, TextHAlignment hAlignment /* = TextHAlignment::LEFT */, 
              TextVAlignment vAlignment /* = TextVAlignment::TOP */,bool useDistanceField /* = false */,bool useA8Shader /* = false */)
-: _reusedLetter(nullptr)
-, _commonLineHeight(0.0f)
+: _commonLineHeight(0.0f)
 , _lineBreakWithoutSpaces(false)
 , _maxLineWidth(0)
 , _labelWidth(0)
@@ -268,7 +270,6 @@ Label::Label(FontAtlas *atlas /* = nullptr */, TextHAlignment hAlignment /* = Te
 , _vAlignment(vAlignment)
 , _currentUTF16String(nullptr)
 , _originalUTF16String(nullptr)
-, _horizontalKernings(nullptr)
 , _fontAtlas(atlas)
 , _isOpacityModifyRGB(false)
 , _useDistanceField(useDistanceField)
@@ -278,6 +279,9 @@ Label::Label(FontAtlas *atlas /* = nullptr */, TextHAlignment hAlignment /* = Te
 , _currNumLines(-1)
 , _textSprite(nullptr)
 , _contentDirty(false)
+, _currentUTF16Capacity(0)
+, _originalUTF16Capacity(0)
+, _canRelayoutLines(false)
 {
     _cascadeColorEnabled = true;
     
@@ -296,14 +300,11 @@ Label::~Label()
 {   
     delete [] _currentUTF16String;
     delete [] _originalUTF16String;
-    delete [] _horizontalKernings;
 
     if (_fontAtlas)
     {
         FontAtlasCache::releaseFontAtlas(_fontAtlas);
     }
-
-    CC_SAFE_RELEASE_NULL(_reusedLetter);
 }
 
 void Label::reset()
@@ -335,8 +336,6 @@ void Label::reset()
 
     Node::removeAllChildrenWithCleanup(true);
     _textSprite = nullptr;
-
-    CC_SAFE_RELEASE_NULL(_reusedLetter);
 }
 
 void Label::updateShaderProgram()
@@ -344,6 +343,22 @@ void Label::updateShaderProgram()
     switch (_currLabelEffect)
     {
     case cocos2d::LabelEffect::NORMAL:
+        //The letters are drawn by QuadCommands, whose vertices are already in world space
+        if (_useDistanceField)
+            setShaderProgram(ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_LABEL_DISTANCEFIELD_NORMAL_NO_MVP));
+        else if (_useA8Shader)
+            setShaderProgram(ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_A8_COLOR_NO_MVP));
+        else
+            setShaderProgram(ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_NO_MVP));
+
+        break;
+    case cocos2d::LabelEffect::OUTLINE:
+        if (_currentLabelType == LabelType::TTF)
+        {
+            setShaderProgram(ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_LABEL_OUTLINE));
+            break;
+        }
+        //Only the TTF glyphs have an outline, the others are drawn as they are
     case cocos2d::LabelEffect::SHADOW:
         if (_useDistanceField)
             setShaderProgram(ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_LABEL_DISTANCEFIELD_NORMAL));
@@ -353,9 +368,6 @@ void Label::updateShaderProgram()
             setShaderProgram(ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR));
 
         break;
-    case cocos2d::LabelEffect::OUTLINE:
-            setShaderProgram(ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_LABEL_OUTLINE));
-        break;
     case cocos2d::LabelEffect::GLOW:
         if (_useDistanceField)
             setShaderProgram(ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_LABEL_DISTANCEFIELD_GLOW));
@@ -382,23 +394,12 @@ void Label::setFontAtlas(FontAtlas* atlas,bool distanceFieldEnabled /* = false *
 
     _fontAtlas = atlas;
     SpriteBatchNode::initWithTexture(_fontAtlas->getTexture(0), 30);
-    if (_reusedLetter == nullptr)
-    {
-        _reusedLetter = Sprite::createWithTexture(_fontAtlas->getTexture(0));
-        _reusedLetter->setOpacityModifyRGB(_isOpacityModifyRGB);            
-        _reusedLetter->retain();
-        _reusedLetter->setAnchorPoint(Point::ANCHOR_TOP_LEFT);
-        _reusedLetter->setBatchNode(this);
-    }
-    else
-    {
-        _reusedLetter->setTexture(_fontAtlas->getTexture(0));
-    }
 
     if (_fontAtlas)
     {
         _commonLineHeight = _fontAtlas->getCommonLineHeight();
         _contentDirty = true;
+        _canRelayoutLines = false;
     }
     _useDistanceField = distanceFieldEnabled;
     _useA8Shader = useA8Shader;
@@ -460,10 +461,18 @@ void Label::setFontDefinition(const FontDefinition& textDefinition)
     _fontName = textDefinition._fontName;
     _fontSize = textDefinition._fontSize;
     _contentDirty = true;
+    _canRelayoutLines = false;
 }
 
 void Label::setString(const std::string& text)
 {
+    //counters and HUDs set the same string every frame, don't lay it out again
+    if (text == _originalUTF8String)
+    {
+        return;
+    }
+
+    //only the lines that changed are laid out again, see relayoutChangedLines()
     _originalUTF8String = text;
     _contentDirty = true;
 }
@@ -479,6 +488,8 @@ void Label::setAlignment(TextHAlignment hAlignment,TextVAlignment vAlignment)
         _vAlignment = vAlignment;
 
         _contentDirty = true;
+
+        _canRelayoutLines = false;
     }
 }
 
@@ -488,6 +499,7 @@ void Label::setMaxLineWidth(unsigned int maxLineWidth)
     {
         _maxLineWidth = maxLineWidth;
         _contentDirty = true;
+        _canRelayoutLines = false;
     }
 }
 
@@ -505,6 +517,7 @@ void Label::setDimensions(unsigned int width,unsigned int height)
 
         _maxLineWidth = width;
         _contentDirty = true;
+        _canRelayoutLines = false;
     }  
 }
 
@@ -513,7 +526,8 @@ void Label::setLineBreakWithoutSpace(bool breakWithoutSpace)
     if (breakWithoutSpace != _lineBreakWithoutSpaces)
     {
         _lineBreakWithoutSpaces = breakWithoutSpace;
-        _contentDirty = true;     
+        _contentDirty = true;
+        _canRelayoutLines = false;
     }
 }
 
@@ -580,12 +594,12 @@ void Label::alignText()
         batchNode->getTextureAtlas()->removeAllQuads();
     }
     _fontAtlas->prepareLetterDefinitions(_currentUTF16String);
-    auto textures = _fontAtlas->getTextures();
+    const auto& textures = _fontAtlas->getTextures();
     if (textures.size() > _batchNodes.size())
     {
         for (auto index = _batchNodes.size(); index < textures.size(); ++index)
         {
-            auto batchNode = SpriteBatchNode::createWithTexture(textures[index]);
+            auto batchNode = SpriteBatchNode::createWithTexture(textures.at(index));
             batchNode->setAnchorPoint(Point::ANCHOR_TOP_LEFT);
             batchNode->setPosition(Point::ZERO);
             Node::addChild(batchNode,0,Node::INVALID_TAG);
@@ -618,42 +632,285 @@ void Label::alignText()
                 uvRect.origin.x    = _lettersInfo[tag].def.U;
                 uvRect.origin.y    = _lettersInfo[tag].def.V;
 
-                letterSprite->setTexture(textures[_lettersInfo[tag].def.textureID]);
+                letterSprite->setTexture(textures.at(_lettersInfo[tag].def.textureID));
                 letterSprite->setTextureRect(uvRect);
             }          
         }
     }
 
-    int index;
+    V3F_C4B_T2F_Quad quad;
     for (int ctr = 0; ctr < _limitShowCount; ++ctr)
     {        
         if (_lettersInfo[ctr].def.validDefinition)
         {
-            updateSpriteWithLetterDefinition(_lettersInfo[ctr].def,textures[_lettersInfo[ctr].def.textureID]);
-            _reusedLetter->setPosition(_lettersInfo[ctr].position);
-            index = _batchNodes[_lettersInfo[ctr].def.textureID]->getTextureAtlas()->getTotalQuads();
-            _batchNodes[_lettersInfo[ctr].def.textureID]->insertQuadFromSprite(_reusedLetter,index);
+            auto batchNode = _batchNodes[_lettersInfo[ctr].def.textureID];
+            auto textureAtlas = batchNode->getTextureAtlas();
+            ssize_t index = textureAtlas->getTotalQuads();
+            if (index == textureAtlas->getCapacity())
+            {
+                batchNode->increaseAtlasCapacity();
+            }
+
+            updateQuadWithLetterInfo(_lettersInfo[ctr], textureAtlas->getTexture(), quad);
+            textureAtlas->updateQuad(&quad, index);
         }     
     }
 
     updateColor();
+
+    //wrapped labels, labels cut by their height and labels with letter sprites are always laid out as a whole
+    _canRelayoutLines = _maxLineWidth == 0 && _labelHeight == 0 && _commonLineHeight > 0
+        && strLen > 0 && _currentUTF16String[strLen - 1] != '\n'
+        && _linesInfo.size() == static_cast<size_t>(_currNumLines);
+    for (const auto& lineInfo : _linesInfo)
+    {
+        //LabelTextFormatter::alignText() skips the lines ending with a letter out of the font
+        if (lineInfo.length > 0 && !_lettersInfo[lineInfo.start + lineInfo.length - 1].def.validDefinition)
+        {
+            _canRelayoutLines = false;
+        }
+    }
+    for (const auto& child : _children)
+    {
+        if (child->getTag() >= 0)
+        {
+            _canRelayoutLines = false;
+        }
+    }
 }
 
-bool Label::computeHorizontalKernings(unsigned short int *stringToRender)
+bool Label::relayoutChangedLines()
 {
-    if (_horizontalKernings)
+    if (! _canRelayoutLines || ! _fontAtlas || _textSprite)
     {
-        delete [] _horizontalKernings;
-        _horizontalKernings = nullptr;
+        return false;
     }
 
-    int letterCount = 0;
-    _horizontalKernings = _fontAtlas->getFont()->getHorizontalKerningForTextUTF16(stringToRender, letterCount);
+    //the buffer keeps its capacity from one string to the next
+    cc_utf8_to_utf16_vec(_originalUTF8String.c_str(), _utf16Buffer);
+    unsigned short *newString = _utf16Buffer.data();
+    int newLength = static_cast<int>(_utf16Buffer.size()) - 1;
+    if (newLength <= 0 || newString[newLength - 1] == '\n')
+    {
+        return false;
+    }
 
-    if(!_horizontalKernings)
+    int numLines = static_cast<int>(_linesInfo.size());
+    int lineCount = 1;
+    for (int i = 0; i < newLength; ++i)
+    {
+        if (newString[i] == '\n')
+        {
+            ++lineCount;
+        }
+    }
+    if (lineCount != numLines)
+    {
         return false;
-    else
-        return true;
+    }
+
+    //find the changed lines, the starts stay those of the current string until the letters are moved
+    int newStart = 0;
+    bool anyDirty = false;
+    for (auto& lineInfo : _linesInfo)
+    {
+        int newEnd = newStart;
+        while (newEnd < newLength && newString[newEnd] != '\n')
+        {
+            ++newEnd;
+        }
+        int length = newEnd - newStart;
+        lineInfo.dirty = length != lineInfo.length
+            || memcmp(newString + newStart, _currentUTF16String + lineInfo.start, length * sizeof(unsigned short)) != 0;
+        lineInfo.length = length;
+        anyDirty = anyDirty || lineInfo.dirty;
+        newStart = newEnd + 1;
+    }
+
+    FontLetterDefinition letterDefinition;
+    if (anyDirty)
+    {
+        _fontAtlas->prepareLetterDefinitions(newString);
+        if (_fontAtlas->getTextures().size() > _batchNodes.size())
+        {
+            return false;
+        }
+
+        newStart = 0;
+        for (const auto& lineInfo : _linesInfo)
+        {
+            if (lineInfo.dirty && lineInfo.length > 0)
+            {
+                int last = newStart + lineInfo.length - 1;
+                if (! _fontAtlas->getLetterDefinitionForChar(newString[last], letterDefinition) || ! letterDefinition.validDefinition)
+                {
+                    return false;
+                }
+            }
+            newStart += lineInfo.length + 1;
+        }
+    }
+
+    //the new string replaces the current one in place
+    if (newLength + 1 > _currentUTF16Capacity)
+    {
+        delete [] _currentUTF16String;
+        _currentUTF16String = new unsigned short int [newLength + 1];
+        _currentUTF16Capacity = newLength + 1;
+    }
+    memcpy(_currentUTF16String, newString, (newLength + 1) * sizeof(unsigned short));
+    if (newLength + 1 > _originalUTF16Capacity)
+    {
+        delete [] _originalUTF16String;
+        _originalUTF16String = new unsigned short int [newLength + 1];
+        _originalUTF16Capacity = newLength + 1;
+    }
+    memcpy(_originalUTF16String, newString, (newLength + 1) * sizeof(unsigned short));
+
+    //move the letters of the lines kept to their new indices, the ones moving right from the last line,
+    //then the ones moving left from the first line, so no line overwrites another before it moved
+    int oldLength = static_cast<int>(_horizontalKernings.size());
+    if (static_cast<int>(_lettersInfo.size()) < newLength)
+    {
+        _lettersInfo.resize(newLength);
+    }
+    if (oldLength < newLength)
+    {
+        _horizontalKernings.resize(newLength);
+    }
+
+    newStart = newLength + 1;
+    for (int line = numLines - 1; line >= 0; --line)
+    {
+        auto& lineInfo = _linesInfo[line];
+        newStart -= lineInfo.length + 1;
+        if (! lineInfo.dirty && newStart > lineInfo.start)
+        {
+            std::copy_backward(_lettersInfo.begin() + lineInfo.start, _lettersInfo.begin() + lineInfo.start + lineInfo.length, _lettersInfo.begin() + newStart + lineInfo.length);
+            std::copy_backward(_horizontalKernings.begin() + lineInfo.start, _horizontalKernings.begin() + lineInfo.start + lineInfo.length, _horizontalKernings.begin() + newStart + lineInfo.length);
+        }
+    }
+    newStart = 0;
+    for (auto& lineInfo : _linesInfo)
+    {
+        if (! lineInfo.dirty && newStart < lineInfo.start)
+        {
+            std::copy(_lettersInfo.begin() + lineInfo.start, _lettersInfo.begin() + lineInfo.start + lineInfo.length, _lettersInfo.begin() + newStart);
+            std::copy(_horizontalKernings.begin() + lineInfo.start, _horizontalKernings.begin() + lineInfo.start + lineInfo.length, _horizontalKernings.begin() + newStart);
+        }
+        lineInfo.start = newStart;
+        newStart += lineInfo.length + 1;
+        if (newStart <= newLength)
+        {
+            _lettersInfo[newStart - 1].def.validDefinition = false;
+        }
+    }
+    if (oldLength > newLength)
+    {
+        _horizontalKernings.resize(newLength);
+    }
+
+    //the kernings of a line only depend on its letters and the '\n' around them
+    auto contentScaleFactor = CC_CONTENT_SCALE_FACTOR();
+    const Font *font = _fontAtlas->getFont();
+    int nextFontPositionY = _commonLineHeight * numLines;
+    int longestLine = 0;
+    for (auto& lineInfo : _linesInfo)
+    {
+        if (lineInfo.dirty)
+        {
+            font->computeHorizontalKerningForTextUTF16(_currentUTF16String, newLength, lineInfo.start, lineInfo.start + lineInfo.length, _horizontalKernings.data());
+            lineInfo.width = LabelTextFormatter::createLineSprites(this, lineInfo.start, lineInfo.start + lineInfo.length, nextFontPositionY);
+            lineInfo.shift = 0;
+        }
+        longestLine = std::max(longestLine, lineInfo.width);
+        nextFontPositionY -= _commonLineHeight;
+    }
+    _limitShowCount = newLength;
+
+    //same width as LabelTextFormatter::createStringSprites() gives, with the last letter drawn past its advance
+    const auto& lastDefinition = _lettersInfo[newLength - 1].def;
+    float width = longestLine;
+    if (lastDefinition.xAdvance < lastDefinition.width * contentScaleFactor)
+    {
+        width = longestLine - lastDefinition.xAdvance + lastDefinition.width * contentScaleFactor;
+    }
+    setContentSize(Size(width / contentScaleFactor, _contentSize.height));
+
+    //the first letter whose quad changed, every quad after it in its texture is written again
+    int firstDirty = newLength;
+    bool aligned = numLines > 1 && _hAlignment != TextHAlignment::LEFT;
+    for (auto& lineInfo : _linesInfo)
+    {
+        float shift = 0;
+        if (aligned && lineInfo.length > 0)
+        {
+            const auto& lastLetter = _lettersInfo[lineInfo.start + lineInfo.length - 1];
+            float lineWidth = lastLetter.position.x - lineInfo.shift + lastLetter.contentSize.width;
+            shift = _hAlignment == TextHAlignment::CENTER ? _contentSize.width/2.0f - lineWidth/2.0f : _contentSize.width - lineWidth;
+        }
+        if (shift != lineInfo.shift || lineInfo.dirty)
+        {
+            for (int index = lineInfo.start; index < lineInfo.start + lineInfo.length; ++index)
+            {
+                _lettersInfo[index].position.x += shift - lineInfo.shift;
+            }
+            lineInfo.shift = shift;
+            firstDirty = std::min(firstDirty, lineInfo.start);
+        }
+    }
+
+    Color4B color4 = getQuadColor();
+    V3F_C4B_T2F_Quad quad;
+    for (int textureID = 0; textureID < static_cast<int>(_batchNodes.size()); ++textureID)
+    {
+        int kept = 0;
+        for (int index = 0; index < firstDirty; ++index)
+        {
+            if (_lettersInfo[index].def.validDefinition && _lettersInfo[index].def.textureID == textureID)
+            {
+                ++kept;
+            }
+        }
+        auto textureAtlas = _batchNodes[textureID]->getTextureAtlas();
+        if (textureAtlas->getTotalQuads() > kept)
+        {
+            textureAtlas->removeQuadsAtIndex(kept, textureAtlas->getTotalQuads() - kept);
+        }
+    }
+    for (int index = firstDirty; index < newLength; ++index)
+    {
+        if (_lettersInfo[index].def.validDefinition)
+        {
+            auto batchNode = _batchNodes[_lettersInfo[index].def.textureID];
+            auto textureAtlas = batchNode->getTextureAtlas();
+            ssize_t quadIndex = textureAtlas->getTotalQuads();
+            if (quadIndex == textureAtlas->getCapacity())
+            {
+                batchNode->increaseAtlasCapacity();
+            }
+
+            updateQuadWithLetterInfo(_lettersInfo[index], textureAtlas->getTexture(), quad);
+            quad.bl.colors = color4;
+            quad.br.colors = color4;
+            quad.tl.colors = color4;
+            quad.tr.colors = color4;
+            textureAtlas->updateQuad(&quad, quadIndex);
+        }
+    }
+
+    return true;
+}
+
+bool Label::computeHorizontalKernings(unsigned short int *stringToRender)
+{
+    int letterCount = stringToRender ? cc_wcslen(stringToRender) : 0;
+    _horizontalKernings.resize(letterCount);
+    if (letterCount == 0)
+        return false;
+
+    _fontAtlas->getFont()->computeHorizontalKerningForTextUTF16(stringToRender, letterCount, 0, letterCount, _horizontalKernings.data());
+    return true;
 }
 
 bool Label::setOriginalString(unsigned short *stringToSet)
@@ -665,6 +922,7 @@ bool Label::setOriginalString(unsigned short *stringToSet)
 
     int newStringLenght = cc_wcslen(stringToSet);
     _originalUTF16String = new unsigned short int [newStringLenght + 1];
+    _originalUTF16Capacity = newStringLenght + 1;
     memset(_originalUTF16String, 0, (newStringLenght + 1) * 2);
     memcpy(_originalUTF16String, stringToSet, (newStringLenght * 2));
     _originalUTF16String[newStringLenght] = 0;
@@ -681,6 +939,7 @@ bool Label::setCurrentString(unsigned short *stringToSet)
     }
 
     _currentUTF16String  = stringToSet;
+    _currentUTF16Capacity = stringToSet ? cc_wcslen(stringToSet) + 1 : 0;
     computeStringNumLines();
 
     // compute the advances
@@ -691,16 +950,43 @@ bool Label::setCurrentString(unsigned short *stringToSet)
     return true;
 }
 
-void Label::updateSpriteWithLetterDefinition(const FontLetterDefinition &theDefinition, Texture2D *theTexture)
+void Label::updateQuadWithLetterInfo(const LetterInfo &letterInfo, Texture2D *texture, V3F_C4B_T2F_Quad &quad)
 {
-    _reusedRect.size.height = theDefinition.height;
-    _reusedRect.size.width  = theDefinition.width;
-    _reusedRect.origin.x    = theDefinition.U;
-    _reusedRect.origin.y    = theDefinition.V;
+    //same quad as a letter sprite anchored at its top left corner, without going through the sprite
+    Rect rect = CC_RECT_POINTS_TO_PIXELS(Rect(letterInfo.def.U, letterInfo.def.V, letterInfo.def.width, letterInfo.def.height));
+    float atlasWidth = (float)texture->getPixelsWide();
+    float atlasHeight = (float)texture->getPixelsHigh();
 
-    if(_reusedLetter->getBatchNode() != _batchNodes[theDefinition.textureID])
-        _reusedLetter->setBatchNode(_batchNodes[theDefinition.textureID]);
-    _reusedLetter->setTextureRect(_reusedRect,false,_reusedRect.size);
+#if CC_FIX_ARTIFACTS_BY_STRECHING_TEXEL
+    float left   = (2*rect.origin.x+1)/(2*atlasWidth);
+    float right  = left+(rect.size.width*2-2)/(2*atlasWidth);
+    float top    = (2*rect.origin.y+1)/(2*atlasHeight);
+    float bottom = top+(rect.size.height*2-2)/(2*atlasHeight);
+#else
+    float left   = rect.origin.x/atlasWidth;
+    float right  = (rect.origin.x + rect.size.width) / atlasWidth;
+    float top    = rect.origin.y/atlasHeight;
+    float bottom = (rect.origin.y + rect.size.height) / atlasHeight;
+#endif
+
+    float x1 = letterInfo.position.x;
+    float y2 = letterInfo.position.y;
+    float x2 = x1 + letterInfo.def.width;
+    float y1 = y2 - letterInfo.def.height;
+
+    //the colors are set by updateColor()
+    quad.bl.vertices = Vertex3F(x1, y1, 0);
+    quad.bl.texCoords.u = left;
+    quad.bl.texCoords.v = bottom;
+    quad.br.vertices = Vertex3F(x2, y1, 0);
+    quad.br.texCoords.u = right;
+    quad.br.texCoords.v = bottom;
+    quad.tl.vertices = Vertex3F(x1, y2, 0);
+    quad.tl.texCoords.u = left;
+    quad.tl.texCoords.v = top;
+    quad.tr.vertices = Vertex3F(x2, y2, 0);
+    quad.tr.texCoords.u = right;
+    quad.tr.texCoords.v = top;
 }
 
 bool Label::recordLetterInfo(const cocos2d::Point& point,const FontLetterDefinition& letterDef, int spriteIndex)
@@ -782,7 +1068,6 @@ void Label::enableOutline(const Color4B& outlineColor,int outlineSize /* = 1 */)
                 auto config = _fontConfig;
                 config.outlineSize = outlineSize;
                 setTTFConfig(config);
-                updateShaderProgram();
             }
         }
         _fontDefinition._stroke._strokeEnabled = true;
@@ -790,7 +1075,9 @@ void Label::enableOutline(const Color4B& outlineColor,int outlineSize /* = 1 */)
         _fontDefinition._stroke._strokeColor = Color3B(outlineColor.r,outlineColor.g,outlineColor.b);
 
         _currLabelEffect = LabelEffect::OUTLINE;
+        updateShaderProgram();
         _contentDirty = true;
+        _canRelayoutLines = false;
     }
 }
 
@@ -802,6 +1089,7 @@ void Label::enableShadow(const Color3B& shadowColor /* = Color3B::BLACK */,const
     //todo:support blur for shadow
     _shadowBlurRadius = 0;
     _currLabelEffect = LabelEffect::SHADOW;
+    updateShaderProgram();
 
     _fontDefinition._shadow._shadowEnabled = true;
     _fontDefinition._shadow._shadowBlur = blurRadius;
@@ -809,6 +1097,8 @@ void Label::enableShadow(const Color3B& shadowColor /* = Color3B::BLACK */,const
     _fontDefinition._shadow._shadowOpacity = opacity;
 
     _contentDirty = true;
+
+    _canRelayoutLines = false;
 }
 
 void Label::disableEffect()
@@ -821,6 +1111,7 @@ void Label::disableEffect()
     _currLabelEffect = LabelEffect::NORMAL;
     updateShaderProgram();
     _contentDirty = true;
+    _canRelayoutLines = false;
 }
 
 void Label::setFontScale(float fontScale)
@@ -914,6 +1205,48 @@ void Label::drawShadowWithoutBlur()
 
 void Label::draw(Renderer *renderer, const kmMat4 &transform, bool transformUpdated)
 {
+    //Keep the pages of the font atlas drawn this frame from being reused for other glyphs
+    if (_fontAtlas)
+    {
+        for (size_t index = 0; index < _batchNodes.size(); ++index)
+        {
+            if (_batchNodes[index]->getTextureAtlas()->getTotalQuads() > 0)
+            {
+                _fontAtlas->markTextureUsed(static_cast<int>(index));
+            }
+        }
+    }
+
+    //Without effect the shader needs no uniform, so the letters are batched with the other labels and sprites
+    if (_currLabelEffect == LabelEffect::NORMAL)
+    {
+        for(const auto &child: _children)
+        {
+            if(child->getTag() >= 0)
+                child->updateTransform();
+        }
+
+        FrameArena* arena = renderer->getFrameArena();
+        for (const auto& batchNode:_batchNodes)
+        {
+            auto textureAtlas = batchNode->getTextureAtlas();
+            if (textureAtlas->getTotalQuads() == 0)
+            {
+                continue;
+            }
+
+            //Copy the quads, a purge of the font atlas lays the letters out again while the command is queued
+            ssize_t quadCount = textureAtlas->getTotalQuads();
+            V3F_C4B_T2F_Quad* quads = arena->allocateArray<V3F_C4B_T2F_Quad>(quadCount);
+            memcpy(quads, textureAtlas->getQuads(), sizeof(V3F_C4B_T2F_Quad) * quadCount);
+
+            QuadCommand* command = arena->create<QuadCommand>();
+            command->init(_globalZOrder, textureAtlas->getTexture()->getName(), _shaderProgram, _blendFunc, quads, quadCount, transform);
+            renderer->addCommand(command);
+        }
+        return;
+    }
+
     _customCommand.init(_globalZOrder);
     _customCommand.func = CC_CALLBACK_0(Label::onDraw, this, transform, transformUpdated);
     renderer->addCommand(&_customCommand);
@@ -943,6 +1276,13 @@ void Label::createSpriteWithFontDefinition()
 
 void Label::updateContent()
 {
+    if (relayoutChangedLines())
+    {
+        _contentDirty = false;
+        return;
+    }
+    _canRelayoutLines = false;
+
     auto utf16String = cc_utf8_to_utf16(_originalUTF8String.c_str());
     setCurrentString(utf16String);
     setOriginalString(utf16String);
@@ -973,6 +1313,7 @@ void Label::updateFont()
     _fontDefinition._fontName = _fontName;
     _fontDefinition._fontSize = _fontSize;
     _contentDirty = true;
+    _canRelayoutLines = false;
     _fontDirty = false;
 }
 
@@ -1083,6 +1424,7 @@ Sprite * Label::getLetter(int lettetIndex)
             sp->setOpacity(_realOpacity);
 
             this->addSpriteWithoutQuad(sp, lettetIndex, lettetIndex);
+            _canRelayoutLines = false;
         }
         return sp;
     }
@@ -1136,8 +1478,6 @@ void Label::setOpacityModifyRGB(bool isOpacityModifyRGB)
     for(const auto& child: _children) {
         child->setOpacityModifyRGB(_isOpacityModifyRGB);
     }
-
-    _reusedLetter->setOpacityModifyRGB(true);
 }
 
 void Label::setColor(const Color3B& color)
@@ -1147,16 +1487,25 @@ void Label::setColor(const Color3B& color)
     {
         updateContent();
     }
-    if (_reusedLetter)
+    SpriteBatchNode::setColor(color);
+}
+
+Color4B Label::getQuadColor() const
+{
+    Color4B color4( _displayedColor.r, _displayedColor.g, _displayedColor.b, _displayedOpacity );
+
+    // special opacity for premultiplied textures
+    if (_isOpacityModifyRGB)
     {
-        _reusedLetter->setColor(color);
+        color4.r *= _displayedOpacity/255.0f;
+        color4.g *= _displayedOpacity/255.0f;
+        color4.b *= _displayedOpacity/255.0f;
     }
-    SpriteBatchNode::setColor(color);
+    return color4;
 }
 
 void Label::updateColor()
 {
-    Color4B color4( _displayedColor.r, _displayedColor.g, _displayedColor.b, _displayedOpacity );
     if (_textSprite)
     {
         _textSprite->setColor(_displayedColor);
@@ -1168,13 +1517,7 @@ void Label::updateColor()
         return;
     }
 
-    // special opacity for premultiplied textures
-    if (_isOpacityModifyRGB)
-    {
-        color4.r *= _displayedOpacity/255.0f;
-        color4.g *= _displayedOpacity/255.0f;
-        color4.b *= _displayedOpacity/255.0f;
-    }
+    Color4B color4 = getQuadColor();
 
     cocos2d::TextureAtlas* textureAtlas;
     V3F_C4B_T2F_Quad *quads;
@@ -1221,6 +1564,7 @@ void Label::listenToBackground(EventCustom *event)
         _batchNodes.clear();
         _batchNodes.push_back(this);
         Node::removeAllChildrenWithCleanup(true);
+        _canRelayoutLines = false;
     }
 #endif
 }
@@ -249,6 +249,15 @@ protected:
         Point position;
         Size  contentSize;
     };
+    //! A line of the last layout, between two '\n' of the current string
+    struct LineInfo
+    {
+        int   start;
+        int   length;
+        int   width;    //! The furthest the pen went on the line, in pixels
+        float shift;    //! The horizontal alignment offset applied to its letters, in points
+        bool  dirty;
+    };
     enum class LabelType {
 
         TTF,
@@ -276,15 +285,20 @@ protected:
     void setFontScale(float fontScale);
     
     virtual void alignText();
+    /** Lays out again only the lines the new string changed, reusing the letters and quads of the others.
+     Returns false when the whole label has to be laid out, which leaves the label to alignText().
+     */
+    bool relayoutChangedLines();
     
     bool computeHorizontalKernings(unsigned short int *stringToRender);
     bool setCurrentString(unsigned short *stringToSet);
     bool setOriginalString(unsigned short *stringToSet);
     void computeStringNumLines();
 
-    void updateSpriteWithLetterDefinition(const FontLetterDefinition &theDefinition, Texture2D *theTexture);
+    void updateQuadWithLetterInfo(const LetterInfo &letterInfo, Texture2D *texture, V3F_C4B_T2F_Quad &quad);
 
     virtual void updateColor() override;
+    Color4B getQuadColor() const;
 
     virtual void updateShaderProgram();
 
@@ -312,14 +326,11 @@ protected:
     Sprite* _textSprite;
     FontDefinition _fontDefinition;
 
-    //! used for optimization
-    Sprite *_reusedLetter;
-    Rect _reusedRect;
     int _limitShowCount;
 
     float _commonLineHeight;
     bool  _lineBreakWithoutSpaces;
-    int * _horizontalKernings;
+    std::vector<int> _horizontalKernings;
 
     unsigned int _maxLineWidth;
     Size         _labelDimensions;
@@ -332,6 +343,13 @@ protected:
     unsigned short int * _currentUTF16String;
     unsigned short int * _originalUTF16String;
     std::string          _originalUTF8String;
+    int                  _currentUTF16Capacity;
+    int                  _originalUTF16Capacity;
+
+    //! Set by a full layout the lines can be laid out again from
+    bool                        _canRelayoutLines;
+    std::vector<LineInfo>       _linesInfo;
+    std::vector<unsigned short> _utf16Buffer;
 
     float _fontScale;
 
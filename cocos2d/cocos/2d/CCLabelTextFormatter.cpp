@@ -243,6 +243,11 @@ bool LabelTextFormatter::alignText(Label *theLabel)
                     break;
             }
             
+            if (lineNumber < static_cast<int>(theLabel->_linesInfo.size()))
+            {
+                theLabel->_linesInfo[lineNumber].shift = shift;
+            }
+
             if (shift != 0)
             {
                 for (unsigned j = 0; j < lineLength; ++j)
@@ -321,8 +326,12 @@ bool LabelTextFormatter::createStringSprites(Label *theLabel)
     FontLetterDefinition tempDefinition;
     Point letterPosition;
     const auto& kernings = theLabel->_horizontalKernings;
+    auto& linesInfo = theLabel->_linesInfo;
+    Label::LineInfo lineInfo = { 0, 0, 0, 0.0f, false };
+    linesInfo.clear();
     
-    for (unsigned int i = 0; i < stringLen; i++)
+    unsigned int i = 0;
+    for (; i < stringLen; i++)
     {
         unsigned short c    = strWhole[i];
         if (fontAtlas->getLetterDefinitionForChar(c, tempDefinition))
@@ -340,6 +349,11 @@ bool LabelTextFormatter::createStringSprites(Label *theLabel)
         
         if (c == '\n')
         {
+            lineInfo.length = i - lineInfo.start;
+            linesInfo.push_back(lineInfo);
+            lineInfo.start = i + 1;
+            lineInfo.width = 0;
+
             nextFontPositionX  = 0;
             nextFontPositionY -= theLabel->_commonLineHeight;
             
@@ -365,6 +379,15 @@ bool LabelTextFormatter::createStringSprites(Label *theLabel)
         {
             longestLine = nextFontPositionX;
         }
+        if (lineInfo.width < nextFontPositionX)
+        {
+            lineInfo.width = nextFontPositionX;
+        }
+    }
+    if (i == stringLen)
+    {
+        lineInfo.length = i - lineInfo.start;
+        linesInfo.push_back(lineInfo);
     }
     
     float lastCharWidth = tempDefinition.width * contentScaleFactor;
@@ -390,4 +413,41 @@ bool LabelTextFormatter::createStringSprites(Label *theLabel)
     return true;
 }
 
+int LabelTextFormatter::createLineSprites(Label *theLabel, int begin, int end, int nextFontPositionY)
+{
+    int nextFontPositionX = 0;
+    int lineWidth = 0;
+    auto contentScaleFactor = CC_CONTENT_SCALE_FACTOR();
+
+    auto strWhole = theLabel->_currentUTF16String;
+    auto fontAtlas = theLabel->_fontAtlas;
+    FontLetterDefinition tempDefinition;
+    Point letterPosition;
+    const auto& kernings = theLabel->_horizontalKernings;
+
+    //same placement as createStringSprites()
+    for (int i = begin; i < end; ++i)
+    {
+        fontAtlas->getLetterDefinitionForChar(strWhole[i], tempDefinition);
+        int charXOffset = tempDefinition.offsetX;
+        int charYOffset = tempDefinition.offsetY;
+
+        letterPosition.x = (nextFontPositionX + charXOffset + kernings[i]) / contentScaleFactor;
+        letterPosition.y = (nextFontPositionY - charYOffset) / contentScaleFactor;
+
+        if (theLabel->recordLetterInfo(letterPosition,tempDefinition,i) == false)
+        {
+            continue;
+        }
+
+        nextFontPositionX += tempDefinition.xAdvance + kernings[i];
+        if (lineWidth < nextFontPositionX)
+        {
+            lineWidth = nextFontPositionX;
+        }
+    }
+
+    return lineWidth;
+}
+
 NS_CC_END
@@ -37,6 +37,8 @@ public:
     static bool multilineText(Label *theLabel);
     static bool alignText(Label *theLabel);
     static bool createStringSprites(Label *theLabel);
+    /** Lays out the letters [begin, end) of a line without '\n' at the pen height, returns the furthest the pen went. */
+    static int createLineSprites(Label *theLabel, int begin, int end, int nextFontPositionY);
 
 };
 
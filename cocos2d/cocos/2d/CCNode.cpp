@@ -44,6 +44,7 @@ THE SOFTWARE.
 #include "CCEvent.h"
 #include "CCEventTouch.h"
 #include "CCScene.h"
+#include "renderer/CCRenderer.h"
 
 #if CC_USE_PHYSICS
 #include "CCPhysicsBody.h"
@@ -109,6 +110,9 @@ Node::Node(void)
 , _visible(true)
 , _ignoreAnchorPointForPosition(false)
 , _reorderChildDirty(false)
+, _renderCache(nullptr)
+, _renderCacheDirty(true)
+, _inRenderCache(false)
 , _isTransitionFinished(false)
 #if CC_ENABLE_SCRIPT_BINDING
 , _updateScriptHandler(0)
@@ -167,11 +171,14 @@ Node::~Node()
     for (auto& child : _children)
     {
         child->_parent = nullptr;
+        child->updateInRenderCache();
     }
 
     removeAllComponents();
     
     CC_SAFE_DELETE(_componentContainer);
+
+    setRenderCacheEnabled(false);
     
 #if CC_USE_PHYSICS
     setPhysicsBody(nullptr);
@@ -195,6 +202,7 @@ void Node::setSkewX(float skewX)
     
     _skewX = skewX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setRenderCacheDirty();
 }
 
 float Node::getSkewY() const
@@ -209,6 +217,7 @@ void Node::setSkewY(float skewY)
     
     _skewY = skewY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setRenderCacheDirty();
 }
 
 
@@ -239,6 +248,7 @@ void Node::setGlobalZOrder(float globalZOrder)
     {
         _globalZOrder = globalZOrder;
         _eventDispatcher->setDirtyForNode(this);
+        setRenderCacheDirty();
     }
 }
 
@@ -257,6 +267,7 @@ void Node::setRotation(float rotation)
     
     _rotationZ_X = _rotationZ_Y = rotation;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setRenderCacheDirty();
 
 #if CC_USE_PHYSICS
     if (_physicsBody)
@@ -279,6 +290,7 @@ void Node::setRotation3D(const Vertex3F& rotation)
         return;
     
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setRenderCacheDirty();
 
     _rotationX = rotation.x;
     _rotationY = rotation.y;
@@ -309,6 +321,7 @@ void Node::setRotationSkewX(float rotationX)
     
     _rotationZ_X = rotationX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setRenderCacheDirty();
 }
 
 float Node::getRotationSkewY() const
@@ -323,6 +336,7 @@ void Node::setRotationSkewY(float rotationY)
     
     _rotationZ_Y = rotationY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setRenderCacheDirty();
 }
 
 /// scale getter
@@ -340,6 +354,7 @@ void Node::setScale(float scale)
 
     _scaleX = _scaleY = _scaleZ = scale;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setRenderCacheDirty();
 }
 
 /// scaleX getter
@@ -357,6 +372,7 @@ void Node::setScale(float scaleX,float scaleY)
     _scaleX = scaleX;
     _scaleY = scaleY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setRenderCacheDirty();
 }
 
 /// scaleX setter
@@ -367,6 +383,7 @@ void Node::setScaleX(float scaleX)
     
     _scaleX = scaleX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setRenderCacheDirty();
 }
 
 /// scaleY getter
@@ -383,6 +400,7 @@ void Node::setScaleZ(float scaleZ)
     
     _scaleZ = scaleZ;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setRenderCacheDirty();
 }
 
 /// scaleY getter
@@ -399,6 +417,7 @@ void Node::setScaleY(float scaleY)
     
     _scaleY = scaleY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setRenderCacheDirty();
 }
 
 
@@ -416,6 +435,7 @@ void Node::setPosition(const Point& position)
     
     _position = position;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setRenderCacheDirty();
 
 #if CC_USE_PHYSICS
     if (_physicsBody)
@@ -484,6 +504,7 @@ void Node::setPositionZ(float positionZ)
         return;
     
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setRenderCacheDirty();
 
     _positionZ = positionZ;
 
@@ -510,6 +531,7 @@ void Node::setVisible(bool var)
     {
         _visible = var;
         if(_visible) _transformUpdated = _transformDirty = _inverseDirty = true;
+        setRenderCacheDirty();
     }
 }
 
@@ -539,6 +561,7 @@ void Node::setAnchorPoint(const Point& point)
         _anchorPoint = point;
         _anchorPointInPoints = Point(_contentSize.width * _anchorPoint.x, _contentSize.height * _anchorPoint.y );
         _transformUpdated = _transformDirty = _inverseDirty = true;
+        setRenderCacheDirty();
     }
 }
 
@@ -556,6 +579,7 @@ void Node::setContentSize(const Size & size)
 
         _anchorPointInPoints = Point(_contentSize.width * _anchorPoint.x, _contentSize.height * _anchorPoint.y );
         _transformUpdated = _transformDirty = _inverseDirty = true;
+        setRenderCacheDirty();
     }
 }
 
@@ -569,6 +593,7 @@ bool Node::isRunning() const
 void Node::setParent(Node * var)
 {
     _parent = var;
+    updateInRenderCache();
 }
 
 /// isRelativeAnchorPoint getter
@@ -583,6 +608,7 @@ void Node::ignoreAnchorPointForPosition(bool newValue)
     {
 		_ignoreAnchorPointForPosition = newValue;
         _transformUpdated = _transformDirty = _inverseDirty = true;
+        setRenderCacheDirty();
 	}
 }
 
@@ -627,6 +653,7 @@ void Node::setShaderProgram(GLProgram *pShaderProgram)
     CC_SAFE_RETAIN(pShaderProgram);
     CC_SAFE_RELEASE(_shaderProgram);
     _shaderProgram = pShaderProgram;
+    setRenderCacheDirty();
 }
 
 Scene* Node::getScene()
@@ -852,6 +879,7 @@ void Node::removeAllChildrenWithCleanup(bool cleanup)
     }
     
     _children.clear();
+    setRenderCacheDirty();
 }
 
 void Node::detachChild(Node *child, ssize_t childIndex, bool doCleanup)
@@ -884,6 +912,7 @@ void Node::detachChild(Node *child, ssize_t childIndex, bool doCleanup)
     child->setParent(nullptr);
 
     _children.erase(childIndex);
+    setRenderCacheDirty();
 }
 
 
@@ -893,6 +922,7 @@ void Node::insertChild(Node* child, int z)
     _reorderChildDirty = true;
     _children.pushBack(child);
     child->_setLocalZOrder(z);
+    setRenderCacheDirty();
 }
 
 void Node::reorderChild(Node *child, int zOrder)
@@ -901,6 +931,7 @@ void Node::reorderChild(Node *child, int zOrder)
     _reorderChildDirty = true;
     child->setOrderOfArrival(s_globalOrderOfArrival++);
     child->_setLocalZOrder(zOrder);
+    setRenderCacheDirty();
 }
 
 void Node::sortAllChildren()
@@ -938,10 +969,24 @@ void Node::visit(Renderer* renderer, const kmMat4 &parentTransform, bool parentT
     }
 
     bool dirty = _transformUpdated || parentTransformUpdated;
+
+    // nothing changed in the subtree since it was recorded
+    if(_renderCache && !dirty && !_renderCacheDirty)
+    {
+        renderer->addRecordedCommands(*_renderCache);
+        return;
+    }
+
     if(dirty)
         _modelViewTransform = this->transform(parentTransform);
     _transformUpdated = false;
 
+    if(_renderCache)
+    {
+        _renderCache->clear();
+        renderer->beginRecording(_renderCache);
+    }
+
 
     // IMPORTANT:
     // To ease the migration to v3.0, we still support the kmGL stack,
@@ -979,6 +1024,60 @@ void Node::visit(Renderer* renderer, const kmMat4 &parentTransform, bool parentT
     _orderOfArrival = 0;
  
     kmGLPopMatrix();
+
+    if(_renderCache)
+    {
+        // record again next frame if the subtree used commands of the frame arena
+        _renderCacheDirty = !renderer->endRecording();
+    }
+}
+
+void Node::setRenderCacheEnabled(bool enabled)
+{
+    if(enabled == (_renderCache != nullptr))
+        return;
+
+    if(enabled)
+    {
+        _renderCache = new std::vector<RecordedRenderCommand>();
+        _renderCacheDirty = true;
+    }
+    else
+    {
+        CC_SAFE_DELETE(_renderCache);
+    }
+
+    updateInRenderCache();
+}
+
+void Node::invalidateRenderCache()
+{
+    //Stop at the outermost cache, the ancestors above it have nothing recorded
+    for(Node* node = this; node != nullptr && node->_inRenderCache; node = node->_parent)
+    {
+        node->_renderCacheDirty = true;
+    }
+}
+
+void Node::setRenderCacheDirty()
+{
+    if(_inRenderCache)
+    {
+        invalidateRenderCache();
+    }
+}
+
+void Node::updateInRenderCache()
+{
+    bool inRenderCache = _renderCache != nullptr || (_parent != nullptr && _parent->_inRenderCache);
+    if(inRenderCache == _inRenderCache)
+        return;
+
+    _inRenderCache = inRenderCache;
+    for(const auto& child : _children)
+    {
+        child->updateInRenderCache();
+    }
 }
 
 kmMat4 Node::transform(const kmMat4& parentTransform)
@@ -1200,6 +1299,11 @@ void Node::scheduleUpdateWithPriority(int priority)
     _scheduler->scheduleUpdate(this, priority, !_running);
 }
 
+void Node::scheduleParallelUpdate(int priority)
+{
+    _scheduler->scheduleParallelUpdate(this, priority, !_running);
+}
+
 void Node::scheduleUpdateWithPriorityLua(int nHandler, int priority)
 {
     unscheduleUpdate();
@@ -1416,6 +1520,7 @@ void Node::setNodeToParentTransform(const kmMat4& transform)
     _transform = transform;
     _transformDirty = false;
     _transformUpdated = true;
+    setRenderCacheDirty();
 }
 
 void Node::setAdditionalTransform(const AffineTransform& additionalTransform)
@@ -1434,6 +1539,7 @@ void Node::setAdditionalTransform(kmMat4* additionalTransform)
         _useAdditionalTransform = true;
     }
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    setRenderCacheDirty();
 }
 
 
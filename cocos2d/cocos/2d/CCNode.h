@@ -55,6 +55,7 @@ class ComponentContainer;
 class EventDispatcher;
 class Scene;
 class Renderer;
+struct RecordedRenderCommand;
 #if CC_USE_PHYSICS
 class PhysicsBody;
 #endif
@@ -929,6 +930,28 @@ public:
     virtual void visit(Renderer *renderer, const kmMat4& parentTransform, bool parentTransformUpdated);
     virtual void visit() final;
 
+    /**
+     * Enables or disables the render cache of the node.
+     *
+     * When enabled, the render commands of the node and of its children are recorded the first time the node is visited.
+     * In the following frames the recorded commands are added again to the Renderer, without visiting the children.
+     * The commands are recorded again when the transform, the visibility, the order, the texture or the children
+     * of any node of the subtree change.
+     *
+     * Nodes that update their render commands in other ways (particles, labels whose string changes, ...) should not
+     * be part of a cached subtree unless `invalidateRenderCache()` is called after every change.
+     * Nodes relying on the deprecated kmGL matrix stack in `draw()` can't be cached either.
+     * Subtrees that add commands created with `Renderer::getFrameArena()` are recorded again every frame.
+     * @since v3.0
+     */
+    void setRenderCacheEnabled(bool enabled);
+    bool isRenderCacheEnabled() const { return _renderCache != nullptr; }
+
+    /** Records again the commands of the render caches that contain the node.
+     @since v3.0
+     */
+    void invalidateRenderCache();
+
 
     /** Returns the Scene that contains the Node.
      It returns `nullptr` if the node doesn't belong to any Scene.
@@ -1076,6 +1099,19 @@ public:
      */
     void scheduleUpdateWithPriority(int priority);
 
+    /**
+     * Schedules the "computeUpdate" and "applyUpdate" methods instead of "update".
+     *
+     * Every frame, "computeUpdate" is called on a worker thread of the JobPool, concurrently with the
+     * other parallel updates. Then "applyUpdate" is called on the cocos2d thread, before the regular
+     * "update" methods.
+     * @see computeUpdate(float)
+     * @see Scheduler::scheduleParallelUpdate
+     * @js NA
+     * @lua NA
+     */
+    void scheduleParallelUpdate(int priority = 0);
+
     /*
      * Unschedules the "update" method.
      * @see scheduleUpdate();
@@ -1173,6 +1209,26 @@ public:
      */
     virtual void update(float delta);
 
+    /**
+     * Parallel part of the update, called on a worker thread if "scheduleParallelUpdate" is called.
+     *
+     * It must be pure computation: it can read the node, but must only write members of the subclass
+     * that nothing else reads during the frame. It can't call the setters of Node (they invalidate the
+     * render caches of the ancestors and move the physics body), add or remove nodes, run actions,
+     * dispatch events or schedule callbacks. The results are written back in "applyUpdate".
+     * @js NA
+     * @lua NA
+     */
+    virtual void computeUpdate(float delta) {}
+
+    /**
+     * Writes back the results of "computeUpdate". It is called on the cocos2d thread once every
+     * parallel update of the frame is computed, and can use the whole API.
+     * @js NA
+     * @lua NA
+     */
+    virtual void applyUpdate(float delta) {}
+
     /// @} end of Scheduler and Timer
 
     /// @{
@@ -1364,6 +1420,12 @@ protected:
     virtual void disableCascadeColor();
     virtual void updateColor() {}
 
+    /// Invalidates the render caches containing the node. It is a no-op if neither the node nor an ancestor has a render cache.
+    void setRenderCacheDirty();
+
+    /// Updates `_inRenderCache` of the node and of its children after the parent or the render cache changed.
+    void updateInRenderCache();
+
     float _rotationX;               ///< rotation on the X-axis
     float _rotationY;               ///< rotation on the Y-axis
 
@@ -1428,6 +1490,10 @@ protected:
                                           ///< Used by Layer and Scene.
 
     bool _reorderChildDirty;          ///< children order dirty flag
+
+    std::vector<RecordedRenderCommand>* _renderCache; ///< commands recorded for the subtree, nullptr if the render cache is disabled
+    bool _renderCacheDirty;           ///< whether or not the subtree has to be recorded again
+    bool _inRenderCache;              ///< whether or not the node or one of its ancestors has a render cache
     bool _isTransitionFinished;       ///< flag to indicate whether the transition was finished
 
 #if CC_ENABLE_SCRIPT_BINDING
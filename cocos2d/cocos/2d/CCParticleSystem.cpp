@@ -59,11 +59,275 @@ THE SOFTWARE.
 // opengl
 #include "CCGL.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CC_PARTICLE_USE_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define CC_PARTICLE_USE_NEON 1
+#include <arm_neon.h>
+#endif
+
 using namespace std;
 
 
 NS_CC_BEGIN
 
+// ParticleData
+
+// number of arrays of ParticleData, atlasIndex included
+static const int PARTICLE_DATA_ARRAYS = 26;
+
+ParticleData::ParticleData()
+: _block(nullptr)
+, _maxCount(0)
+, _stride(0)
+{
+    posx = posy = startPosX = startPosY = nullptr;
+    colorR = colorG = colorB = colorA = nullptr;
+    deltaColorR = deltaColorG = deltaColorB = deltaColorA = nullptr;
+    size = deltaSize = rotation = deltaRotation = timeToLive = nullptr;
+    atlasIndex = nullptr;
+    modeA.dirX = modeA.dirY = modeA.radialAccel = modeA.tangentialAccel = nullptr;
+    modeB.angle = modeB.degreesPerSecond = modeB.radius = modeB.deltaRadius = nullptr;
+}
+
+ParticleData::~ParticleData()
+{
+    release();
+}
+
+bool ParticleData::init(int count)
+{
+    //pad every array to a multiple of 4 particles, so the arrays stay 16 bytes aligned
+    unsigned int stride = (MAX(count, 0) + 3) & ~3u;
+    size_t bytes = sizeof(float) * stride * PARTICLE_DATA_ARRAYS;
+
+    //keep the current storage if the allocation fails
+    void* block = malloc(bytes + 15);
+    if (!block)
+    {
+        return false;
+    }
+    release();
+
+    memset(block, 0, bytes + 15);
+    _block = block;
+    _maxCount = count;
+    _stride = stride;
+
+    float* base = (float*)(((uintptr_t)block + 15) & ~(uintptr_t)15);
+    float** arrays[] = {
+        &posx, &posy, &startPosX, &startPosY,
+        &colorR, &colorG, &colorB, &colorA,
+        &deltaColorR, &deltaColorG, &deltaColorB, &deltaColorA,
+        &size, &deltaSize, &rotation, &deltaRotation, &timeToLive,
+        &modeA.dirX, &modeA.dirY, &modeA.radialAccel, &modeA.tangentialAccel,
+        &modeB.angle, &modeB.degreesPerSecond, &modeB.radius, &modeB.deltaRadius,
+    };
+    static_assert(sizeof(arrays) / sizeof(arrays[0]) == PARTICLE_DATA_ARRAYS - 1, "ParticleData arrays mismatch");
+
+    for (int i = 0; i < PARTICLE_DATA_ARRAYS - 1; ++i)
+    {
+        *arrays[i] = base + i * stride;
+    }
+    atlasIndex = (unsigned int*)(base + (PARTICLE_DATA_ARRAYS - 1) * stride);
+
+    return true;
+}
+
+void ParticleData::release()
+{
+    CC_SAFE_FREE(_block);
+    _maxCount = 0;
+    _stride = 0;
+}
+
+void ParticleData::copyParticle(int dst, int src)
+{
+    //copy the raw 4 bytes values: atlasIndex is not a float
+    char* base = (char*)posx;
+    const size_t arraySize = sizeof(float) * _stride;
+    for (int i = 0; i < PARTICLE_DATA_ARRAYS; ++i, base += arraySize)
+    {
+        memcpy(base + dst * sizeof(float), base + src * sizeof(float), sizeof(float));
+    }
+}
+
+// Particle kernels.
+// They process the particles 4 at a time, the arrays of ParticleData being padded for it.
+
+//dst[i] += src[i] * scale
+static void particleMulAdd(float* dst, const float* src, float scale, int count)
+{
+#if CC_PARTICLE_USE_SSE2
+    const __m128 s = _mm_set1_ps(scale);
+    for (int i = 0; i < count; i += 4)
+    {
+        _mm_store_ps(dst + i, _mm_add_ps(_mm_load_ps(dst + i), _mm_mul_ps(_mm_load_ps(src + i), s)));
+    }
+#elif CC_PARTICLE_USE_NEON
+    const float32x4_t s = vdupq_n_f32(scale);
+    for (int i = 0; i < count; i += 4)
+    {
+        vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), s));
+    }
+#else
+    for (int i = 0; i < count; ++i)
+    {
+        dst[i] += src[i] * scale;
+    }
+#endif
+}
+
+//dst[i] = MAX(dst[i] + src[i] * scale, 0)
+static void particleMulAddPositive(float* dst, const float* src, float scale, int count)
+{
+#if CC_PARTICLE_USE_SSE2
+    const __m128 s = _mm_set1_ps(scale);
+    const __m128 zero = _mm_setzero_ps();
+    for (int i = 0; i < count; i += 4)
+    {
+        __m128 v = _mm_add_ps(_mm_load_ps(dst + i), _mm_mul_ps(_mm_load_ps(src + i), s));
+        _mm_store_ps(dst + i, _mm_max_ps(v, zero));
+    }
+#elif CC_PARTICLE_USE_NEON
+    const float32x4_t s = vdupq_n_f32(scale);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    for (int i = 0; i < count; i += 4)
+    {
+        vst1q_f32(dst + i, vmaxq_f32(vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), s), zero));
+    }
+#else
+    for (int i = 0; i < count; ++i)
+    {
+        dst[i] = MAX(0, dst[i] + src[i] * scale);
+    }
+#endif
+}
+
+//dst[i] += value
+static void particleAdd(float* dst, float value, int count)
+{
+#if CC_PARTICLE_USE_SSE2
+    const __m128 v = _mm_set1_ps(value);
+    for (int i = 0; i < count; i += 4)
+    {
+        _mm_store_ps(dst + i, _mm_add_ps(_mm_load_ps(dst + i), v));
+    }
+#elif CC_PARTICLE_USE_NEON
+    const float32x4_t v = vdupq_n_f32(value);
+    for (int i = 0; i < count; i += 4)
+    {
+        vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), v));
+    }
+#else
+    for (int i = 0; i < count; ++i)
+    {
+        dst[i] += value;
+    }
+#endif
+}
+
+//Mode A: direction += (radial + tangential + gravity) * dt, position += direction * posDt
+static void particleIntegrateGravity(ParticleData& data, const Point& gravity, float dt, float posDt, int count)
+{
+    float* posx = data.posx;
+    float* posy = data.posy;
+    float* dirX = data.modeA.dirX;
+    float* dirY = data.modeA.dirY;
+    const float* radialAccel = data.modeA.radialAccel;
+    const float* tangentialAccel = data.modeA.tangentialAccel;
+
+#if CC_PARTICLE_USE_SSE2
+    const __m128 gx = _mm_set1_ps(gravity.x);
+    const __m128 gy = _mm_set1_ps(gravity.y);
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 vposDt = _mm_set1_ps(posDt);
+    const __m128 zero = _mm_setzero_ps();
+    for (int i = 0; i < count; i += 4)
+    {
+        __m128 px = _mm_load_ps(posx + i);
+        __m128 py = _mm_load_ps(posy + i);
+
+        // radial direction, zero for particles at the origin
+        __m128 len2 = _mm_add_ps(_mm_mul_ps(px, px), _mm_mul_ps(py, py));
+        __m128 nonZero = _mm_cmpgt_ps(len2, zero);
+        __m128 len = _mm_sqrt_ps(len2);
+        __m128 rx = _mm_and_ps(nonZero, _mm_div_ps(px, len));
+        __m128 ry = _mm_and_ps(nonZero, _mm_div_ps(py, len));
+
+        __m128 radial = _mm_load_ps(radialAccel + i);
+        __m128 tangential = _mm_load_ps(tangentialAccel + i);
+        __m128 ax = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rx, radial), _mm_mul_ps(ry, tangential)), gx);
+        __m128 ay = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ry, radial), _mm_mul_ps(rx, tangential)), gy);
+
+        __m128 dx = _mm_add_ps(_mm_load_ps(dirX + i), _mm_mul_ps(ax, vdt));
+        __m128 dy = _mm_add_ps(_mm_load_ps(dirY + i), _mm_mul_ps(ay, vdt));
+        _mm_store_ps(dirX + i, dx);
+        _mm_store_ps(dirY + i, dy);
+
+        _mm_store_ps(posx + i, _mm_add_ps(px, _mm_mul_ps(dx, vposDt)));
+        _mm_store_ps(posy + i, _mm_add_ps(py, _mm_mul_ps(dy, vposDt)));
+    }
+#elif CC_PARTICLE_USE_NEON
+    const float32x4_t gx = vdupq_n_f32(gravity.x);
+    const float32x4_t gy = vdupq_n_f32(gravity.y);
+    const float32x4_t vdt = vdupq_n_f32(dt);
+    const float32x4_t vposDt = vdupq_n_f32(posDt);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    for (int i = 0; i < count; i += 4)
+    {
+        float32x4_t px = vld1q_f32(posx + i);
+        float32x4_t py = vld1q_f32(posy + i);
+
+        // radial direction, zero for particles at the origin.
+        // No division on ARMv7 NEON: reciprocal square root estimate refined by 2 Newton-Raphson steps
+        float32x4_t len2 = vmlaq_f32(vmulq_f32(px, px), py, py);
+        uint32x4_t nonZero = vcgtq_f32(len2, zero);
+        float32x4_t invLen = vrsqrteq_f32(len2);
+        invLen = vmulq_f32(invLen, vrsqrtsq_f32(vmulq_f32(len2, invLen), invLen));
+        invLen = vmulq_f32(invLen, vrsqrtsq_f32(vmulq_f32(len2, invLen), invLen));
+        float32x4_t rx = vreinterpretq_f32_u32(vandq_u32(nonZero, vreinterpretq_u32_f32(vmulq_f32(px, invLen))));
+        float32x4_t ry = vreinterpretq_f32_u32(vandq_u32(nonZero, vreinterpretq_u32_f32(vmulq_f32(py, invLen))));
+
+        float32x4_t radial = vld1q_f32(radialAccel + i);
+        float32x4_t tangential = vld1q_f32(tangentialAccel + i);
+        float32x4_t ax = vaddq_f32(vmlsq_f32(vmulq_f32(rx, radial), ry, tangential), gx);
+        float32x4_t ay = vaddq_f32(vmlaq_f32(vmulq_f32(ry, radial), rx, tangential), gy);
+
+        float32x4_t dx = vmlaq_f32(vld1q_f32(dirX + i), ax, vdt);
+        float32x4_t dy = vmlaq_f32(vld1q_f32(dirY + i), ay, vdt);
+        vst1q_f32(dirX + i, dx);
+        vst1q_f32(dirY + i, dy);
+
+        vst1q_f32(posx + i, vmlaq_f32(px, dx, vposDt));
+        vst1q_f32(posy + i, vmlaq_f32(py, dy, vposDt));
+    }
+#else
+    for (int i = 0; i < count; ++i)
+    {
+        Point radial = Point::ZERO;
+        // radial acceleration
+        if (posx[i] || posy[i])
+        {
+            radial = Point(posx[i], posy[i]).normalize();
+        }
+        // tangential acceleration
+        Point tangential(-radial.y, radial.x);
+        radial = radial * radialAccel[i];
+        tangential = tangential * tangentialAccel[i];
+
+        // (gravity + radial + tangential) * dt
+        Point tmp = (radial + tangential + gravity) * dt;
+        dirX[i] += tmp.x;
+        dirY[i] += tmp.y;
+
+        posx[i] += dirX[i] * posDt;
+        posy[i] += dirY[i] * posDt;
+    }
+#endif
+}
+
 // ideas taken from:
 //     . The ocean spray in your face [Jeff Lander]
 //        http://www.double.co.nz/dust/col0798.pdf
@@ -86,10 +350,8 @@ ParticleSystem::ParticleSystem()
 , _isAutoRemoveOnFinish(false)
 , _plistFile("")
 , _elapsed(0)
-, _particles(nullptr)
 , _configName("")
 , _emitCounter(0)
-, _particleIdx(0)
 , _batchNode(nullptr)
 , _atlasIndex(0)
 , _transformSystemDirty(false)
@@ -426,11 +688,7 @@ bool ParticleSystem::initWithTotalParticles(int numberOfParticles)
 {
     _totalParticles = numberOfParticles;
 
-    CC_SAFE_FREE(_particles);
-    
-    _particles = (tParticle*)calloc(_totalParticles, sizeof(tParticle));
-
-    if( ! _particles )
+    if( ! _particleData.init(_totalParticles) )
     {
         CCLOG("Particle system: not enough memory");
         this->release();
@@ -442,7 +700,7 @@ bool ParticleSystem::initWithTotalParticles(int numberOfParticles)
     {
         for (int i = 0; i < _totalParticles; i++)
         {
-            _particles[i].atlasIndex=i;
+            _particleData.atlasIndex[i]=i;
         }
     }
     // default, active
@@ -479,7 +737,7 @@ ParticleSystem::~ParticleSystem()
     // Since the scheduler retains the "target (in this case the ParticleSystem)
 	// it is not needed to call "unscheduleUpdate" here. In fact, it will be called in "cleanup"
     //unscheduleUpdate();
-    CC_SAFE_FREE(_particles);
+    _particleData.release();
     CC_SAFE_RELEASE(_texture);
 }
 
@@ -490,123 +748,163 @@ bool ParticleSystem::addParticle()
         return false;
     }
 
-    tParticle * particle = &_particles[ _particleCount ];
-    this->initParticle(particle);
-    ++_particleCount;
+    this->addParticles(1);
 
     return true;
 }
 
-void ParticleSystem::initParticle(tParticle* particle)
+void ParticleSystem::addParticles(int count)
 {
+    count = MIN(count, _totalParticles - _particleCount);
+    if (count <= 0)
+    {
+        return;
+    }
+
+    //the new particles are initialized value by value
+    int start = _particleCount;
+    int end = start + count;
+    ParticleData& data = _particleData;
+
     // timeToLive
     // no negative life. prevent division by 0
-    particle->timeToLive = _life + _lifeVar * CCRANDOM_MINUS1_1();
-    particle->timeToLive = MAX(0, particle->timeToLive);
+    for (int i = start; i < end; ++i)
+    {
+        data.timeToLive[i] = MAX(0, _life + _lifeVar * CCRANDOM_MINUS1_1());
+    }
 
     // position
-    particle->pos.x = _sourcePosition.x + _posVar.x * CCRANDOM_MINUS1_1();
-
-    particle->pos.y = _sourcePosition.y + _posVar.y * CCRANDOM_MINUS1_1();
-
-
-    // Color
-    Color4F start;
-    start.r = clampf(_startColor.r + _startColorVar.r * CCRANDOM_MINUS1_1(), 0, 1);
-    start.g = clampf(_startColor.g + _startColorVar.g * CCRANDOM_MINUS1_1(), 0, 1);
-    start.b = clampf(_startColor.b + _startColorVar.b * CCRANDOM_MINUS1_1(), 0, 1);
-    start.a = clampf(_startColor.a + _startColorVar.a * CCRANDOM_MINUS1_1(), 0, 1);
-
-    Color4F end;
-    end.r = clampf(_endColor.r + _endColorVar.r * CCRANDOM_MINUS1_1(), 0, 1);
-    end.g = clampf(_endColor.g + _endColorVar.g * CCRANDOM_MINUS1_1(), 0, 1);
-    end.b = clampf(_endColor.b + _endColorVar.b * CCRANDOM_MINUS1_1(), 0, 1);
-    end.a = clampf(_endColor.a + _endColorVar.a * CCRANDOM_MINUS1_1(), 0, 1);
+    for (int i = start; i < end; ++i)
+    {
+        data.posx[i] = _sourcePosition.x + _posVar.x * CCRANDOM_MINUS1_1();
+        data.posy[i] = _sourcePosition.y + _posVar.y * CCRANDOM_MINUS1_1();
+    }
 
-    particle->color = start;
-    particle->deltaColor.r = (end.r - start.r) / particle->timeToLive;
-    particle->deltaColor.g = (end.g - start.g) / particle->timeToLive;
-    particle->deltaColor.b = (end.b - start.b) / particle->timeToLive;
-    particle->deltaColor.a = (end.a - start.a) / particle->timeToLive;
+    // color
+    const float startColor[4] = { _startColor.r, _startColor.g, _startColor.b, _startColor.a };
+    const float startColorVar[4] = { _startColorVar.r, _startColorVar.g, _startColorVar.b, _startColorVar.a };
+    const float endColor[4] = { _endColor.r, _endColor.g, _endColor.b, _endColor.a };
+    const float endColorVar[4] = { _endColorVar.r, _endColorVar.g, _endColorVar.b, _endColorVar.a };
+    float* colors[4] = { data.colorR, data.colorG, data.colorB, data.colorA };
+    float* deltaColors[4] = { data.deltaColorR, data.deltaColorG, data.deltaColorB, data.deltaColorA };
+    for (int c = 0; c < 4; ++c)
+    {
+        float* color = colors[c];
+        float* deltaColor = deltaColors[c];
+        for (int i = start; i < end; ++i)
+        {
+            color[i] = clampf(startColor[c] + startColorVar[c] * CCRANDOM_MINUS1_1(), 0, 1);
+            float endValue = clampf(endColor[c] + endColorVar[c] * CCRANDOM_MINUS1_1(), 0, 1);
+            deltaColor[i] = (endValue - color[i]) / data.timeToLive[i];
+        }
+    }
 
     // size
-    float startS = _startSize + _startSizeVar * CCRANDOM_MINUS1_1();
-    startS = MAX(0, startS); // No negative value
-
-    particle->size = startS;
-
+    for (int i = start; i < end; ++i)
+    {
+        data.size[i] = MAX(0, _startSize + _startSizeVar * CCRANDOM_MINUS1_1()); // No negative value
+    }
     if (_endSize == START_SIZE_EQUAL_TO_END_SIZE)
     {
-        particle->deltaSize = 0;
+        for (int i = start; i < end; ++i)
+        {
+            data.deltaSize[i] = 0;
+        }
     }
     else
     {
-        float endS = _endSize + _endSizeVar * CCRANDOM_MINUS1_1();
-        endS = MAX(0, endS); // No negative values
-        particle->deltaSize = (endS - startS) / particle->timeToLive;
+        for (int i = start; i < end; ++i)
+        {
+            float endS = MAX(0, _endSize + _endSizeVar * CCRANDOM_MINUS1_1()); // No negative values
+            data.deltaSize[i] = (endS - data.size[i]) / data.timeToLive[i];
+        }
     }
 
     // rotation
-    float startA = _startSpin + _startSpinVar * CCRANDOM_MINUS1_1();
-    float endA = _endSpin + _endSpinVar * CCRANDOM_MINUS1_1();
-    particle->rotation = startA;
-    particle->deltaRotation = (endA - startA) / particle->timeToLive;
+    for (int i = start; i < end; ++i)
+    {
+        float startA = _startSpin + _startSpinVar * CCRANDOM_MINUS1_1();
+        float endA = _endSpin + _endSpinVar * CCRANDOM_MINUS1_1();
+        data.rotation[i] = startA;
+        data.deltaRotation[i] = (endA - startA) / data.timeToLive[i];
+    }
 
     // position
+    Point startPos = Point::ZERO;
     if (_positionType == PositionType::FREE)
     {
-        particle->startPos = this->convertToWorldSpace(Point::ZERO);
+        startPos = this->convertToWorldSpace(Point::ZERO);
     }
     else if (_positionType == PositionType::RELATIVE)
     {
-        particle->startPos = _position;
+        startPos = _position;
+    }
+    for (int i = start; i < end; ++i)
+    {
+        data.startPosX[i] = startPos.x;
+        data.startPosY[i] = startPos.y;
     }
-
-    // direction
-    float a = CC_DEGREES_TO_RADIANS( _angle + _angleVar * CCRANDOM_MINUS1_1() );    
 
     // Mode Gravity: A
     if (_emitterMode == Mode::GRAVITY)
     {
-        Point v(cosf( a ), sinf( a ));
-        float s = modeA.speed + modeA.speedVar * CCRANDOM_MINUS1_1();
-
-        // direction
-        particle->modeA.dir = v * s ;
+        for (int i = start; i < end; ++i)
+        {
+            // direction
+            float a = CC_DEGREES_TO_RADIANS( _angle + _angleVar * CCRANDOM_MINUS1_1() );
+            float s = modeA.speed + modeA.speedVar * CCRANDOM_MINUS1_1();
+            data.modeA.dirX[i] = cosf( a ) * s;
+            data.modeA.dirY[i] = sinf( a ) * s;
+
+            // rotation is dir
+            if (modeA.rotationIsDir)
+            {
+                data.rotation[i] = -CC_RADIANS_TO_DEGREES(Point(data.modeA.dirX[i], data.modeA.dirY[i]).getAngle());
+            }
+        }
 
         // radial accel
-        particle->modeA.radialAccel = modeA.radialAccel + modeA.radialAccelVar * CCRANDOM_MINUS1_1();
- 
+        for (int i = start; i < end; ++i)
+        {
+            data.modeA.radialAccel[i] = modeA.radialAccel + modeA.radialAccelVar * CCRANDOM_MINUS1_1();
+        }
 
         // tangential accel
-        particle->modeA.tangentialAccel = modeA.tangentialAccel + modeA.tangentialAccelVar * CCRANDOM_MINUS1_1();
-
-        // rotation is dir
-        if(modeA.rotationIsDir)
-            particle->rotation = -CC_RADIANS_TO_DEGREES(particle->modeA.dir.getAngle());
+        for (int i = start; i < end; ++i)
+        {
+            data.modeA.tangentialAccel[i] = modeA.tangentialAccel + modeA.tangentialAccelVar * CCRANDOM_MINUS1_1();
+        }
     }
 
     // Mode Radius: B
-    else 
+    else
     {
         // Set the default diameter of the particle from the source position
-        float startRadius = modeB.startRadius + modeB.startRadiusVar * CCRANDOM_MINUS1_1();
-        float endRadius = modeB.endRadius + modeB.endRadiusVar * CCRANDOM_MINUS1_1();
+        for (int i = start; i < end; ++i)
+        {
+            float startRadius = modeB.startRadius + modeB.startRadiusVar * CCRANDOM_MINUS1_1();
+            float endRadius = modeB.endRadius + modeB.endRadiusVar * CCRANDOM_MINUS1_1();
 
-        particle->modeB.radius = startRadius;
+            data.modeB.radius[i] = startRadius;
 
-        if (modeB.endRadius == START_RADIUS_EQUAL_TO_END_RADIUS)
-        {
-            particle->modeB.deltaRadius = 0;
+            if (modeB.endRadius == START_RADIUS_EQUAL_TO_END_RADIUS)
+            {
+                data.modeB.deltaRadius[i] = 0;
+            }
+            else
+            {
+                data.modeB.deltaRadius[i] = (endRadius - startRadius) / data.timeToLive[i];
+            }
         }
-        else
+
+        for (int i = start; i < end; ++i)
         {
-            particle->modeB.deltaRadius = (endRadius - startRadius) / particle->timeToLive;
+            data.modeB.angle[i] = CC_DEGREES_TO_RADIANS( _angle + _angleVar * CCRANDOM_MINUS1_1() );
+            data.modeB.degreesPerSecond[i] = CC_DEGREES_TO_RADIANS(modeB.rotatePerSecond + modeB.rotatePerSecondVar * CCRANDOM_MINUS1_1());
         }
+    }
 
-        particle->modeB.angle = a;
-        particle->modeB.degreesPerSecond = CC_DEGREES_TO_RADIANS(modeB.rotatePerSecond + modeB.rotatePerSecondVar * CCRANDOM_MINUS1_1());
-    }    
+    _particleCount = end;
 }
 
 void ParticleSystem::stopSystem()
@@ -620,10 +918,9 @@ void ParticleSystem::resetSystem()
 {
     _isActive = true;
     _elapsed = 0;
-    for (_particleIdx = 0; _particleIdx < _particleCount; ++_particleIdx)
+    for (int i = 0; i < _particleCount; ++i)
     {
-        tParticle *p = &_particles[_particleIdx];
-        p->timeToLive = 0;
+        _particleData.timeToLive[i] = 0;
     }
 }
 bool ParticleSystem::isFull()
@@ -645,11 +942,14 @@ void ParticleSystem::update(float dt)
             _emitCounter += dt;
         }
         
-        while (_particleCount < _totalParticles && _emitCounter > rate) 
+        //emit the particles of the frame at once, they are initialized value by value
+        int emitCount = 0;
+        while (_particleCount + emitCount < _totalParticles && _emitCounter > rate) 
         {
-            this->addParticle();
+            ++emitCount;
             _emitCounter -= rate;
         }
+        this->addParticles(emitCount);
 
         _elapsed += dt;
         if (_duration != -1 && _duration < _elapsed)
@@ -658,157 +958,94 @@ void ParticleSystem::update(float dt)
         }
     }
 
-    _particleIdx = 0;
-
-    Point currentPosition = Point::ZERO;
-    if (_positionType == PositionType::FREE)
-    {
-        currentPosition = this->convertToWorldSpace(Point::ZERO);
-    }
-    else if (_positionType == PositionType::RELATIVE)
-    {
-        currentPosition = _position;
-    }
-
     if (_visible)
     {
-        while (_particleIdx < _particleCount)
-        {
-            tParticle *p = &_particles[_particleIdx];
+        ParticleData& data = _particleData;
 
-            // life
-            p->timeToLive -= dt;
+        // life
+        particleAdd(data.timeToLive, -dt, _particleCount);
 
-            if (p->timeToLive > 0) 
+        // remove the dead particles, the last particle takes the place of a dead one
+        bool removed = false;
+        for (int i = 0; i < _particleCount; )
+        {
+            if (data.timeToLive[i] > 0)
             {
-                // Mode A: gravity, direction, tangential accel & radial accel
-                if (_emitterMode == Mode::GRAVITY)
-                {
-                    Point tmp, radial, tangential;
-
-                    radial = Point::ZERO;
-                    // radial acceleration
-                    if (p->pos.x || p->pos.y)
-                    {
-                        radial = p->pos.normalize();
-                    }
-                    tangential = radial;
-                    radial = radial * p->modeA.radialAccel;
-
-                    // tangential acceleration
-                    float newy = tangential.x;
-                    tangential.x = -tangential.y;
-                    tangential.y = newy;
-                    tangential = tangential * p->modeA.tangentialAccel;
-
-                    // (gravity + radial + tangential) * dt
-                    tmp = radial + tangential + modeA.gravity;
-                    tmp = tmp * dt;
-                    p->modeA.dir = p->modeA.dir + tmp;
-					if (_configName.length()>0)
-					{
-						if (_yCoordFlipped == -1)
-						{
-							 tmp = p->modeA.dir * dt;
-						}
-						else
-						{
-							 tmp = p->modeA.dir * -dt;
-						}
-					}
-					else
-					{
-						 tmp = p->modeA.dir * dt;
-					}
-                    p->pos = p->pos + tmp;
-                }
-
-                // Mode B: radius movement
-                else 
-                {                
-                    // Update the angle and radius of the particle.
-                    p->modeB.angle += p->modeB.degreesPerSecond * dt;
-                    p->modeB.radius += p->modeB.deltaRadius * dt;
-
-                    p->pos.x = - cosf(p->modeB.angle) * p->modeB.radius;
-                    p->pos.y = - sinf(p->modeB.angle) * p->modeB.radius;
-                    if (_yCoordFlipped == 1)
-                    {
-                      p->pos.y = -p->pos.y;
-                    }
-				}
-
-                // color
-                p->color.r += (p->deltaColor.r * dt);
-                p->color.g += (p->deltaColor.g * dt);
-                p->color.b += (p->deltaColor.b * dt);
-                p->color.a += (p->deltaColor.a * dt);
+                ++i;
+                continue;
+            }
 
-                // size
-                p->size += (p->deltaSize * dt);
-                p->size = MAX( 0, p->size );
+            int last = _particleCount - 1;
+            unsigned int currentIndex = data.atlasIndex[i];
+            if( i != last )
+            {
+                data.copyParticle(i, last);
+            }
+            if (_batchNode)
+            {
+                //disable the switched particle
+                _batchNode->disableParticle(_atlasIndex+currentIndex);
 
-                // angle
-                p->rotation += (p->deltaRotation * dt);
+                //switch indexes
+                data.atlasIndex[last] = currentIndex;
+            }
 
-                //
-                // update values in quad
-                //
+            --_particleCount;
+            removed = true;
+        }
 
-                Point    newPos;
+        if( removed && _particleCount == 0 && _isAutoRemoveOnFinish )
+        {
+            this->unscheduleUpdate();
+            _parent->removeChild(this, true);
+            return;
+        }
 
-                if (_positionType == PositionType::FREE || _positionType == PositionType::RELATIVE)
-                {
-                    Point diff = currentPosition - p->startPos;
-                    newPos = p->pos - diff;
-                } 
-                else
-                {
-                    newPos = p->pos;
-                }
+        int count = _particleCount;
 
-                // translate newPos to correct position, since matrix transform isn't performed in batchnode
-                // don't update the particle with the new position information, it will interfere with the radius and tangential calculations
-                if (_batchNode)
-                {
-                    newPos.x+=_position.x;
-                    newPos.y+=_position.y;
-                }
+        // Mode A: gravity, direction, tangential accel & radial accel
+        if (_emitterMode == Mode::GRAVITY)
+        {
+            float posDt = dt;
+            if (_configName.length()>0 && _yCoordFlipped != -1)
+            {
+                posDt = -dt;
+            }
+            particleIntegrateGravity(data, modeA.gravity, dt, posDt, count);
+        }
 
-                updateQuadWithParticle(p, newPos);
-                //updateParticleImp(self, updateParticleSel, p, newPos);
+        // Mode B: radius movement
+        else
+        {
+            // Update the angle and radius of the particle.
+            particleMulAdd(data.modeB.angle, data.modeB.degreesPerSecond, dt, count);
+            particleMulAdd(data.modeB.radius, data.modeB.deltaRadius, dt, count);
 
-                // update particle counter
-                ++_particleIdx;
-            } 
-            else 
+            const float flipY = (_yCoordFlipped == 1) ? 1.0f : -1.0f;
+            for (int i = 0; i < count; ++i)
             {
-                // life < 0
-                int currentIndex = p->atlasIndex;
-                if( _particleIdx != _particleCount-1 )
-                {
-                    _particles[_particleIdx] = _particles[_particleCount-1];
-                }
-                if (_batchNode)
-                {
-                    //disable the switched particle
-                    _batchNode->disableParticle(_atlasIndex+currentIndex);
+                data.posx[i] = - cosf(data.modeB.angle[i]) * data.modeB.radius[i];
+                data.posy[i] = flipY * sinf(data.modeB.angle[i]) * data.modeB.radius[i];
+            }
+        }
 
-                    //switch indexes
-                    _particles[_particleCount-1].atlasIndex = currentIndex;
-                }
+        // color
+        particleMulAdd(data.colorR, data.deltaColorR, dt, count);
+        particleMulAdd(data.colorG, data.deltaColorG, dt, count);
+        particleMulAdd(data.colorB, data.deltaColorB, dt, count);
+        particleMulAdd(data.colorA, data.deltaColorA, dt, count);
 
+        // size
+        particleMulAddPositive(data.size, data.deltaSize, dt, count);
 
-                --_particleCount;
+        // angle
+        particleMulAdd(data.rotation, data.deltaRotation, dt, count);
+
+        //
+        // update values in quads
+        //
+        updateParticleQuads();
 
-                if( _particleCount == 0 && _isAutoRemoveOnFinish )
-                {
-                    this->unscheduleUpdate();
-                    _parent->removeChild(this, true);
-                    return;
-                }
-            }
-        } //while
         _transformSystemDirty = false;
     }
     if (! _batchNode)
@@ -824,10 +1061,8 @@ void ParticleSystem::updateWithNoTime(void)
     this->update(0.0f);
 }
 
-void ParticleSystem::updateQuadWithParticle(tParticle* particle, const Point& newPosition)
+void ParticleSystem::updateParticleQuads()
 {
-    CC_UNUSED_PARAM(particle);
-    CC_UNUSED_PARAM(newPosition);
     // should be overridden
 }
 
@@ -1125,7 +1360,7 @@ void ParticleSystem::setBatchNode(ParticleBatchNode* batchNode)
             //each particle needs a unique index
             for (int i = 0; i < _totalParticles; i++)
             {
-                _particles[i].atlasIndex=i;
+                _particleData.atlasIndex[i]=i;
             }
         }
     }
@@ -42,43 +42,78 @@ NS_CC_BEGIN
 class ParticleBatchNode;
 
 /**
-Structure that contains the values of each particle
+Structure of arrays that contains the values of the particles.
+
+Every value has its own array, so the particle system processes each value as a
+contiguous stream. The arrays are allocated in a single block, aligned to 16 bytes
+and padded to a multiple of 4 particles, so they can be processed 4 particles at a time.
+@since v3.0
 */
-typedef struct sParticle {
-    Point     pos;
-    Point     startPos;
+class CC_DLL ParticleData
+{
+public:
+    float* posx;
+    float* posy;
+    float* startPosX;
+    float* startPosY;
 
-    Color4F    color;
-    Color4F    deltaColor;
+    float* colorR;
+    float* colorG;
+    float* colorB;
+    float* colorA;
 
-    float        size;
-    float        deltaSize;
+    float* deltaColorR;
+    float* deltaColorG;
+    float* deltaColorB;
+    float* deltaColorA;
 
-    float        rotation;
-    float        deltaRotation;
+    float* size;
+    float* deltaSize;
 
-    float        timeToLive;
+    float* rotation;
+    float* deltaRotation;
 
-    unsigned int    atlasIndex;
+    float* timeToLive;
+
+    unsigned int* atlasIndex;
 
     //! Mode A: gravity, direction, radial accel, tangential accel
     struct {
-        Point        dir;
-        float        radialAccel;
-        float        tangentialAccel;
+        float* dirX;
+        float* dirY;
+        float* radialAccel;
+        float* tangentialAccel;
     } modeA;
 
     //! Mode B: radius mode
     struct {
-        float        angle;
-        float        degreesPerSecond;
-        float        radius;
-        float        deltaRadius;
+        float* angle;
+        float* degreesPerSecond;
+        float* radius;
+        float* deltaRadius;
     } modeB;
 
-}tParticle;
+    ParticleData();
+    ~ParticleData();
+
+    /** Allocates zeroed storage for `count` particles. The previous content is discarded */
+    bool init(int count);
+    /** Frees the storage */
+    void release();
+
+    inline unsigned int getMaxCount() const { return _maxCount; }
 
-//typedef void (*CC_UPDATE_PARTICLE_IMP)(id, SEL, tParticle*, Point);
+    /** Copies all the values of the particle `src` to the particle `dst` */
+    void copyParticle(int dst, int src);
+
+private:
+    void* _block;
+    unsigned int _maxCount;
+    // number of elements allocated for every array
+    unsigned int _stride;
+
+    CC_DISALLOW_COPY_AND_ASSIGN(ParticleData);
+};
 
 class Texture2D;
 
@@ -175,8 +210,8 @@ public:
 
     //! Add a particle to the emitter
     bool addParticle();
-    //! Initializes a particle
-    void initParticle(tParticle* particle);
+    //! Add `count` particles to the emitter, if there is room for them
+    void addParticles(int count);
     //! stop emitting particles. Running particles will continue to run until they die
     void stopSystem();
     //! Kill all living particles.
@@ -184,8 +219,8 @@ public:
     //! whether or not the system is full
     bool isFull();
 
-    //! should be overridden by subclasses
-    virtual void updateQuadWithParticle(tParticle* particle, const Point& newPosition);
+    //! Updates the quads of the living particles. Should be overridden by subclasses
+    virtual void updateParticleQuads();
     //! should be overridden by subclasses
     virtual void postStep();
 
@@ -455,8 +490,8 @@ protected:
         float rotatePerSecondVar;
     } modeB;
 
-    //! Array of particles
-    tParticle *_particles;
+    //! Values of the particles
+    ParticleData _particleData;
 
     //Emitter name
     std::string _configName;
@@ -467,9 +502,6 @@ protected:
     //! How many particles can be emitted per second
     float _emitCounter;
 
-    //!  particle idx
-    int _particleIdx;
-
     // Optimization
     //CC_UPDATE_PARTICLE_IMP    updateParticleImp;
     //SEL                        updateParticleSel;
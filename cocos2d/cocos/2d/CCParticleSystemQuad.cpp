@@ -47,8 +47,119 @@ THE SOFTWARE.
 #include "CCEventListenerCustom.h"
 #include "CCEventDispatcher.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CC_PARTICLE_USE_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define CC_PARTICLE_USE_NEON 1
+#include <arm_neon.h>
+#endif
+
 NS_CC_BEGIN
 
+// Vertices and colors of the quads of 4 consecutive particles
+struct ParticleQuadBlock
+{
+    // [corner][particle], corners in bottom-left, bottom-right, top-left, top-right order
+    float x[4][4];
+    float y[4][4];
+    // [channel][particle], r g b a in 0..255
+    int color[4][4];
+};
+
+//Computes the quads of the particles [first, first + 4).
+//newPos = pos + startPos * startScale + offset, the corners are rotated by (cr, sr)
+static void computeParticleQuadBlock(const ParticleData& data, int first, const float* cr, const float* sr,
+                                     float startScale, const Point& offset, bool premultiply, ParticleQuadBlock& block)
+{
+#if CC_PARTICLE_USE_SSE2
+    const __m128 scale = _mm_set1_ps(startScale);
+    __m128 x = _mm_add_ps(_mm_add_ps(_mm_load_ps(data.posx + first), _mm_mul_ps(_mm_load_ps(data.startPosX + first), scale)), _mm_set1_ps(offset.x));
+    __m128 y = _mm_add_ps(_mm_add_ps(_mm_load_ps(data.posy + first), _mm_mul_ps(_mm_load_ps(data.startPosY + first), scale)), _mm_set1_ps(offset.y));
+
+    __m128 size_2 = _mm_mul_ps(_mm_load_ps(data.size + first), _mm_set1_ps(0.5f));
+    __m128 hc = _mm_mul_ps(size_2, _mm_loadu_ps(cr));
+    __m128 hs = _mm_mul_ps(size_2, _mm_loadu_ps(sr));
+
+    _mm_storeu_ps(block.x[0], _mm_add_ps(_mm_sub_ps(x, hc), hs));
+    _mm_storeu_ps(block.y[0], _mm_sub_ps(_mm_sub_ps(y, hs), hc));
+    _mm_storeu_ps(block.x[1], _mm_add_ps(_mm_add_ps(x, hc), hs));
+    _mm_storeu_ps(block.y[1], _mm_sub_ps(_mm_add_ps(y, hs), hc));
+    _mm_storeu_ps(block.x[2], _mm_sub_ps(_mm_sub_ps(x, hc), hs));
+    _mm_storeu_ps(block.y[2], _mm_add_ps(_mm_sub_ps(y, hs), hc));
+    _mm_storeu_ps(block.x[3], _mm_sub_ps(_mm_add_ps(x, hc), hs));
+    _mm_storeu_ps(block.y[3], _mm_add_ps(_mm_add_ps(y, hs), hc));
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 max = _mm_set1_ps(255.0f);
+    __m128 a = _mm_mul_ps(_mm_load_ps(data.colorA + first), max);
+    __m128 rgbScale = premultiply ? _mm_load_ps(data.colorA + first) : _mm_set1_ps(1.0f);
+    rgbScale = _mm_mul_ps(rgbScale, max);
+    const float* channels[3] = { data.colorR, data.colorG, data.colorB };
+    for (int c = 0; c < 3; ++c)
+    {
+        __m128 v = _mm_mul_ps(_mm_load_ps(channels[c] + first), rgbScale);
+        _mm_storeu_si128((__m128i*)block.color[c], _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(v, zero), max)));
+    }
+    _mm_storeu_si128((__m128i*)block.color[3], _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(a, zero), max)));
+#elif CC_PARTICLE_USE_NEON
+    const float32x4_t scale = vdupq_n_f32(startScale);
+    float32x4_t x = vaddq_f32(vmlaq_f32(vld1q_f32(data.posx + first), vld1q_f32(data.startPosX + first), scale), vdupq_n_f32(offset.x));
+    float32x4_t y = vaddq_f32(vmlaq_f32(vld1q_f32(data.posy + first), vld1q_f32(data.startPosY + first), scale), vdupq_n_f32(offset.y));
+
+    float32x4_t size_2 = vmulq_n_f32(vld1q_f32(data.size + first), 0.5f);
+    float32x4_t hc = vmulq_f32(size_2, vld1q_f32(cr));
+    float32x4_t hs = vmulq_f32(size_2, vld1q_f32(sr));
+
+    vst1q_f32(block.x[0], vaddq_f32(vsubq_f32(x, hc), hs));
+    vst1q_f32(block.y[0], vsubq_f32(vsubq_f32(y, hs), hc));
+    vst1q_f32(block.x[1], vaddq_f32(vaddq_f32(x, hc), hs));
+    vst1q_f32(block.y[1], vsubq_f32(vaddq_f32(y, hs), hc));
+    vst1q_f32(block.x[2], vsubq_f32(vsubq_f32(x, hc), hs));
+    vst1q_f32(block.y[2], vaddq_f32(vsubq_f32(y, hs), hc));
+    vst1q_f32(block.x[3], vsubq_f32(vaddq_f32(x, hc), hs));
+    vst1q_f32(block.y[3], vaddq_f32(vaddq_f32(y, hs), hc));
+
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t max = vdupq_n_f32(255.0f);
+    float32x4_t a = vmulq_f32(vld1q_f32(data.colorA + first), max);
+    float32x4_t rgbScale = premultiply ? a : max;
+    const float* channels[3] = { data.colorR, data.colorG, data.colorB };
+    for (int c = 0; c < 3; ++c)
+    {
+        float32x4_t v = vmulq_f32(vld1q_f32(channels[c] + first), rgbScale);
+        vst1q_s32(block.color[c], vcvtq_s32_f32(vminq_f32(vmaxq_f32(v, zero), max)));
+    }
+    vst1q_s32(block.color[3], vcvtq_s32_f32(vminq_f32(vmaxq_f32(a, zero), max)));
+#else
+    for (int i = 0; i < 4; ++i)
+    {
+        int p = first + i;
+        float x = data.posx[p] + data.startPosX[p] * startScale + offset.x;
+        float y = data.posy[p] + data.startPosY[p] * startScale + offset.y;
+        float size_2 = data.size[p] * 0.5f;
+        float hc = size_2 * cr[i];
+        float hs = size_2 * sr[i];
+
+        block.x[0][i] = x - hc + hs;
+        block.y[0][i] = y - hs - hc;
+        block.x[1][i] = x + hc + hs;
+        block.y[1][i] = y + hs - hc;
+        block.x[2][i] = x - hc - hs;
+        block.y[2][i] = y - hs + hc;
+        block.x[3][i] = x + hc - hs;
+        block.y[3][i] = y + hs + hc;
+
+        float a = data.colorA[p] * 255;
+        float rgbScale = premultiply ? a : 255;
+        block.color[0][i] = (int)clampf(data.colorR[p] * rgbScale, 0, 255);
+        block.color[1][i] = (int)clampf(data.colorG[p] * rgbScale, 0, 255);
+        block.color[2][i] = (int)clampf(data.colorB[p] * rgbScale, 0, 255);
+        block.color[3][i] = (int)clampf(a, 0, 255);
+    }
+#endif
+}
+
 //implementation ParticleSystemQuad
 // overriding the init method
 bool ParticleSystemQuad::initWithTotalParticles(int numberOfParticles)
@@ -255,87 +366,84 @@ void ParticleSystemQuad::initIndices()
     }
 }
 
-void ParticleSystemQuad::updateQuadWithParticle(tParticle* particle, const Point& newPosition)
+void ParticleSystemQuad::updateParticleQuads()
 {
-    V3F_C4B_T2F_Quad *quad;
+    if (_particleCount <= 0)
+    {
+        return;
+    }
 
-    if (_batchNode)
+    Point currentPosition = Point::ZERO;
+    if (_positionType == PositionType::FREE)
     {
-        V3F_C4B_T2F_Quad *batchQuads = _batchNode->getTextureAtlas()->getQuads();
-        quad = &(batchQuads[_atlasIndex+particle->atlasIndex]);
+        currentPosition = this->convertToWorldSpace(Point::ZERO);
     }
-    else
+    else if (_positionType == PositionType::RELATIVE)
     {
-        quad = &(_quads[_particleIdx]);
+        currentPosition = _position;
     }
-    Color4B color = (_opacityModifyRGB)
-        ? Color4B( particle->color.r*particle->color.a*255, particle->color.g*particle->color.a*255, particle->color.b*particle->color.a*255, particle->color.a*255)
-        : Color4B( particle->color.r*255, particle->color.g*255, particle->color.b*255, particle->color.a*255);
 
-    quad->bl.colors = color;
-    quad->br.colors = color;
-    quad->tl.colors = color;
-    quad->tr.colors = color;
-
-    // vertices
-    GLfloat size_2 = particle->size/2;
-    if (particle->rotation) 
+    // free and relative particles: newPos = pos - (currentPosition - startPos)
+    // translate newPos to correct position, since matrix transform isn't performed in batchnode
+    float startScale = (_positionType == PositionType::FREE || _positionType == PositionType::RELATIVE) ? 1.0f : 0.0f;
+    Point offset = -currentPosition;
+    if (_batchNode)
     {
-        GLfloat x1 = -size_2;
-        GLfloat y1 = -size_2;
-
-        GLfloat x2 = size_2;
-        GLfloat y2 = size_2;
-        GLfloat x = newPosition.x;
-        GLfloat y = newPosition.y;
-
-        GLfloat r = (GLfloat)-CC_DEGREES_TO_RADIANS(particle->rotation);
-        GLfloat cr = cosf(r);
-        GLfloat sr = sinf(r);
-        GLfloat ax = x1 * cr - y1 * sr + x;
-        GLfloat ay = x1 * sr + y1 * cr + y;
-        GLfloat bx = x2 * cr - y1 * sr + x;
-        GLfloat by = x2 * sr + y1 * cr + y;
-        GLfloat cx = x2 * cr - y2 * sr + x;
-        GLfloat cy = x2 * sr + y2 * cr + y;
-        GLfloat dx = x1 * cr - y2 * sr + x;
-        GLfloat dy = x1 * sr + y2 * cr + y;
-
-        // bottom-left
-        quad->bl.vertices.x = ax;
-        quad->bl.vertices.y = ay;
-
-        // bottom-right vertex:
-        quad->br.vertices.x = bx;
-        quad->br.vertices.y = by;
+        offset = offset + _position;
+    }
 
-        // top-left vertex:
-        quad->tl.vertices.x = dx;
-        quad->tl.vertices.y = dy;
+    V3F_C4B_T2F_Quad *quads = _quads;
+    const unsigned int *atlasIndex = nullptr;
+    if (_batchNode)
+    {
+        quads = &(_batchNode->getTextureAtlas()->getQuads()[_atlasIndex]);
+        atlasIndex = _particleData.atlasIndex;
+    }
 
-        // top-right vertex:
-        quad->tr.vertices.x = cx;
-        quad->tr.vertices.y = cy;
-    } 
-    else 
+    ParticleQuadBlock block;
+    for (int first = 0; first < _particleCount; first += 4)
     {
-        // bottom-left vertex:
-        quad->bl.vertices.x = newPosition.x - size_2;
-        quad->bl.vertices.y = newPosition.y - size_2;
+        int n = MIN(4, _particleCount - first);
 
-        // bottom-right vertex:
-        quad->br.vertices.x = newPosition.x + size_2;
-        quad->br.vertices.y = newPosition.y - size_2;
+        //rotation of the corners, only non rotated particles skip the trigonometry
+        float cr[4] = { 1, 1, 1, 1 };
+        float sr[4] = { 0, 0, 0, 0 };
+        for (int i = 0; i < n; ++i)
+        {
+            float rotation = _particleData.rotation[first + i];
+            if (rotation)
+            {
+                float r = -CC_DEGREES_TO_RADIANS(rotation);
+                cr[i] = cosf(r);
+                sr[i] = sinf(r);
+            }
+        }
 
-        // top-left vertex:
-        quad->tl.vertices.x = newPosition.x - size_2;
-        quad->tl.vertices.y = newPosition.y + size_2;
+        computeParticleQuadBlock(_particleData, first, cr, sr, startScale, offset, _opacityModifyRGB, block);
 
-        // top-right vertex:
-        quad->tr.vertices.x = newPosition.x + size_2;
-        quad->tr.vertices.y = newPosition.y + size_2;                
+        for (int i = 0; i < n; ++i)
+        {
+            int p = first + i;
+            V3F_C4B_T2F_Quad *quad = atlasIndex ? &quads[atlasIndex[p]] : &quads[p];
+
+            Color4B color(block.color[0][i], block.color[1][i], block.color[2][i], block.color[3][i]);
+            quad->bl.colors = color;
+            quad->br.colors = color;
+            quad->tl.colors = color;
+            quad->tr.colors = color;
+
+            quad->bl.vertices.x = block.x[0][i];
+            quad->bl.vertices.y = block.y[0][i];
+            quad->br.vertices.x = block.x[1][i];
+            quad->br.vertices.y = block.y[1][i];
+            quad->tl.vertices.x = block.x[2][i];
+            quad->tl.vertices.y = block.y[2][i];
+            quad->tr.vertices.x = block.x[3][i];
+            quad->tr.vertices.y = block.y[3][i];
+        }
     }
 }
+
 void ParticleSystemQuad::postStep()
 {
     glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
@@ -360,11 +468,10 @@ void ParticleSystemQuad::postStep()
 // overriding draw method
 void ParticleSystemQuad::draw(Renderer *renderer, const kmMat4 &transform, bool transformUpdated)
 {
-    CCASSERT( _particleIdx == _particleCount, "Abnormal error in particle quad");
     //quad command
-    if(_particleIdx > 0)
+    if(_particleCount > 0)
     {
-        _quadCommand.init(_globalZOrder, _texture->getName(), _shaderProgram, _blendFunc, _quads, _particleIdx, transform);
+        _quadCommand.init(_globalZOrder, _texture->getName(), _shaderProgram, _blendFunc, _quads, _particleCount, transform);
         renderer->addCommand(&_quadCommand);
     }
 }
@@ -376,23 +483,21 @@ void ParticleSystemQuad::setTotalParticles(int tp)
     if( tp > _allocatedParticles )
     {
         // Allocate new memory
-        size_t particlesSize = tp * sizeof(tParticle);
         size_t quadsSize = sizeof(_quads[0]) * tp * 1;
         size_t indicesSize = sizeof(_indices[0]) * tp * 6 * 1;
 
-        tParticle* particlesNew = (tParticle*)realloc(_particles, particlesSize);
+        // the particle data is cleared by init
+        bool particlesAllocated = _particleData.init(tp);
         V3F_C4B_T2F_Quad* quadsNew = (V3F_C4B_T2F_Quad*)realloc(_quads, quadsSize);
         GLushort* indicesNew = (GLushort*)realloc(_indices, indicesSize);
 
-        if (particlesNew && quadsNew && indicesNew)
+        if (particlesAllocated && quadsNew && indicesNew)
         {
             // Assign pointers
-            _particles = particlesNew;
             _quads = quadsNew;
             _indices = indicesNew;
 
             // Clear the memory
-            memset(_particles, 0, particlesSize);
             memset(_quads, 0, quadsSize);
             memset(_indices, 0, indicesSize);
             
@@ -401,7 +506,6 @@ void ParticleSystemQuad::setTotalParticles(int tp)
         else
         {
             // Out of memory, failed to resize some array
-            if (particlesNew) _particles = particlesNew;
             if (quadsNew) _quads = quadsNew;
             if (indicesNew) _indices = indicesNew;
 
@@ -416,7 +520,7 @@ void ParticleSystemQuad::setTotalParticles(int tp)
         {
             for (int i = 0; i < _totalParticles; i++)
             {
-                _particles[i].atlasIndex=i;
+                _particleData.atlasIndex[i]=i;
             }
         }
 
@@ -46,6 +46,7 @@ THE SOFTWARE.
 #include "kazmath/GL/matrix.h"
 #include "CCEventListenerCustom.h"
 #include "CCEventDispatcher.h"
+#include "platform/CCGLHeadless.h"
 
 NS_CC_BEGIN
 
@@ -421,10 +422,14 @@ bool RenderTexture::saveToFile(const std::string& fileName, Image::Format format
              "the image can only be saved as JPG or PNG format");
     
     std::string fullpath = FileUtils::getInstance()->getWritablePath() + fileName;
-    _saveToFileCommand.init(_globalZOrder);
-    _saveToFileCommand.func = CC_CALLBACK_0(RenderTexture::onSaveToFile,this,fullpath);
+
+    //Use a new command for each call, so that saving several files in the same frame saves all of them
+    Renderer *renderer = Director::getInstance()->getRenderer();
+    CustomCommand *saveToFileCommand = renderer->getFrameArena()->create<CustomCommand>();
+    saveToFileCommand->init(_globalZOrder);
+    saveToFileCommand->func = CC_CALLBACK_0(RenderTexture::onSaveToFile,this,fullpath);
     
-    Director::getInstance()->getRenderer()->addCommand(&_saveToFileCommand);
+    renderer->addCommand(saveToFileCommand);
     return true;
 }
 
@@ -214,7 +214,6 @@ protected:
     CustomCommand _clearCommand;
     CustomCommand _beginCommand;
     CustomCommand _endCommand;
-    CustomCommand _saveToFileCommand;
 protected:
     //renderer caches and callbacks
     void onBegin();
@@ -32,6 +32,10 @@ THE SOFTWARE.
 #include "ccCArray.h"
 #include "CCArray.h"
 #include "CCScriptSupport.h"
+#include "CCJobPool.h"
+
+#include <algorithm>
+#include <chrono>
 
 NS_CC_BEGIN
 
@@ -46,6 +50,9 @@ typedef struct _listEntry
     int                 priority;
     bool                paused;
     bool                markedForDeletion; // selector will no longer be called and entry will be removed at end of the next tick
+    bool                parallel;          // callback runs on the JobPool, applyCallback writes its results back
+    ccSchedulerFunc     applyCallback;
+    float               updateTime;        // duration of the last call in seconds, when timing is enabled
 } tListEntry;
 
 typedef struct _hashUpdateEntry
@@ -62,9 +69,6 @@ typedef struct _hashSelectorEntry
 {
     ccArray             *timers;
     void                *target;
-    int                 timerIndex;
-    Timer               *currentTimer;
-    bool                currentTimerSalvaged;
     bool                paused;
     UT_hash_handle      hh;
 } tHashTimerEntry;
@@ -80,6 +84,11 @@ Timer::Timer()
 , _repeat(0)
 , _delay(0.0f)
 , _interval(0.0f)
+, _startTime(0.0)
+, _queueSequence(0)
+, _queued(false)
+, _scheduled(false)
+, _paused(false)
 {
 }
 
@@ -146,6 +155,37 @@ void Timer::update(float dt)
     }
 }
 
+void Timer::fire(double now)
+{
+    _elapsed = (float)(now - _startTime);
+
+    if (_runForever && !_useDelay)
+    {//standard timer usage
+        trigger();
+
+        _startTime = now;
+    }
+    else
+    {//advanced usage
+        trigger();
+
+        if (_useDelay)
+        {
+            _startTime += _delay;
+            _useDelay = false;
+        }
+        else
+        {
+            _startTime = now;
+        }
+        _timesExecuted += 1;
+
+        if (!_runForever && _timesExecuted > _repeat)
+        {    //unschedule timer
+            cancel();
+        }
+    }
+}
 
 // TimerTargetSelector
 
@@ -252,9 +292,13 @@ Scheduler::Scheduler(void)
 , _updates0List(nullptr)
 , _updatesPosList(nullptr)
 , _hashForUpdates(nullptr)
+, _updateTimingEnabled(false)
+, _parallelUpdatesTime(0.0f)
+, _serialUpdatesTime(0.0f)
 , _hashForTimers(nullptr)
-, _currentTarget(nullptr)
-, _currentTargetSalvaged(false)
+, _timerClock(0.0)
+, _timerSequence(0)
+, _staleTimerEntries(0)
 , _updateHashLocked(false)
 #if CC_ENABLE_SCRIPT_BINDING
 , _scriptHandlerEntries(20)
@@ -267,6 +311,15 @@ Scheduler::Scheduler(void)
 Scheduler::~Scheduler(void)
 {
     unscheduleAll();
+
+    for (auto& entry : _timerQueue)
+    {
+        entry.timer->release();
+    }
+    for (auto timer : _timersToStart)
+    {
+        timer->release();
+    }
 }
 
 void Scheduler::removeHashElement(_hashSelectorEntry *element)
@@ -276,6 +329,170 @@ void Scheduler::removeHashElement(_hashSelectorEntry *element)
     free(element);
 }
 
+// timer queue
+
+bool Scheduler::laterTimer(const TimerQueueEntry& a, const TimerQueueEntry& b)
+{
+    //std heaps keep the greatest element on top, compare reversed to get the earliest fire time.
+    //The sequence keeps the timers due at the same time in scheduling order.
+    return a.fireTime > b.fireTime || (a.fireTime == b.fireTime && a.sequence > b.sequence);
+}
+
+void Scheduler::addTimer(tHashTimerEntry *element, Timer *timer)
+{
+    ccArrayAppendObject(element->timers, timer);
+
+    timer->_scheduled = true;
+    timer->_paused = element->paused;
+
+    // like the first Timer::update, the tick that follows only starts the timer
+    timer->retain();
+    _timersToStart.push_back(timer);
+}
+
+void Scheduler::removeTimer(Timer *timer)
+{
+    timer->_scheduled = false;
+    unqueueTimer(timer);
+}
+
+void Scheduler::queueTimer(Timer *timer)
+{
+    unqueueTimer(timer);
+
+    timer->retain();
+    timer->_queued = true;
+    timer->_queueSequence = ++_timerSequence;
+
+    TimerQueueEntry entry = { timer->getFireTime(), timer->_queueSequence, timer };
+    _timerQueue.push_back(entry);
+    std::push_heap(_timerQueue.begin(), _timerQueue.end(), laterTimer);
+}
+
+void Scheduler::unqueueTimer(Timer *timer)
+{
+    if (!timer->_queued)
+    {
+        return;
+    }
+
+    // the entry stays in the heap until it is popped or compacted
+    timer->_queued = false;
+    ++_staleTimerEntries;
+
+    if (_staleTimerEntries > 64 && _staleTimerEntries > _timerQueue.size() / 2)
+    {
+        compactTimerQueue();
+    }
+}
+
+void Scheduler::compactTimerQueue()
+{
+    auto last = std::remove_if(_timerQueue.begin(), _timerQueue.end(), [](const TimerQueueEntry& entry) {
+        if (!entry.timer->_queued || entry.timer->_queueSequence != entry.sequence)
+        {
+            entry.timer->release();
+            return true;
+        }
+        return false;
+    });
+    _timerQueue.erase(last, _timerQueue.end());
+    std::make_heap(_timerQueue.begin(), _timerQueue.end(), laterTimer);
+
+    _staleTimerEntries = 0;
+}
+
+void Scheduler::setTimersPaused(tHashTimerEntry *element, bool paused)
+{
+    if (element->paused == paused)
+    {
+        return;
+    }
+    element->paused = paused;
+
+    for (int i = 0; i < element->timers->num; ++i)
+    {
+        Timer *timer = static_cast<Timer*>(element->timers->arr[i]);
+        timer->_paused = paused;
+
+        // timers which haven't started yet are handled by updateTimers
+        if (timer->_elapsed == -1)
+        {
+            continue;
+        }
+
+        if (paused)
+        {
+            timer->_elapsed = (float)(_timerClock - timer->_startTime);
+            unqueueTimer(timer);
+        }
+        else
+        {
+            timer->_startTime = _timerClock - timer->_elapsed;
+            queueTimer(timer);
+        }
+    }
+}
+
+void Scheduler::updateTimers(float dt)
+{
+    _timerClock += dt;
+
+    while (!_timerQueue.empty() && _timerQueue.front().fireTime <= _timerClock)
+    {
+        std::pop_heap(_timerQueue.begin(), _timerQueue.end(), laterTimer);
+        TimerQueueEntry entry = _timerQueue.back();
+        _timerQueue.pop_back();
+
+        Timer *timer = entry.timer;
+        if (!timer->_queued || timer->_queueSequence != entry.sequence)
+        {
+            --_staleTimerEntries;
+            timer->release();
+            continue;
+        }
+
+        timer->_queued = false;
+        timer->fire(_timerClock);
+
+        if (timer->_scheduled && timer->_paused)
+        {
+            // paused by its own callback
+            timer->_elapsed = (float)(_timerClock - timer->_startTime);
+        }
+
+        // queued again once the due timers are processed, so a timer fires at most once per tick.
+        // The reference held by the popped entry is handed over.
+        _timersToQueue.push_back(timer);
+    }
+
+    for (auto timer : _timersToQueue)
+    {
+        if (timer->_scheduled && !timer->_paused)
+        {
+            queueTimer(timer);
+        }
+        timer->release();
+    }
+    _timersToQueue.clear();
+
+    // timers scheduled since the last tick start counting from now
+    for (auto timer : _timersToStart)
+    {
+        if (timer->_scheduled)
+        {
+            timer->_elapsed = 0;
+            timer->_startTime = _timerClock;
+            if (!timer->_paused)
+            {
+                queueTimer(timer);
+            }
+        }
+        timer->release();
+    }
+    _timersToStart.clear();
+}
+
 void Scheduler::schedule(const ccSchedulerFunc& callback, void *target, float interval, bool paused, const std::string& key)
 {
     this->schedule(callback, target, interval, kRepeatForever, 0.0f, paused, key);
@@ -318,6 +535,10 @@ void Scheduler::schedule(const ccSchedulerFunc& callback, void *target, float in
             {
                 CCLOG("CCScheduler#scheduleSelector. Selector already scheduled. Updating interval from: %.4f to %.4f", timer->getInterval(), interval);
                 timer->setInterval(interval);
+                if (timer->_queued)
+                {
+                    queueTimer(timer);
+                }
                 return;
             }        
         }
@@ -326,7 +547,7 @@ void Scheduler::schedule(const ccSchedulerFunc& callback, void *target, float in
 
     TimerTargetCallback *timer = new TimerTargetCallback();
     timer->initWithCallback(this, callback, target, key, interval, repeat, delay);
-    ccArrayAppendObject(element->timers, timer);
+    addTimer(element, timer);
     timer->release();
 }
 
@@ -352,30 +573,13 @@ void Scheduler::unschedule(const std::string &key, void *target)
 
             if (key == timer->getKey())
             {
-                if (timer == element->currentTimer && (! element->currentTimerSalvaged))
-                {
-                    element->currentTimer->retain();
-                    element->currentTimerSalvaged = true;
-                }
-
+                // a timer being fired stays alive: the timer queue retains it
+                removeTimer(timer);
                 ccArrayRemoveObjectAtIndex(element->timers, i, true);
 
-                // update timerIndex in case we are in tick:, looping over the actions
-                if (element->timerIndex >= i)
-                {
-                    element->timerIndex--;
-                }
-
                 if (element->timers->num == 0)
                 {
-                    if (_currentTarget == element)
-                    {
-                        _currentTargetSalvaged = true;
-                    }
-                    else
-                    {
-                        removeHashElement(element);
-                    }
+                    removeHashElement(element);
                 }
 
                 return;
@@ -384,7 +588,7 @@ void Scheduler::unschedule(const std::string &key, void *target)
     }
 }
 
-void Scheduler::priorityIn(tListEntry **list, const ccSchedulerFunc& callback, void *target, int priority, bool paused)
+void Scheduler::priorityIn(tListEntry **list, const ccSchedulerFunc& callback, void *target, int priority, bool paused, const ccSchedulerFunc& applyCallback)
 {
     tListEntry *listElement = new tListEntry();
 
@@ -394,6 +598,9 @@ void Scheduler::priorityIn(tListEntry **list, const ccSchedulerFunc& callback, v
     listElement->paused = paused;
     listElement->next = listElement->prev = nullptr;
     listElement->markedForDeletion = false;
+    listElement->parallel = (applyCallback != nullptr);
+    listElement->applyCallback = applyCallback;
+    listElement->updateTime = 0.0f;
 
     // empty list ?
     if (! *list)
@@ -441,7 +648,7 @@ void Scheduler::priorityIn(tListEntry **list, const ccSchedulerFunc& callback, v
     HASH_ADD_PTR(_hashForUpdates, target, hashElement);
 }
 
-void Scheduler::appendIn(_listEntry **list, const ccSchedulerFunc& callback, void *target, bool paused)
+void Scheduler::appendIn(_listEntry **list, const ccSchedulerFunc& callback, void *target, bool paused, const ccSchedulerFunc& applyCallback)
 {
     tListEntry *listElement = new tListEntry();
 
@@ -449,6 +656,9 @@ void Scheduler::appendIn(_listEntry **list, const ccSchedulerFunc& callback, voi
     listElement->target = target;
     listElement->paused = paused;
     listElement->markedForDeletion = false;
+    listElement->parallel = (applyCallback != nullptr);
+    listElement->applyCallback = applyCallback;
+    listElement->updateTime = 0.0f;
 
     DL_APPEND(*list, listElement);
 
@@ -460,7 +670,7 @@ void Scheduler::appendIn(_listEntry **list, const ccSchedulerFunc& callback, voi
     HASH_ADD_PTR(_hashForUpdates, target, hashElement);
 }
 
-void Scheduler::schedulePerFrame(const ccSchedulerFunc& callback, void *target, int priority, bool paused)
+void Scheduler::schedulePerFrame(const ccSchedulerFunc& callback, void *target, int priority, bool paused, const ccSchedulerFunc& applyCallback)
 {
     tHashUpdateEntry *hashElement = nullptr;
     HASH_FIND_PTR(_hashForUpdates, &target, hashElement);
@@ -472,6 +682,9 @@ void Scheduler::schedulePerFrame(const ccSchedulerFunc& callback, void *target,
         // TODO: check if priority has changed!
 
         hashElement->entry->markedForDeletion = false;
+        hashElement->entry->callback = callback;
+        hashElement->entry->parallel = (applyCallback != nullptr);
+        hashElement->entry->applyCallback = applyCallback;
         return;
     }
 
@@ -479,16 +692,16 @@ void Scheduler::schedulePerFrame(const ccSchedulerFunc& callback, void *target,
     // is an special list for updates with priority 0
     if (priority == 0)
     {
-        appendIn(&_updates0List, callback, target, paused);
+        appendIn(&_updates0List, callback, target, paused, applyCallback);
     }
     else if (priority < 0)
     {
-        priorityIn(&_updatesNegList, callback, target, priority, paused);
+        priorityIn(&_updatesNegList, callback, target, priority, paused, applyCallback);
     }
     else
     {
         // priority > 0
-        priorityIn(&_updatesPosList, callback, target, priority, paused);
+        priorityIn(&_updatesPosList, callback, target, priority, paused, applyCallback);
     }
 }
 
@@ -632,22 +845,13 @@ void Scheduler::unscheduleAllForTarget(void *target)
 
     if (element)
     {
-        if (ccArrayContainsObject(element->timers, element->currentTimer)
-            && (! element->currentTimerSalvaged))
+        for (int i = 0; i < element->timers->num; ++i)
         {
-            element->currentTimer->retain();
-            element->currentTimerSalvaged = true;
+            removeTimer(static_cast<Timer*>(element->timers->arr[i]));
         }
         ccArrayRemoveAllObjects(element->timers);
 
-        if (_currentTarget == element)
-        {
-            _currentTargetSalvaged = true;
-        }
-        else
-        {
-            removeHashElement(element);
-        }
+        removeHashElement(element);
     }
 
     // update selector
@@ -686,7 +890,7 @@ void Scheduler::resumeTarget(void *target)
     HASH_FIND_PTR(_hashForTimers, &target, element);
     if (element)
     {
-        element->paused = false;
+        setTimersPaused(element, false);
     }
 
     // update selector
@@ -708,7 +912,7 @@ void Scheduler::pauseTarget(void *target)
     HASH_FIND_PTR(_hashForTimers, &target, element);
     if (element)
     {
-        element->paused = true;
+        setTimersPaused(element, true);
     }
 
     // update selector
@@ -757,7 +961,7 @@ std::set<void*> Scheduler::pauseAllTargetsWithMinPriority(int minPriority)
     for(tHashTimerEntry *element = _hashForTimers; element != nullptr;
         element = (tHashTimerEntry*)element->hh.next)
     {
-        element->paused = true;
+        setTimersPaused(element, true);
         idsWithSelectors.insert(element->target);
     }
 
@@ -812,88 +1016,130 @@ void Scheduler::performFunctionInCocosThread(const std::function<void ()> &funct
     _performMutex.unlock();
 }
 
-// main loop
-void Scheduler::update(float dt)
+float Scheduler::getUpdateTime(void *target)
 {
-    _updateHashLocked = true;
-
-    if (_timeScale != 1.0f)
+    tHashUpdateEntry *element = nullptr;
+    HASH_FIND_PTR(_hashForUpdates, &target, element);
+    if (element)
     {
-        dt *= _timeScale;
+        return element->entry->updateTime;
     }
 
-    //
-    // Selector callbacks
-    //
+    return 0.0f;
+}
 
-    // Iterate over all the Updates' selectors
-    tListEntry *entry, *tmp;
+static inline void invokeUpdate(tListEntry *entry, float dt, bool timed)
+{
+    if (timed)
+    {
+        auto start = std::chrono::steady_clock::now();
+        entry->callback(dt);
+        entry->updateTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+    }
+    else
+    {
+        entry->callback(dt);
+    }
+}
 
-    // updates with priority < 0
-    DL_FOREACH_SAFE(_updatesNegList, entry, tmp)
+void Scheduler::updateList(tListEntry *list, float dt, bool parallel)
+{
+    tListEntry *entry, *tmp;
+    DL_FOREACH_SAFE(list, entry, tmp)
     {
-        if ((! entry->paused) && (! entry->markedForDeletion))
+        if ((! entry->paused) && (! entry->markedForDeletion) && entry->parallel == parallel)
         {
-            entry->callback(dt);
+            if (parallel)
+            {
+                _parallelUpdates.push_back(entry);
+            }
+            else
+            {
+                invokeUpdate(entry, dt, _updateTimingEnabled);
+            }
         }
     }
+}
 
-    // updates with priority == 0
-    DL_FOREACH_SAFE(_updates0List, entry, tmp)
+void Scheduler::updateParallel(float dt)
+{
+    _parallelUpdates.clear();
+
+    // collect them in priority order, so the chunks are started in that order
+    updateList(_updatesNegList, dt, true);
+    updateList(_updates0List, dt, true);
+    updateList(_updatesPosList, dt, true);
+
+    if (_parallelUpdates.empty())
     {
-        if ((! entry->paused) && (! entry->markedForDeletion))
+        return;
+    }
+
+    bool timed = _updateTimingEnabled;
+    auto job = [this, dt, timed](ssize_t begin, ssize_t end) {
+        for (ssize_t i = begin; i < end; ++i)
         {
-            entry->callback(dt);
+            invokeUpdate(_parallelUpdates[i], dt, timed);
         }
+    };
+
+    //One callback per chunk: updates are usually much heavier than the cost of dispatching them
+    JobPool *jobPool = Director::getInstance()->getJobPool();
+    if (jobPool)
+    {
+        jobPool->parallelFor(_parallelUpdates.size(), 1, job);
+    }
+    else
+    {
+        job(0, _parallelUpdates.size());
     }
 
-    // updates with priority > 0
-    DL_FOREACH_SAFE(_updatesPosList, entry, tmp)
+    // write the results back on this thread, where the whole API can be used
+    for (auto entry : _parallelUpdates)
     {
-        if ((! entry->paused) && (! entry->markedForDeletion))
+        if (! entry->markedForDeletion)
         {
-            entry->callback(dt);
+            entry->applyCallback(dt);
         }
     }
+}
 
-    // Iterate over all the custom selectors
-    for (tHashTimerEntry *elt = _hashForTimers; elt != nullptr; )
+// main loop
+void Scheduler::update(float dt)
+{
+    _updateHashLocked = true;
+
+    if (_timeScale != 1.0f)
     {
-        _currentTarget = elt;
-        _currentTargetSalvaged = false;
+        dt *= _timeScale;
+    }
 
-        if (! _currentTarget->paused)
-        {
-            // The 'timers' array may change while inside this loop
-            for (elt->timerIndex = 0; elt->timerIndex < elt->timers->num; ++(elt->timerIndex))
-            {
-                elt->currentTimer = (Timer*)(elt->timers->arr[elt->timerIndex]);
-                elt->currentTimerSalvaged = false;
+    //
+    // Selector callbacks
+    //
 
-                elt->currentTimer->update(dt);
+    // Iterate over all the Updates' selectors
+    tListEntry *entry, *tmp;
 
-                if (elt->currentTimerSalvaged)
-                {
-                    // The currentTimer told the remove itself. To prevent the timer from
-                    // accidentally deallocating itself before finishing its step, we retained
-                    // it. Now that step is done, it's safe to release it.
-                    elt->currentTimer->release();
-                }
+    // parallel-safe updates, spread across the JobPool
+    auto phaseStart = std::chrono::steady_clock::now();
+    updateParallel(dt);
+    auto phaseEnd = std::chrono::steady_clock::now();
+    _parallelUpdatesTime = std::chrono::duration<float>(phaseEnd - phaseStart).count();
 
-                elt->currentTimer = nullptr;
-            }
-        }
+    // updates with priority < 0
+    updateList(_updatesNegList, dt, false);
 
-        // elt, at this moment, is still valid
-        // so it is safe to ask this here (issue #490)
-        elt = (tHashTimerEntry *)elt->hh.next;
+    // updates with priority == 0
+    updateList(_updates0List, dt, false);
 
-        // only delete currentTarget if no actions were scheduled during the cycle (issue #481)
-        if (_currentTargetSalvaged && _currentTarget->timers->num == 0)
-        {
-            removeHashElement(_currentTarget);
-        }
-    }
+    // updates with priority > 0
+    updateList(_updatesPosList, dt, false);
+
+    _serialUpdatesTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - phaseEnd).count();
+
+    // Fire the custom selectors that are due
+    updateTimers(dt);
 
     // delete all updates that are marked for deletion
     // updates with priority < 0
@@ -924,7 +1170,6 @@ void Scheduler::update(float dt)
     }
 
     _updateHashLocked = false;
-    _currentTarget = nullptr;
 
 #if CC_ENABLE_SCRIPT_BINDING
     //
@@ -1003,6 +1248,10 @@ void Scheduler::schedule(SEL_SCHEDULE selector, Ref *target, float interval, uns
             {
                 CCLOG("CCScheduler#scheduleSelector. Selector already scheduled. Updating interval from: %.4f to %.4f", timer->getInterval(), interval);
                 timer->setInterval(interval);
+                if (timer->_queued)
+                {
+                    queueTimer(timer);
+                }
                 return;
             }
         }
@@ -1011,7 +1260,7 @@ void Scheduler::schedule(SEL_SCHEDULE selector, Ref *target, float interval, uns
     
     TimerTargetSelector *timer = new TimerTargetSelector();
     timer->initWithSelector(this, selector, target, interval, repeat, delay);
-    ccArrayAppendObject(element->timers, timer);
+    addTimer(element, timer);
     timer->release();
 }
 
@@ -1077,30 +1326,13 @@ void Scheduler::unschedule(SEL_SCHEDULE selector, Ref *target)
             
             if (selector == timer->getSelector())
             {
-                if (timer == element->currentTimer && (! element->currentTimerSalvaged))
-                {
-                    element->currentTimer->retain();
-                    element->currentTimerSalvaged = true;
-                }
-                
+                // a timer being fired stays alive: the timer queue retains it
+                removeTimer(timer);
                 ccArrayRemoveObjectAtIndex(element->timers, i, true);
                 
-                // update timerIndex in case we are in tick:, looping over the actions
-                if (element->timerIndex >= i)
-                {
-                    element->timerIndex--;
-                }
-                
                 if (element->timers->num == 0)
                 {
-                    if (_currentTarget == element)
-                    {
-                        _currentTargetSalvaged = true;
-                    }
-                    else
-                    {
-                        removeHashElement(element);
-                    }
+                    removeHashElement(element);
                 }
                 
                 return;
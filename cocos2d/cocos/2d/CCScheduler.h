@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include <functional>
 #include <mutex>
 #include <set>
+#include <vector>
 
 #include "CCRef.h"
 #include "CCVector.h"
@@ -68,9 +69,16 @@ public:
     
     /** triggers the timer */
     void update(float dt);
+
+    /** Returns the time of the scheduler clock at which the timer is due */
+    inline double getFireTime() const { return _startTime + (_useDelay ? _delay : _interval); }
+
+    /** triggers the timer, which is due at 'now', the time of the scheduler clock */
+    void fire(double now);
     
 protected:
-    
+    friend class Scheduler;
+
     Scheduler* _scheduler; // weak ref
     float _elapsed;
     bool _runForever;
@@ -79,6 +87,13 @@ protected:
     unsigned int _repeat; //0 = once, 1 is 2 x executed
     float _delay;
     float _interval;
+
+    // Scheduler bookkeeping
+    double _startTime;              // scheduler clock when the elapsed time was 0
+    unsigned long long _queueSequence;  // sequence of the latest timer queue entry, older entries are stale
+    bool _queued;                   // there is a valid entry in the timer queue
+    bool _scheduled;                // still owned by a target of the scheduler
+    bool _paused;                   // paused with its target; _elapsed holds the elapsed time
 };
 
 
@@ -248,6 +263,25 @@ public:
         }, target, priority, paused);
     }
 
+    /** Schedules the 'computeUpdate' and 'applyUpdate' selectors for a given target, in place of 'update'.
+     The 'computeUpdate' selectors are executed on the Director's JobPool, concurrently with each other,
+     before the regular updates of the frame. They must be pure computation: they can't modify the nodes
+     through their setters, modify the scene graph, run actions, dispatch events or schedule callbacks.
+     The 'applyUpdate' selectors are then executed on the cocos2d thread, in priority order, to write
+     the results back.
+     @since v3.0
+     @lua NA
+     */
+    template <class T>
+    void scheduleParallelUpdate(T *target, int priority, bool paused)
+    {
+        this->schedulePerFrame([target](float dt){
+            target->computeUpdate(dt);
+        }, target, priority, paused, [target](float dt){
+            target->applyUpdate(dt);
+        });
+    }
+
 #if CC_ENABLE_SCRIPT_BINDING
     // schedule for script bindings
     /** The scheduled script callback will be called every 'interval' seconds.
@@ -363,6 +397,35 @@ public:
      @since v3.0
      */
     void performFunctionInCocosThread( const std::function<void()> &function);
+
+    /////////////////////////////////////
+    // profiling
+
+    /** Enables or disables measuring the duration of every 'update' callback.
+     Disabled by default.
+     @since v3.0
+     */
+    void setUpdateTimingEnabled(bool enabled) { _updateTimingEnabled = enabled; }
+    /** Returns whether the duration of every 'update' callback is measured.
+     @since v3.0
+     */
+    bool isUpdateTimingEnabled() const { return _updateTimingEnabled; }
+
+    /** Returns the time in seconds spent in the 'update' callback of the target during the last frame.
+     Returns 0 if the timing is disabled or the target has no 'update' callback.
+     @since v3.0
+     */
+    float getUpdateTime(void *target);
+
+    /** Returns the time in seconds spent running the parallel-safe updates during the last frame.
+     @since v3.0
+     */
+    float getParallelUpdatesTime() const { return _parallelUpdatesTime; }
+
+    /** Returns the time in seconds spent running the serial updates during the last frame.
+     @since v3.0
+     */
+    float getSerialUpdatesTime() const { return _serialUpdatesTime; }
     
     /////////////////////////////////////
     
@@ -426,15 +489,29 @@ protected:
      @note This method is only for internal use.
      @since v3.0
      */
-    void schedulePerFrame(const ccSchedulerFunc& callback, void *target, int priority, bool paused);
+    void schedulePerFrame(const ccSchedulerFunc& callback, void *target, int priority, bool paused, const ccSchedulerFunc& applyCallback = nullptr);
     
     void removeHashElement(struct _hashSelectorEntry *element);
+
+    // timer queue
+    void addTimer(struct _hashSelectorEntry *element, Timer *timer);
+    void removeTimer(Timer *timer);
+    void queueTimer(Timer *timer);
+    void unqueueTimer(Timer *timer);
+    void setTimersPaused(struct _hashSelectorEntry *element, bool paused);
+    void compactTimerQueue();
+    void updateTimers(float dt);
     void removeUpdateFromHash(struct _listEntry *entry);
 
     // update specific
 
-    void priorityIn(struct _listEntry **list, const ccSchedulerFunc& callback, void *target, int priority, bool paused);
-    void appendIn(struct _listEntry **list, const ccSchedulerFunc& callback, void *target, bool paused);
+    void priorityIn(struct _listEntry **list, const ccSchedulerFunc& callback, void *target, int priority, bool paused, const ccSchedulerFunc& applyCallback);
+    void appendIn(struct _listEntry **list, const ccSchedulerFunc& callback, void *target, bool paused, const ccSchedulerFunc& applyCallback);
+
+    // runs the 'update' callbacks of the list, either the parallel-safe ones or the serial ones
+    void updateList(struct _listEntry *list, float dt, bool parallel);
+    // runs the parallel 'computeUpdate' callbacks on the JobPool, then their 'applyUpdate' callbacks
+    void updateParallel(float dt);
 
 
     float _timeScale;
@@ -447,10 +524,35 @@ protected:
     struct _listEntry *_updatesPosList;        // list priority > 0
     struct _hashUpdateEntry *_hashForUpdates; // hash used to fetch quickly the list entries for pause,delete,etc
 
+    // parallel-safe updates collected for the current frame
+    std::vector<struct _listEntry*> _parallelUpdates;
+
+    bool _updateTimingEnabled;
+    float _parallelUpdatesTime;
+    float _serialUpdatesTime;
+
     // Used for "selectors with interval"
     struct _hashSelectorEntry *_hashForTimers;
-    struct _hashSelectorEntry *_currentTarget;
-    bool _currentTargetSalvaged;
+
+    // min-heap of the running timers ordered by fire time, so a tick only visits the due timers.
+    // Every entry retains its timer. Entries of unscheduled or paused timers are left in the heap
+    // as stale entries and skipped.
+    struct TimerQueueEntry
+    {
+        double fireTime;
+        unsigned long long sequence;
+        Timer *timer;
+    };
+    static bool laterTimer(const TimerQueueEntry& a, const TimerQueueEntry& b);
+    std::vector<TimerQueueEntry> _timerQueue;
+    // timers scheduled since the last tick, they start counting at the next tick (retained)
+    std::vector<Timer*> _timersToStart;
+    // timers fired during the current tick, waiting to be queued again (retained)
+    std::vector<Timer*> _timersToQueue;
+    // scaled time elapsed since the scheduler was created
+    double _timerClock;
+    unsigned long long _timerSequence;
+    size_t _staleTimerEntries;
     // If true unschedule will not remove anything from a hash. Elements will only be marked for deletion.
     bool _updateHashLocked;
     
@@ -42,9 +42,11 @@ enum {
     kShaderType_PositionTexture,
     kShaderType_PositionTexture_uColor,
     kShaderType_PositionTextureA8Color,
+    kShaderType_PositionTextureA8Color_noMVP,
     kShaderType_Position_uColor,
     kShaderType_PositionLengthTexureColor,
     kShaderType_LabelDistanceFieldNormal,
+    kShaderType_LabelDistanceFieldNormal_noMVP,
     kShaderType_LabelDistanceFieldGlow,
     kShaderType_LabelOutline,
     kShaderType_MAX,
@@ -158,6 +160,13 @@ void ShaderCache::loadDefaultShaders()
     loadDefaultShader(p, kShaderType_PositionTextureA8Color);
     _programs.insert( std::make_pair(GLProgram::SHADER_NAME_POSITION_TEXTURE_A8_COLOR, p) );
 
+    //
+    // Position Texture A8 Color without MVP shader
+    //
+    p = new GLProgram();
+    loadDefaultShader(p, kShaderType_PositionTextureA8Color_noMVP);
+    _programs.insert( std::make_pair(GLProgram::SHADER_NAME_POSITION_TEXTURE_A8_COLOR_NO_MVP, p) );
+
     //
     // Position and 1 color passed as a uniform (to simulate glColor4ub )
     //
@@ -176,6 +185,10 @@ void ShaderCache::loadDefaultShaders()
     loadDefaultShader(p, kShaderType_LabelDistanceFieldNormal);
     _programs.insert( std::make_pair(GLProgram::SHADER_NAME_LABEL_DISTANCEFIELD_NORMAL, p) );
 
+    p = new GLProgram();
+    loadDefaultShader(p, kShaderType_LabelDistanceFieldNormal_noMVP);
+    _programs.insert( std::make_pair(GLProgram::SHADER_NAME_LABEL_DISTANCEFIELD_NORMAL_NO_MVP, p) );
+
     p = new GLProgram();
     loadDefaultShader(p, kShaderType_LabelDistanceFieldGlow);
     _programs.insert( std::make_pair(GLProgram::SHADER_NAME_LABEL_DISTANCEFIELD_GLOW, p) );
@@ -241,6 +254,13 @@ void ShaderCache::reloadDefaultShaders()
     p = getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_A8_COLOR);
     p->reset();
     loadDefaultShader(p, kShaderType_PositionTextureA8Color);
+
+    //
+    // Position Texture A8 Color without MVP shader
+    //
+    p = getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_A8_COLOR_NO_MVP);
+    p->reset();
+    loadDefaultShader(p, kShaderType_PositionTextureA8Color_noMVP);
     
     //
     // Position and 1 color passed as a uniform (to simulate glColor4ub )
@@ -260,6 +280,10 @@ void ShaderCache::reloadDefaultShaders()
     p->reset();
     loadDefaultShader(p, kShaderType_LabelDistanceFieldNormal);
 
+    p = getProgram(GLProgram::SHADER_NAME_LABEL_DISTANCEFIELD_NORMAL_NO_MVP);
+    p->reset();
+    loadDefaultShader(p, kShaderType_LabelDistanceFieldNormal_noMVP);
+
     p = getProgram(GLProgram::SHADER_NAME_LABEL_DISTANCEFIELD_GLOW);
     p->reset();
     loadDefaultShader(p, kShaderType_LabelDistanceFieldGlow);
@@ -340,6 +364,14 @@ void ShaderCache::loadDefaultShader(GLProgram *p, int type)
             p->bindAttribLocation(GLProgram::ATTRIBUTE_NAME_COLOR, GLProgram::VERTEX_ATTRIB_COLOR);
             p->bindAttribLocation(GLProgram::ATTRIBUTE_NAME_TEX_COORD, GLProgram::VERTEX_ATTRIB_TEX_COORDS);
 
+            break;
+        case kShaderType_PositionTextureA8Color_noMVP:
+            p->initWithByteArrays(ccPositionTextureColor_noMVP_vert, ccPositionTextureA8Color_frag);
+            
+            p->bindAttribLocation(GLProgram::ATTRIBUTE_NAME_POSITION, GLProgram::VERTEX_ATTRIB_POSITION);
+            p->bindAttribLocation(GLProgram::ATTRIBUTE_NAME_COLOR, GLProgram::VERTEX_ATTRIB_COLOR);
+            p->bindAttribLocation(GLProgram::ATTRIBUTE_NAME_TEX_COORD, GLProgram::VERTEX_ATTRIB_TEX_COORDS);
+
             break;
         case kShaderType_Position_uColor:
             p->initWithByteArrays(ccPosition_uColor_vert, ccPosition_uColor_frag);
@@ -362,6 +394,14 @@ void ShaderCache::loadDefaultShader(GLProgram *p, int type)
             p->bindAttribLocation(GLProgram::ATTRIBUTE_NAME_COLOR, GLProgram::VERTEX_ATTRIB_COLOR);
             p->bindAttribLocation(GLProgram::ATTRIBUTE_NAME_TEX_COORD, GLProgram::VERTEX_ATTRIB_TEX_COORDS);
 
+            break;
+        case kShaderType_LabelDistanceFieldNormal_noMVP:
+            p->initWithByteArrays(ccPositionTextureColor_noMVP_vert, ccLabelDistanceFieldNormal_frag);
+
+            p->bindAttribLocation(GLProgram::ATTRIBUTE_NAME_POSITION, GLProgram::VERTEX_ATTRIB_POSITION);
+            p->bindAttribLocation(GLProgram::ATTRIBUTE_NAME_COLOR, GLProgram::VERTEX_ATTRIB_COLOR);
+            p->bindAttribLocation(GLProgram::ATTRIBUTE_NAME_TEX_COORD, GLProgram::VERTEX_ATTRIB_TEX_COORDS);
+
             break;
         case kShaderType_LabelDistanceFieldGlow:
             p->initWithByteArrays(ccLabelDistanceFieldGlow_vert, ccLabelDistanceFieldGlow_frag);
@@ -350,6 +350,7 @@ void Sprite::setTexture(Texture2D *texture)
         CC_SAFE_RELEASE(_texture);
         _texture = texture;
         updateBlendFunc();
+        setRenderCacheDirty();
     }
 }
 
@@ -386,7 +386,7 @@ public:
     *In lua: local setBlendFunc(local src, local dst)
     *@endcode
     */
-    inline void setBlendFunc(const BlendFunc &blendFunc) override { _blendFunc = blendFunc; }
+    inline void setBlendFunc(const BlendFunc &blendFunc) override { _blendFunc = blendFunc; setRenderCacheDirty(); }
     /**
     * @js  NA
     * @lua NA
@@ -40,6 +40,9 @@ THE SOFTWARE.
 #include "CCDictionary.h"
 #include "CCDirector.h"
 #include <vector>
+#include <algorithm>
+#include <stdint.h>
+#include <string.h>
 
 using namespace std;
 
@@ -47,6 +50,295 @@ NS_CC_BEGIN
 
 static SpriteFrameCache *_sharedSpriteFrameCache = nullptr;
 
+/*
+ * Binary sprite sheet index (.ccsf).
+ * The file is a header followed by the frames sorted by the hash of their name, the aliases sorted the same way
+ * and the nul terminated names. Every field is 4 bytes, in the little endian order of all the supported platforms,
+ * so the records are used in place from the file content.
+ */
+static const char *BINARY_EXTENSION = ".ccsf";
+static const char BINARY_MAGIC[4] = {'C', 'C', 'S', 'F'};
+static const uint32_t BINARY_VERSION = 1;
+static const uint32_t BINARY_NO_STRING = 0xFFFFFFFF;
+
+struct BinarySheetHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t size;
+    // relative to the index file, BINARY_NO_STRING to use the index file name with a .png extension
+    uint32_t textureFileName;
+    uint32_t frames;
+    uint32_t frameCount;
+    uint32_t aliases;
+    uint32_t aliasCount;
+    uint32_t chars;
+    uint32_t charCount;
+};
+
+struct BinarySheetFrame
+{
+    uint32_t hash;
+    uint32_t name;
+    float x, y, width, height;
+    float offsetX, offsetY;
+    float originalWidth, originalHeight;
+    int32_t rotated;
+};
+
+struct BinarySheetAlias
+{
+    uint32_t hash;
+    uint32_t name;
+    uint32_t frame;
+};
+
+// FNV-1a
+static uint32_t hashFrameName(const std::string& name)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < name.size(); i++)
+    {
+        hash = (hash ^ (unsigned char)name[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static bool isBinaryFile(const std::string& filePath)
+{
+    size_t startPos = filePath.find_last_of(".");
+    return startPos != std::string::npos && filePath.compare(startPos, std::string::npos, BINARY_EXTENSION) == 0;
+}
+
+template <typename T>
+static bool isHashLess(const T& record, uint32_t hash)
+{
+    return (record.hash) < hash;
+}
+
+template <typename T>
+static bool isRecordLess(const T& a, const T& b)
+{
+    return (a.hash) < (b.hash);
+}
+
+/** The content of a binary sprite sheet and the texture of its frames */
+class SpriteSheetIndex
+{
+public:
+    SpriteSheetIndex(const std::string& fullPath, Data& content, Texture2D *texture)
+    : _fullPath(fullPath)
+    , _content(std::move(content))
+    , _texture(texture)
+    {
+        _header = (const BinarySheetHeader*)_content.getBytes();
+        CC_SAFE_RETAIN(_texture);
+    }
+
+    ~SpriteSheetIndex()
+    {
+        CC_SAFE_RELEASE(_texture);
+    }
+
+    /** Checks the header, the sections and the names once, so they are used without any check afterwards */
+    static bool isValid(const Data& content)
+    {
+        if (content.getSize() < (ssize_t)sizeof(BinarySheetHeader))
+        {
+            return false;
+        }
+
+        const BinarySheetHeader *header = (const BinarySheetHeader*)content.getBytes();
+        if (memcmp(header->magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0 || header->version != BINARY_VERSION
+            || header->size != (uint32_t)content.getSize())
+        {
+            return false;
+        }
+        if (!isSectionValid(header, header->frames, header->frameCount, sizeof(BinarySheetFrame))
+            || !isSectionValid(header, header->aliases, header->aliasCount, sizeof(BinarySheetAlias))
+            || !isSectionValid(header, header->chars, header->charCount, 1))
+        {
+            return false;
+        }
+
+        // the names are nul terminated inside the chars
+        const char *chars = (const char*)content.getBytes() + header->chars;
+        if (header->charCount == 0 || chars[header->charCount - 1] != '\0')
+        {
+            return false;
+        }
+        if (header->textureFileName != BINARY_NO_STRING && header->textureFileName >= header->charCount)
+        {
+            return false;
+        }
+
+        // the records are sorted by hash, to be searched by halves
+        const BinarySheetFrame *frames = (const BinarySheetFrame*)(content.getBytes() + header->frames);
+        for (uint32_t i = 0; i < header->frameCount; i++)
+        {
+            if (frames[i].name >= header->charCount || (i > 0 && frames[i].hash < frames[i - 1].hash))
+                return false;
+        }
+        const BinarySheetAlias *aliases = (const BinarySheetAlias*)(content.getBytes() + header->aliases);
+        for (uint32_t i = 0; i < header->aliasCount; i++)
+        {
+            if (aliases[i].name >= header->charCount || aliases[i].frame >= header->frameCount
+                || (i > 0 && aliases[i].hash < aliases[i - 1].hash))
+                return false;
+        }
+
+        return true;
+    }
+
+    /** The texture file name saved in a valid content, empty when there is none */
+    static std::string getTextureFileName(const Data& content)
+    {
+        const BinarySheetHeader *header = (const BinarySheetHeader*)content.getBytes();
+        if (header->textureFileName == BINARY_NO_STRING)
+        {
+            return "";
+        }
+        return (const char*)content.getBytes() + header->chars + header->textureFileName;
+    }
+
+    inline const std::string& getFullPath() const { return _fullPath; }
+    inline Texture2D* getTexture() const { return _texture; }
+
+    /** The texture of the frames created from now on */
+    void setTexture(Texture2D *texture)
+    {
+        if (texture != _texture)
+        {
+            CC_SAFE_RETAIN(texture);
+            CC_SAFE_RELEASE(_texture);
+            _texture = texture;
+        }
+    }
+    inline uint32_t getFrameCount() const { return _header->frameCount; }
+    inline const BinarySheetFrame& getFrame(uint32_t index) const { return frames()[index]; }
+    inline const char* getString(uint32_t offset) const { return (const char*)_content.getBytes() + _header->chars + offset; }
+
+    /** The index of the frame with the given name or alias, -1 when there is none */
+    int findFrame(const std::string& name, uint32_t hash) const
+    {
+        const BinarySheetFrame *framesEnd = frames() + _header->frameCount;
+        for (auto it = std::lower_bound(frames(), framesEnd, hash, isHashLess<BinarySheetFrame>); it != framesEnd && it->hash == hash; ++it)
+        {
+            if (name.compare(getString(it->name)) == 0)
+                return (int)(it - frames());
+        }
+
+        const BinarySheetAlias *aliasesEnd = aliases() + _header->aliasCount;
+        for (auto it = std::lower_bound(aliases(), aliasesEnd, hash, isHashLess<BinarySheetAlias>); it != aliasesEnd && it->hash == hash; ++it)
+        {
+            if (name.compare(getString(it->name)) == 0)
+                return (int)it->frame;
+        }
+        return -1;
+    }
+
+    /** Hides a frame removed from the cache, until the file is added again */
+    void removeFrame(int index)
+    {
+        if (_removed.empty())
+        {
+            _removed.resize(_header->frameCount, false);
+        }
+        _removed[index] = true;
+    }
+
+    inline bool isFrameRemoved(int index) const { return !_removed.empty() && _removed[index]; }
+    inline void restoreFrames() { _removed.clear(); }
+
+private:
+    static bool isSectionValid(const BinarySheetHeader *header, uint32_t offset, uint32_t count, size_t recordSize)
+    {
+        return (recordSize == 1 || (offset & 3) == 0) && offset <= header->size && count <= (header->size - offset) / recordSize;
+    }
+
+    inline const BinarySheetFrame* frames() const { return (const BinarySheetFrame*)(_content.getBytes() + _header->frames); }
+    inline const BinarySheetAlias* aliases() const { return (const BinarySheetAlias*)(_content.getBytes() + _header->aliases); }
+
+    std::string _fullPath;
+    Data _content;
+    const BinarySheetHeader *_header;
+    Texture2D *_texture;
+    std::vector<bool> _removed;
+};
+
+/*
+ Supported Zwoptex Formats:
+
+ ZWTCoordinatesFormatOptionXMLLegacy = 0, // Flash Version
+ ZWTCoordinatesFormatOptionXML1_0 = 1, // Desktop Version 0.0 - 0.4b
+ ZWTCoordinatesFormatOptionXML1_1 = 2, // Desktop Version 1.0.0 - 1.0.1
+ ZWTCoordinatesFormatOptionXML1_2 = 3, // Desktop Version 1.0.2+
+ */
+static int getDictionaryFormat(ValueMap& dictionary)
+{
+    int format = 0;
+
+    // get the format
+    if (dictionary.find("metadata") != dictionary.end())
+    {
+        ValueMap& metadataDict = dictionary["metadata"].asValueMap();
+        format = metadataDict["format"].asInt();
+    }
+    return format;
+}
+
+static void readFrameDictionary(ValueMap& frameDict, int format, Rect& rect, bool& rotated, Point& offset, Size& originalSize)
+{
+    rotated = false;
+
+    if(format == 0) 
+    {
+        float x = frameDict["x"].asFloat();
+        float y = frameDict["y"].asFloat();
+        float w = frameDict["width"].asFloat();
+        float h = frameDict["height"].asFloat();
+        float ox = frameDict["offsetX"].asFloat();
+        float oy = frameDict["offsetY"].asFloat();
+        int ow = frameDict["originalWidth"].asInt();
+        int oh = frameDict["originalHeight"].asInt();
+        // check ow/oh
+        if(!ow || !oh)
+        {
+            CCLOGWARN("cocos2d: WARNING: originalWidth/Height not found on the SpriteFrame. AnchorPoint won't work as expected. Regenrate the .plist");
+        }
+        // abs ow/oh
+        ow = abs(ow);
+        oh = abs(oh);
+        rect = Rect(x, y, w, h);
+        offset = Point(ox, oy);
+        originalSize = Size((float)ow, (float)oh);
+    } 
+    else if(format == 1 || format == 2) 
+    {
+        rect = RectFromString(frameDict["frame"].asString());
+
+        // rotation
+        if (format == 2)
+        {
+            rotated = frameDict["rotated"].asBool();
+        }
+
+        offset = PointFromString(frameDict["offset"].asString());
+        originalSize = SizeFromString(frameDict["sourceSize"].asString());
+    } 
+    else if (format == 3)
+    {
+        // get values
+        Size spriteSize = SizeFromString(frameDict["spriteSize"].asString());
+        Rect textureRect = RectFromString(frameDict["textureRect"].asString());
+
+        rect = Rect(textureRect.origin.x, textureRect.origin.y, spriteSize.width, spriteSize.height);
+        rotated = frameDict["textureRotated"].asBool();
+        offset = PointFromString(frameDict["spriteOffset"].asString());
+        originalSize = SizeFromString(frameDict["spriteSourceSize"].asString());
+    }
+}
+
 SpriteFrameCache* SpriteFrameCache::getInstance()
 {
     if (! _sharedSpriteFrameCache)
@@ -74,29 +366,16 @@ bool SpriteFrameCache::init(void)
 SpriteFrameCache::~SpriteFrameCache(void)
 {
     CC_SAFE_DELETE(_loadedFileNames);
+    for (auto index : _sheetIndices)
+    {
+        delete index;
+    }
 }
 
 void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dictionary, Texture2D* texture)
 {
-    /*
-    Supported Zwoptex Formats:
-
-    ZWTCoordinatesFormatOptionXMLLegacy = 0, // Flash Version
-    ZWTCoordinatesFormatOptionXML1_0 = 1, // Desktop Version 0.0 - 0.4b
-    ZWTCoordinatesFormatOptionXML1_1 = 2, // Desktop Version 1.0.0 - 1.0.1
-    ZWTCoordinatesFormatOptionXML1_2 = 3, // Desktop Version 1.0.2+
-    */
-
-    
     ValueMap& framesDict = dictionary["frames"].asValueMap();
-    int format = 0;
-
-    // get the format
-    if (dictionary.find("metadata") != dictionary.end())
-    {
-        ValueMap& metadataDict = dictionary["metadata"].asValueMap();
-        format = metadataDict["format"].asInt();
-    }
+    int format = getDictionaryFormat(dictionary);
 
     // check the format
     CCASSERT(format >=0 && format <= 3, "format is not supported for SpriteFrameCache addSpriteFramesWithDictionary:textureFilename:");
@@ -110,66 +389,15 @@ void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dictionary, Textu
         {
             continue;
         }
-        
-        if(format == 0) 
-        {
-            float x = frameDict["x"].asFloat();
-            float y = frameDict["y"].asFloat();
-            float w = frameDict["width"].asFloat();
-            float h = frameDict["height"].asFloat();
-            float ox = frameDict["offsetX"].asFloat();
-            float oy = frameDict["offsetY"].asFloat();
-            int ow = frameDict["originalWidth"].asInt();
-            int oh = frameDict["originalHeight"].asInt();
-            // check ow/oh
-            if(!ow || !oh)
-            {
-                CCLOGWARN("cocos2d: WARNING: originalWidth/Height not found on the SpriteFrame. AnchorPoint won't work as expected. Regenrate the .plist");
-            }
-            // abs ow/oh
-            ow = abs(ow);
-            oh = abs(oh);
-            // create frame
-            spriteFrame = new SpriteFrame();
-            spriteFrame->initWithTexture(texture,
-                                        Rect(x, y, w, h), 
-                                        false,
-                                        Point(ox, oy),
-                                        Size((float)ow, (float)oh)
-                                        );
-        } 
-        else if(format == 1 || format == 2) 
-        {
-            Rect frame = RectFromString(frameDict["frame"].asString());
-            bool rotated = false;
-
-            // rotation
-            if (format == 2)
-            {
-                rotated = frameDict["rotated"].asBool();
-            }
 
-            Point offset = PointFromString(frameDict["offset"].asString());
-            Size sourceSize = SizeFromString(frameDict["sourceSize"].asString());
-
-            // create frame
-            spriteFrame = new SpriteFrame();
-            spriteFrame->initWithTexture(texture,
-                frame,
-                rotated,
-                offset,
-                sourceSize
-                );
-        } 
-        else if (format == 3)
-        {
-            // get values
-            Size spriteSize = SizeFromString(frameDict["spriteSize"].asString());
-            Point spriteOffset = PointFromString(frameDict["spriteOffset"].asString());
-            Size spriteSourceSize = SizeFromString(frameDict["spriteSourceSize"].asString());
-            Rect textureRect = RectFromString(frameDict["textureRect"].asString());
-            bool textureRotated = frameDict["textureRotated"].asBool();
+        Rect rect;
+        bool rotated;
+        Point offset;
+        Size originalSize;
+        readFrameDictionary(frameDict, format, rect, rotated, offset, originalSize);
 
+        if (format == 3)
+        {
             // get aliases
             ValueVector& aliases = frameDict["aliases"].asValueVector();
 
@@ -182,25 +410,55 @@ void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dictionary, Textu
 
                 _spriteFramesAliases[oneAlias] = Value(spriteFrameName);
             }
-            
-            // create frame
-            spriteFrame = new SpriteFrame();
-            spriteFrame->initWithTexture(texture,
-                            Rect(textureRect.origin.x, textureRect.origin.y, spriteSize.width, spriteSize.height),
-                            textureRotated,
-                            spriteOffset,
-                            spriteSourceSize);
         }
 
+        // create frame
+        spriteFrame = new SpriteFrame();
+        spriteFrame->initWithTexture(texture,
+                                     rect,
+                                     rotated,
+                                     offset,
+                                     originalSize);
+
         // add sprite frame
         _spriteFrames.insert(spriteFrameName, spriteFrame);
         spriteFrame->release();
     }
 }
 
+void SpriteFrameCache::addSpriteFramesWithBinary(const std::string& fullPath, Data& content, Texture2D *texture)
+{
+    // a file added again, maybe with another texture: like for a plist, the frames already cached keep
+    // their texture and the others are created with the new one
+    for (auto index : _sheetIndices)
+    {
+        if (index->getFullPath() == fullPath)
+        {
+            index->setTexture(texture);
+            index->restoreFrames();
+            return;
+        }
+    }
+
+    _sheetIndices.push_back(new SpriteSheetIndex(fullPath, content, texture));
+}
+
 void SpriteFrameCache::addSpriteFramesWithFile(const std::string& pszPlist, Texture2D *pobTexture)
 {
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(pszPlist);
+
+    if (isBinaryFile(pszPlist))
+    {
+        Data content = FileUtils::getInstance()->getDataFromFile(fullPath);
+        if (!SpriteSheetIndex::isValid(content))
+        {
+            CCLOG("cocos2d: SpriteFrameCache: %s is not a valid binary sprite sheet", pszPlist.c_str());
+            return;
+        }
+        addSpriteFramesWithBinary(fullPath, content, pobTexture);
+        return;
+    }
+
     ValueMap dict = FileUtils::getInstance()->getValueMapFromFile(fullPath);
 
     addSpriteFramesWithDictionary(dict, pobTexture);
@@ -228,15 +486,32 @@ void SpriteFrameCache::addSpriteFramesWithFile(const std::string& pszPlist)
     if (_loadedFileNames->find(pszPlist) == _loadedFileNames->end())
     {
         std::string fullPath = FileUtils::getInstance()->fullPathForFilename(pszPlist);
-        ValueMap dict = FileUtils::getInstance()->getValueMapFromFile(fullPath);
+        bool binary = isBinaryFile(pszPlist);
+        ValueMap dict;
+        Data content;
 
         string texturePath("");
 
-        if (dict.find("metadata") != dict.end())
+        if (binary)
         {
-            ValueMap& metadataDict = dict["metadata"].asValueMap();
-            // try to read  texture file name from meta data
-            texturePath = metadataDict["textureFileName"].asString();
+            content = FileUtils::getInstance()->getDataFromFile(fullPath);
+            if (!SpriteSheetIndex::isValid(content))
+            {
+                CCLOG("cocos2d: SpriteFrameCache: %s is not a valid binary sprite sheet", pszPlist.c_str());
+                return;
+            }
+            texturePath = SpriteSheetIndex::getTextureFileName(content);
+        }
+        else
+        {
+            dict = FileUtils::getInstance()->getValueMapFromFile(fullPath);
+
+            if (dict.find("metadata") != dict.end())
+            {
+                ValueMap& metadataDict = dict["metadata"].asValueMap();
+                // try to read  texture file name from meta data
+                texturePath = metadataDict["textureFileName"].asString();
+            }
         }
 
         if (!texturePath.empty())
@@ -263,7 +538,14 @@ void SpriteFrameCache::addSpriteFramesWithFile(const std::string& pszPlist)
 
         if (texture)
         {
-            addSpriteFramesWithDictionary(dict, texture);
+            if (binary)
+            {
+                addSpriteFramesWithBinary(fullPath, content, texture);
+            }
+            else
+            {
+                addSpriteFramesWithDictionary(dict, texture);
+            }
             _loadedFileNames->insert(pszPlist);
         }
         else
@@ -283,6 +565,11 @@ void SpriteFrameCache::removeSpriteFrames()
     _spriteFrames.clear();
     _spriteFramesAliases.clear();
     _loadedFileNames->clear();
+    for (auto index : _sheetIndices)
+    {
+        delete index;
+    }
+    _sheetIndices.clear();
 }
 
 void SpriteFrameCache::removeUnusedSpriteFrames()
@@ -330,6 +617,18 @@ void SpriteFrameCache::removeSpriteFrameByName(const std::string& name)
         _spriteFrames.erase(name);
     }
 
+    // the binary sprite sheets would create it again
+    const std::string& frameName = key.empty() ? name : key;
+    const uint32_t hash = hashFrameName(frameName);
+    for (auto index : _sheetIndices)
+    {
+        int frame = index->findFrame(frameName, hash);
+        if (frame >= 0)
+        {
+            index->removeFrame(frame);
+        }
+    }
+
     // XXX. Since we don't know the .plist file that originated the frame, we must remove all .plist from the cache
     _loadedFileNames->clear();
 }
@@ -337,6 +636,20 @@ void SpriteFrameCache::removeSpriteFrameByName(const std::string& name)
 void SpriteFrameCache::removeSpriteFramesFromFile(const std::string& plist)
 {
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(plist);
+    if (isBinaryFile(plist))
+    {
+        for (size_t i = 0; i < _sheetIndices.size(); i++)
+        {
+            if (_sheetIndices[i]->getFullPath() == fullPath)
+            {
+                removeSpriteFramesFromBinary(i);
+                break;
+            }
+        }
+        _loadedFileNames->erase(plist);
+        return;
+    }
+
     ValueMap dict = FileUtils::getInstance()->getValueMapFromFile(fullPath);
     if (dict.empty())
     {
@@ -369,8 +682,28 @@ void SpriteFrameCache::removeSpriteFramesFromDictionary(ValueMap& dictionary)
     _spriteFrames.erase(keysToRemove);
 }
 
+void SpriteFrameCache::removeSpriteFramesFromBinary(size_t index)
+{
+    SpriteSheetIndex *sheetIndex = _sheetIndices[index];
+    for (uint32_t i = 0; i < sheetIndex->getFrameCount(); i++)
+    {
+        _spriteFrames.erase(sheetIndex->getString(sheetIndex->getFrame(i).name));
+    }
+
+    _sheetIndices.erase(_sheetIndices.begin() + index);
+    delete sheetIndex;
+}
+
 void SpriteFrameCache::removeSpriteFramesFromTexture(Texture2D* texture)
 {
+    for (size_t i = _sheetIndices.size(); i > 0; i--)
+    {
+        if (_sheetIndices[i - 1]->getTexture() == texture)
+        {
+            removeSpriteFramesFromBinary(i - 1);
+        }
+    }
+
     std::vector<std::string> keysToRemove;
 
     for (auto iter = _spriteFrames.cbegin(); iter != _spriteFrames.cend(); ++iter)
@@ -402,8 +735,171 @@ SpriteFrame* SpriteFrameCache::getSpriteFrameByName(const std::string& name)
             }
         }
     }
+    if (!frame && !_sheetIndices.empty())
+    {
+        frame = getSpriteFrameFromBinaries(name);
+    }
     return frame;
 }
 
+SpriteFrame* SpriteFrameCache::getSpriteFrameFromBinaries(const std::string& name)
+{
+    const uint32_t hash = hashFrameName(name);
+    for (auto index : _sheetIndices)
+    {
+        int i = index->findFrame(name, hash);
+        if (i < 0 || index->isFrameRemoved(i))
+        {
+            continue;
+        }
+
+        const BinarySheetFrame& record = index->getFrame(i);
+        std::string frameName = index->getString(record.name);
+        // asked for by an alias, the frame may exist already
+        SpriteFrame *frame = _spriteFrames.at(frameName);
+        if (!frame)
+        {
+            frame = new SpriteFrame();
+            frame->initWithTexture(index->getTexture(),
+                                   Rect(record.x, record.y, record.width, record.height),
+                                   record.rotated != 0,
+                                   Point(record.offsetX, record.offsetY),
+                                   Size(record.originalWidth, record.originalHeight));
+            _spriteFrames.insert(frameName, frame);
+            frame->release();
+        }
+        if (frameName != name)
+        {
+            _spriteFramesAliases[name] = Value(frameName);
+        }
+        return frame;
+    }
+    return nullptr;
+}
+
+bool SpriteFrameCache::convertToBinaryFile(const std::string& plist, const std::string& binaryFilePath)
+{
+    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(plist);
+    ValueMap dict = FileUtils::getInstance()->getValueMapFromFile(fullPath);
+    if (dict.find("frames") == dict.end())
+    {
+        CCLOG("cocos2d: SpriteFrameCache: %s can't be converted to the binary format.", plist.c_str());
+        return false;
+    }
+
+    int format = getDictionaryFormat(dict);
+    if (format < 0 || format > 3)
+    {
+        CCLOG("cocos2d: SpriteFrameCache: the format of %s is not supported.", plist.c_str());
+        return false;
+    }
+
+    std::vector<char> chars;
+    auto addString = [&chars](const std::string& str) -> uint32_t {
+        uint32_t offset = (uint32_t)chars.size();
+        chars.insert(chars.end(), str.c_str(), str.c_str() + str.size() + 1);
+        return offset;
+    };
+
+    BinarySheetHeader header;
+    memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    header.version = BINARY_VERSION;
+    header.textureFileName = BINARY_NO_STRING;
+    if (dict.find("metadata") != dict.end())
+    {
+        std::string textureFileName = dict["metadata"].asValueMap()["textureFileName"].asString();
+        if (!textureFileName.empty())
+        {
+            header.textureFileName = addString(textureFileName);
+        }
+    }
+
+    // the frames are sorted by name first, so the same plist always gives the same file
+    ValueMap& framesDict = dict["frames"].asValueMap();
+    std::vector<std::string> names;
+    names.reserve(framesDict.size());
+    for (auto iter = framesDict.begin(); iter != framesDict.end(); ++iter)
+    {
+        names.push_back(iter->first);
+    }
+    std::sort(names.begin(), names.end());
+
+    std::vector<BinarySheetFrame> frames;
+    std::vector<std::pair<std::string, std::string>> aliasNames;
+    for (const auto& name : names)
+    {
+        ValueMap& frameDict = framesDict[name].asValueMap();
+        Rect rect;
+        bool rotated;
+        Point offset;
+        Size originalSize;
+        readFrameDictionary(frameDict, format, rect, rotated, offset, originalSize);
+
+        BinarySheetFrame record;
+        record.hash = hashFrameName(name);
+        record.name = addString(name);
+        record.x = rect.origin.x;
+        record.y = rect.origin.y;
+        record.width = rect.size.width;
+        record.height = rect.size.height;
+        record.offsetX = offset.x;
+        record.offsetY = offset.y;
+        record.originalWidth = originalSize.width;
+        record.originalHeight = originalSize.height;
+        record.rotated = rotated ? 1 : 0;
+        frames.push_back(record);
+
+        if (format == 3)
+        {
+            for (const auto& value : frameDict["aliases"].asValueVector())
+            {
+                aliasNames.push_back(std::make_pair(value.asString(), name));
+            }
+        }
+    }
+    std::stable_sort(frames.begin(), frames.end(), isRecordLess<BinarySheetFrame>);
+
+    // the aliases refer to the frames by their sorted index
+    std::unordered_map<std::string, uint32_t> frameIndices;
+    for (uint32_t i = 0; i < frames.size(); i++)
+    {
+        frameIndices[&chars[frames[i].name]] = i;
+    }
+    std::sort(aliasNames.begin(), aliasNames.end());
+    std::vector<BinarySheetAlias> aliases;
+    for (const auto& aliasName : aliasNames)
+    {
+        BinarySheetAlias record;
+        record.hash = hashFrameName(aliasName.first);
+        record.name = addString(aliasName.first);
+        record.frame = frameIndices[aliasName.second];
+        aliases.push_back(record);
+    }
+    std::stable_sort(aliases.begin(), aliases.end(), isRecordLess<BinarySheetAlias>);
+
+    std::vector<unsigned char> content(sizeof(BinarySheetHeader));
+    header.frames = (uint32_t)content.size();
+    header.frameCount = (uint32_t)frames.size();
+    content.insert(content.end(), (const unsigned char*)frames.data(), (const unsigned char*)(frames.data() + frames.size()));
+    header.aliases = (uint32_t)content.size();
+    header.aliasCount = (uint32_t)aliases.size();
+    content.insert(content.end(), (const unsigned char*)aliases.data(), (const unsigned char*)(aliases.data() + aliases.size()));
+    header.chars = (uint32_t)content.size();
+    header.charCount = (uint32_t)chars.size();
+    content.insert(content.end(), chars.begin(), chars.end());
+    header.size = (uint32_t)content.size();
+    memcpy(content.data(), &header, sizeof(header));
+
+    FILE *fp = fopen(binaryFilePath.c_str(), "wb");
+    if (!fp)
+    {
+        CCLOG("cocos2d: SpriteFrameCache: can't open %s to write the binary sprite sheet.", binaryFilePath.c_str());
+        return false;
+    }
+    bool written = fwrite(content.data(), 1, content.size(), fp) == content.size();
+    fclose(fp);
+    return written;
+}
+
 NS_CC_END
 
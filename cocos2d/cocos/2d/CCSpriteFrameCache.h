@@ -40,13 +40,16 @@ THE SOFTWARE.
 #include "CCRef.h"
 #include "CCValue.h"
 #include "CCMap.h"
+#include "CCData.h"
 
 #include <set>
 #include <string>
+#include <vector>
 
 NS_CC_BEGIN
 
 class Sprite;
+class SpriteSheetIndex;
 
 /**
  * @addtogroup sprite_nodes
@@ -55,6 +58,9 @@ class Sprite;
 
 /** @brief Singleton that handles the loading of the sprite frames.
  It saves in a cache the sprite frames.
+
+ Sprite sheets converted to the binary index format (.ccsf) by convertToBinaryFile() are used in place:
+ their frames are found by the hash of their name and only created the first time they are asked for.
  @since v0.9
  */
 class CC_DLL SpriteFrameCache : public Ref
@@ -85,7 +91,7 @@ public:
     bool init(void);
 
 public:
-    /** Adds multiple Sprite Frames from a plist file.
+    /** Adds multiple Sprite Frames from a plist file, or a binary index file (.ccsf).
      * A texture will be loaded automatically. The texture name will composed by replacing the .plist suffix with .png
      * If you want to use another texture, you should use the addSpriteFramesWithFile(const std::string& plist, const std::string& textureFileName) method.
      * @js addSpriteFrames
@@ -152,6 +158,14 @@ public:
     /** @deprecated use getSpriteFrameByName() instead */
     CC_DEPRECATED_ATTRIBUTE SpriteFrame* spriteFrameByName(const std::string&name) { return getSpriteFrameByName(name); }
 
+    /** Converts a plist file to the binary index format, to be done offline or once on the device.
+     * The frames are saved sorted by the hash of their name, so they are found without parsing the file.
+     *
+     * @param plist The plist file
+     * @param binaryFilePath The full path of the binary file to write, its extension should be .ccsf
+     */
+    static bool convertToBinaryFile(const std::string& plist, const std::string& binaryFilePath);
+
 private:
     /*Adds multiple Sprite Frames with a dictionary. The texture will be associated with the created sprite frames.
      */
@@ -162,10 +176,18 @@ private:
     */
     void removeSpriteFramesFromDictionary(ValueMap& dictionary);
 
+    /** Adds the binary index of a sprite sheet, its frames are created when they are asked for */
+    void addSpriteFramesWithBinary(const std::string& fullPath, Data& content, Texture2D *texture);
+    /** Removes the index of a binary sprite sheet and the frames created from it */
+    void removeSpriteFramesFromBinary(size_t index);
+    /** Creates and caches the frame of the binary sprite sheets with the given name or alias */
+    SpriteFrame* getSpriteFrameFromBinaries(const std::string& name);
+
 protected:
     Map<std::string, SpriteFrame*> _spriteFrames;
     ValueMap _spriteFramesAliases;
     std::set<std::string>*  _loadedFileNames;
+    std::vector<SpriteSheetIndex*> _sheetIndices;
 };
 
 // end of sprite_nodes group
@@ -44,11 +44,20 @@ THE SOFTWARE.
 #include "ccGLStateCache.h"
 #include "CCShaderCache.h"
 #include "platform/CCDevice.h"
+#include "platform/CCGLHeadless.h"
 
 #if CC_ENABLE_CACHE_TEXTURE_DATA
     #include "CCTextureCache.h"
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CC_TEXTURE2D_USE_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define CC_TEXTURE2D_USE_NEON 1
+#include <arm_neon.h>
+#endif
+
 NS_CC_BEGIN
 
 namespace {
@@ -120,6 +129,107 @@ static bool _PVRHaveAlphaPremultiplied = false;
 //////////////////////////////////////////////////////////////////////////
 //conventer function
 
+// The vectorized loops convert the bulk of the pixels, the scalar loop after them converts the rest.
+// Both give the same bits.
+#if CC_TEXTURE2D_USE_SSE2
+// SSE2 registers hold 4 RGBA8888 pixels, R in the low byte of each 32 bit lane
+
+// packs the low 16 bits of the lanes of a and b
+static inline __m128i packLow16(__m128i a, __m128i b)
+{
+    // sign extended, the saturation of packs leaves them untouched
+    return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16), _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+}
+
+// packs 16 values of 8 bits held in 32 bit lanes
+static inline __m128i packLow8(__m128i a, __m128i b, __m128i c, __m128i d)
+{
+    return _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+}
+
+// (R*299 + G*587 + B*114 + 500) / 1000. The float product truncates to the same value for 8 bit components
+static inline __m128i luminanceRGBA8888(__m128i p)
+{
+    __m128i rb = _mm_and_si128(p, _mm_set1_epi32(0x00FF00FF));
+    __m128i g = _mm_and_si128(_mm_srli_epi32(p, 8), _mm_set1_epi32(0xFF));
+    __m128i sum = _mm_add_epi32(_mm_add_epi32(_mm_madd_epi16(rb, _mm_set1_epi32(114 << 16 | 299)),
+                                              _mm_madd_epi16(g, _mm_set1_epi32(587))),
+                                _mm_set1_epi32(500));
+    return _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(sum), _mm_set1_ps(0.001f)));
+}
+
+static inline __m128i rgba8888ToRGB565(__m128i p)
+{
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xF8)), 8),        //R
+                                     _mm_srli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xFC00)), 5)),     //G
+                        _mm_srli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xF80000)), 19));               //B
+}
+
+static inline __m128i rgba8888ToRGBA4444(__m128i p)
+{
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xF0)), 8),        //R
+                                     _mm_srli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xF000)), 4)),     //G
+                        _mm_or_si128(_mm_srli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xF00000)), 16),   //B
+                                     _mm_srli_epi32(p, 28)));                                          //A
+}
+
+static inline __m128i rgba8888ToRGB5A1(__m128i p)
+{
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xF8)), 8),        //R
+                                     _mm_srli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xF800)), 5)),     //G
+                        _mm_or_si128(_mm_srli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xF80000)), 18),   //B
+                                     _mm_srli_epi32(p, 31)));                                          //A
+}
+#elif CC_TEXTURE2D_USE_NEON
+// NEON loads split 16 pixels in one register per component. The 16 bit formats are stored
+// as their low and high bytes interleaved
+
+// (R*299 + G*587 + B*114 + 500) / 1000. The float product truncates to the same value for 8 bit components
+static inline uint8x8_t luminance8(uint8x8_t r, uint8x8_t g, uint8x8_t b)
+{
+    uint16x8_t r16 = vmovl_u8(r);
+    uint16x8_t g16 = vmovl_u8(g);
+    uint16x8_t b16 = vmovl_u8(b);
+    uint32x4_t lo = vmlal_n_u16(vmlal_n_u16(vmlal_n_u16(vdupq_n_u32(500), vget_low_u16(r16), 299), vget_low_u16(g16), 587), vget_low_u16(b16), 114);
+    uint32x4_t hi = vmlal_n_u16(vmlal_n_u16(vmlal_n_u16(vdupq_n_u32(500), vget_high_u16(r16), 299), vget_high_u16(g16), 587), vget_high_u16(b16), 114);
+    lo = vcvtq_u32_f32(vmulq_n_f32(vcvtq_f32_u32(lo), 0.001f));
+    hi = vcvtq_u32_f32(vmulq_n_f32(vcvtq_f32_u32(hi), 0.001f));
+    return vmovn_u16(vcombine_u16(vmovn_u32(lo), vmovn_u32(hi)));
+}
+
+static inline uint8x16_t luminance16(uint8x16_t r, uint8x16_t g, uint8x16_t b)
+{
+    return vcombine_u8(luminance8(vget_low_u8(r), vget_low_u8(g), vget_low_u8(b)),
+                       luminance8(vget_high_u8(r), vget_high_u8(g), vget_high_u8(b)));
+}
+
+static inline uint8x16x2_t packRGB565(uint8x16_t r, uint8x16_t g, uint8x16_t b)
+{
+    uint8x16x2_t out;
+    out.val[0] = vorrq_u8(vshlq_n_u8(vandq_u8(g, vdupq_n_u8(0x1C)), 3), vshrq_n_u8(b, 3));      //GGGBBBBB
+    out.val[1] = vorrq_u8(vandq_u8(r, vdupq_n_u8(0xF8)), vshrq_n_u8(g, 5));                     //RRRRRGGG
+    return out;
+}
+
+static inline uint8x16x2_t packRGBA4444(uint8x16_t r, uint8x16_t g, uint8x16_t b, uint8x16_t a)
+{
+    uint8x16x2_t out;
+    out.val[0] = vorrq_u8(vandq_u8(b, vdupq_n_u8(0xF0)), vshrq_n_u8(a, 4));                     //BBBBAAAA
+    out.val[1] = vorrq_u8(vandq_u8(r, vdupq_n_u8(0xF0)), vshrq_n_u8(g, 4));                     //RRRRGGGG
+    return out;
+}
+
+static inline uint8x16x2_t packRGB5A1(uint8x16_t r, uint8x16_t g, uint8x16_t b, uint8x16_t a)
+{
+    uint8x16x2_t out;
+    out.val[0] = vorrq_u8(vorrq_u8(vshlq_n_u8(vandq_u8(g, vdupq_n_u8(0x18)), 3),
+                                   vshlq_n_u8(vshrq_n_u8(b, 3), 1)),
+                          vshrq_n_u8(a, 7));                                                    //GGBBBBBA
+    out.val[1] = vorrq_u8(vandq_u8(r, vdupq_n_u8(0xF8)), vshrq_n_u8(g, 5));                     //RRRRRGGG
+    return out;
+}
+#endif
+
 // IIIIIIII -> RRRRRRRRGGGGGGGGGBBBBBBBB
 void Texture2D::convertI8ToRGB888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
@@ -145,7 +255,31 @@ void Texture2D::convertAI88ToRGB888(const unsigned char* data, ssize_t dataLen,
 // IIIIIIII -> RRRRRRRRGGGGGGGGGBBBBBBBBAAAAAAAA
 void Texture2D::convertI8ToRGBA8888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0; i < dataLen; ++i)
+    ssize_t i = 0;
+#if CC_TEXTURE2D_USE_SSE2
+    const __m128i alpha = _mm_set1_epi8((char)0xFF);
+    for (ssize_t l = dataLen - 15; i < l; i += 16, outData += 64)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i ii = _mm_unpacklo_epi8(v, v);
+        __m128i ia = _mm_unpacklo_epi8(v, alpha);
+        _mm_storeu_si128((__m128i*)outData, _mm_unpacklo_epi16(ii, ia));
+        _mm_storeu_si128((__m128i*)(outData + 16), _mm_unpackhi_epi16(ii, ia));
+        ii = _mm_unpackhi_epi8(v, v);
+        ia = _mm_unpackhi_epi8(v, alpha);
+        _mm_storeu_si128((__m128i*)(outData + 32), _mm_unpacklo_epi16(ii, ia));
+        _mm_storeu_si128((__m128i*)(outData + 48), _mm_unpackhi_epi16(ii, ia));
+    }
+#elif CC_TEXTURE2D_USE_NEON
+    for (ssize_t l = dataLen - 15; i < l; i += 16, outData += 64)
+    {
+        uint8x16x4_t out;
+        out.val[0] = out.val[1] = out.val[2] = vld1q_u8(data + i);
+        out.val[3] = vdupq_n_u8(0xFF);
+        vst4q_u8(outData, out);
+    }
+#endif
+    for (; i < dataLen; ++i)
     {
         *outData++ = data[i];     //R
         *outData++ = data[i];     //G
@@ -157,7 +291,27 @@ void Texture2D::convertI8ToRGBA8888(const unsigned char* data, ssize_t dataLen,
 // IIIIIIIIAAAAAAAA -> RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA
 void Texture2D::convertAI88ToRGBA8888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 1; i < l; i += 2)
+    ssize_t i = 0;
+#if CC_TEXTURE2D_USE_SSE2
+    for (ssize_t l = dataLen - 15; i < l; i += 16, outData += 32)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i intensity = _mm_and_si128(v, _mm_set1_epi16(0x00FF));
+        __m128i ii = _mm_or_si128(intensity, _mm_slli_epi16(intensity, 8));
+        _mm_storeu_si128((__m128i*)outData, _mm_unpacklo_epi16(ii, v));
+        _mm_storeu_si128((__m128i*)(outData + 16), _mm_unpackhi_epi16(ii, v));
+    }
+#elif CC_TEXTURE2D_USE_NEON
+    for (ssize_t l = dataLen - 31; i < l; i += 32, outData += 64)
+    {
+        uint8x16x2_t v = vld2q_u8(data + i);
+        uint8x16x4_t out;
+        out.val[0] = out.val[1] = out.val[2] = v.val[0];
+        out.val[3] = v.val[1];
+        vst4q_u8(outData, out);
+    }
+#endif
+    for (ssize_t l = dataLen - 1; i < l; i += 2)
     {
         *outData++ = data[i];     //R
         *outData++ = data[i];     //G
@@ -274,7 +428,20 @@ void Texture2D::convertAI88ToI8(const unsigned char* data, ssize_t dataLen, unsi
 // RRRRRRRRGGGGGGGGBBBBBBBB -> RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA
 void Texture2D::convertRGB888ToRGBA8888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 3)
+    ssize_t i = 0;
+#if CC_TEXTURE2D_USE_NEON
+    for (ssize_t l = dataLen - 47; i < l; i += 48, outData += 64)
+    {
+        uint8x16x3_t v = vld3q_u8(data + i);
+        uint8x16x4_t out;
+        out.val[0] = v.val[0];
+        out.val[1] = v.val[1];
+        out.val[2] = v.val[2];
+        out.val[3] = vdupq_n_u8(0xFF);
+        vst4q_u8(outData, out);
+    }
+#endif
+    for (ssize_t l = dataLen - 2; i < l; i += 3)
     {
         *outData++ = data[i];         //R
         *outData++ = data[i + 1];     //G
@@ -286,7 +453,19 @@ void Texture2D::convertRGB888ToRGBA8888(const unsigned char* data, ssize_t dataL
 // RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRRRRRGGGGGGGGBBBBBBBB
 void Texture2D::convertRGBA8888ToRGB888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
+    ssize_t i = 0;
+#if CC_TEXTURE2D_USE_NEON
+    for (ssize_t l = dataLen - 63; i < l; i += 64, outData += 48)
+    {
+        uint8x16x4_t v = vld4q_u8(data + i);
+        uint8x16x3_t out;
+        out.val[0] = v.val[0];
+        out.val[1] = v.val[1];
+        out.val[2] = v.val[2];
+        vst3q_u8(outData, out);
+    }
+#endif
+    for (ssize_t l = dataLen - 3; i < l; i += 4)
     {
         *outData++ = data[i];         //R
         *outData++ = data[i + 1];     //G
@@ -298,7 +477,15 @@ void Texture2D::convertRGBA8888ToRGB888(const unsigned char* data, ssize_t dataL
 void Texture2D::convertRGB888ToRGB565(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
     unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 3)
+    ssize_t i = 0;
+#if CC_TEXTURE2D_USE_NEON
+    for (ssize_t l = dataLen - 47; i < l; i += 48, out16 += 16)
+    {
+        uint8x16x3_t v = vld3q_u8(data + i);
+        vst2q_u8((unsigned char*)out16, packRGB565(v.val[0], v.val[1], v.val[2]));
+    }
+#endif
+    for (ssize_t l = dataLen - 2; i < l; i += 3)
     {
         *out16++ = (data[i] & 0x00F8) << 8    //R
             | (data[i + 1] & 0x00FC) << 3     //G
@@ -310,7 +497,22 @@ void Texture2D::convertRGB888ToRGB565(const unsigned char* data, ssize_t dataLen
 void Texture2D::convertRGBA8888ToRGB565(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
     unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
+    ssize_t i = 0;
+#if CC_TEXTURE2D_USE_SSE2
+    for (ssize_t l = dataLen - 31; i < l; i += 32, out16 += 8)
+    {
+        __m128i p0 = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i p1 = _mm_loadu_si128((const __m128i*)(data + i + 16));
+        _mm_storeu_si128((__m128i*)out16, packLow16(rgba8888ToRGB565(p0), rgba8888ToRGB565(p1)));
+    }
+#elif CC_TEXTURE2D_USE_NEON
+    for (ssize_t l = dataLen - 63; i < l; i += 64, out16 += 16)
+    {
+        uint8x16x4_t v = vld4q_u8(data + i);
+        vst2q_u8((unsigned char*)out16, packRGB565(v.val[0], v.val[1], v.val[2]));
+    }
+#endif
+    for (ssize_t l = dataLen - 3; i < l; i += 4)
     {
         *out16++ = (data[i] & 0x00F8) << 8    //R
             | (data[i + 1] & 0x00FC) << 3     //G
@@ -321,7 +523,15 @@ void Texture2D::convertRGBA8888ToRGB565(const unsigned char* data, ssize_t dataL
 // RRRRRRRRGGGGGGGGBBBBBBBB -> IIIIIIII
 void Texture2D::convertRGB888ToI8(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 3)
+    ssize_t i = 0;
+#if CC_TEXTURE2D_USE_NEON
+    for (ssize_t l = dataLen - 47; i < l; i += 48, outData += 16)
+    {
+        uint8x16x3_t v = vld3q_u8(data + i);
+        vst1q_u8(outData, luminance16(v.val[0], v.val[1], v.val[2]));
+    }
+#endif
+    for (ssize_t l = dataLen - 2; i < l; i += 3)
     {
         *outData++ = (data[i] * 299 + data[i + 1] * 587 + data[i + 2] * 114 + 500) / 1000;  //I =  (R*299 + G*587 + B*114 + 500) / 1000
     }
@@ -330,7 +540,24 @@ void Texture2D::convertRGB888ToI8(const unsigned char* data, ssize_t dataLen, un
 // RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> IIIIIIII
 void Texture2D::convertRGBA8888ToI8(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
+    ssize_t i = 0;
+#if CC_TEXTURE2D_USE_SSE2
+    for (ssize_t l = dataLen - 63; i < l; i += 64, outData += 16)
+    {
+        const __m128i* in = (const __m128i*)(data + i);
+        _mm_storeu_si128((__m128i*)outData, packLow8(luminanceRGBA8888(_mm_loadu_si128(in)),
+                                                     luminanceRGBA8888(_mm_loadu_si128(in + 1)),
+                                                     luminanceRGBA8888(_mm_loadu_si128(in + 2)),
+                                                     luminanceRGBA8888(_mm_loadu_si128(in + 3))));
+    }
+#elif CC_TEXTURE2D_USE_NEON
+    for (ssize_t l = dataLen - 63; i < l; i += 64, outData += 16)
+    {
+        uint8x16x4_t v = vld4q_u8(data + i);
+        vst1q_u8(outData, luminance16(v.val[0], v.val[1], v.val[2]));
+    }
+#endif
+    for (ssize_t l = dataLen - 3; i < l; i += 4)
     {
         *outData++ = (data[i] * 299 + data[i + 1] * 587 + data[i + 2] * 114 + 500) / 1000;  //I =  (R*299 + G*587 + B*114 + 500) / 1000
     }
@@ -339,7 +566,23 @@ void Texture2D::convertRGBA8888ToI8(const unsigned char* data, ssize_t dataLen,
 // RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> AAAAAAAA
 void Texture2D::convertRGBA8888ToA8(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen -3; i < l; i += 4)
+    ssize_t i = 0;
+#if CC_TEXTURE2D_USE_SSE2
+    for (ssize_t l = dataLen - 63; i < l; i += 64, outData += 16)
+    {
+        const __m128i* in = (const __m128i*)(data + i);
+        _mm_storeu_si128((__m128i*)outData, packLow8(_mm_srli_epi32(_mm_loadu_si128(in), 24),
+                                                     _mm_srli_epi32(_mm_loadu_si128(in + 1), 24),
+                                                     _mm_srli_epi32(_mm_loadu_si128(in + 2), 24),
+                                                     _mm_srli_epi32(_mm_loadu_si128(in + 3), 24)));
+    }
+#elif CC_TEXTURE2D_USE_NEON
+    for (ssize_t l = dataLen - 63; i < l; i += 64, outData += 16)
+    {
+        vst1q_u8(outData, vld4q_u8(data + i).val[3]);
+    }
+#endif
+    for (ssize_t l = dataLen -3; i < l; i += 4)
     {
         *outData++ = data[i + 3]; //A
     }
@@ -348,7 +591,18 @@ void Texture2D::convertRGBA8888ToA8(const unsigned char* data, ssize_t dataLen,
 // RRRRRRRRGGGGGGGGBBBBBBBB -> IIIIIIIIAAAAAAAA
 void Texture2D::convertRGB888ToAI88(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 3)
+    ssize_t i = 0;
+#if CC_TEXTURE2D_USE_NEON
+    for (ssize_t l = dataLen - 47; i < l; i += 48, outData += 32)
+    {
+        uint8x16x3_t v = vld3q_u8(data + i);
+        uint8x16x2_t out;
+        out.val[0] = luminance16(v.val[0], v.val[1], v.val[2]);
+        out.val[1] = vdupq_n_u8(0xFF);
+        vst2q_u8(outData, out);
+    }
+#endif
+    for (ssize_t l = dataLen - 2; i < l; i += 3)
     {
         *outData++ = (data[i] * 299 + data[i + 1] * 587 + data[i + 2] * 114 + 500) / 1000;  //I =  (R*299 + G*587 + B*114 + 500) / 1000
         *outData++ = 0xFF;
@@ -359,7 +613,26 @@ void Texture2D::convertRGB888ToAI88(const unsigned char* data, ssize_t dataLen,
 // RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> IIIIIIIIAAAAAAAA
 void Texture2D::convertRGBA8888ToAI88(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
+    ssize_t i = 0;
+#if CC_TEXTURE2D_USE_SSE2
+    for (ssize_t l = dataLen - 31; i < l; i += 32, outData += 16)
+    {
+        __m128i p0 = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i p1 = _mm_loadu_si128((const __m128i*)(data + i + 16));
+        _mm_storeu_si128((__m128i*)outData, packLow16(_mm_or_si128(luminanceRGBA8888(p0), _mm_slli_epi32(_mm_srli_epi32(p0, 24), 8)),
+                                                      _mm_or_si128(luminanceRGBA8888(p1), _mm_slli_epi32(_mm_srli_epi32(p1, 24), 8))));
+    }
+#elif CC_TEXTURE2D_USE_NEON
+    for (ssize_t l = dataLen - 63; i < l; i += 64, outData += 32)
+    {
+        uint8x16x4_t v = vld4q_u8(data + i);
+        uint8x16x2_t out;
+        out.val[0] = luminance16(v.val[0], v.val[1], v.val[2]);
+        out.val[1] = v.val[3];
+        vst2q_u8(outData, out);
+    }
+#endif
+    for (ssize_t l = dataLen - 3; i < l; i += 4)
     {
         *outData++ = (data[i] * 299 + data[i + 1] * 587 + data[i + 2] * 114 + 500) / 1000;  //I =  (R*299 + G*587 + B*114 + 500) / 1000
         *outData++ = data[i + 3];
@@ -370,7 +643,15 @@ void Texture2D::convertRGBA8888ToAI88(const unsigned char* data, ssize_t dataLen
 void Texture2D::convertRGB888ToRGBA4444(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
     unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 3)
+    ssize_t i = 0;
+#if CC_TEXTURE2D_USE_NEON
+    for (ssize_t l = dataLen - 47; i < l; i += 48, out16 += 16)
+    {
+        uint8x16x3_t v = vld3q_u8(data + i);
+        vst2q_u8((unsigned char*)out16, packRGBA4444(v.val[0], v.val[1], v.val[2], vdupq_n_u8(0xFF)));
+    }
+#endif
+    for (ssize_t l = dataLen - 2; i < l; i += 3)
     {
         *out16++ = ((data[i] & 0x00F0) << 8           //R
                     | (data[i + 1] & 0x00F0) << 4     //G
@@ -383,7 +664,22 @@ void Texture2D::convertRGB888ToRGBA4444(const unsigned char* data, ssize_t dataL
 void Texture2D::convertRGBA8888ToRGBA4444(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
     unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
+    ssize_t i = 0;
+#if CC_TEXTURE2D_USE_SSE2
+    for (ssize_t l = dataLen - 31; i < l; i += 32, out16 += 8)
+    {
+        __m128i p0 = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i p1 = _mm_loadu_si128((const __m128i*)(data + i + 16));
+        _mm_storeu_si128((__m128i*)out16, packLow16(rgba8888ToRGBA4444(p0), rgba8888ToRGBA4444(p1)));
+    }
+#elif CC_TEXTURE2D_USE_NEON
+    for (ssize_t l = dataLen - 63; i < l; i += 64, out16 += 16)
+    {
+        uint8x16x4_t v = vld4q_u8(data + i);
+        vst2q_u8((unsigned char*)out16, packRGBA4444(v.val[0], v.val[1], v.val[2], v.val[3]));
+    }
+#endif
+    for (ssize_t l = dataLen - 3; i < l; i += 4)
     {
         *out16++ = (data[i] & 0x00F0) << 8    //R
         | (data[i + 1] & 0x00F0) << 4         //G
@@ -396,7 +692,15 @@ void Texture2D::convertRGBA8888ToRGBA4444(const unsigned char* data, ssize_t dat
 void Texture2D::convertRGB888ToRGB5A1(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
     unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 3)
+    ssize_t i = 0;
+#if CC_TEXTURE2D_USE_NEON
+    for (ssize_t l = dataLen - 47; i < l; i += 48, out16 += 16)
+    {
+        uint8x16x3_t v = vld3q_u8(data + i);
+        vst2q_u8((unsigned char*)out16, packRGB5A1(v.val[0], v.val[1], v.val[2], vdupq_n_u8(0xFF)));
+    }
+#endif
+    for (ssize_t l = dataLen - 2; i < l; i += 3)
     {
         *out16++ = (data[i] & 0x00F8) << 8    //R
             | (data[i + 1] & 0x00F8) << 3     //G
@@ -409,7 +713,22 @@ void Texture2D::convertRGB888ToRGB5A1(const unsigned char* data, ssize_t dataLen
 void Texture2D::convertRGBA8888ToRGB5A1(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
     unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 4)
+    ssize_t i = 0;
+#if CC_TEXTURE2D_USE_SSE2
+    for (ssize_t l = dataLen - 31; i < l; i += 32, out16 += 8)
+    {
+        __m128i p0 = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i p1 = _mm_loadu_si128((const __m128i*)(data + i + 16));
+        _mm_storeu_si128((__m128i*)out16, packLow16(rgba8888ToRGB5A1(p0), rgba8888ToRGB5A1(p1)));
+    }
+#elif CC_TEXTURE2D_USE_NEON
+    for (ssize_t l = dataLen - 63; i < l; i += 64, out16 += 16)
+    {
+        uint8x16x4_t v = vld4q_u8(data + i);
+        vst2q_u8((unsigned char*)out16, packRGB5A1(v.val[0], v.val[1], v.val[2], v.val[3]));
+    }
+#endif
+    for (ssize_t l = dataLen - 2; i < l; i += 4)
     {
         *out16++ = (data[i] & 0x00F8) << 8    //R
             | (data[i + 1] & 0x00F8) << 3     //G
@@ -430,6 +749,7 @@ Texture2D::Texture2D()
 , _hasPremultipliedAlpha(false)
 , _hasMipmaps(false)
 , _shaderProgram(nullptr)
+, _memoryReleased(false)
 {
 }
 
@@ -468,6 +788,59 @@ GLuint Texture2D::getName() const
     return _name;
 }
 
+unsigned int Texture2D::getLastUseFrame() const
+{
+    return _name ? GL::getTextureBindFrame(_name) : 0;
+}
+
+ssize_t Texture2D::getMemorySize() const
+{
+    if (_name == 0 || _memoryReleased)
+    {
+        return 0;
+    }
+
+    ssize_t bytes = (ssize_t)_pixelsWide * _pixelsHigh * getBitsPerPixelForFormat() / 8;
+    // a full mipmap chain adds a third
+    return _hasMipmaps ? bytes + bytes / 3 : bytes;
+}
+
+void Texture2D::releaseTextureMemory()
+{
+    if (_name == 0 || _memoryReleased)
+    {
+        return;
+    }
+
+    // a transparent pixel, the tex parameters of the texture are kept
+    static const unsigned char transparentPixel[4] = {0, 0, 0, 0};
+    GL::bindTexture2D(_name);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, transparentPixel);
+
+    if (_hasMipmaps)
+    {
+        // the other levels of the mipmap chain are emptied
+        int width = _pixelsWide;
+        int height = _pixelsHigh;
+        for (int level = 1; width > 1 || height > 1; ++level)
+        {
+            width = MAX(width / 2, 1);
+            height = MAX(height / 2, 1);
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        }
+    }
+
+    CHECK_GL_ERROR_DEBUG(); // clean possible GL error
+
+    _memoryReleased = true;
+}
+
+bool Texture2D::isMemoryReleased() const
+{
+    return _memoryReleased;
+}
+
 Size Texture2D::getContentSize() const
 {
     Size ret;
@@ -547,6 +920,26 @@ bool Texture2D::initWithData(const void *data, ssize_t dataLen, Texture2D::Pixel
     _maxT = contentSize.height / (float)(pixelsHigh);
 }
 
+bool Texture2D::updateWithData(const void *data, int offsetX, int offsetY, int width, int height)
+{
+    if (_name == 0 || _pixelFormatInfoTables.find(_pixelFormat) == _pixelFormatInfoTables.end())
+    {
+        return false;
+    }
+
+    const PixelFormatInfo& info = _pixelFormatInfoTables.at(_pixelFormat);
+    CCASSERT(!info.compressed, "compressed textures can't be updated");
+    CCASSERT(offsetX >= 0 && offsetY >= 0 && offsetX + width <= _pixelsWide && offsetY + height <= _pixelsHigh, "Invalid rect");
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    GL::bindTexture2D(_name);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, offsetX, offsetY, width, height, info.format, info.type, data);
+
+    CHECK_GL_ERROR_DEBUG(); // clean possible GL error
+
+    return true;
+}
+
 bool Texture2D::initWithMipmaps(MipmapInfo* mipmaps, int mipmapsNum, PixelFormat pixelFormat, int pixelsWide, int pixelsHigh)
 {
     //the pixelFormat must be a certain value 
@@ -605,7 +998,12 @@ bool Texture2D::initWithMipmaps(MipmapInfo* mipmaps, int mipmapsNum, PixelFormat
     
 
 
-    glGenTextures(1, &_name);
+    // a texture whose memory was released is filled again under the same name
+    if (!_memoryReleased || _name == 0)
+    {
+        glGenTextures(1, &_name);
+    }
+    _memoryReleased = false;
     GL::bindTexture2D(_name);
 
     if (mipmapsNum == 1)
@@ -223,6 +223,11 @@ public:
     /** Initializes with mipmaps */
     bool initWithMipmaps(MipmapInfo* mipmaps, int mipmapsNum, Texture2D::PixelFormat pixelFormat, int pixelsWide, int pixelsHigh);
 
+    /** Updates a rectangle of an initialized texture with data in the texture's pixel format.
+     The data is tightly packed, its rows are width pixels long.
+     */
+    bool updateWithData(const void *data, int offsetX, int offsetY, int width, int height);
+
     /**
     Drawing extensions to make it easy to draw basic quads using a Texture2D object.
     These functions require GL_TEXTURE_2D and both GL_VERTEX_ARRAY and GL_TEXTURE_COORD_ARRAY client states to be enabled.
@@ -336,6 +341,29 @@ public:
     /** Gets the texture name */
     GLuint getName() const;
     
+    /** Gets the frame in which the texture was last bound to be drawn, see GL::getTextureBindFrame().
+     @since v3.0
+     */
+    unsigned int getLastUseFrame() const;
+    
+    /** Gets the number of bytes taken in video memory, the mipmaps included. 0 when there is no GL texture.
+     @since v3.0
+     */
+    ssize_t getMemorySize() const;
+    
+    /** Replaces the content of the texture by a transparent pixel to free its video memory.
+     The texture keeps its name, its tex parameters and its description, so the commands already recorded with it
+     stay valid, and the next initialization fills the same name again.
+     Used by TextureCache to evict the textures that were not drawn for a while.
+     @since v3.0
+     */
+    void releaseTextureMemory();
+    
+    /** Whether the memory was released by releaseTextureMemory() and the texture was not initialized since.
+     @since v3.0
+     */
+    bool isMemoryReleased() const;
+    
     /** Gets max S */
     GLfloat getMaxS() const;
     /** Sets max S */
@@ -353,16 +381,16 @@ public:
     
 public:
     static const PixelFormatInfoMap& getPixelFormatInfoMap();
-    
-private:
-
-    /**convert functions*/
 
     /**
     Convert the format to the format param you specified, if the format is PixelFormat::Automatic, it will detect it automatically and convert to the closest format for you.
-    It will return the converted format to you. if the outData != data, you must delete it manually.
+    It will return the converted format to you. if the outData != data, you must free it manually.
     */
     static PixelFormat convertDataToFormat(const unsigned char* data, ssize_t dataLen, PixelFormat originFormat, PixelFormat format, unsigned char** outData, ssize_t* outDataLen);
+    
+private:
+
+    /**convert functions*/
 
     static PixelFormat convertI8ToFormat(const unsigned char* data, ssize_t dataLen, PixelFormat format, unsigned char** outData, ssize_t* outDataLen);
     static PixelFormat convertAI88ToFormat(const unsigned char* data, ssize_t dataLen, PixelFormat format, unsigned char** outData, ssize_t* outDataLen);
@@ -433,7 +461,13 @@ protected:
     /** shader program used by drawAtPoint and drawInRect */
     GLProgram* _shaderProgram;
 
+    /** whether the content was replaced by a transparent pixel */
+    bool _memoryReleased;
+
     static const PixelFormatInfoMap _pixelFormatInfoTables;
+
+    friend class TextureCache;
+    friend class VolatileTextureMgr;
 };
 
 
@@ -29,6 +29,8 @@ THE SOFTWARE.
 #include <stack>
 #include <cctype>
 #include <list>
+#include <algorithm>
+#include <climits>
 
 #include "CCTextureCache.h"
 #include "CCTexture2D.h"
@@ -56,13 +58,27 @@ TextureCache * TextureCache::getInstance()
     return Director::getInstance()->getTextureCache();
 }
 
+// number of requests the loading threads may hold at once, further requests wait in the cocos2d thread
+static const size_t ASYNC_QUEUE_CAPACITY = 128;
+// bytes of decoded images uploaded per frame by default
+static const ssize_t DEFAULT_ASYNC_UPLOAD_BUDGET = 4 * 1024 * 1024;
+static const unsigned int MAX_LOADING_THREADS = 4;
+// textures drawn during that many frames are never evicted
+static const unsigned int MIN_EVICTION_IDLE_FRAMES = 60;
+
 TextureCache::TextureCache()
-: _loadingThread(nullptr)
-, _asyncStructQueue(nullptr)
-, _imageInfoQueue(nullptr)
+: _imageInfoQueue(nullptr)
+, _asyncStructsInFlight(0)
+, _queuedAsyncStructs(0)
 , _needQuit(false)
 , _asyncRefCount(0)
+, _asyncUploadBudget(DEFAULT_ASYNC_UPLOAD_BUDGET)
+, _residentBudget(0)
 {
+    for (int i = 0; i < ASYNC_PRIORITY_COUNT; ++i)
+    {
+        _asyncStructQueues[i] = nullptr;
+    }
 }
 
 TextureCache::~TextureCache()
@@ -72,7 +88,37 @@ TextureCache::~TextureCache()
     for( auto it=_textures.begin(); it!=_textures.end(); ++it)
         (it->second)->release();
 
-    CC_SAFE_DELETE(_loadingThread);
+    if (!_loadingThreads.empty())
+    {
+        waitForQuit();
+    }
+
+    //release the requests that were never completed
+    AsyncStruct *asyncStruct = nullptr;
+    for (int i = 0; i < ASYNC_PRIORITY_COUNT; ++i)
+    {
+        for (auto& overflow : _asyncStructOverflow[i])
+        {
+            delete overflow;
+        }
+        if (_asyncStructQueues[i])
+        {
+            while (_asyncStructQueues[i]->pop(asyncStruct))
+            {
+                delete asyncStruct;
+            }
+            delete _asyncStructQueues[i];
+        }
+    }
+    if (_imageInfoQueue)
+    {
+        while (_imageInfoQueue->pop(asyncStruct))
+        {
+            CC_SAFE_RELEASE(asyncStruct->image);
+            delete asyncStruct;
+        }
+        delete _imageInfoQueue;
+    }
 }
 
 void TextureCache::destroyInstance()
@@ -94,6 +140,11 @@ std::string TextureCache::getDescription() const
 }
 
 void TextureCache::addImageAsync(const std::string &path, std::function<void(Texture2D*)> callback)
+{
+    addImageAsync(path, callback, AsyncPriority::NORMAL);
+}
+
+void TextureCache::addImageAsync(const std::string &path, std::function<void(Texture2D*)> callback, AsyncPriority priority)
 {
     Texture2D *texture = nullptr;
 
@@ -109,16 +160,24 @@ void TextureCache::addImageAsync(const std::string &path, std::function<void(Tex
         return;
     }
 
-    // lazy init
-    if (_asyncStructQueue == nullptr)
-    {             
-        _asyncStructQueue = new queue<AsyncStruct*>();
-        _imageInfoQueue   = new deque<ImageInfo*>();        
+    // already being loaded, just wait for it
+    auto pending = _pendingAsyncStructs.find(fullpath);
+    if (pending != _pendingAsyncStructs.end())
+    {
+        pending->second->callbacks.push_back(callback);
+        return;
+    }
 
-        // create a new thread to load images
-        _loadingThread = new std::thread(&TextureCache::loadImage, this);
+    AsyncStruct *data = queueAsyncStruct(fullpath, priority);
+    data->callbacks.push_back(callback);
+}
 
-        _needQuit = false;
+TextureCache::AsyncStruct* TextureCache::queueAsyncStruct(const std::string &fullpath, AsyncPriority priority)
+{
+    // lazy init
+    if (_loadingThreads.empty())
+    {
+        startLoadingThreads();
     }
 
     if (0 == _asyncRefCount)
@@ -129,14 +188,81 @@ void TextureCache::addImageAsync(const std::string &path, std::function<void(Tex
     ++_asyncRefCount;
 
     // generate async struct
-    AsyncStruct *data = new AsyncStruct(fullpath, callback);
+    AsyncStruct *data = new AsyncStruct(fullpath, priority);
+    _pendingAsyncStructs[fullpath] = data;
+
+    // keep the requests of a priority in order if some of them are already waiting
+    auto& overflow = _asyncStructOverflow[(int)priority];
+    if (!overflow.empty() || !pushAsyncStruct(data))
+    {
+        overflow.push_back(data);
+    }
+    return data;
+}
+
+void TextureCache::cancelImageAsync(const std::string &path)
+{
+    std::string fullpath = FileUtils::getInstance()->fullPathForFilename(path);
+
+    auto it = _pendingAsyncStructs.find(fullpath);
+    if (it != _pendingAsyncStructs.end())
+    {
+        // the loading threads skip it, it is deleted once it comes back to the cocos2d thread
+        it->second->cancelled = true;
+        it->second->callbacks.clear();
+        _pendingAsyncStructs.erase(it);
+    }
+}
+
+void TextureCache::cancelAllImageAsync()
+{
+    for (auto& pending : _pendingAsyncStructs)
+    {
+        pending.second->cancelled = true;
+        pending.second->callbacks.clear();
+    }
+    _pendingAsyncStructs.clear();
+}
+
+void TextureCache::startLoadingThreads()
+{
+    if (_imageInfoQueue == nullptr)
+    {
+        for (int i = 0; i < ASYNC_PRIORITY_COUNT; ++i)
+        {
+            _asyncStructQueues[i] = new MPMCQueue<AsyncStruct*>(ASYNC_QUEUE_CAPACITY);
+        }
+        _imageInfoQueue = new MPMCQueue<AsyncStruct*>(ASYNC_QUEUE_CAPACITY);
+    }
 
-    // add async struct into queue
-    _asyncStructQueueMutex.lock();
-    _asyncStructQueue->push(data);
-    _asyncStructQueueMutex.unlock();
+    _needQuit = false;
 
+    // the cocos2d thread keeps running while the images are decoded, leave it a core
+    unsigned int threadCount = std::thread::hardware_concurrency();
+    threadCount = threadCount > 1 ? std::min(threadCount - 1, MAX_LOADING_THREADS) : 1;
+
+    for (unsigned int i = 0; i < threadCount; ++i)
+    {
+        _loadingThreads.push_back(std::thread(&TextureCache::loadImage, this));
+    }
+}
+
+bool TextureCache::pushAsyncStruct(AsyncStruct* asyncStruct)
+{
+    // never give the loading threads more requests than _imageInfoQueue can hold, so that they never wait for the cocos2d thread
+    if (_asyncStructsInFlight >= _imageInfoQueue->getCapacity())
+        return false;
+
+    _asyncStructQueues[(int)asyncStruct->priority]->push(asyncStruct);
+    ++_asyncStructsInFlight;
+
+    {
+        std::lock_guard<std::mutex> lk(_sleepMutex);
+        ++_queuedAsyncStructs;
+    }
     _sleepCondition.notify_one();
+
+    return true;
 }
 
 void TextureCache::loadImage()
@@ -145,109 +271,104 @@ void TextureCache::loadImage()
 
     while (true)
     {
-        std::queue<AsyncStruct*> *pQueue = _asyncStructQueue;
-        _asyncStructQueueMutex.lock();
-        if (pQueue->empty())
         {
-            _asyncStructQueueMutex.unlock();
-            if (_needQuit) {
+            std::unique_lock<std::mutex> lk(_sleepMutex);
+            _sleepCondition.wait(lk, [this]{ return _needQuit || _queuedAsyncStructs > 0; });
+            if (_needQuit)
                 break;
-            }
-            else {
-                std::unique_lock<std::mutex> lk(_sleepMutex);
-                _sleepCondition.wait(lk);
-                continue;
-            }
+
+            // claim one of the queued requests, it was pushed before being counted so it is in one of the queues
+            --_queuedAsyncStructs;
         }
-        else
+
+        asyncStruct = nullptr;
+        while (true)
         {
-            asyncStruct = pQueue->front();
-            pQueue->pop();
-            _asyncStructQueueMutex.unlock();
-        }        
+            int priority = 0;
+            while (priority < ASYNC_PRIORITY_COUNT && !_asyncStructQueues[priority]->pop(asyncStruct))
+                ++priority;
 
-        Image *image = nullptr;
-        bool generateImage = false;
+            if (priority < ASYNC_PRIORITY_COUNT)
+                break;
 
-        auto it = _textures.find(asyncStruct->filename);
-        if( it == _textures.end() )
-        {
-           _imageInfoMutex.lock();
-           ImageInfo *imageInfo;
-           size_t pos = 0;
-           size_t infoSize = _imageInfoQueue->size();
-           for (; pos < infoSize; pos++)
-           {
-               imageInfo = (*_imageInfoQueue)[pos];
-               if(imageInfo->asyncStruct->filename.compare(asyncStruct->filename))
-                   break;
-           }
-           _imageInfoMutex.unlock();
-           if(infoSize == 0 || pos < infoSize)
-               generateImage = true;
+            // another push is still being written
+            std::this_thread::yield();
         }
 
-        if (generateImage)
+        if (!asyncStruct->cancelled)
         {
             const std::string& filename = asyncStruct->filename;
-            // generate image      
-            image = new Image();
-            if (image && !image->initWithImageFileThreadSafe(filename))
+            // generate image
+            Image *image = new Image();
+            if (image->initWithImageFileThreadSafe(filename))
+            {
+                asyncStruct->image = image;
+            }
+            else
             {
                 CC_SAFE_RELEASE(image);
                 CCLOG("can not load %s", filename.c_str());
-                continue;
             }
-        }    
-
-        // generate image info
-        ImageInfo *imageInfo = new ImageInfo();
-        imageInfo->asyncStruct = asyncStruct;
-        imageInfo->image = image;
+        }
 
-        // put the image info into the queue
-        _imageInfoMutex.lock();
-        _imageInfoQueue->push_back(imageInfo);
-        _imageInfoMutex.unlock();
-    }
-    
-	if(_asyncStructQueue != nullptr)
-    {
-        delete _asyncStructQueue;
-	    _asyncStructQueue = nullptr;
-        delete _imageInfoQueue;
-	    _imageInfoQueue = nullptr;
+        // give it back to the cocos2d thread, failed and cancelled requests too so that they get released there
+        _imageInfoQueue->push(asyncStruct);
     }
 }
 
 void TextureCache::addImageAsyncCallBack(float dt)
 {
-    // the image is generated in loading thread
-    std::deque<ImageInfo*> *imagesQueue = _imageInfoQueue;
+    // the images are generated in the loading threads, upload them until the budget of this frame is spent
+    std::vector<std::pair<AsyncStruct*, Texture2D*>> loaded;
+    ssize_t uploadedBytes = 0;
+    AsyncStruct *asyncStruct = nullptr;
 
-    _imageInfoMutex.lock();
-    if (imagesQueue->empty())
-    {
-        _imageInfoMutex.unlock();
-    }
-    else
+    while ((_asyncUploadBudget <= 0 || uploadedBytes < _asyncUploadBudget) && _imageInfoQueue->pop(asyncStruct))
     {
-        ImageInfo *imageInfo = imagesQueue->front();
-        imagesQueue->pop_front();
-        _imageInfoMutex.unlock();
+        --_asyncStructsInFlight;
 
-        AsyncStruct *asyncStruct = imageInfo->asyncStruct;
-        Image *image = imageInfo->image;
+        Image *image = asyncStruct->image;
+        asyncStruct->image = nullptr;
+
+        if (asyncStruct->cancelled)
+        {
+            CC_SAFE_RELEASE(image);
+            delete asyncStruct;
+            --_asyncRefCount;
+            continue;
+        }
 
         const std::string& filename = asyncStruct->filename;
+        _pendingAsyncStructs.erase(filename);
 
         Texture2D *texture = nullptr;
-        if (image)
+        auto it = _textures.find(filename);
+        if (it != _textures.end())
+        {
+            // loaded with addImage() in the meantime, or evicted and drawn again
+            texture = it->second;
+            auto evicted = _evictedTextures.find(texture);
+            if (evicted != _evictedTextures.end())
+            {
+                if (image)
+                {
+                    restoreTexture(texture, image);
+                    uploadedBytes += image->getDataLen();
+                }
+                else
+                {
+                    // don't try again each time it is drawn
+                    evicted->second.frame = UINT_MAX;
+                }
+            }
+        }
+        else if (image)
         {
             // generate texture in render thread
             texture = new Texture2D();
 
             texture->initWithImage(image);
+            uploadedBytes += image->getDataLen();
 
 #if CC_ENABLE_CACHE_TEXTURE_DATA
             // cache the texture file name
@@ -255,30 +376,50 @@ void TextureCache::addImageAsyncCallBack(float dt)
 #endif
             // cache the texture. retain it, since it is added in the map
             _textures.insert( std::make_pair(filename, texture) );
+            _fileTextures.insert( std::make_pair(texture, filename) );
             texture->retain();
 
             texture->autorelease();
         }
-        else
+
+        CC_SAFE_RELEASE(image);
+        loaded.push_back(std::make_pair(asyncStruct, texture));
+    }
+
+    // the loading threads have room again, hand them the waiting requests
+    for (int i = 0; i < ASYNC_PRIORITY_COUNT; ++i)
+    {
+        auto& overflow = _asyncStructOverflow[i];
+        while (!overflow.empty())
         {
-            auto it = _textures.find(asyncStruct->filename);
-            if(it != _textures.end())
-                texture = it->second;
+            asyncStruct = overflow.front();
+            if (asyncStruct->cancelled)
+            {
+                delete asyncStruct;
+                --_asyncRefCount;
+            }
+            else if (!pushAsyncStruct(asyncStruct))
+            {
+                break;
+            }
+            overflow.pop_front();
         }
-        
-        asyncStruct->callback(texture);
-        if(image)
-        {
-            image->release();
-        }       
-        delete asyncStruct;
-        delete imageInfo;
+    }
 
-        --_asyncRefCount;
-        if (0 == _asyncRefCount)
+    // call the callbacks once all the textures of this frame are ready
+    for (auto& info : loaded)
+    {
+        for (auto& callback : info.first->callbacks)
         {
-            Director::getInstance()->getScheduler()->unschedule(schedule_selector(TextureCache::addImageAsyncCallBack), this);
+            callback(info.second);
         }
+        delete info.first;
+        --_asyncRefCount;
+    }
+
+    if (0 == _asyncRefCount)
+    {
+        Director::getInstance()->getScheduler()->unschedule(schedule_selector(TextureCache::addImageAsyncCallBack), this);
     }
 }
 
@@ -299,7 +440,16 @@ Texture2D * TextureCache::addImage(const std::string &path)
     if( it != _textures.end() )
         texture = it->second;
 
-    if (! texture)
+    if (texture && _evictedTextures.find(texture) != _evictedTextures.end())
+    {
+        // evicted, it is needed right now
+        image = new Image();
+        if (image->initWithImageFile(fullpath))
+        {
+            restoreTexture(texture, image);
+        }
+    }
+    else if (! texture)
     {
         // all images are handled by UIImage except PVR extension that is handled by our own handler
         do 
@@ -320,6 +470,7 @@ Texture2D * TextureCache::addImage(const std::string &path)
 #endif
                 // texture already retained, no need to re-retain it
                 _textures.insert( std::make_pair(fullpath, texture) );
+                _fileTextures.insert( std::make_pair(texture, fullpath) );
             }
             else
             {
@@ -416,6 +567,10 @@ void TextureCache::removeAllTextures()
         (it->second)->release();
     }
     _textures.clear();
+    while (!_fileTextures.empty())
+    {
+        forgetTexture(_fileTextures.begin()->first);
+    }
 }
 
 void TextureCache::removeUnusedTextures()
@@ -425,6 +580,7 @@ void TextureCache::removeUnusedTextures()
         if( tex->getReferenceCount() == 1 ) {
             CCLOG("cocos2d: TextureCache: removing unused texture: %s", it->first.c_str());
 
+            forgetTexture(tex);
             tex->release();
             _textures.erase(it++);
         } else {
@@ -443,6 +599,7 @@ void TextureCache::removeTexture(Texture2D* texture)
 
     for( auto it=_textures.cbegin(); it!=_textures.cend(); /* nothing */ ) {
         if( it->second == texture ) {
+            forgetTexture(texture);
             texture->release();
             _textures.erase(it++);
             break;
@@ -462,6 +619,7 @@ void TextureCache::removeTextureForKey(const std::string &textureKeyName)
     }
 
     if( it != _textures.end() ) {
+        forgetTexture(it->second);
         (it->second)->release();
         _textures.erase(it);
     }
@@ -492,10 +650,177 @@ void TextureCache::reloadAllTextures()
 
 void TextureCache::waitForQuit()
 {
-    // notify sub thread to quick
-    _needQuit = true;
-    _sleepCondition.notify_one();
-    if (_loadingThread) _loadingThread->join();
+    // notify sub threads to quit
+    {
+        std::lock_guard<std::mutex> lk(_sleepMutex);
+        _needQuit = true;
+    }
+    _sleepCondition.notify_all();
+
+    for (auto& thread : _loadingThreads)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+    _loadingThreads.clear();
+}
+
+// TextureCache - Resident budget
+
+void TextureCache::setResidentBudget(ssize_t bytes)
+{
+    _residentBudget = bytes;
+
+    // it keeps running without a budget until the evicted textures are reloaded
+    auto scheduler = Director::getInstance()->getScheduler();
+    if (_residentBudget > 0 && !scheduler->isScheduled(schedule_selector(TextureCache::updateResidency), this))
+    {
+        scheduler->schedule(schedule_selector(TextureCache::updateResidency), this, 0, false);
+    }
+}
+
+ssize_t TextureCache::getResidentBytes() const
+{
+    ssize_t bytes = 0;
+    for (auto& entry : _textures)
+    {
+        bytes += entry.second->getMemorySize();
+    }
+    return bytes;
+}
+
+void TextureCache::updateResidency(float dt)
+{
+    // reload the evicted textures drawn since their eviction, forget the ones initialized again by other means
+    for (auto it = _evictedTextures.begin(); it != _evictedTextures.end(); /* nothing */)
+    {
+        Texture2D *texture = it->first;
+        if (!texture->isMemoryReleased())
+        {
+            it = _evictedTextures.erase(it);
+            continue;
+        }
+
+        const EvictedTexture& evicted = it->second;
+        if (texture->getLastUseFrame() >= evicted.frame && _pendingAsyncStructs.find(evicted.filename) == _pendingAsyncStructs.end())
+        {
+            queueAsyncStruct(evicted.filename, AsyncPriority::HIGH);
+        }
+        ++it;
+    }
+
+    if (_residentBudget > 0)
+    {
+        ssize_t residentBytes = getResidentBytes();
+        if (residentBytes > _residentBudget)
+        {
+            evictTextures(residentBytes - _residentBudget);
+        }
+    }
+    else if (_evictedTextures.empty())
+    {
+        Director::getInstance()->getScheduler()->unschedule(schedule_selector(TextureCache::updateResidency), this);
+    }
+}
+
+void TextureCache::evictTextures(ssize_t bytes)
+{
+    // the textures loaded from a file not drawn lately, the coldest first.
+    // the others can't be loaded again.
+    const unsigned int frame = Director::getInstance()->getTotalFrames();
+    std::vector<std::pair<unsigned int, Texture2D*>> candidates;
+    for (auto& entry : _fileTextures)
+    {
+        Texture2D *texture = entry.first;
+        unsigned int lastUseFrame = texture->getLastUseFrame();
+        if (texture->_name != 0 && !texture->isMemoryReleased() && frame - lastUseFrame >= MIN_EVICTION_IDLE_FRAMES)
+        {
+            candidates.push_back(std::make_pair(lastUseFrame, texture));
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    for (auto& candidate : candidates)
+    {
+        Texture2D *texture = candidate.second;
+        const std::string filename = _fileTextures[texture];
+        bytes -= texture->getMemorySize();
+
+        if (texture->getReferenceCount() == 1)
+        {
+            // nothing else uses it, it is loaded again if it is ever added again
+            CCLOG("cocos2d: TextureCache: removing cold texture: %s", filename.c_str());
+            forgetTexture(texture);
+            _textures.erase(filename);
+            texture->release();
+        }
+        else
+        {
+            // the texture keeps its name, so the render caches recorded with it stay valid
+            CCLOG("cocos2d: TextureCache: evicting cold texture: %s", filename.c_str());
+            EvictedTexture evicted;
+            evicted.filename = filename;
+            evicted.pixelFormat = texture->getPixelFormat();
+            evicted.hasMipmaps = texture->hasMipmaps();
+            // releasing the memory binds the texture in this frame
+            evicted.frame = frame + 1;
+
+            texture->releaseTextureMemory();
+            _evictedTextures[texture] = evicted;
+        }
+
+        if (bytes <= 0)
+            break;
+    }
+}
+
+void TextureCache::restoreTexture(Texture2D* texture, Image* image)
+{
+    auto it = _evictedTextures.find(texture);
+    const EvictedTexture& evicted = it->second;
+
+    // the texture still has its tex parameters, initWithImage() resets them
+    Texture2D::TexParams texParams;
+    GLint param = 0;
+    GL::bindTexture2D(texture->_name);
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, &param);
+    texParams.minFilter = param;
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, &param);
+    texParams.magFilter = param;
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, &param);
+    texParams.wrapS = param;
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, &param);
+    texParams.wrapT = param;
+
+    if (texture->initWithImage(image, evicted.pixelFormat))
+    {
+        if (evicted.hasMipmaps && !texture->hasMipmaps())
+        {
+            texture->generateMipmap();
+        }
+        texture->setTexParameters(texParams);
+        _evictedTextures.erase(it);
+    }
+}
+
+void TextureCache::forgetTexture(Texture2D* texture)
+{
+    _fileTextures.erase(texture);
+
+    auto it = _evictedTextures.find(texture);
+    if (it == _evictedTextures.end())
+    {
+        return;
+    }
+
+    // its reload is not wanted anymore
+    auto pending = _pendingAsyncStructs.find(it->second.filename);
+    if (pending != _pendingAsyncStructs.end() && pending->second->callbacks.empty())
+    {
+        pending->second->cancelled = true;
+        _pendingAsyncStructs.erase(pending);
+    }
+    _evictedTextures.erase(it);
 }
 
 std::string TextureCache::getCachedTextureInfo() const
@@ -513,18 +838,19 @@ std::string TextureCache::getCachedTextureInfo() const
 
         Texture2D* tex = it->second;
         unsigned int bpp = tex->getBitsPerPixelForFormat();
-        // Each texture takes up width * height * bytesPerPixel bytes.
-        auto bytes = tex->getPixelsWide() * tex->getPixelsHigh() * bpp / 8;
+        // Each texture takes up width * height * bytesPerPixel bytes, evicted ones nothing.
+        auto bytes = tex->getMemorySize();
         totalBytes += bytes;
         count++;
-        snprintf(buftmp,sizeof(buftmp)-1,"\"%s\" rc=%lu id=%lu %lu x %lu @ %ld bpp => %lu KB\n",
+        snprintf(buftmp,sizeof(buftmp)-1,"\"%s\" rc=%lu id=%lu %lu x %lu @ %ld bpp => %lu KB%s\n",
                it->first.c_str(),
                (long)tex->getReferenceCount(),
-               (long)tex->getName(),
+               (long)tex->_name,
                (long)tex->getPixelsWide(),
                (long)tex->getPixelsHigh(),
                (long)bpp,
-               (long)bytes / 1024);
+               (long)bytes / 1024,
+               _evictedTextures.find(tex) != _evictedTextures.end() ? " (evicted)" : "");
         
         buffer += buftmp;
     }
@@ -532,6 +858,14 @@ std::string TextureCache::getCachedTextureInfo() const
     snprintf(buftmp, sizeof(buftmp)-1, "TextureCache dumpDebugInfo: %ld textures, for %lu KB (%.2f MB)\n", (long)count, (long)totalBytes / 1024, totalBytes / (1024.0f*1024.0f));
     buffer += buftmp;
 
+    snprintf(buftmp, sizeof(buftmp)-1, "TextureCache resident budget: %lu KB, %ld textures evicted\n", (long)_residentBudget / 1024, (long)_evictedTextures.size());
+    buffer += buftmp;
+
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    snprintf(buftmp, sizeof(buftmp)-1, "VolatileTextureMgr: %lu KB of image data kept to reload the textures\n", (long)VolatileTextureMgr::getCachedBytes() / 1024);
+    buffer += buftmp;
+#endif
+
     return buffer;
 }
 
@@ -664,10 +998,29 @@ void VolatileTextureMgr::removeTexture(Texture2D *t)
     }
 }
 
+ssize_t VolatileTextureMgr::getCachedBytes()
+{
+    ssize_t bytes = 0;
+    for (auto vt : _textures)
+    {
+        if (vt->_cashedImageType == VolatileTexture::kImage && vt->_uiImage)
+            bytes += vt->_uiImage->getDataLen();
+        else if (vt->_cashedImageType == VolatileTexture::kImageData)
+            bytes += vt->_dataLen;
+    }
+    return bytes;
+}
+
 void VolatileTextureMgr::reloadAllTextures()
 {
     _isReloading = true;
 
+    // the names kept by the evicted textures belong to the lost context, they are all loaded again
+    for (auto vt : _textures)
+    {
+        vt->_texture->_memoryReleased = false;
+    }
+
     CCLOG("reload all texture");
     auto iter = _textures.begin();
 
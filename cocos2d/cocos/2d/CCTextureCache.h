@@ -32,12 +32,15 @@ THE SOFTWARE.
 #include <mutex>
 #include <thread>
 #include <condition_variable>
-#include <queue>
+#include <atomic>
+#include <deque>
+#include <vector>
 #include <string>
 #include <unordered_map>
 #include <functional>
 
 #include "CCRef.h"
+#include "CCMPMCQueue.h"
 #include "CCTexture2D.h"
 #include "platform/CCImage.h"
 
@@ -119,6 +122,57 @@ public:
     */
     virtual void addImageAsync(const std::string &filepath, std::function<void(Texture2D*)> callback);
 
+    /** Priority of an asynchronous load. Pending images are decoded from the highest priority first.
+     @since v3.0
+     */
+    enum class AsyncPriority
+    {
+        HIGH,
+        NORMAL,
+        LOW,
+    };
+
+    /** Same as addImageAsync(filepath, callback), but lets you choose the order in which the pending images are decoded.
+    * Requesting an image that is already being loaded does not decode it twice, the callback is added to the pending request.
+    * @since v3.0
+    * @js NA
+    * @lua NA
+    */
+    void addImageAsync(const std::string &filepath, std::function<void(Texture2D*)> callback, AsyncPriority priority);
+
+    /** Cancels the pending asynchronous loads of a file. Its callbacks won't be called.
+    * @since v3.0
+    */
+    void cancelImageAsync(const std::string &filepath);
+
+    /** Cancels every pending asynchronous load.
+    * @since v3.0
+    */
+    void cancelAllImageAsync();
+
+    /** Sets the number of bytes of decoded images that may be uploaded to GL each frame.
+    * At least one texture is uploaded per frame, whatever its size. 0 means no limit.
+    * @since v3.0
+    */
+    void setAsyncUploadBudget(ssize_t bytesPerFrame) { _asyncUploadBudget = bytesPerFrame; }
+    ssize_t getAsyncUploadBudget() const { return _asyncUploadBudget; }
+
+    /** Sets the number of bytes the cached textures may take in video memory. 0 means no limit, the default.
+    * Once over budget, the textures loaded from a file that were not drawn for the longest time are evicted:
+    * the unused ones are removed from the cache, the others release their video memory but keep their GL name,
+    * so the render caches recorded with them stay valid and draw nothing until they are back.
+    * An evicted texture is reloaded asynchronously as soon as it is bound again, or synchronously by addImage().
+    * Textures bound during the last second, by the render caches too, are never evicted.
+    * @since v3.0
+    */
+    void setResidentBudget(ssize_t bytes);
+    ssize_t getResidentBudget() const { return _residentBudget; }
+
+    /** Returns the number of bytes the cached textures take in video memory.
+    * @since v3.0
+    */
+    ssize_t getResidentBytes() const;
+
     /** Returns a Texture2D object given an Image.
     * If the image was not previously loaded, it will create a new Texture2D object and it will return it.
     * Otherwise it will return a reference of a previously loaded image.
@@ -180,39 +234,73 @@ public:
 private:
     void addImageAsyncCallBack(float dt);
     void loadImage();
+    void updateResidency(float dt);
 
 public:
     struct AsyncStruct
     {
     public:
-        AsyncStruct(const std::string& fn, std::function<void(Texture2D*)> f) : filename(fn), callback(f) {}
+        AsyncStruct(const std::string& fn, AsyncPriority p) : filename(fn), priority(p), image(nullptr), cancelled(false) {}
 
         std::string filename;
-        std::function<void(Texture2D*)> callback;
+        std::vector<std::function<void(Texture2D*)>> callbacks;
+        AsyncPriority priority;
+        // decoded by a loading thread, nullptr if the file could not be loaded
+        Image* image;
+        std::atomic<bool> cancelled;
     };
 
 protected:
-    typedef struct _ImageInfo
+    static const int ASYNC_PRIORITY_COUNT = 3;
+
+    void startLoadingThreads();
+    bool pushAsyncStruct(AsyncStruct* asyncStruct);
+    AsyncStruct* queueAsyncStruct(const std::string& fullpath, AsyncPriority priority);
+
+    // what is needed to initialize an evicted texture again like it was
+    struct EvictedTexture
     {
-        AsyncStruct *asyncStruct;
-        Image        *image;
-    } ImageInfo;
-    
-    std::thread* _loadingThread;
+        std::string filename;
+        Texture2D::PixelFormat pixelFormat;
+        bool hasMipmaps;
+        // the texture is reloaded once it is bound from this frame on
+        unsigned int frame;
+    };
+
+    void evictTextures(ssize_t bytes);
+    void restoreTexture(Texture2D* texture, Image* image);
+    void forgetTexture(Texture2D* texture);
 
-    std::queue<AsyncStruct*>* _asyncStructQueue;
-    std::deque<ImageInfo*>* _imageInfoQueue;
+    std::vector<std::thread> _loadingThreads;
 
-    std::mutex _asyncStructQueueMutex;
-    std::mutex _imageInfoMutex;
+    // requests waiting to be decoded, one queue per priority
+    MPMCQueue<AsyncStruct*>* _asyncStructQueues[ASYNC_PRIORITY_COUNT];
+    // decoded images waiting to be uploaded in the cocos2d thread
+    MPMCQueue<AsyncStruct*>* _imageInfoQueue;
+    // requests handed to the loading threads and not yet uploaded
+    size_t _asyncStructsInFlight;
+    // requests waiting for room in the queues, only used by the cocos2d thread
+    std::deque<AsyncStruct*> _asyncStructOverflow[ASYNC_PRIORITY_COUNT];
+    // requests not yet uploaded, by full path, only used by the cocos2d thread
+    std::unordered_map<std::string, AsyncStruct*> _pendingAsyncStructs;
 
     std::mutex _sleepMutex;
     std::condition_variable _sleepCondition;
+    // number of requests pushed to the queues and not yet taken by a loading thread, guarded by _sleepMutex
+    int _queuedAsyncStructs;
 
     bool _needQuit;
 
     int _asyncRefCount;
 
+    ssize_t _asyncUploadBudget;
+
+    ssize_t _residentBudget;
+    // the textures whose memory was released, only used by the cocos2d thread
+    std::unordered_map<Texture2D*, EvictedTexture> _evictedTextures;
+    // the textures loaded from a file, by their key, the only ones that can be evicted
+    std::unordered_map<Texture2D*, std::string> _fileTextures;
+
     std::unordered_map<std::string, Texture2D*> _textures;
 };
 
@@ -267,6 +355,8 @@ public:
     static void setTexParameters(Texture2D *t, const Texture2D::TexParams &texParams);
     static void removeTexture(Texture2D *t);
     static void reloadAllTextures();
+    /** Number of bytes of image data kept in memory to reload the textures */
+    static ssize_t getCachedBytes();
 public:
     static std::list<VolatileTexture*> _textures;
     static bool _isReloading;
@@ -181,6 +181,22 @@ Only valid for cocos2d-mac. Not supported on cocos2d-ios.
 #endif
 
 
+/** @def CC_RENDERER_USE_MAP_BUFFER_RANGE
+ If enabled, the Renderer writes the batched quads straight into its streaming VBO with
+ glMapBufferRange and uses sync objects to know when a section of the VBO is free again.
+ It is only used when the driver exposes GL_ARB_map_buffer_range and GL_ARB_sync,
+ otherwise the VBO is updated with glBufferSubData.
+
+ Enabled by default on the platforms using desktop OpenGL through GLEW.
+ */
+#ifndef CC_RENDERER_USE_MAP_BUFFER_RANGE
+    #if (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX) || (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+        #define CC_RENDERER_USE_MAP_BUFFER_RANGE 1
+    #else
+        #define CC_RENDERER_USE_MAP_BUFFER_RANGE 0
+    #endif
+#endif
+
 /** @def CC_USE_LA88_LABELS
  If enabled, it will use LA88 (Luminance Alpha 16-bit textures) for LabelTTF objects.
  If it is disabled, it will use A8 (Alpha 8-bit textures).
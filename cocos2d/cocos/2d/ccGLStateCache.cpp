@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "CCDirector.h"
 #include "ccConfig.h"
 #include "CCConfiguration.h"
+#include <vector>
 
 // extern
 #include "kazmath/GL/matrix.h"
@@ -43,6 +44,8 @@ namespace
     static bool        s_vertexAttribPosition = false;
     static bool        s_vertexAttribColor = false;
     static bool        s_vertexAttribTexCoords = false;
+    // frame of the last bind of each texture, by name
+    static std::vector<unsigned int> s_textureBindFrames;
     
 #if CC_ENABLE_GL_STATE_CACHE
     
@@ -155,6 +158,12 @@ void bindTexture2D(GLuint textureId)
 
 void bindTexture2DN(GLuint textureUnit, GLuint textureId)
 {
+    if (textureId >= s_textureBindFrames.size())
+    {
+        s_textureBindFrames.resize(textureId + 1, 0);
+    }
+    s_textureBindFrames[textureId] = Director::getInstance()->getTotalFrames();
+
 #if CC_ENABLE_GL_STATE_CACHE
     CCASSERT(textureUnit < kMaxActiveTexture, "textureUnit is too big");
     if (s_currentBoundTexture[textureUnit] != textureId)
@@ -185,6 +194,16 @@ void deleteTextureN(GLuint textureUnit, GLuint textureId)
 #endif // CC_ENABLE_GL_STATE_CACHE
     
 	glDeleteTextures(1, &textureId);
+
+    if (textureId < s_textureBindFrames.size())
+    {
+        s_textureBindFrames[textureId] = 0;
+    }
+}
+
+unsigned int getTextureBindFrame(GLuint textureId)
+{
+    return textureId < s_textureBindFrames.size() ? s_textureBindFrames[textureId] : 0;
 }
 
 void activeTexture(GLenum texture)
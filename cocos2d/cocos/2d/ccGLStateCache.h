@@ -129,6 +129,12 @@ void CC_DLL deleteTexture(GLuint textureId);
  */
 void CC_DLL deleteTextureN(GLuint textureUnit, GLuint textureId);
 
+/** Returns the frame in which the texture was last bound by bindTexture2D() or bindTexture2DN(), 0 if it never was.
+ Like the binding itself, it is only tracked on the cocos2d thread.
+ @since v3.0
+ */
+unsigned int CC_DLL getTextureBindFrame(GLuint textureId);
+
 /** Select active texture unit.
  If CC_ENABLE_GL_STATE_CACHE is disabled, it will call glActiveTexture() directly.
  @since v3.0
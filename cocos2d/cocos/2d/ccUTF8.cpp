@@ -308,6 +308,20 @@ unsigned short* cc_utf8_to_utf16(const char* str_old, int length/* = -1 */, int*
     return str_new;
 }
 
+void cc_utf8_to_utf16_vec(const char* str, std::vector<unsigned short>& outString)
+{
+    long len = cc_utf8_strlen(str, -1);
+
+    // the capacity of the vector is kept when the string gets shorter
+    outString.resize(len + 1);
+    for (long i = 0; i < len; ++i)
+    {
+        outString[i] = cc_utf8_get_char(str);
+        str = cc_utf8_next_char(str);
+    }
+    outString[len] = 0;
+}
+
 std::vector<unsigned short> cc_utf16_vec_from_utf16_str(const unsigned short* str)
 {
     int len = cc_wcslen(str);
@@ -86,6 +86,15 @@ CC_DLL std::vector<unsigned short> cc_utf16_vec_from_utf16_str(const unsigned sh
  * */
 CC_DLL unsigned short* cc_utf8_to_utf16(const char* str_old, int length = -1, int* rUtf16Size = nullptr);
 
+/**
+ * Converts a null terminated UTF-8 string to UTF-16 into a vector, without
+ * allocating when the vector already has the capacity.
+ *
+ * @param str       pointer to the start of a C string.
+ * @param outString the UTF-16 string followed by a 0, its size is the length plus one.
+ * */
+CC_DLL void cc_utf8_to_utf16_vec(const char* str, std::vector<unsigned short>& outString);
+
 /**
  * Convert a string from UTF-16 to UTF-8. The result will be null terminated.
  *
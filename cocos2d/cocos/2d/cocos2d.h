@@ -129,6 +129,7 @@ THE SOFTWARE.
 #include "renderer/CCQuadCommand.h"
 #include "renderer/CCRenderCommand.h"
 #include "renderer/CCRenderCommandPool.h"
+#include "renderer/CCFrameArena.h"
 #include "renderer/CCRenderMaterial.h"
 #include "renderer/CCRenderer.h"
 
@@ -217,6 +218,7 @@ THE SOFTWARE.
 #include "CCNotificationCenter.h"
 #include "CCProfiling.h"
 #include "CCConsole.h"
+#include "CCJobPool.h"
 #include "CCUserDefault.h"
 #include "CCVertex.h"
 
@@ -28,7 +28,7 @@ THE SOFTWARE.
 #include "CCDirector.h"
 #include "CCSet.h"
 #include "CCEventDispatcher.h"
-
+#include "platform/CCGLHeadless.h"
 
 NS_CC_BEGIN
 
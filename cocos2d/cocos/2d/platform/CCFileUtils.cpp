@@ -31,6 +31,22 @@ THE SOFTWARE.
 #include "tinyxml2.h"
 #include "unzip.h"
 #include <stack>
+#include <algorithm>
+
+#if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#endif
+
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+#include <android/asset_manager.h>
+#include "android/CCFileUtilsAndroid.h"
+#endif
 
 using namespace std;
 
@@ -463,6 +479,304 @@ bool FileUtils::writeToFile(ValueMap& dict, const std::string &fullPath) {return
 
 #endif /* (CC_TARGET_PLATFORM != CC_PLATFORM_IOS) && (CC_TARGET_PLATFORM != CC_PLATFORM_MAC) */
 
+// Asset packs, a header, the entries sorted by hash, their names, then the data of the files.
+// The data are aligned for SIMD loads and followed by a nul, so text files can be read as strings.
+static const char ASSET_PACK_MAGIC[4] = {'C', 'C', 'P', 'K'};
+static const uint32_t ASSET_PACK_VERSION = 1;
+static const uint32_t ASSET_PACK_ALIGNMENT = 16;
+
+struct AssetPackHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t size;
+    uint32_t entries;
+    uint32_t entryCount;
+    uint32_t chars;
+    uint32_t charCount;
+    uint32_t reserved;
+};
+
+struct AssetPackEntry
+{
+    uint32_t hash;
+    uint32_t name;
+    uint32_t offset;
+    uint32_t size;
+};
+
+// FNV-1a
+static uint32_t hashAssetName(const std::string& name)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < name.size(); i++)
+    {
+        hash = (hash ^ (unsigned char)name[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static bool isEntryHashLess(const AssetPackEntry& entry, uint32_t hash)
+{
+    return (entry.hash) < hash;
+}
+
+static bool isEntryLess(const AssetPackEntry& a, const AssetPackEntry& b)
+{
+    return (a.hash) < (b.hash);
+}
+
+/** A mounted asset pack, mapped in memory for its whole life */
+class AssetPack
+{
+public:
+    /** Maps and checks a pack, nullptr if it can't be used */
+    static AssetPack* create(const std::string& fullPath)
+    {
+        AssetPack *pack = new AssetPack(fullPath);
+        if (!pack->map() || !pack->isValid())
+        {
+            delete pack;
+            return nullptr;
+        }
+        pack->_header = (const AssetPackHeader*)pack->_bytes;
+        return pack;
+    }
+
+    ~AssetPack()
+    {
+        if (_mapped)
+        {
+#if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+            UnmapViewOfFile(_bytes);
+#else
+            munmap(_mapping, _mappingSize);
+#endif
+        }
+    }
+
+    inline const std::string& getFullPath() const { return _fullPath; }
+    inline unsigned char* getBytes(const AssetPackEntry *entry) const { return _bytes + entry->offset; }
+
+    /** The entry of the file with the given name, nullptr when there is none */
+    const AssetPackEntry* findEntry(const std::string& name, uint32_t hash) const
+    {
+        const AssetPackEntry *entries = (const AssetPackEntry*)(_bytes + _header->entries);
+        const AssetPackEntry *entriesEnd = entries + _header->entryCount;
+        const char *chars = (const char*)_bytes + _header->chars;
+        for (auto it = std::lower_bound(entries, entriesEnd, hash, isEntryHashLess); it != entriesEnd && it->hash == hash; ++it)
+        {
+            if (name.compare(chars + it->name) == 0)
+                return it;
+        }
+        return nullptr;
+    }
+
+private:
+    AssetPack(const std::string& fullPath)
+    : _fullPath(fullPath)
+    , _bytes(nullptr)
+    , _size(0)
+    , _mapped(false)
+    , _mapping(nullptr)
+    , _mappingSize(0)
+    , _header(nullptr)
+    {
+    }
+
+    bool map()
+    {
+        // The pages are copied on write, so a decoder writing to a view can't break the file
+#if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+        WCHAR wszBuf[512] = {0};
+        MultiByteToWideChar(CP_UTF8, 0, _fullPath.c_str(), -1, wszBuf, sizeof(wszBuf)/sizeof(wszBuf[0]));
+        HANDLE fileHandle = ::CreateFileW(wszBuf, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, NULL, NULL);
+        if (fileHandle != INVALID_HANDLE_VALUE)
+        {
+            _size = ::GetFileSize(fileHandle, NULL);
+            HANDLE mappingHandle = ::CreateFileMappingW(fileHandle, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+            if (mappingHandle)
+            {
+                _bytes = (unsigned char*)::MapViewOfFile(mappingHandle, FILE_MAP_COPY, 0, 0, 0);
+                ::CloseHandle(mappingHandle);
+            }
+            ::CloseHandle(fileHandle);
+        }
+        _mapped = _bytes != nullptr;
+#else
+        int fd = -1;
+        off_t start = 0;
+        off_t length = 0;
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+        if (_fullPath[0] != '/')
+        {
+            // A file stored uncompressed in the apk is a range of the apk, mapped through its descriptor
+            std::string relativePath = _fullPath.compare(0, strlen("assets/"), "assets/") == 0 ? _fullPath.substr(strlen("assets/")) : _fullPath;
+            AAssetManager *assetManager = FileUtilsAndroid::getAssetManager();
+            AAsset *asset = assetManager ? AAssetManager_open(assetManager, relativePath.c_str(), AASSET_MODE_UNKNOWN) : nullptr;
+            if (asset)
+            {
+                fd = AAsset_openFileDescriptor(asset, &start, &length);
+                AAsset_close(asset);
+            }
+        }
+        else
+#endif
+        {
+            fd = open(_fullPath.c_str(), O_RDONLY);
+            struct stat st;
+            if (fd >= 0 && fstat(fd, &st) == 0)
+            {
+                length = st.st_size;
+            }
+        }
+        if (fd >= 0)
+        {
+            if (length > 0)
+            {
+                // mmap wants an offset on a page boundary
+                off_t offset = start & ~((off_t)sysconf(_SC_PAGESIZE) - 1);
+                size_t mappingSize = (size_t)(length + start - offset);
+                void *mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, offset);
+                if (mapping != MAP_FAILED)
+                {
+                    _mapping = mapping;
+                    _mappingSize = mappingSize;
+                    _bytes = (unsigned char*)mapping + (start - offset);
+                    _size = length;
+                    _mapped = true;
+                }
+            }
+            close(fd);
+        }
+#endif
+        if (!_mapped)
+        {
+            // A pack compressed in the apk has no descriptor, it is read in memory once instead
+            _content = FileUtils::getInstance()->getDataFromFile(_fullPath);
+            _bytes = _content.getBytes();
+            _size = _content.getSize();
+        }
+        return _bytes != nullptr;
+    }
+
+    /** Checks the header, the entries and the names once, so they are used without any check afterwards */
+    bool isValid() const
+    {
+        if (_size < (ssize_t)sizeof(AssetPackHeader))
+        {
+            return false;
+        }
+
+        const AssetPackHeader *header = (const AssetPackHeader*)_bytes;
+        if (memcmp(header->magic, ASSET_PACK_MAGIC, sizeof(ASSET_PACK_MAGIC)) != 0 || header->version != ASSET_PACK_VERSION
+            || header->size != (uint64_t)_size)
+        {
+            return false;
+        }
+        if ((header->entries & 3) != 0 || header->entries > header->size
+            || header->entryCount > (header->size - header->entries) / sizeof(AssetPackEntry)
+            || header->chars > header->size || header->charCount > header->size - header->chars)
+        {
+            return false;
+        }
+
+        const char *chars = (const char*)_bytes + header->chars;
+        if (header->charCount > 0 && chars[header->charCount - 1] != '\0')
+        {
+            return false;
+        }
+
+        // every file keeps its trailing nul inside the pack
+        const AssetPackEntry *entries = (const AssetPackEntry*)(_bytes + header->entries);
+        for (uint32_t i = 0; i < header->entryCount; i++)
+        {
+            if (entries[i].name >= header->charCount || (i > 0 && entries[i].hash < entries[i - 1].hash)
+                || entries[i].offset > header->size || entries[i].size >= header->size - entries[i].offset)
+                return false;
+        }
+        return true;
+    }
+
+    std::string _fullPath;
+    unsigned char *_bytes;
+    ssize_t _size;
+    bool _mapped;
+    void *_mapping;
+    size_t _mappingSize;
+    Data _content;
+    const AssetPackHeader *_header;
+};
+
+// Lists the files below a directory, by their path relative to it
+static void listAssetFiles(const std::string& directory, const std::string& prefix, std::vector<std::string>& files)
+{
+#if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    WCHAR wszBuf[512] = {0};
+    MultiByteToWideChar(CP_UTF8, 0, (directory + prefix + "*").c_str(), -1, wszBuf, sizeof(wszBuf)/sizeof(wszBuf[0]));
+    WIN32_FIND_DATAW findData;
+    HANDLE findHandle = ::FindFirstFileW(wszBuf, &findData);
+    if (findHandle == INVALID_HANDLE_VALUE)
+    {
+        return;
+    }
+    do
+    {
+        char name[512] = {0};
+        WideCharToMultiByte(CP_UTF8, 0, findData.cFileName, -1, name, sizeof(name), NULL, NULL);
+        if (name[0] == '.')
+            continue;
+
+        if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+            listAssetFiles(directory, prefix + name + "/", files);
+        else
+            files.push_back(prefix + name);
+    } while (::FindNextFileW(findHandle, &findData));
+    ::FindClose(findHandle);
+#else
+    DIR *dir = opendir((directory + prefix).c_str());
+    if (!dir)
+    {
+        return;
+    }
+    while (struct dirent *dirEntry = readdir(dir))
+    {
+        std::string name = dirEntry->d_name;
+        if (name[0] == '.')
+            continue;
+
+        struct stat st;
+        if (stat((directory + prefix + name).c_str(), &st) != 0)
+            continue;
+
+        if (S_ISDIR(st.st_mode))
+            listAssetFiles(directory, prefix + name + "/", files);
+        else if (S_ISREG(st.st_mode))
+            files.push_back(prefix + name);
+    }
+    closedir(dir);
+#endif
+}
+
+// Tells whether two paths name the same file, whatever their form (relative, "./", backslashes or links)
+static bool isSameFile(const std::string& path1, const std::string& path2)
+{
+#if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    WCHAR wszPath1[512] = {0};
+    WCHAR wszPath2[512] = {0};
+    WCHAR wszFullPath1[512] = {0};
+    WCHAR wszFullPath2[512] = {0};
+    MultiByteToWideChar(CP_UTF8, 0, path1.c_str(), -1, wszPath1, sizeof(wszPath1)/sizeof(wszPath1[0]));
+    MultiByteToWideChar(CP_UTF8, 0, path2.c_str(), -1, wszPath2, sizeof(wszPath2)/sizeof(wszPath2[0]));
+    return ::GetFullPathNameW(wszPath1, sizeof(wszFullPath1)/sizeof(wszFullPath1[0]), wszFullPath1, NULL) != 0
+        && ::GetFullPathNameW(wszPath2, sizeof(wszFullPath2)/sizeof(wszFullPath2[0]), wszFullPath2, NULL) != 0
+        && ::lstrcmpiW(wszFullPath1, wszFullPath2) == 0;
+#else
+    struct stat st1, st2;
+    return stat(path1.c_str(), &st1) == 0 && stat(path2.c_str(), &st2) == 0
+        && st1.st_dev == st2.st_dev && st1.st_ino == st2.st_ino;
+#endif
+}
 
 FileUtils* FileUtils::s_sharedFileUtils = nullptr;
 
@@ -478,6 +792,10 @@ FileUtils::FileUtils()
 
 FileUtils::~FileUtils()
 {
+    for (auto pack : _assetPacks)
+    {
+        delete pack;
+    }
 }
 
 
@@ -493,7 +811,7 @@ void FileUtils::purgeCachedEntries()
     _fullPathCache.clear();
 }
 
-static Data getData(const std::string& filename, bool forString)
+Data FileUtils::getData(const std::string& filename, bool forString)
 {
     CCASSERT(!filename.empty(), "Invalid filename!");
     
@@ -509,7 +827,7 @@ static Data getData(const std::string& filename, bool forString)
     do
     {
         // Read the file from hardware
-        std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filename);
+        std::string fullPath = fullPathForFilename(filename);
         FILE *fp = fopen(fullPath.c_str(), mode);
         CC_BREAK_IF(!fp);
         fseek(fp,0,SEEK_END);
@@ -546,6 +864,12 @@ static Data getData(const std::string& filename, bool forString)
 
 std::string FileUtils::getStringFromFile(const std::string& filename)
 {
+    Data view;
+    if (readAssetPackFile(filename, view))
+    {
+        return std::string((const char*)view.getBytes(), view.getSize());
+    }
+
     Data data = getData(filename, true);
     if (data.isNull())
     	return "";
@@ -555,36 +879,32 @@ std::string FileUtils::getStringFromFile(const std::string& filename)
 
 Data FileUtils::getDataFromFile(const std::string& filename)
 {
+    Data view;
+    if (readAssetPackFile(filename, view))
+    {
+        return view;
+    }
     return getData(filename, false);
 }
 
 unsigned char* FileUtils::getFileData(const std::string& filename, const char* mode, ssize_t *size)
 {
-    unsigned char * buffer = nullptr;
     CCASSERT(!filename.empty() && size != nullptr && mode != nullptr, "Invalid parameters.");
-    *size = 0;
-    do
-    {
-        // read the file from hardware
-        const std::string fullPath = fullPathForFilename(filename);
-        FILE *fp = fopen(fullPath.c_str(), mode);
-        CC_BREAK_IF(!fp);
-        
-        fseek(fp,0,SEEK_END);
-        *size = ftell(fp);
-        fseek(fp,0,SEEK_SET);
-        buffer = (unsigned char*)malloc(*size);
-        *size = fread(buffer,sizeof(unsigned char), *size,fp);
-        fclose(fp);
-    } while (0);
-    
-    if (! buffer)
+
+    Data data;
+    if (readAssetPackFile(filename, data))
     {
-        std::string msg = "Get data from file(";
-        msg.append(filename).append(") failed!");
-        
-        CCLOG("%s", msg.c_str());
+        unsigned char* buffer = (unsigned char*)malloc(data.getSize());
+        memcpy(buffer, data.getBytes(), data.getSize());
+        *size = data.getSize();
+        return buffer;
     }
+
+    // the caller owns the buffer read from the file
+    data = getData(filename, false);
+    unsigned char* buffer = data.getBytes();
+    *size = data.getSize();
+    data.fastSet(nullptr, 0);
     return buffer;
 }
 
@@ -688,6 +1008,40 @@ std::string FileUtils::fullPathForFilename(const std::string &filename)
     
 	std::string fullpath;
     
+    // The files of the asset packs are found without touching the file system
+    if (!_assetPacks.empty())
+    {
+        std::string file = newFilename;
+        std::string file_path = "";
+        size_t pos = newFilename.find_last_of("/");
+        if (pos != std::string::npos)
+        {
+            file_path = newFilename.substr(0, pos+1);
+            file = newFilename.substr(pos+1);
+        }
+
+        for (auto searchIt = _searchPathArray.cbegin(); searchIt != _searchPathArray.cend(); ++searchIt) {
+            for (auto resolutionIt = _searchResolutionsOrderArray.cbegin(); resolutionIt != _searchResolutionsOrderArray.cend(); ++resolutionIt) {
+                
+                fullpath = *searchIt + file_path + *resolutionIt;
+                if (fullpath.size() && fullpath[fullpath.size()-1] != '/') {
+                    fullpath += '/';
+                }
+                fullpath += file;
+                
+                if (isFileInAssetPacks(fullpath))
+                {
+                    if (!isAbsolutePath(fullpath))
+                    {
+                        fullpath.insert(0, _defaultResRootPath);
+                    }
+                    _fullPathCache.insert(std::pair<std::string, std::string>(filename, fullpath));
+                    return fullpath;
+                }
+            }
+        }
+    }
+    
     for (auto searchIt = _searchPathArray.cbegin(); searchIt != _searchPathArray.cend(); ++searchIt) {
         for (auto resolutionIt = _searchResolutionsOrderArray.cbegin(); resolutionIt != _searchResolutionsOrderArray.cend(); ++resolutionIt) {
             
@@ -709,6 +1063,219 @@ std::string FileUtils::fullPathForFilename(const std::string &filename)
     return filename;
 }
 
+// The name of a file in the asset packs, its path relative to the resource root
+static std::string getAssetName(const std::string& path, const std::string& rootPath, bool isAbsolute)
+{
+    std::string name = path;
+    std::string root = rootPath;
+    std::replace(name.begin(), name.end(), '\\', '/');
+    std::replace(root.begin(), root.end(), '\\', '/');
+    
+    if (!root.empty() && name.compare(0, root.size(), root) == 0)
+    {
+        name.erase(0, root.size());
+    }
+    else if (isAbsolute)
+    {
+        return "";
+    }
+    
+    while (name.compare(0, 2, "./") == 0)
+    {
+        name.erase(0, 2);
+    }
+    return name;
+}
+
+bool FileUtils::addAssetPack(const std::string& packFilePath)
+{
+    std::string fullPath = fullPathForFilename(packFilePath);
+    for (auto pack : _assetPacks)
+    {
+        if (pack->getFullPath() == fullPath)
+            return true;
+    }
+    
+    AssetPack *pack = AssetPack::create(fullPath);
+    if (!pack)
+    {
+        CCLOG("cocos2d: FileUtils: %s is not a valid asset pack.", packFilePath.c_str());
+        return false;
+    }
+    
+    _assetPacks.push_back(pack);
+    _fullPathCache.clear();
+    return true;
+}
+
+void FileUtils::removeAssetPack(const std::string& packFilePath)
+{
+    std::string fullPath = fullPathForFilename(packFilePath);
+    for (auto iter = _assetPacks.begin(); iter != _assetPacks.end(); ++iter)
+    {
+        if ((*iter)->getFullPath() == fullPath)
+        {
+            delete *iter;
+            _assetPacks.erase(iter);
+            _fullPathCache.clear();
+            return;
+        }
+    }
+}
+
+void FileUtils::removeAllAssetPacks()
+{
+    for (auto pack : _assetPacks)
+    {
+        delete pack;
+    }
+    _assetPacks.clear();
+    _fullPathCache.clear();
+}
+
+bool FileUtils::getDataFromAssetPacks(const std::string& fullPath, Data& data) const
+{
+    if (_assetPacks.empty() || fullPath.empty())
+    {
+        return false;
+    }
+    
+    const std::string name = getAssetName(fullPath, _defaultResRootPath, isAbsolutePath(fullPath));
+    if (name.empty())
+    {
+        return false;
+    }
+    
+    const uint32_t hash = hashAssetName(name);
+    for (auto iter = _assetPacks.crbegin(); iter != _assetPacks.crend(); ++iter)
+    {
+        const AssetPackEntry *entry = (*iter)->findEntry(name, hash);
+        if (entry)
+        {
+            data.setView((*iter)->getBytes(entry), entry->size);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FileUtils::isFileInAssetPacks(const std::string& fullPath) const
+{
+    Data view;
+    return getDataFromAssetPacks(fullPath, view);
+}
+
+bool FileUtils::readAssetPackFile(const std::string& filename, Data& data)
+{
+    return !_assetPacks.empty() && getDataFromAssetPacks(fullPathForFilename(filename), data);
+}
+
+bool FileUtils::buildAssetPack(const std::string& directory, const std::string& packFilePath)
+{
+    std::string root = directory;
+    if (root.size() && root[root.size()-1] != '/' && root[root.size()-1] != '\\') {
+        root += '/';
+    }
+    
+    // the files are sorted by name first, so the same tree always gives the same pack
+    std::vector<std::string> names;
+    listAssetFiles(root, "", names);
+    std::sort(names.begin(), names.end());
+    
+    std::vector<char> chars;
+    std::vector<AssetPackEntry> entries;
+    for (const auto& name : names)
+    {
+        // a pack written into the directory it packs is left out of the next one
+        if (isSameFile(root + name, packFilePath))
+            continue;
+        
+        FILE *fp = fopen((root + name).c_str(), "rb");
+        if (!fp)
+        {
+            CCLOG("cocos2d: FileUtils: can't open %s to pack it.", name.c_str());
+            return false;
+        }
+        fseek(fp, 0, SEEK_END);
+        long size = ftell(fp);
+        fclose(fp);
+        
+        AssetPackEntry entry;
+        entry.hash = hashAssetName(name);
+        entry.name = (uint32_t)chars.size();
+        entry.offset = 0;
+        entry.size = (uint32_t)size;
+        entries.push_back(entry);
+        chars.insert(chars.end(), name.c_str(), name.c_str() + name.size() + 1);
+    }
+    std::stable_sort(entries.begin(), entries.end(), isEntryLess);
+    
+    AssetPackHeader header;
+    memcpy(header.magic, ASSET_PACK_MAGIC, sizeof(ASSET_PACK_MAGIC));
+    header.version = ASSET_PACK_VERSION;
+    header.entries = sizeof(AssetPackHeader);
+    header.entryCount = (uint32_t)entries.size();
+    header.chars = header.entries + (uint32_t)(entries.size() * sizeof(AssetPackEntry));
+    header.charCount = (uint32_t)chars.size();
+    header.reserved = 0;
+    
+    // the data follow in the order of the entries, each one padded with at least a nul
+    uint64_t offset = header.chars + header.charCount;
+    for (auto& entry : entries)
+    {
+        offset = (offset + ASSET_PACK_ALIGNMENT - 1) / ASSET_PACK_ALIGNMENT * ASSET_PACK_ALIGNMENT;
+        entry.offset = (uint32_t)offset;
+        offset += entry.size + 1;
+    }
+    offset = (offset + ASSET_PACK_ALIGNMENT - 1) / ASSET_PACK_ALIGNMENT * ASSET_PACK_ALIGNMENT;
+    if (offset > 0xFFFFFFFFu)
+    {
+        CCLOG("cocos2d: FileUtils: the files of %s don't fit in an asset pack.", directory.c_str());
+        return false;
+    }
+    header.size = (uint32_t)offset;
+    
+    FILE *out = fopen(packFilePath.c_str(), "wb");
+    if (!out)
+    {
+        CCLOG("cocos2d: FileUtils: can't open %s to write the asset pack.", packFilePath.c_str());
+        return false;
+    }
+    
+    bool written = fwrite(&header, sizeof(header), 1, out) == 1
+        && (entries.empty() || fwrite(entries.data(), sizeof(AssetPackEntry), entries.size(), out) == entries.size())
+        && (chars.empty() || fwrite(chars.data(), 1, chars.size(), out) == chars.size());
+    
+    std::vector<unsigned char> buffer;
+    uint32_t position = header.chars + header.charCount;
+    for (auto iter = entries.cbegin(); written && iter != entries.cend(); ++iter)
+    {
+        // the padding up to the data, then the data and its trailing nul
+        buffer.assign(iter->offset - position + iter->size + 1, 0);
+        FILE *fp = fopen((root + &chars[iter->name]).c_str(), "rb");
+        written = fp != nullptr;
+        if (fp)
+        {
+            written = fread(buffer.data() + (iter->offset - position), 1, iter->size, fp) == iter->size;
+            fclose(fp);
+        }
+        written = written && fwrite(buffer.data(), 1, buffer.size(), out) == buffer.size();
+        position = iter->offset + iter->size + 1;
+    }
+    if (written && position < header.size)
+    {
+        buffer.assign(header.size - position, 0);
+        written = fwrite(buffer.data(), 1, buffer.size(), out) == buffer.size();
+    }
+    fclose(out);
+    
+    if (!written)
+    {
+        CCLOG("cocos2d: FileUtils: failed to write the asset pack %s.", packFilePath.c_str());
+    }
+    return written;
+}
+
 std::string FileUtils::fullPathFromRelativeFile(const std::string &filename, const std::string &relativeFile)
 {
     return relativeFile.substr(0, relativeFile.rfind('/')+1) + getNewFilename(filename);
@@ -36,6 +36,8 @@ THE SOFTWARE.
 
 NS_CC_BEGIN
 
+class AssetPack;
+
 /**
  * @addtogroup platform
  * @{
@@ -110,6 +112,41 @@ public:
      */
     virtual unsigned char* getFileDataFromZip(const std::string& zipFilePath, const std::string& filename, ssize_t *size);
 
+    /**
+     *  Mounts an asset pack made by buildAssetPack().
+     *
+     *  The pack is memory mapped and its files are found by their path relative to the resource root,
+     *  through the search paths and the resolution directories, before any loose file.
+     *  Their data are views of the mapping, so no file is opened nor copied when they are read.
+     *  The packs mounted last are searched first, so a pack can patch the files of another one.
+     *
+     *  @note Views returned by getDataFromFile() must not outlive the pack.
+     *        Files read by third party libraries from their full path (e.g. the audio) have to stay loose.
+     *  @note On Android a pack in the apk is only mapped if it is stored uncompressed
+     *        (e.g. noCompress "ccpk" in the aapt options), otherwise it is read in memory as a whole.
+     *        Its data are then aligned by zipalign (4 bytes by default) rather than for SIMD loads;
+     *        copy the pack to the writable path to get the full alignment.
+     *  @param packFilePath The full path of the pack, or its path relative to the resource root.
+     *  @return true if the pack is valid and was mounted, otherwise false.
+     */
+    virtual bool addAssetPack(const std::string& packFilePath);
+
+    /** Unmounts an asset pack, the views of its files become invalid */
+    virtual void removeAssetPack(const std::string& packFilePath);
+
+    /** Unmounts all the asset packs */
+    virtual void removeAllAssetPacks();
+
+    /**
+     *  Builds an asset pack offline from all the files of a directory tree, e.g. the Resources folder.
+     *  The files are stored uncompressed, keyed by their path relative to the directory.
+     *
+     *  @param directory The root directory of the files to pack.
+     *  @param packFilePath The path of the pack to write, it is skipped if it lies in the directory.
+     *  @return true if the pack was written, otherwise false.
+     */
+    static bool buildAssetPack(const std::string& directory, const std::string& packFilePath);
+
     
     /** Returns the fullpath for a given filename.
      
@@ -378,6 +415,30 @@ protected:
      */
     virtual std::string getFullPathForDirectoryAndFilename(const std::string& directory, const std::string& filename);
     
+    /**
+     *  Gets the view of a file of the mounted asset packs.
+     *
+     *  @param fullPath The full path of the file, as returned by fullPathForFilename().
+     *  @param data Receives the view of the file.
+     *  @return true if the file is in an asset pack, otherwise false.
+     */
+    bool getDataFromAssetPacks(const std::string& fullPath, Data& data) const;
+    
+    /** Checks whether a file is in one of the mounted asset packs */
+    bool isFileInAssetPacks(const std::string& fullPath) const;
+    
+    /**
+     *  Resolves the full path of a file and gets its view if it is in a mounted asset pack.
+     */
+    bool readAssetPackFile(const std::string& filename, Data& data);
+    
+    /**
+     *  Reads a file from the file system of the platform, with a trailing nul if `forString` is true.
+     *  getStringFromFile(), getDataFromFile() and getFileData() look the file up in the asset packs first,
+     *  so the platforms only override this one to read loose files.
+     */
+    virtual Data getData(const std::string& filename, bool forString);
+    
     
     /** Dictionary used to lookup filenames based on a key.
      *  It is used internally by the following methods:
@@ -415,6 +476,11 @@ protected:
      */
     std::unordered_map<std::string, std::string> _fullPathCache;
     
+    /**
+     *  The mounted asset packs, searched from the last one.
+     */
+    std::vector<AssetPack*> _assetPacks;
+    
     /**
      *  The singleton pointer of FileUtils.
      */
@@ -0,0 +1,58 @@
+/****************************************************************************
+Copyright (c) 2013-2014 Chukong Technologies Inc.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef __CC_GL_HEADLESS_H__
+#define __CC_GL_HEADLESS_H__
+
+/*
+ * Private to the engine sources, don't include it from a public header.
+ *
+ * The OpenGL 1.1 functions returning data are exported by the GL library and can't be rebound like
+ * the functions loaded by glew. On the platforms with headless views, the engine calls them through
+ * these pointers, so headless views can stub them. Include this header after the other ones,
+ * it renames the functions for the rest of the source file.
+ */
+
+#include "CCGL.h"
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32) || (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+
+typedef void (GLAPIENTRY * PFNCCGLGENTEXTURESPROC) (GLsizei n, GLuint* textures);
+typedef void (GLAPIENTRY * PFNCCGLGETINTEGERVPROC) (GLenum pname, GLint* params);
+typedef void (GLAPIENTRY * PFNCCGLGETFLOATVPROC) (GLenum pname, GLfloat* params);
+typedef void (GLAPIENTRY * PFNCCGLGETBOOLEANVPROC) (GLenum pname, GLboolean* params);
+
+extern PFNCCGLGENTEXTURESPROC __ccglGenTextures;
+extern PFNCCGLGETINTEGERVPROC __ccglGetIntegerv;
+extern PFNCCGLGETFLOATVPROC __ccglGetFloatv;
+extern PFNCCGLGETBOOLEANVPROC __ccglGetBooleanv;
+
+#define glGenTextures __ccglGenTextures
+#define glGetIntegerv __ccglGetIntegerv
+#define glGetFloatv __ccglGetFloatv
+#define glGetBooleanv __ccglGetBooleanv
+
+#endif // (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32) || (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX)
+
+#endif // __CC_GL_HEADLESS_H__
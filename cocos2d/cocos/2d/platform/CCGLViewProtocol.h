@@ -82,6 +82,11 @@ public:
     /** Get whether opengl render system is ready, subclass must implement this method. */
     virtual bool isOpenGLReady() = 0;
 
+    /** Whether the view has neither a window nor a GL context, the Director then uses a headless Renderer.
+     @since v3.0
+     */
+    virtual bool isHeadless() const { return false; }
+
     /** Exchanges the front and back buffers, subclass must implement this method. */
     virtual void swapBuffers() = 0;
 
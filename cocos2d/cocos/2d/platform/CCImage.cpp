@@ -59,6 +59,14 @@ extern "C"
 #include "android/CCFileUtilsAndroid.h"
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CC_IMAGE_USE_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define CC_IMAGE_USE_NEON 1
+#include <arm_neon.h>
+#endif
+
 #define CC_GL_ATC_RGB_AMD                                          0x8C92
 #define CC_GL_ATC_RGBA_EXPLICIT_ALPHA_AMD                          0x8C93
 #define CC_GL_ATC_RGBA_INTERPOLATED_ALPHA_AMD                      0x87EE
@@ -409,13 +417,7 @@ bool Image::initWithImageFile(const std::string& path)
     int size = 4 * (iSurf->w * iSurf->h);
     ret = initWithRawData((const unsigned char*)iSurf->pixels, size, iSurf->w, iSurf->h, 8, true);
 
-    unsigned int *tmp = (unsigned int *)_data;
-    int nrPixels = iSurf->w * iSurf->h;
-    for(int i = 0; i < nrPixels; i++)
-    {
-        unsigned char *p = _data + i * 4;
-        tmp[i] = CC_RGB_PREMULTIPLY_ALPHA( p[0], p[1], p[2], p[3] );
-    }
+    premultiplyAlpha();
 
     SDL_FreeSurface(iSurf);
 #else
@@ -1890,6 +1892,59 @@ bool Image::initWithRawData(const unsigned char * data, ssize_t dataLen, int wid
     return bRet;
 }
 
+#if CC_IMAGE_USE_NEON
+// (c * (a + 1)) >> 8 of 8 components
+static inline uint8x8_t premultiply8(uint8x8_t c, uint8x8_t a)
+{
+    return vshrn_n_u16(vaddw_u8(vmull_u8(c, a), c), 8);
+}
+
+static inline uint8x16_t premultiply16(uint8x16_t c, uint8x16_t a)
+{
+    return vcombine_u8(premultiply8(vget_low_u8(c), vget_low_u8(a)), premultiply8(vget_high_u8(c), vget_high_u8(a)));
+}
+#endif
+
+void Image::premultiplyAlpha()
+{
+    CCASSERT(_renderFormat == Texture2D::PixelFormat::RGBA8888, "The pixel format should be RGBA8888!");
+
+    const ssize_t pixels = (ssize_t)_width * _height;
+    ssize_t i = 0;
+#if CC_IMAGE_USE_SSE2
+    // 16 bit lanes hold R, G, B, A of 2 pixels, the alpha lanes are kept as they are
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i alphaMask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    for (; i + 4 <= pixels; i += 4)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(_data + i * 4));
+        __m128i lo = _mm_unpacklo_epi8(v, zero);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+        __m128i alphaLo = _mm_add_epi16(_mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3,3,3,3)), _MM_SHUFFLE(3,3,3,3)), one);
+        __m128i alphaHi = _mm_add_epi16(_mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3,3,3,3)), _MM_SHUFFLE(3,3,3,3)), one);
+        lo = _mm_or_si128(_mm_andnot_si128(alphaMask, _mm_srli_epi16(_mm_mullo_epi16(lo, alphaLo), 8)), _mm_and_si128(alphaMask, lo));
+        hi = _mm_or_si128(_mm_andnot_si128(alphaMask, _mm_srli_epi16(_mm_mullo_epi16(hi, alphaHi), 8)), _mm_and_si128(alphaMask, hi));
+        _mm_storeu_si128((__m128i*)(_data + i * 4), _mm_packus_epi16(lo, hi));
+    }
+#elif CC_IMAGE_USE_NEON
+    for (; i + 16 <= pixels; i += 16)
+    {
+        uint8x16x4_t v = vld4q_u8(_data + i * 4);
+        v.val[0] = premultiply16(v.val[0], v.val[3]);
+        v.val[1] = premultiply16(v.val[1], v.val[3]);
+        v.val[2] = premultiply16(v.val[2], v.val[3]);
+        vst4q_u8(_data + i * 4, v);
+    }
+#endif
+    unsigned int *tmp = (unsigned int *)_data;
+    for (; i < pixels; ++i)
+    {
+        unsigned char *p = _data + i * 4;
+        tmp[i] = CC_RGB_PREMULTIPLY_ALPHA( p[0], p[1], p[2], p[3] );
+    }
+}
+
 
 #if (CC_TARGET_PLATFORM != CC_PLATFORM_IOS)
 bool Image::saveToFile(const std::string& filename, bool bIsToRGB)
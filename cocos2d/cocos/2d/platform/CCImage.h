@@ -154,6 +154,9 @@ protected:
 
     bool saveImageToPNG(const std::string& filePath, bool isToRGB = true);
     bool saveImageToJPG(const std::string& filePath);
+
+    /** multiplies the colors of the RGBA8888 data by their alpha, as CC_RGB_PREMULTIPLY_ALPHA does */
+    void premultiplyAlpha();
     
 private:
     /**
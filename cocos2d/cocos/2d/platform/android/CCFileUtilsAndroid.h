@@ -60,27 +60,18 @@ public:
     /* override funtions */
     bool init();
 
-    /** @deprecated Please use FileUtils::getDataFromFile or FileUtils::getStringFromFile instead. */
-    CC_DEPRECATED_ATTRIBUTE virtual unsigned char* getFileData(const std::string& filename, const char* mode, ssize_t * size) override;
-
-    /**
-     *  Gets string from a file.
-     */
-    virtual std::string getStringFromFile(const std::string& filename) override;
-    
-    /**
-     *  Creates binary data from a file.
-     *  @return A data object.
-     */
-    virtual Data getDataFromFile(const std::string& filename) override;
-
     virtual std::string getWritablePath() const;
     virtual bool isFileExist(const std::string& strFilePath) const;
     virtual bool isAbsolutePath(const std::string& strPath) const;
     
-private:
-    Data getData(const std::string& filename, bool forString);
+    /** The asset manager of the apk, used to read and map the files it contains */
+    static AAssetManager* getAssetManager() { return assetmanager; }
 
+protected:
+    /** Reads a file from the apk, or from the file system if its path is absolute */
+    virtual Data getData(const std::string& filename, bool forString) override;
+
+private:
     static AAssetManager* assetmanager;
 };
 
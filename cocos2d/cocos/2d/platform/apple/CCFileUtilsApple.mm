@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include <stack>
 #include "CCString.h"
 #include "CCFileUtils.h"
+#include "CCData.h"
 #include "CCDirector.h"
 #include "CCSAXParser.h"
 #include "CCDictionary.h"
@@ -254,6 +255,11 @@ bool FileUtilsApple::isFileExist(const std::string& filePath) const
         return false;
     }
 
+    if (isFileInAssetPacks(filePath))
+    {
+        return true;
+    }
+
     bool ret = false;
     
     if (filePath[0] != '/')
@@ -311,11 +317,37 @@ std::string FileUtilsApple::getFullPathForDirectoryAndFilename(const std::string
     return "";
 }
 
+// Parses a plist from the view of a file in an asset pack, the view has to outlive the returned objects' use
+static id propertyListWithData(const Data& data)
+{
+    if (data.isNull())
+    {
+        return nil;
+    }
+    NSData* nsData = [NSData dataWithBytesNoCopy:data.getBytes() length:data.getSize() freeWhenDone:NO];
+    return [NSPropertyListSerialization propertyListWithData:nsData options:NSPropertyListImmutable format:NULL error:NULL];
+}
+
 ValueMap FileUtilsApple::getValueMapFromFile(const std::string& filename)
 {
     std::string fullPath = fullPathForFilename(filename);
-    NSString* path = [NSString stringWithUTF8String:fullPath.c_str()];
-    NSDictionary* dict = [NSDictionary dictionaryWithContentsOfFile:path];
+    NSDictionary* dict = nil;
+    
+    // the packed files aren't on the disk, they are parsed from their view
+    Data data;
+    if (getDataFromAssetPacks(fullPath, data))
+    {
+        id plist = propertyListWithData(data);
+        if ([plist isKindOfClass:[NSDictionary class]])
+        {
+            dict = plist;
+        }
+    }
+    else
+    {
+        NSString* path = [NSString stringWithUTF8String:fullPath.c_str()];
+        dict = [NSDictionary dictionaryWithContentsOfFile:path];
+    }
     
     ValueMap ret;
     
@@ -355,8 +387,22 @@ ValueVector FileUtilsApple::getValueVectorFromFile(const std::string& filename)
     //    pPath = [[NSBundle mainBundle] pathForResource:pPath ofType:pathExtension];
     //    fixing cannot read data using Array::createWithContentsOfFile
     std::string fullPath = fullPathForFilename(filename);
-    NSString* path = [NSString stringWithUTF8String:fullPath.c_str()];
-    NSArray* array = [NSArray arrayWithContentsOfFile:path];
+    NSArray* array = nil;
+    
+    Data data;
+    if (getDataFromAssetPacks(fullPath, data))
+    {
+        id plist = propertyListWithData(data);
+        if ([plist isKindOfClass:[NSArray class]])
+        {
+            array = plist;
+        }
+    }
+    else
+    {
+        NSString* path = [NSString stringWithUTF8String:fullPath.c_str()];
+        array = [NSArray arrayWithContentsOfFile:path];
+    }
     
     ValueVector ret;
     
@@ -25,7 +25,9 @@ THE SOFTWARE.
 
 #include "CCGLView.h"
 
+#include <algorithm>
 #include <unordered_map>
+#include <vector>
 
 #include "CCDirector.h"
 #include "CCSet.h"
@@ -34,9 +36,14 @@ THE SOFTWARE.
 #include "CCEventKeyboard.h"
 #include "CCEventMouse.h"
 #include "CCIMEDispatcher.h"
+#include "platform/CCGLHeadless.h"
 
 NS_CC_BEGIN
 
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_MAC)
+static void glew_null_binding();
+#endif
+
 // GLFWEventHandler
 
 class GLFWEventHandler
@@ -263,6 +270,8 @@ GLView::GLView()
 , _primaryMonitor(nullptr)
 , _mouseX(0.0f)
 , _mouseY(0.0f)
+, _headless(false)
+, _headlessClosed(false)
 {
     _viewName = "cocos2dx";
     g_keyCodeMap.clear();
@@ -317,6 +326,18 @@ GLView* GLView::createWithFullScreen(const std::string& viewName)
     return nullptr;
 }
 
+GLView* GLView::createHeadless(const std::string& viewName, const Size& frameSize)
+{
+    auto ret = new GLView();
+    if(ret && ret->initHeadless(viewName, frameSize)) {
+        ret->autorelease();
+        return ret;
+    }
+
+    CC_SAFE_DELETE(ret);
+    return nullptr;
+}
+
 bool GLView::initWithRect(const std::string& viewName, Rect rect, float frameZoomFactor)
 {
     setViewName(viewName);
@@ -364,6 +385,23 @@ bool GLView::initWithRect(const std::string& viewName, Rect rect, float frameZoo
     return true;
 }
 
+bool GLView::initHeadless(const std::string& viewName, const Size& frameSize)
+{
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_MAC)
+    CCLOGERROR("GLView: headless views are not supported on Mac");
+    return false;
+#else
+    setViewName(viewName);
+
+    _headless = true;
+    GLViewProtocol::setFrameSize(frameSize.width, frameSize.height);
+
+    glew_null_binding();
+
+    return true;
+#endif
+}
+
 bool GLView::initWithFullScreen(const std::string& viewName)
 {
     _primaryMonitor = glfwGetPrimaryMonitor();
@@ -376,11 +414,16 @@ bool GLView::initWithFullScreen(const std::string& viewName)
 
 bool GLView::isOpenGLReady()
 {
+    if (_headless)
+        return !_headlessClosed;
+
     return nullptr != _mainWindow;
 }
 
 void GLView::end()
 {
+    _headlessClosed = true;
+
     if(_mainWindow)
     {
         glfwSetWindowShouldClose(_mainWindow,1);
@@ -398,7 +441,9 @@ void GLView::swapBuffers()
 
 bool GLView::windowShouldClose()
 {
-    if(_mainWindow)
+    if(_headless)
+        return _headlessClosed;
+    else if(_mainWindow)
         return glfwWindowShouldClose(_mainWindow) ? true : false;
     else
         return true;
@@ -406,7 +451,8 @@ bool GLView::windowShouldClose()
 
 void GLView::pollEvents()
 {
-    glfwPollEvents();
+    if(!_headless)
+        glfwPollEvents();
 }
 
 
@@ -452,7 +498,7 @@ float GLView::getFrameZoomFactor()
 
 void GLView::updateFrameSize()
 {
-    if (_screenSize.width > 0 && _screenSize.height > 0)
+    if (_screenSize.width > 0 && _screenSize.height > 0 && !_headless)
     {
         int w = 0, h = 0;
         glfwGetWindowSize(_mainWindow, &w, &h);
@@ -719,6 +765,261 @@ static bool glew_dynamic_binding()
 }
 #endif
 
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_MAC)
+// Stubs used by headless views: every GL entry point loaded by glew does nothing and returns a zero value.
+// The OpenGL 1.1 functions are exported by the GL library itself and do nothing without a current context,
+// the ones returning data are called through the pointers declared in CCGLHeadless.h and replaced as well.
+template <typename T> struct NullGLFunction;
+
+template <typename R>
+struct NullGLFunction<R (GLAPIENTRY*)()>
+{
+    static R GLAPIENTRY call() { return R(); }
+};
+template <typename R, typename A1>
+struct NullGLFunction<R (GLAPIENTRY*)(A1)>
+{
+    static R GLAPIENTRY call(A1) { return R(); }
+};
+template <typename R, typename A1, typename A2>
+struct NullGLFunction<R (GLAPIENTRY*)(A1, A2)>
+{
+    static R GLAPIENTRY call(A1, A2) { return R(); }
+};
+template <typename R, typename A1, typename A2, typename A3>
+struct NullGLFunction<R (GLAPIENTRY*)(A1, A2, A3)>
+{
+    static R GLAPIENTRY call(A1, A2, A3) { return R(); }
+};
+template <typename R, typename A1, typename A2, typename A3, typename A4>
+struct NullGLFunction<R (GLAPIENTRY*)(A1, A2, A3, A4)>
+{
+    static R GLAPIENTRY call(A1, A2, A3, A4) { return R(); }
+};
+template <typename R, typename A1, typename A2, typename A3, typename A4, typename A5>
+struct NullGLFunction<R (GLAPIENTRY*)(A1, A2, A3, A4, A5)>
+{
+    static R GLAPIENTRY call(A1, A2, A3, A4, A5) { return R(); }
+};
+template <typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+struct NullGLFunction<R (GLAPIENTRY*)(A1, A2, A3, A4, A5, A6)>
+{
+    static R GLAPIENTRY call(A1, A2, A3, A4, A5, A6) { return R(); }
+};
+template <typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
+struct NullGLFunction<R (GLAPIENTRY*)(A1, A2, A3, A4, A5, A6, A7)>
+{
+    static R GLAPIENTRY call(A1, A2, A3, A4, A5, A6, A7) { return R(); }
+};
+template <typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
+struct NullGLFunction<R (GLAPIENTRY*)(A1, A2, A3, A4, A5, A6, A7, A8)>
+{
+    static R GLAPIENTRY call(A1, A2, A3, A4, A5, A6, A7, A8) { return R(); }
+};
+
+// glew wraps its pointers in parentheses, decltype then yields a reference
+#define CC_NULL_GL(__fn__) __fn__ = &NullGLFunction<std::remove_reference<decltype(__fn__)>::type>::call
+
+// objects must get non zero names, GLProgram asserts on them
+static GLuint s_nullGLNextName = 0;
+// buffers are mapped to scratch memory of the size given to glBufferData
+static GLuint s_nullGLArrayBuffer = 0;
+static std::unordered_map<GLuint, std::vector<char>> s_nullGLBuffers;
+
+static void GLAPIENTRY nullGLGenNames(GLsizei n, GLuint* names)
+{
+    for (GLsizei i = 0; i < n; ++i)
+        names[i] = ++s_nullGLNextName;
+}
+
+static GLuint GLAPIENTRY nullGLCreateName()
+{
+    return ++s_nullGLNextName;
+}
+
+static GLuint GLAPIENTRY nullGLCreateShader(GLenum)
+{
+    return ++s_nullGLNextName;
+}
+
+static void GLAPIENTRY nullGLGetObjectiv(GLuint, GLenum pname, GLint* param)
+{
+    *param = (pname == GL_COMPILE_STATUS || pname == GL_LINK_STATUS) ? GL_TRUE : 0;
+}
+
+static GLint GLAPIENTRY nullGLGetLocation(GLuint, const GLchar*)
+{
+    return -1;
+}
+
+static GLenum GLAPIENTRY nullGLCheckFramebufferStatus(GLenum)
+{
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+
+static void GLAPIENTRY nullGLBindBuffer(GLenum target, GLuint buffer)
+{
+    if (target == GL_ARRAY_BUFFER)
+        s_nullGLArrayBuffer = buffer;
+}
+
+static void GLAPIENTRY nullGLBufferData(GLenum target, GLsizeiptr size, const void*, GLenum)
+{
+    if (target == GL_ARRAY_BUFFER)
+        s_nullGLBuffers[s_nullGLArrayBuffer].resize(size);
+}
+
+static void GLAPIENTRY nullGLDeleteBuffers(GLsizei n, const GLuint* buffers)
+{
+    for (GLsizei i = 0; i < n; ++i)
+        s_nullGLBuffers.erase(buffers[i]);
+}
+
+static void* GLAPIENTRY nullGLMapBuffer(GLenum target, GLenum)
+{
+    if (target != GL_ARRAY_BUFFER)
+        return nullptr;
+
+    auto& data = s_nullGLBuffers[s_nullGLArrayBuffer];
+    return data.empty() ? nullptr : data.data();
+}
+
+static void* GLAPIENTRY nullGLMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr, GLbitfield)
+{
+    char* data = static_cast<char*>(nullGLMapBuffer(target, GL_WRITE_ONLY));
+    return data ? data + offset : nullptr;
+}
+
+static GLboolean GLAPIENTRY nullGLUnmapBuffer(GLenum)
+{
+    return GL_TRUE;
+}
+
+// number of values written by glGet* for the states queried by the engine
+static int nullGLGetValueCount(GLenum pname)
+{
+    switch (pname)
+    {
+        case GL_VIEWPORT:
+        case GL_SCISSOR_BOX:
+        case GL_COLOR_CLEAR_VALUE:
+        case GL_COLOR_WRITEMASK:
+        case GL_BLEND_COLOR:
+            return 4;
+        case GL_MAX_VIEWPORT_DIMS:
+        case GL_DEPTH_RANGE:
+        case GL_ALIASED_POINT_SIZE_RANGE:
+        case GL_ALIASED_LINE_WIDTH_RANGE:
+            return 2;
+        case GL_MODELVIEW_MATRIX:
+        case GL_PROJECTION_MATRIX:
+        case GL_TEXTURE_MATRIX:
+            return 16;
+        case GL_COMPRESSED_TEXTURE_FORMATS:
+            // GL_NUM_COMPRESSED_TEXTURE_FORMATS is 0
+            return 0;
+        default:
+            return 1;
+    }
+}
+
+static void GLAPIENTRY nullGLGetIntegerv(GLenum pname, GLint* params)
+{
+    std::fill_n(params, nullGLGetValueCount(pname), 0);
+}
+
+static void GLAPIENTRY nullGLGetFloatv(GLenum pname, GLfloat* params)
+{
+    std::fill_n(params, nullGLGetValueCount(pname), 0.0f);
+}
+
+static void GLAPIENTRY nullGLGetBooleanv(GLenum pname, GLboolean* params)
+{
+    std::fill_n(params, nullGLGetValueCount(pname), (GLboolean)GL_FALSE);
+}
+
+static void glew_null_binding()
+{
+    CC_NULL_GL(glActiveTexture);
+    CC_NULL_GL(glAttachShader);
+    CC_NULL_GL(glBindAttribLocation);
+    CC_NULL_GL(glBindFramebuffer);
+    CC_NULL_GL(glBindRenderbuffer);
+    CC_NULL_GL(glBindVertexArray);
+    CC_NULL_GL(glBlendEquation);
+    CC_NULL_GL(glBlendFuncSeparate);
+    CC_NULL_GL(glBufferSubData);
+    CC_NULL_GL(glClientWaitSync);
+    CC_NULL_GL(glCompileShader);
+    CC_NULL_GL(glCompressedTexImage2D);
+    CC_NULL_GL(glDeleteFramebuffers);
+    CC_NULL_GL(glDeleteProgram);
+    CC_NULL_GL(glDeleteRenderbuffers);
+    CC_NULL_GL(glDeleteShader);
+    CC_NULL_GL(glDeleteSync);
+    CC_NULL_GL(glDeleteVertexArrays);
+    CC_NULL_GL(glDisableVertexAttribArray);
+    CC_NULL_GL(glEnableVertexAttribArray);
+    CC_NULL_GL(glFenceSync);
+    CC_NULL_GL(glFramebufferRenderbuffer);
+    CC_NULL_GL(glFramebufferTexture2D);
+    CC_NULL_GL(glGenerateMipmap);
+    CC_NULL_GL(glGetProgramInfoLog);
+    CC_NULL_GL(glGetShaderInfoLog);
+    CC_NULL_GL(glGetShaderSource);
+    CC_NULL_GL(glLinkProgram);
+    CC_NULL_GL(glRenderbufferStorage);
+    CC_NULL_GL(glShaderSource);
+    CC_NULL_GL(glUniform1f);
+    CC_NULL_GL(glUniform1fv);
+    CC_NULL_GL(glUniform1i);
+    CC_NULL_GL(glUniform1iv);
+    CC_NULL_GL(glUniform2f);
+    CC_NULL_GL(glUniform2fv);
+    CC_NULL_GL(glUniform2i);
+    CC_NULL_GL(glUniform2iv);
+    CC_NULL_GL(glUniform3f);
+    CC_NULL_GL(glUniform3fv);
+    CC_NULL_GL(glUniform3i);
+    CC_NULL_GL(glUniform3iv);
+    CC_NULL_GL(glUniform4f);
+    CC_NULL_GL(glUniform4fv);
+    CC_NULL_GL(glUniform4i);
+    CC_NULL_GL(glUniform4iv);
+    CC_NULL_GL(glUniformMatrix2fv);
+    CC_NULL_GL(glUniformMatrix3fv);
+    CC_NULL_GL(glUniformMatrix4fv);
+    CC_NULL_GL(glUseProgram);
+    CC_NULL_GL(glVertexAttribPointer);
+
+    glGenBuffers = nullGLGenNames;
+    glGenFramebuffers = nullGLGenNames;
+    glGenRenderbuffers = nullGLGenNames;
+    glGenVertexArrays = nullGLGenNames;
+    glCreateProgram = nullGLCreateName;
+    glCreateShader = nullGLCreateShader;
+    glGetShaderiv = nullGLGetObjectiv;
+    glGetProgramiv = nullGLGetObjectiv;
+    glGetUniformLocation = nullGLGetLocation;
+    glGetAttribLocation = nullGLGetLocation;
+    glCheckFramebufferStatus = nullGLCheckFramebufferStatus;
+    glBindBuffer = nullGLBindBuffer;
+    glBufferData = nullGLBufferData;
+    glDeleteBuffers = nullGLDeleteBuffers;
+    glMapBuffer = nullGLMapBuffer;
+    glMapBufferRange = nullGLMapBufferRange;
+    glUnmapBuffer = nullGLUnmapBuffer;
+
+    // textures get unique names too, the renderer batches quads by texture name
+    glGenTextures = nullGLGenNames;
+    glGetIntegerv = nullGLGetIntegerv;
+    glGetFloatv = nullGLGetFloatv;
+    glGetBooleanv = nullGLGetBooleanv;
+}
+
+#undef CC_NULL_GL
+#endif // (CC_TARGET_PLATFORM != CC_PLATFORM_MAC)
+
 // helper
 bool GLView::initGlew()
 {
@@ -762,3 +1063,15 @@ bool GLView::initGlew()
 }
 
 NS_CC_END // end of namespace cocos2d;
+
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_MAC)
+#undef glGenTextures
+#undef glGetIntegerv
+#undef glGetFloatv
+#undef glGetBooleanv
+
+PFNCCGLGENTEXTURESPROC __ccglGenTextures = glGenTextures;
+PFNCCGLGETINTEGERVPROC __ccglGetIntegerv = glGetIntegerv;
+PFNCCGLGETFLOATVPROC __ccglGetFloatv = glGetFloatv;
+PFNCCGLGETBOOLEANVPROC __ccglGetBooleanv = glGetBooleanv;
+#endif // (CC_TARGET_PLATFORM != CC_PLATFORM_MAC)
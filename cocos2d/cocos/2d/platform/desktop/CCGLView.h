@@ -39,6 +39,12 @@ public:
     static GLView* create(const std::string& viewName);
     static GLView* createWithRect(const std::string& viewName, Rect size, float frameZoomFactor = 1.0f);
     static GLView* createWithFullScreen(const std::string& viewName);
+    /** Creates a view without a window nor a GL context, to run scenes on a machine without a GPU.
+     GL calls are bound to stubs that do nothing and the Director renders with a headless Renderer.
+     The view closes when the Director ends. Not available on Mac.
+     @since v3.0
+     */
+    static GLView* createHeadless(const std::string& viewName, const Size& frameSize);
 
     /*
      *frameZoomFactor for frame. This method is for debugging big resolution (e.g.new ipad) app on desktop.
@@ -59,6 +65,7 @@ public:
 
     /* override functions */
     virtual bool isOpenGLReady() override;
+    virtual bool isHeadless() const override { return _headless; }
     virtual void end() override;
     virtual void swapBuffers() override;
     virtual void setFrameSize(float width, float height) override;
@@ -82,6 +89,7 @@ protected:
 
     bool initWithRect(const std::string& viewName, Rect rect, float frameZoomFactor);
     bool initWithFullScreen(const std::string& viewName);
+    bool initHeadless(const std::string& viewName, const Size& frameSize);
 
     bool initGlew();
 
@@ -112,6 +120,10 @@ protected:
     float _mouseX;
     float _mouseY;
 
+    bool _headless;
+    // a headless view has no window to close, it is closed by end()
+    bool _headlessClosed;
+
     friend class GLFWEventHandler;
 
 private:
@@ -107,6 +107,11 @@ bool FileUtilsLinux::isFileExist(const std::string& strFilePath) const
         return false;
     }
 
+    if (isFileInAssetPacks(strFilePath))
+    {
+        return true;
+    }
+
     std::string strPath = strFilePath;
     if (!isAbsolutePath(strPath))
     { // Not absolute path, add the default root path at the beginning.
@@ -103,6 +103,11 @@ bool FileUtilsWin32::isFileExist(const std::string& strFilePath) const
         return false;
     }
     
+    if (isFileInAssetPacks(strFilePath))
+    {
+        return true;
+    }
+
     std::string strPath = strFilePath;
     if (!isAbsolutePath(strPath))
     { // Not absolute path, add the default root path at the beginning.
@@ -126,7 +131,7 @@ bool FileUtilsWin32::isAbsolutePath(const std::string& strPath) const
     return false;
 }
 
-static Data getData(const std::string& filename, bool forString)
+Data FileUtilsWin32::getData(const std::string& filename, bool forString)
 {
     unsigned char *buffer = nullptr;
     CCASSERT(!filename.empty(), "Invalid parameters.");
@@ -185,66 +190,6 @@ static Data getData(const std::string& filename, bool forString)
     return ret;
 }
 
-std::string FileUtilsWin32::getStringFromFile(const std::string& filename)
-{
-    Data data = getData(filename, true);
-	if (data.isNull())
-	{
-		return "";
-	}
-    std::string ret((const char*)data.getBytes());
-    return ret;
-}
-    
-Data FileUtilsWin32::getDataFromFile(const std::string& filename)
-{
-    return getData(filename, false);
-}
-
-unsigned char* FileUtilsWin32::getFileData(const std::string& filename, const char* mode, ssize_t* size)
-{
-    unsigned char * pBuffer = NULL;
-    *size = 0;
-    do
-    {
-        // read the file from hardware
-        std::string fullPath = fullPathForFilename(filename);
-
-        WCHAR wszBuf[CC_MAX_PATH] = {0};
-        MultiByteToWideChar(CP_UTF8, 0, fullPath.c_str(), -1, wszBuf, sizeof(wszBuf)/sizeof(wszBuf[0]));
-
-        HANDLE fileHandle = ::CreateFileW(wszBuf, GENERIC_READ, 0, NULL, OPEN_EXISTING, NULL, NULL);
-        CC_BREAK_IF(fileHandle == INVALID_HANDLE_VALUE);
-        
-        *size = ::GetFileSize(fileHandle, NULL);
-
-        pBuffer = (unsigned char*) malloc(*size);
-        DWORD sizeRead = 0;
-        BOOL successed = FALSE;
-        successed = ::ReadFile(fileHandle, pBuffer, *size, &sizeRead, NULL);
-        ::CloseHandle(fileHandle);
-
-        if (!successed)
-        {
-            free(pBuffer);
-            pBuffer = nullptr;
-        }
-    } while (0);
-    
-    if (! pBuffer)
-    {
-        std::string msg = "Get data from file(";
-        // Gets error code.
-        DWORD errorCode = ::GetLastError();
-        char errorCodeBuffer[20] = {0};
-        snprintf(errorCodeBuffer, sizeof(errorCodeBuffer), "%d", errorCode);
-
-        msg = msg + filename + ") failed, error code is " + errorCodeBuffer;
-        CCLOG("%s", msg.c_str());
-    }
-    return pBuffer;
-}
-
 std::string FileUtilsWin32::getPathForFilename(const std::string& filename, const std::string& resolutionDirectory, const std::string& searchPath)
 {
     std::string unixFileName = convertPathFormatToUnixStyle(filename);
@@ -0,0 +1,142 @@
+/****************************************************************************
+ Copyright (c) 2013-2014 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "renderer/CCFrameArena.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <algorithm>
+
+NS_CC_BEGIN
+
+FrameArena::FrameArena(size_t blockSize)
+: _blockSize(blockSize)
+, _offset(0)
+, _finalizers(nullptr)
+, _allocationCount(0)
+, _allocatedBytes(0)
+, _lastFrameAllocationCount(0)
+, _lastFrameAllocatedBytes(0)
+, _peakAllocatedBytes(0)
+{
+    addBlock(_blockSize);
+}
+
+FrameArena::~FrameArena()
+{
+    destroyObjects();
+
+    for (auto& block : _blocks)
+    {
+        free(block.data);
+    }
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment)
+{
+    Block* block = &_blocks.back();
+    uintptr_t base = reinterpret_cast<uintptr_t>(block->data);
+    uintptr_t address = (base + _offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+
+    if (address + size > base + block->size)
+    {
+        //The frame doesn't fit, start a new block big enough for this allocation
+        addBlock(std::max(_blockSize, size + alignment));
+        block = &_blocks.back();
+        base = reinterpret_cast<uintptr_t>(block->data);
+        address = (base + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    }
+
+    _offset = (size_t)(address - base) + size;
+    ++_allocationCount;
+    _allocatedBytes += size;
+
+    return reinterpret_cast<void*>(address);
+}
+
+void FrameArena::reset()
+{
+    destroyObjects();
+
+    _lastFrameAllocationCount = _allocationCount;
+    _lastFrameAllocatedBytes = _allocatedBytes;
+    _peakAllocatedBytes = std::max(_peakAllocatedBytes, _allocatedBytes);
+    _allocationCount = 0;
+    _allocatedBytes = 0;
+
+    if (_blocks.size() > 1)
+    {
+        //Merge the blocks so that a frame like this one fits in a single block
+        size_t capacity = getCapacity();
+        for (auto& block : _blocks)
+        {
+            free(block.data);
+        }
+        _blocks.clear();
+        addBlock(capacity);
+    }
+
+    _offset = 0;
+}
+
+bool FrameArena::owns(const void* pointer) const
+{
+    const char* p = static_cast<const char*>(pointer);
+    for (const auto& block : _blocks)
+    {
+        if (p >= block.data && p < block.data + block.size)
+            return true;
+    }
+    return false;
+}
+
+size_t FrameArena::getCapacity() const
+{
+    size_t capacity = 0;
+    for (const auto& block : _blocks)
+    {
+        capacity += block.size;
+    }
+    return capacity;
+}
+
+void FrameArena::addBlock(size_t size)
+{
+    Block block;
+    block.data = static_cast<char*>(malloc(size));
+    block.size = size;
+    _blocks.push_back(block);
+    _offset = 0;
+}
+
+void FrameArena::destroyObjects()
+{
+    for (Finalizer* finalizer = _finalizers; finalizer != nullptr; finalizer = finalizer->next)
+    {
+        finalizer->destroy(finalizer->object);
+    }
+    _finalizers = nullptr;
+}
+
+NS_CC_END
@@ -0,0 +1,143 @@
+/****************************************************************************
+ Copyright (c) 2013-2014 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __CC_FRAMEARENA_H__
+#define __CC_FRAMEARENA_H__
+
+#include <new>
+#include <vector>
+#include "CCPlatformMacros.h"
+#include "CCStdC.h"
+
+NS_CC_BEGIN
+
+/** FrameArena is a linear allocator for the objects that only live until the end of a frame.
+
+ Allocating is just moving a pointer forward, and `reset()` releases everything at once.
+ The `Renderer` owns one and resets it at the end of `Renderer::render()`, so
+ commands created with it can be added to the renderer without being kept by the caller.
+ When a frame needs more than the arena holds, new blocks are added, and they are
+ merged in a single block on the next reset so the following frames fit in it.
+
+ It is not thread safe, only use it from the cocos2d thread.
+ */
+class CC_DLL FrameArena
+{
+public:
+    static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+    static const size_t DEFAULT_ALIGNMENT = 16;
+
+    explicit FrameArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~FrameArena();
+
+    /** Returns `size` bytes aligned on `alignment`, valid until the next reset. `alignment` must be a power of two */
+    void* allocate(size_t size, size_t alignment = DEFAULT_ALIGNMENT);
+
+    /** Returns uninitialized storage for `count` objects of type T.
+     No constructor nor destructor is called, only use it for plain data.
+     */
+    template <class T>
+    T* allocateArray(ssize_t count)
+    {
+        return static_cast<T*>(allocate(sizeof(T) * count));
+    }
+
+    /** Creates an object with its default constructor. It is destroyed by the next reset */
+    template <class T>
+    T* create()
+    {
+        Finalizer* finalizer = static_cast<Finalizer*>(allocate(sizeof(Finalizer)));
+        T* object = new (allocate(sizeof(T))) T();
+        finalizer->destroy = &destroyObject<T>;
+        finalizer->object = object;
+        finalizer->next = _finalizers;
+        _finalizers = finalizer;
+        return object;
+    }
+
+    /** Destroys the objects created since the last reset and makes all the memory available again */
+    void reset();
+
+    /** Returns true if `pointer` points inside the memory of the arena */
+    bool owns(const void* pointer) const;
+
+    /** Returns the number of allocations since the last reset */
+    ssize_t getAllocationCount() const { return _allocationCount; }
+    /** Returns the number of bytes allocated since the last reset */
+    size_t getAllocatedBytes() const { return _allocatedBytes; }
+    /** Returns the number of allocations made between the last two resets */
+    ssize_t getLastFrameAllocationCount() const { return _lastFrameAllocationCount; }
+    /** Returns the number of bytes allocated between the last two resets */
+    size_t getLastFrameAllocatedBytes() const { return _lastFrameAllocatedBytes; }
+    /** Returns the biggest number of bytes allocated between two resets */
+    size_t getPeakAllocatedBytes() const { return _peakAllocatedBytes; }
+    /** Returns the number of bytes reserved by the arena */
+    size_t getCapacity() const;
+
+protected:
+    struct Block
+    {
+        char* data;
+        size_t size;
+    };
+
+    struct Finalizer
+    {
+        void (*destroy)(void* object);
+        void* object;
+        Finalizer* next;
+    };
+
+    template <class T>
+    static void destroyObject(void* object)
+    {
+        static_cast<T*>(object)->~T();
+    }
+
+    void addBlock(size_t size);
+    void destroyObjects();
+
+    // the last block is the one being filled
+    std::vector<Block> _blocks;
+    size_t _blockSize;
+    size_t _offset;
+
+    // objects to destroy on reset, last created first
+    Finalizer* _finalizers;
+
+    // stats
+    ssize_t _allocationCount;
+    size_t _allocatedBytes;
+    ssize_t _lastFrameAllocationCount;
+    size_t _lastFrameAllocatedBytes;
+    size_t _peakAllocatedBytes;
+
+private:
+    CC_DISALLOW_COPY_AND_ASSIGN(FrameArena);
+};
+
+NS_CC_END
+
+#endif //__CC_FRAMEARENA_H__
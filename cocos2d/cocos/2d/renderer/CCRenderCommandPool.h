@@ -26,11 +26,15 @@
 #ifndef __CC_RENDERCOMMANDPOOL_H__
 #define __CC_RENDERCOMMANDPOOL_H__
 
-#include <set>
-#include <list>
+#include <vector>
 #include "CCPlatformMacros.h"
 NS_CC_BEGIN
 
+/** Recycles render commands of type T.
+ The commands are allocated in blocks and the free ones are kept in a vector,
+ so getting and returning a command never allocates once the pool is warm.
+ For commands that only live during one frame, prefer `FrameArena`.
+ */
 template <class T>
 class RenderCommandPool
 {
@@ -40,12 +44,8 @@ public:
     }
     ~RenderCommandPool()
     {
-//        if( 0 != _usedPool.size())
-//        {
-//            CCLOG("All RenderCommand should not be used when Pool is released!");
-//        }
         _freePool.clear();
-        for (typename std::list<T*>::iterator iter = _allocatedPoolBlocks.begin(); iter != _allocatedPoolBlocks.end(); ++iter)
+        for (typename std::vector<T*>::iterator iter = _allocatedPoolBlocks.begin(); iter != _allocatedPoolBlocks.end(); ++iter)
         {
             delete[] *iter;
             *iter = nullptr;
@@ -55,28 +55,18 @@ public:
 
     T* generateCommand()
     {
-        T* result = nullptr;
         if(_freePool.empty())
         {
             AllocateCommands();
         }
-        result = _freePool.front();
-        _freePool.pop_front();
-        //_usedPool.insert(result);
+        T* result = _freePool.back();
+        _freePool.pop_back();
         return result;
     }
     
     void pushBackCommand(T* ptr)
     {
-//        if(_usedPool.find(ptr) == _usedPool.end())
-//        {
-//            CCLOG("push Back Wrong command!");
-//            return;
-//        }
-        
         _freePool.push_back(ptr);
-        //_usedPool.erase(ptr);
-        
     }
 private:
     void AllocateCommands()
@@ -84,15 +74,17 @@ private:
         static const int COMMANDS_ALLOCATE_BLOCK_SIZE = 32;
         T* commands = new T[COMMANDS_ALLOCATE_BLOCK_SIZE];
         _allocatedPoolBlocks.push_back(commands);
-        for(int index = 0; index < COMMANDS_ALLOCATE_BLOCK_SIZE; ++index)
+        _freePool.reserve(_allocatedPoolBlocks.size() * COMMANDS_ALLOCATE_BLOCK_SIZE);
+        //Push them backwards so that they are handed out in memory order
+        for(int index = COMMANDS_ALLOCATE_BLOCK_SIZE - 1; index >= 0; --index)
         {
             _freePool.push_back(commands+index);
         }
     }
 
-    std::list<T*> _allocatedPoolBlocks;
-    std::list<T*> _freePool;
-    //std::set<T*> _usedPool;
+    std::vector<T*> _allocatedPoolBlocks;
+    // used as a stack, the last returned command is handed out first while it is still in the cache
+    std::vector<T*> _freePool;
 };
 
 NS_CC_END
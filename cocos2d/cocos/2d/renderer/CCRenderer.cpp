@@ -34,62 +34,132 @@
 #include "CCEventDispatcher.h"
 #include "CCEventListenerCustom.h"
 #include "CCEventType.h"
+#include "CCJobPool.h"
 #include <algorithm>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CC_RENDERER_USE_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define CC_RENDERER_USE_NEON 1
+#include <arm_neon.h>
+#endif
+
 NS_CC_BEGIN
 
-bool compareRenderCommand(RenderCommand* a, RenderCommand* b)
+RenderQueue::RenderQueue()
+: _isSorted(true)
 {
-    return a->getGlobalOrder() < b->getGlobalOrder();
+}
+
+uint64_t RenderQueue::makeSortKey(float globalOrder, uint32_t sequence)
+{
+    // -0.0f and 0.0f must end up in the same bucket
+    if(globalOrder == 0)
+        globalOrder = 0;
+
+    // Flip the float bits so that they compare like an unsigned integer:
+    // negative numbers get all their bits inverted, positive ones only the sign bit.
+    uint32_t bits;
+    memcpy(&bits, &globalOrder, sizeof(bits));
+    bits = (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+
+    return (uint64_t)bits << 32 | sequence;
 }
 
 void RenderQueue::push_back(RenderCommand* command)
 {
-    float z = command->getGlobalOrder();
-    if(z < 0)
-        _queueNegZ.push_back(command);
-    else if(z > 0)
-        _queuePosZ.push_back(command);
-    else
-        _queue0.push_back(command);
+    Entry entry = { makeSortKey(command->getGlobalOrder(), (uint32_t)_commands.size()), command };
+
+    if(_isSorted && !_commands.empty() && entry.key < _commands.back().key)
+        _isSorted = false;
+
+    _commands.push_back(entry);
 }
 
 ssize_t RenderQueue::size() const
 {
-    return _queueNegZ.size() + _queue0.size() + _queuePosZ.size();
+    return _commands.size();
 }
 
 void RenderQueue::sort()
 {
-    // Don't sort _queue0, it already comes sorted
-    std::sort(std::begin(_queueNegZ), std::end(_queueNegZ), compareRenderCommand);
-    std::sort(std::begin(_queuePosZ), std::end(_queuePosZ), compareRenderCommand);
+    // Commands with `z == 0` are pushed in the correct order, so most of the
+    // frames don't need to be sorted at all
+    if(_isSorted)
+        return;
+
+    radixSort();
+    _isSorted = true;
 }
 
-RenderCommand* RenderQueue::operator[](ssize_t index) const
+void RenderQueue::radixSort()
 {
-    if(index < _queueNegZ.size())
-        return _queueNegZ[index];
+    static const int RADIX_BITS = 8;
+    static const int RADIX_SIZE = 1 << RADIX_BITS;
+    static const int PASSES = 64 / RADIX_BITS;
+
+    const size_t count = _commands.size();
 
-    index -= _queueNegZ.size();
+    // Build the histograms of every pass in a single read of the keys
+    size_t histograms[PASSES][RADIX_SIZE];
+    memset(histograms, 0, sizeof(histograms));
+    for(const auto& entry : _commands)
+    {
+        uint64_t key = entry.key;
+        for(int pass = 0; pass < PASSES; ++pass)
+        {
+            histograms[pass][key & (RADIX_SIZE - 1)]++;
+            key >>= RADIX_BITS;
+        }
+    }
+
+    _sortBuffer.resize(count);
+    Entry* src = _commands.data();
+    Entry* dst = _sortBuffer.data();
+
+    for(int pass = 0; pass < PASSES; ++pass)
+    {
+        const int shift = pass * RADIX_BITS;
+        size_t* histogram = histograms[pass];
 
-    if(index < _queue0.size())
-        return _queue0[index];
+        // Skip the digits that are the same for every key, e.g. the upper
+        // bytes of the sequence number or the Z of a mostly flat scene
+        if(histogram[(src[0].key >> shift) & (RADIX_SIZE - 1)] == count)
+            continue;
 
-    index -= _queue0.size();
+        size_t offset = 0;
+        for(int i = 0; i < RADIX_SIZE; ++i)
+        {
+            size_t bucketSize = histogram[i];
+            histogram[i] = offset;
+            offset += bucketSize;
+        }
 
-    if(index < _queuePosZ.size())
-        return _queuePosZ[index];
+        for(size_t i = 0; i < count; ++i)
+        {
+            dst[histogram[(src[i].key >> shift) & (RADIX_SIZE - 1)]++] = src[i];
+        }
 
-    CCASSERT(false, "invalid index");
-    return nullptr;
+        std::swap(src, dst);
+    }
+
+    if(src != _commands.data())
+    {
+        _commands.swap(_sortBuffer);
+    }
+}
+
+RenderCommand* RenderQueue::operator[](ssize_t index) const
+{
+    CCASSERT(index >= 0 && index < (ssize_t)_commands.size(), "invalid index");
+    return _commands[index].command;
 }
 
 void RenderQueue::clear()
 {
-    _queueNegZ.clear();
-    _queue0.clear();
-    _queuePosZ.clear();
+    _commands.clear();
+    _isSorted = true;
 }
 
 
@@ -100,8 +170,15 @@ void RenderQueue::clear()
 
 Renderer::Renderer()
 :_lastMaterialID(0)
+,_vboSectionCapacity(VBO_INITIAL_SIZE)
+,_vboSection(0)
+,_vboSectionQuads(0)
+,_vboFrameQuads(0)
+,_vboLastFrameQuads(0)
 ,_numQuads(0)
 ,_glViewAssigned(false)
+,_headless(false)
+,_commandStreamEnabled(false)
 #if CC_ENABLE_CACHE_TEXTURE_DATA
 ,_cacheTextureListener(nullptr)
 #endif
@@ -113,18 +190,33 @@ Renderer::Renderer()
     RenderStackElement elelment = {DEFAULT_RENDER_QUEUE, 0};
     _renderStack.push(elelment);
     _batchedQuadCommands.reserve(BATCH_QUADCOMMAND_RESEVER_SIZE);
+    _batchedQuadOffsets.reserve(BATCH_QUADCOMMAND_RESEVER_SIZE);
+#if CC_RENDERER_USE_MAP_BUFFER_RANGE
+    memset(_vboFences, 0, sizeof(_vboFences));
+#endif
+    memset(&_stats, 0, sizeof(_stats));
 }
 
 Renderer::~Renderer()
 {
     _renderGroups.clear();
     
-    glDeleteBuffers(2, _buffersVBO);
-    
-    if (Configuration::getInstance()->supportsShareableVAO())
+    if (!_headless)
     {
-        glDeleteVertexArrays(1, &_quadVAO);
-        GL::bindVAO(0);
+        glDeleteBuffers(2, _buffersVBO);
+#if CC_RENDERER_USE_MAP_BUFFER_RANGE
+        for(auto& fence : _vboFences)
+        {
+            if(fence)
+                glDeleteSync(fence);
+        }
+#endif
+
+        if (Configuration::getInstance()->supportsShareableVAO())
+        {
+            glDeleteVertexArrays(1, &_quadVAO);
+            GL::bindVAO(0);
+        }
     }
 #if CC_ENABLE_CACHE_TEXTURE_DATA
     Director::getInstance()->getEventDispatcher()->removeEventListener(_cacheTextureListener);
@@ -133,6 +225,13 @@ Renderer::~Renderer()
 
 void Renderer::initGLView()
 {
+    if (_headless)
+    {
+        //No GL buffers, the commands are only processed
+        _glViewAssigned = true;
+        return;
+    }
+
 #if CC_ENABLE_CACHE_TEXTURE_DATA
     _cacheTextureListener = EventListenerCustom::create(EVENT_COME_TO_FOREGROUND, [this](EventCustom* event){
         /** listen the event that coming to foreground on Android */
@@ -142,8 +241,6 @@ void Renderer::initGLView()
     Director::getInstance()->getEventDispatcher()->addEventListenerWithFixedPriority(_cacheTextureListener, -1);
 #endif
 
-    setupIndices();
-    
     setupBuffer();
     
     _glViewAssigned = true;
@@ -151,19 +248,30 @@ void Renderer::initGLView()
 
 void Renderer::setupIndices()
 {
-    for( int i=0; i < VBO_SIZE; i++)
+    // The indices only live in the GL buffer, they are generated again if the context is lost
+    std::vector<GLushort> indices(6 * INDEX_QUADS);
+    for( int i=0; i < INDEX_QUADS; i++)
     {
-        _indices[i*6+0] = (GLushort) (i*4+0);
-        _indices[i*6+1] = (GLushort) (i*4+1);
-        _indices[i*6+2] = (GLushort) (i*4+2);
-        _indices[i*6+3] = (GLushort) (i*4+3);
-        _indices[i*6+4] = (GLushort) (i*4+2);
-        _indices[i*6+5] = (GLushort) (i*4+1);
+        indices[i*6+0] = (GLushort) (i*4+0);
+        indices[i*6+1] = (GLushort) (i*4+1);
+        indices[i*6+2] = (GLushort) (i*4+2);
+        indices[i*6+3] = (GLushort) (i*4+3);
+        indices[i*6+4] = (GLushort) (i*4+2);
+        indices[i*6+5] = (GLushort) (i*4+1);
     }
+
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices[0]) * indices.size(), indices.data(), GL_STATIC_DRAW);
 }
 
 void Renderer::setupBuffer()
 {
+    // Buffers are (re)created, any previous fence belonged to a lost context
+    _vboSection = 0;
+    _vboSectionQuads = 0;
+#if CC_RENDERER_USE_MAP_BUFFER_RANGE
+    memset(_vboFences, 0, sizeof(_vboFences));
+#endif
+
     if(Configuration::getInstance()->supportsShareableVAO())
     {
         setupVBOAndVAO();
@@ -182,22 +290,15 @@ void Renderer::setupVBOAndVAO()
     glGenBuffers(2, &_buffersVBO[0]);
 
     glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(_quads[0]) * VBO_SIZE, _quads, GL_DYNAMIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(V3F_C4B_T2F_Quad) * _vboSectionCapacity * VBO_SECTIONS, nullptr, GL_DYNAMIC_DRAW);
 
-    // vertices
     glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_POSITION);
-    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) offsetof( V3F_C4B_T2F, vertices));
-
-    // colors
     glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_COLOR);
-    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(V3F_C4B_T2F), (GLvoid*) offsetof( V3F_C4B_T2F, colors));
-
-    // tex coords
     glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_TEX_COORDS);
-    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORDS, 2, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) offsetof( V3F_C4B_T2F, texCoords));
+    setupVertexAttribPointers(0);
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * VBO_SIZE * 6, _indices, GL_STATIC_DRAW);
+    setupIndices();
 
     // Must unbind the VAO before changing the element buffer.
     GL::bindVAO(0);
@@ -220,16 +321,63 @@ void Renderer::mapBuffers()
     GL::bindVAO(0);
 
     glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(_quads[0]) * VBO_SIZE, _quads, GL_DYNAMIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(V3F_C4B_T2F_Quad) * _vboSectionCapacity * VBO_SECTIONS, nullptr, GL_DYNAMIC_DRAW);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * VBO_SIZE * 6, _indices, GL_STATIC_DRAW);
+    setupIndices();
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
     CHECK_GL_ERROR_DEBUG();
 }
 
+void Renderer::setupVertexAttribPointers(GLintptr offset)
+{
+    // vertices
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) (offset + offsetof(V3F_C4B_T2F, vertices)));
+
+    // colors
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(V3F_C4B_T2F), (GLvoid*) (offset + offsetof(V3F_C4B_T2F, colors)));
+
+    // tex coords
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORDS, 2, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) (offset + offsetof(V3F_C4B_T2F, texCoords)));
+}
+
+void Renderer::nextVertexBufferSection()
+{
+#if CC_RENDERER_USE_MAP_BUFFER_RANGE
+    if(_vboSectionQuads > 0 && Configuration::getInstance()->supportsMapBufferRange())
+    {
+        _vboFences[_vboSection] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+#endif
+
+    _vboSection = (_vboSection + 1) % VBO_SECTIONS;
+    _vboSectionQuads = 0;
+    _vboLastFrameQuads = _vboFrameQuads;
+    _vboFrameQuads = 0;
+}
+
+void Renderer::orphanVertexBuffer()
+{
+    // glBindBuffer(GL_ARRAY_BUFFER) must be bound to the vertex VBO
+    glBufferData(GL_ARRAY_BUFFER, sizeof(V3F_C4B_T2F_Quad) * _vboSectionCapacity * VBO_SECTIONS, nullptr, GL_DYNAMIC_DRAW);
+
+#if CC_RENDERER_USE_MAP_BUFFER_RANGE
+    // The new storage isn't used by the GPU yet
+    for(auto& fence : _vboFences)
+    {
+        if(fence)
+        {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+#endif
+
+    _vboSectionQuads = 0;
+}
+
 void Renderer::addCommand(RenderCommand* command)
 {
     int renderQueue =_commandGroupStack.top();
@@ -241,6 +389,41 @@ void Renderer::addCommand(RenderCommand* command, int renderQueue)
     CCASSERT(renderQueue >=0, "Invalid render queue");
     CCASSERT(command->getType() != RenderCommand::Type::UNKNOWN_COMMAND, "Invalid Command Type");
     _renderGroups[renderQueue].push_back(command);
+
+    if(!_recordings.empty())
+    {
+        //Commands of the frame arena are gone next frame, they can't be replayed
+        bool replayable = !_frameArena.owns(command);
+        for(auto& recording : _recordings)
+        {
+            RecordedRenderCommand recorded = { command, renderQueue == recording.renderQueueID ? -1 : renderQueue };
+            recording.commands->push_back(recorded);
+            recording.replayable = recording.replayable && replayable;
+        }
+    }
+}
+
+void Renderer::beginRecording(std::vector<RecordedRenderCommand>* commands)
+{
+    Recording recording = { commands, _commandGroupStack.top(), true };
+    _recordings.push_back(recording);
+}
+
+bool Renderer::endRecording()
+{
+    CCASSERT(!_recordings.empty(), "endRecording called without beginRecording");
+    bool replayable = _recordings.back().replayable;
+    _recordings.pop_back();
+    return replayable;
+}
+
+void Renderer::addRecordedCommands(const std::vector<RecordedRenderCommand>& commands)
+{
+    int currentRenderQueue = _commandGroupStack.top();
+    for(const auto& recorded : commands)
+    {
+        addCommand(recorded.command, recorded.renderQueueID < 0 ? currentRenderQueue : recorded.renderQueueID);
+    }
 }
 
 void Renderer::pushGroup(int renderQueueID)
@@ -270,7 +453,8 @@ void Renderer::render()
     if (_glViewAssigned)
     {
         // cleanup
-        _drawnBatches = _drawnVertices = 0;
+        memset(&_stats, 0, sizeof(_stats));
+        _commandStream.clear();
 
         //Process render commands
         //1. Sort render commands based on ID
@@ -281,7 +465,7 @@ void Renderer::render()
         
         while(!_renderStack.empty())
         {
-            RenderQueue currRenderQueue = _renderGroups[_renderStack.top().renderQueueID];
+            RenderQueue& currRenderQueue = _renderGroups[_renderStack.top().renderQueueID];
             size_t len = currRenderQueue.size();
             
             //Process RenderQueue
@@ -291,39 +475,42 @@ void Renderer::render()
                 auto command = currRenderQueue[i];
 
                 auto commandType = command->getType();
+                _stats.commands++;
+                if(_commandStreamEnabled)
+                {
+                    recordCommand(command);
+                }
                 
                 if(commandType == RenderCommand::Type::QUAD_COMMAND)
                 {
                     auto cmd = static_cast<QuadCommand*>(command);
                     CCASSERT(nullptr!= cmd, "Illegal command for RenderCommand Taged as QUAD_COMMAND");
                     
-                    //Batch quads
-                    if(_numQuads + cmd->getQuadCount() > VBO_SIZE)
-                    {
-                        CCASSERT(cmd->getQuadCount()>= 0 && cmd->getQuadCount() < VBO_SIZE, "VBO is not big enough for quad data, please break the quad data down or use customized render command");
-
-                        //Draw batched quads if VBO is full
-                        drawBatchedQuads();
-                    }
-                    
+                    //Batch quads, the buffers grow to fit the batch
                     _batchedQuadCommands.push_back(cmd);
                     
-                    memcpy(_quads + _numQuads, cmd->getQuads(), sizeof(V3F_C4B_T2F_Quad) * cmd->getQuadCount());
-                    convertToWorldCoordinates(_quads + _numQuads, cmd->getQuadCount(), cmd->getModelView());
-
+                    //The quads are transformed and uploaded all at once in drawBatchedQuads()
                     _numQuads += cmd->getQuadCount();
                 }
                 else if(commandType == RenderCommand::Type::CUSTOM_COMMAND)
                 {
                     flush();
-                    auto cmd = static_cast<CustomCommand*>(command);
-                    cmd->execute();
+                    _stats.customCommands++;
+                    if(!_headless)
+                    {
+                        auto cmd = static_cast<CustomCommand*>(command);
+                        cmd->execute();
+                    }
                 }
                 else if(commandType == RenderCommand::Type::BATCH_COMMAND)
                 {
                     flush();
-                    auto cmd = static_cast<BatchCommand*>(command);
-                    cmd->execute();
+                    _stats.customCommands++;
+                    if(!_headless)
+                    {
+                        auto cmd = static_cast<BatchCommand*>(command);
+                        cmd->execute();
+                    }
                 }
                 else if(commandType == RenderCommand::Type::GROUP_COMMAND)
                 {
@@ -349,8 +536,7 @@ void Renderer::render()
             //Draw the batched quads
             drawBatchedQuads();
             
-            currRenderQueue = _renderGroups[_renderStack.top().renderQueueID];
-            len = currRenderQueue.size();
+            len = _renderGroups[_renderStack.top().renderQueueID].size();
             //If pop the render stack if we already processed all the commands
             if(_renderStack.top().currentIndex + 1 >= len)
             {
@@ -368,6 +554,11 @@ void Renderer::render()
         // }
         _renderGroups[j].clear();
     }
+
+    if (_glViewAssigned && !_headless)
+    {
+        nextVertexBufferSection();
+    }
     
     //Clear the stack incase gl view hasn't been initialized yet
     while(!_renderStack.empty())
@@ -377,85 +568,141 @@ void Renderer::render()
     RenderStackElement element = {DEFAULT_RENDER_QUEUE, 0};
     _renderStack.push(element);
     _lastMaterialID = 0;
+
+    //Every command of this frame has been executed
+    _frameArena.reset();
 }
 
-void Renderer::convertToWorldCoordinates(V3F_C4B_T2F_Quad* quads, ssize_t quantity, const kmMat4& modelView)
+void Renderer::recordCommand(RenderCommand* command)
 {
-//    kmMat4 matrixP, mvp;
-//    kmGLGetMatrix(KM_GL_PROJECTION, &matrixP);
-//    kmMat4Multiply(&mvp, &matrixP, &modelView);
-
-    for(ssize_t i=0; i<quantity; ++i) {
-        V3F_C4B_T2F_Quad *q = &quads[i];
+    RenderStreamCommand recorded = { command->getType(), command->getGlobalOrder(), 0, 0 };
+    if(recorded.type == RenderCommand::Type::QUAD_COMMAND)
+    {
+        auto cmd = static_cast<QuadCommand*>(command);
+        recorded.id = cmd->getMaterialID();
+        recorded.quads = cmd->getQuadCount();
+    }
+    else if(recorded.type == RenderCommand::Type::GROUP_COMMAND)
+    {
+        recorded.id = static_cast<GroupCommand*>(command)->getRenderQueueID();
+    }
+    _commandStream.push_back(recorded);
+}
 
-        kmVec3 *vec1 = (kmVec3*)&q->bl.vertices;
-        kmVec3Transform(vec1, vec1, &modelView);
+void Renderer::transformBatchedQuads(V3F_C4B_T2F_Quad* dst)
+{
+    _batchedQuadOffsets.clear();
+    ssize_t offset = 0;
+    for(const auto& cmd : _batchedQuadCommands)
+    {
+        _batchedQuadOffsets.push_back(offset);
+        offset += cmd->getQuadCount();
+    }
 
-        kmVec3 *vec2 = (kmVec3*)&q->br.vertices;
-        kmVec3Transform(vec2, vec2, &modelView);
+    auto job = [this, dst](ssize_t begin, ssize_t end) {
+        // last command starting at or before `begin`
+        auto it = std::upper_bound(_batchedQuadOffsets.begin(), _batchedQuadOffsets.end(), begin);
+        size_t index = (it - _batchedQuadOffsets.begin()) - 1;
 
-        kmVec3 *vec3 = (kmVec3*)&q->tr.vertices;
-        kmVec3Transform(vec3, vec3, &modelView);
+        while(begin < end)
+        {
+            auto cmd = _batchedQuadCommands[index];
+            ssize_t cmdBegin = _batchedQuadOffsets[index];
+            ssize_t cmdEnd = std::min(cmdBegin + cmd->getQuadCount(), end);
+            convertToWorldCoordinates(cmd->getQuads() + (begin - cmdBegin), dst + begin, cmdEnd - begin, cmd->getModelView());
+            begin = cmdEnd;
+            index++;
+        }
+    };
 
-        kmVec3 *vec4 = (kmVec3*)&q->tl.vertices;
-        kmVec3Transform(vec4, vec4, &modelView);
-    }
+    Director::getInstance()->getJobPool()->parallelFor(_numQuads, QUADS_PER_TRANSFORM_JOB, job);
 }
 
-void Renderer::drawBatchedQuads()
+void Renderer::convertToWorldCoordinates(const V3F_C4B_T2F_Quad* src, V3F_C4B_T2F_Quad* dst, ssize_t quantity, const kmMat4& modelView)
 {
-    //TODO we can improve the draw performance by insert material switching command before hand.
+    static_assert(sizeof(V3F_C4B_T2F_Quad) == 4 * sizeof(V3F_C4B_T2F), "quads are processed as an array of vertices");
 
-    int quadsToDraw = 0;
-    int startQuad = 0;
+    const V3F_C4B_T2F* in = &src[0].tl;
+    V3F_C4B_T2F* out = &dst[0].tl;
+    const ssize_t count = quantity * 4;
 
-    //Upload buffer to VBO
-    if(_numQuads <= 0 || _batchedQuadCommands.empty())
-    {
-        return;
-    }
+#if CC_RENDERER_USE_SSE2
+    const __m128 col0 = _mm_loadu_ps(&modelView.mat[0]);
+    const __m128 col1 = _mm_loadu_ps(&modelView.mat[4]);
+    const __m128 col2 = _mm_loadu_ps(&modelView.mat[8]);
+    const __m128 col3 = _mm_loadu_ps(&modelView.mat[12]);
+    // x, y, z are replaced, the 4th lane holds the color and is copied untouched
+    const __m128 mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
 
-    if (Configuration::getInstance()->supportsShareableVAO())
+    for(ssize_t i=0; i<count; ++i)
     {
-        //Set VBO data
-        glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
+        __m128 v = _mm_loadu_ps(&in[i].vertices.x);
 
-        // option 1: subdata
-//        glBufferSubData(GL_ARRAY_BUFFER, sizeof(_quads[0])*start, sizeof(_quads[0]) * n , &_quads[start] );
+        __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0,0,0,0)), col0),
+                                         _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1,1,1,1)), col1)),
+                              _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2,2,2,2)), col2),
+                                         col3));
 
-        // option 2: data
-//        glBufferData(GL_ARRAY_BUFFER, sizeof(quads_[0]) * (n-start), &quads_[start], GL_DYNAMIC_DRAW);
+        _mm_storeu_ps(&out[i].vertices.x, _mm_or_ps(_mm_and_ps(mask, r), _mm_andnot_ps(mask, v)));
+        out[i].texCoords = in[i].texCoords;
+    }
+#elif CC_RENDERER_USE_NEON
+    const float32x4_t col0 = vld1q_f32(&modelView.mat[0]);
+    const float32x4_t col1 = vld1q_f32(&modelView.mat[4]);
+    const float32x4_t col2 = vld1q_f32(&modelView.mat[8]);
+    const float32x4_t col3 = vld1q_f32(&modelView.mat[12]);
 
-        // option 3: orphaning + glMapBuffer
-        glBufferData(GL_ARRAY_BUFFER, sizeof(_quads[0]) * (_numQuads), nullptr, GL_DYNAMIC_DRAW);
-        void *buf = glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
-        memcpy(buf, _quads, sizeof(_quads[0])* (_numQuads));
-        glUnmapBuffer(GL_ARRAY_BUFFER);
+    for(ssize_t i=0; i<count; ++i)
+    {
+        float32x4_t v = vld1q_f32(&in[i].vertices.x);
 
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        float32x4_t r = vmlaq_n_f32(col3, col0, vgetq_lane_f32(v, 0));
+        r = vmlaq_n_f32(r, col1, vgetq_lane_f32(v, 1));
+        r = vmlaq_n_f32(r, col2, vgetq_lane_f32(v, 2));
 
-        //Bind VAO
-        GL::bindVAO(_quadVAO);
+        // keep the color stored after the position
+        vst1q_f32(&out[i].vertices.x, vsetq_lane_f32(vgetq_lane_f32(v, 3), r, 3));
+        out[i].texCoords = in[i].texCoords;
     }
-    else
+#else
+    for(ssize_t i=0; i<count; ++i)
     {
-#define kQuadSize sizeof(_quads[0].bl)
-        glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
-
-        glBufferData(GL_ARRAY_BUFFER, sizeof(_quads[0]) * _numQuads , _quads, GL_DYNAMIC_DRAW);
+        out[i] = in[i];
+        kmVec3 *vec = (kmVec3*)&out[i].vertices;
+        kmVec3Transform(vec, vec, &modelView);
+    }
+#endif
+}
 
-        GL::enableVertexAttribs(GL::VERTEX_ATTRIB_FLAG_POS_COLOR_TEX);
+void Renderer::drawBatchedQuads()
+{
+    //TODO we can improve the draw performance by insert material switching command before hand.
 
-        // vertices
-        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, kQuadSize, (GLvoid*) offsetof(V3F_C4B_T2F, vertices));
+    ssize_t quadsToDraw = 0;
+    ssize_t startQuad = 0;
+    // first quad referenced by the attribute pointers
+    ssize_t indexBase = 0;
 
-        // colors
-        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, kQuadSize, (GLvoid*) offsetof(V3F_C4B_T2F, colors));
+    if(_numQuads <= 0 || _batchedQuadCommands.empty())
+    {
+        return;
+    }
 
-        // tex coords
-        glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORDS, 2, GL_FLOAT, GL_FALSE, kQuadSize, (GLvoid*) offsetof(V3F_C4B_T2F, texCoords));
+    _stats.quads += _numQuads;
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
+    GLintptr offset = 0;
+    if(_headless)
+    {
+        //Nothing is uploaded, but the quads are transformed to keep the CPU cost of the frame
+        if(_quads.size() < (size_t)_numQuads)
+        {
+            _quads.resize(_numQuads);
+        }
+        transformBatchedQuads(_quads.data());
+    }
+    else
+    {
+        offset = uploadBatchedQuads();
     }
 
     //Start drawing verties in batch
@@ -467,17 +714,19 @@ void Renderer::drawBatchedQuads()
             //Draw quads
             if(quadsToDraw > 0)
             {
-                glDrawElements(GL_TRIANGLES, (GLsizei) quadsToDraw*6, GL_UNSIGNED_SHORT, (GLvoid*) (startQuad*6*sizeof(_indices[0])) );
-                _drawnBatches++;
-                _drawnVertices += quadsToDraw*6;
+                drawQuads(offset, startQuad, quadsToDraw, indexBase);
 
                 startQuad += quadsToDraw;
                 quadsToDraw = 0;
             }
 
             //Use new material
-            cmd->useMaterial();
+            if(!_headless)
+            {
+                cmd->useMaterial();
+            }
             _lastMaterialID = cmd->getMaterialID();
+            _stats.materialChanges++;
         }
 
         quadsToDraw += cmd->getQuadCount();
@@ -486,24 +735,137 @@ void Renderer::drawBatchedQuads()
     //Draw any remaining quad
     if(quadsToDraw > 0)
     {
-        glDrawElements(GL_TRIANGLES, (GLsizei) quadsToDraw*6, GL_UNSIGNED_SHORT, (GLvoid*) (startQuad*6*sizeof(_indices[0])) );
-        _drawnBatches++;
-        _drawnVertices += quadsToDraw*6;
+        drawQuads(offset, startQuad, quadsToDraw, indexBase);
+    }
+
+    if (!_headless)
+    {
+        if (Configuration::getInstance()->supportsShareableVAO())
+        {
+            //Unbind VAO
+            GL::bindVAO(0);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+        else
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        }
+    }
+
+    _batchedQuadCommands.clear();
+    _numQuads = 0;
+}
+
+GLintptr Renderer::uploadBatchedQuads()
+{
+    //Upload buffer to VBO
+    glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
+
+    //Size the sections from the whole previous frame, so that a frame doesn't orphan the buffer every time
+    if(_vboFrameQuads == 0 && _vboLastFrameQuads > _vboSectionCapacity)
+    {
+        _vboSectionCapacity = std::max(_vboLastFrameQuads, _vboSectionCapacity * 2);
+        orphanVertexBuffer();
+    }
+
+    //Append the quads to the section of the current frame
+    if(_numQuads > _vboSectionCapacity)
+    {
+        //Grow every section so that the whole batch fits in one of them
+        _vboSectionCapacity = std::max((ssize_t)_numQuads, _vboSectionCapacity * 2);
+        orphanVertexBuffer();
+    }
+    else if(_vboSectionQuads + _numQuads > _vboSectionCapacity)
+    {
+        orphanVertexBuffer();
     }
 
+    GLintptr offset = sizeof(V3F_C4B_T2F_Quad) * (_vboSection * _vboSectionCapacity + _vboSectionQuads);
+    GLsizeiptr size = sizeof(V3F_C4B_T2F_Quad) * _numQuads;
+    bool uploaded = false;
+
+#if CC_RENDERER_USE_MAP_BUFFER_RANGE
+    if (Configuration::getInstance()->supportsMapBufferRange())
+    {
+        //Wait until the GPU is done with the frame that used this section
+        GLsync& fence = _vboFences[_vboSection];
+        if(fence)
+        {
+            while(glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED)
+            {
+            }
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+
+        //The range is fenced, so it can be mapped without synchronizing and written in place
+        auto buf = (V3F_C4B_T2F_Quad*) glMapBufferRange(GL_ARRAY_BUFFER, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        if(buf)
+        {
+            transformBatchedQuads(buf);
+            //The content is undefined if the mapping was lost, it is uploaded again below
+            uploaded = glUnmapBuffer(GL_ARRAY_BUFFER) == GL_TRUE;
+        }
+    }
+#endif
+
+    if(!uploaded)
+    {
+        if(_quads.size() < (size_t)_numQuads)
+        {
+            _quads.resize(_numQuads);
+        }
+        transformBatchedQuads(_quads.data());
+        glBufferSubData(GL_ARRAY_BUFFER, offset, size, _quads.data());
+    }
+
+    _vboSectionQuads += _numQuads;
+    _vboFrameQuads += _numQuads;
+
     if (Configuration::getInstance()->supportsShareableVAO())
     {
-        //Unbind VAO
-        GL::bindVAO(0);
+        //Bind VAO, and point it to the quads just written
+        GL::bindVAO(_quadVAO);
+        setupVertexAttribPointers(offset);
     }
     else
     {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        GL::enableVertexAttribs(GL::VERTEX_ATTRIB_FLAG_POS_COLOR_TEX);
+        setupVertexAttribPointers(offset);
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
     }
 
-    _batchedQuadCommands.clear();
-    _numQuads = 0;
+    return offset;
+}
+
+void Renderer::drawQuads(GLintptr offset, ssize_t start, ssize_t count, ssize_t& indexBase)
+{
+    while(count > 0)
+    {
+        //The index buffer only covers INDEX_QUADS quads after the attribute pointers.
+        //Move the pointers when the range goes beyond them.
+        if(start + std::min(count, (ssize_t)INDEX_QUADS) - indexBase > INDEX_QUADS)
+        {
+            indexBase = start;
+            if(!_headless)
+            {
+                setupVertexAttribPointers(offset + sizeof(V3F_C4B_T2F_Quad) * indexBase);
+            }
+        }
+
+        ssize_t quads = std::min(count, INDEX_QUADS - (start - indexBase));
+        if(!_headless)
+        {
+            glDrawElements(GL_TRIANGLES, (GLsizei) quads*6, GL_UNSIGNED_SHORT, (GLvoid*) ((start - indexBase)*6*sizeof(GLushort)) );
+        }
+        _stats.drawnBatches++;
+        _stats.drawnVertices += quads*6;
+
+        start += quads;
+        count -= quads;
+    }
 }
 
 void Renderer::flush()
@@ -28,6 +28,7 @@
 
 #include "CCPlatformMacros.h"
 #include "CCRenderCommand.h"
+#include "CCFrameArena.h"
 #include "CCGLProgram.h"
 #include "CCGL.h"
 #include <vector>
@@ -39,23 +40,75 @@ class EventListenerCustom;
 class QuadCommand;
 
 /** Class that knows how to sort `RenderCommand` objects.
- Since the commands that have `z == 0` are "pushed back" in
- the correct order, the only `RenderCommand` objects that need to be sorted,
- are the ones that have `z < 0` and `z > 0`.
+ Every command is stored together with a 64-bit sort key: the global Z order
+ in the upper 32 bits and the insertion sequence in the lower 32 bits. Sorting
+ the keys with a radix sort keeps the commands that share the same Z in the
+ order they were pushed, and since most commands have `z == 0` the queue is
+ usually already sorted and the sort is skipped entirely.
 */
 class RenderQueue {
 
 public:
+    RenderQueue();
+
     void push_back(RenderCommand* command);
     ssize_t size() const;
     void sort();
     RenderCommand* operator[](ssize_t index) const;
     void clear();
 
+    /** Packs a global Z order and an insertion sequence into a key that sorts as an unsigned integer */
+    static uint64_t makeSortKey(float globalOrder, uint32_t sequence);
+
 protected:
-    std::vector<RenderCommand*> _queueNegZ;
-    std::vector<RenderCommand*> _queue0;
-    std::vector<RenderCommand*> _queuePosZ;
+    struct Entry
+    {
+        uint64_t key;
+        RenderCommand* command;
+    };
+
+    void radixSort();
+
+    std::vector<Entry> _commands;
+    // scratch buffer used by the radix sort, kept to avoid a reallocation per frame
+    std::vector<Entry> _sortBuffer;
+    bool _isSorted;
+};
+
+/** A command recorded by the `Renderer`, with the render queue it was added to.
+ `renderQueueID` is -1 for the commands added to the render queue that was current when the recording started.
+ */
+struct RecordedRenderCommand
+{
+    RenderCommand* command;
+    int renderQueueID;
+};
+
+/** What the `Renderer` processed during a frame, see `Renderer::getStats()` */
+struct RendererStats
+{
+    // render commands processed, group commands included
+    ssize_t commands;
+    // draw calls and vertices, the same values as `getDrawnBatches()` and `getDrawnVertices()`
+    ssize_t drawnBatches;
+    ssize_t drawnVertices;
+    // quads of the QuadCommands
+    ssize_t quads;
+    // times a material (shader, texture and blending) was set up for the quads
+    ssize_t materialChanges;
+    // custom and batch commands, they are not executed by a headless renderer
+    ssize_t customCommands;
+};
+
+/** A command processed by the `Renderer`, see `Renderer::setCommandStreamEnabled()` */
+struct RenderStreamCommand
+{
+    RenderCommand::Type type;
+    float globalOrder;
+    // the material ID of a QuadCommand, the render queue ID of a GroupCommand, 0 otherwise
+    uint64_t id;
+    // the quads of a QuadCommand, 0 otherwise
+    ssize_t quads;
 };
 
 struct RenderStackElement
@@ -71,8 +124,15 @@ Whenever possible prefer to use `QuadCommand` objects since the renderer will au
 class Renderer
 {
 public:
-    static const int VBO_SIZE = 65536 / 6;
+    // initial number of quads of every section of the vertex VBO, it grows with the biggest batch
+    static const int VBO_INITIAL_SIZE = 2048;
+    // the vertex VBO is a ring of VBO_SECTIONS sections, one per frame in flight
+    static const int VBO_SECTIONS = 3;
+    // number of quads covered by the 16-bit index buffer, bigger batches are drawn in several ranges
+    static const int INDEX_QUADS = 65536 / 4;
     static const int BATCH_QUADCOMMAND_RESEVER_SIZE = 64;
+    // minimum number of quads transformed by a single job of the JobPool
+    static const int QUADS_PER_TRANSFORM_JOB = 1024;
 
     Renderer();
     ~Renderer();
@@ -95,55 +155,136 @@ public:
     /** Creates a render queue and returns its Id */
     int createRenderQueue();
 
+    /** Starts recording the commands added to the renderer into `commands`. Recordings can be nested. */
+    void beginRecording(std::vector<RecordedRenderCommand>* commands);
+
+    /** Stops the last recording started with `beginRecording`.
+     Returns false if the recording can't be replayed, because it contains commands created with the frame arena.
+     */
+    bool endRecording();
+
+    /** Adds commands recorded in a previous frame, in the same order and render queues */
+    void addRecordedCommands(const std::vector<RecordedRenderCommand>& commands);
+
     /** Renders into the GLView all the queued `RenderCommand` objects */
     void render();
 
+    /** A headless renderer processes the commands without issuing any GL call.
+     The quads are still batched and transformed and the draw calls are counted as if they were issued,
+     but custom and batch commands are skipped. Used with a headless GLView to profile scenes without a GPU.
+     Must be set before `initGLView()`.
+     */
+    void setHeadless(bool headless) { _headless = headless; }
+    bool isHeadless() const { return _headless; }
+
+    /** Returns the stats of the last frame */
+    const RendererStats& getStats() const { return _stats; }
+
+    /** Keeps the commands processed during each frame, in the order they were processed */
+    void setCommandStreamEnabled(bool enabled) { _commandStreamEnabled = enabled; }
+    bool isCommandStreamEnabled() const { return _commandStreamEnabled; }
+    /** Returns the commands processed during the last frame, when the command stream is enabled */
+    const std::vector<RenderStreamCommand>& getCommandStream() const { return _commandStream; }
+
+    /** Returns the arena for the commands and data that only live until the end of the frame.
+     It is reset at the end of `render()`, objects created with it must not be kept after that.
+     */
+    FrameArena* getFrameArena() { return &_frameArena; }
+
     /* returns the number of drawn batches in the last frame */
-    ssize_t getDrawnBatches() const { return _drawnBatches; }
+    ssize_t getDrawnBatches() const { return _stats.drawnBatches; }
     /* RenderCommands (except) QuadCommand should update this value */
-    void addDrawnBatches(ssize_t number) { _drawnBatches += number; };
+    void addDrawnBatches(ssize_t number) { _stats.drawnBatches += number; };
     /* returns the number of drawn triangles in the last frame */
-    ssize_t getDrawnVertices() const { return _drawnVertices; }
+    ssize_t getDrawnVertices() const { return _stats.drawnVertices; }
     /* RenderCommands (except) QuadCommand should update this value */
-    void addDrawnVertices(ssize_t number) { _drawnVertices += number; };
+    void addDrawnVertices(ssize_t number) { _stats.drawnVertices += number; };
 
 protected:
 
+    //Fills the bound element buffer with the indices of INDEX_QUADS quads
     void setupIndices();
     //Setup VBO or VAO based on OpenGL extensions
     void setupBuffer();
     void setupVBOAndVAO();
     void setupVBO();
     void mapBuffers();
+    //Sets the quad attribute pointers, starting at `offset` bytes in the vertex VBO
+    void setupVertexAttribPointers(GLintptr offset);
+    //Moves to the next section of the vertex VBO, called once per frame
+    void nextVertexBufferSection();
+    //Gets new storage for the vertex VBO when a frame doesn't fit in its section
+    void orphanVertexBuffer();
 
     void drawBatchedQuads();
+    //Uploads the transformed batch to the vertex VBO and binds it, returns the offset of the batch in the VBO
+    GLintptr uploadBatchedQuads();
+    //Draws `count` quads starting at quad `start` of the batch written at `offset` in the vertex VBO
+    void drawQuads(GLintptr offset, ssize_t start, ssize_t count, ssize_t& indexBase);
 
     //Draw the previews queued quads and flush previous context
     void flush();
 
-    void convertToWorldCoordinates(V3F_C4B_T2F_Quad* quads, ssize_t quantity, const kmMat4& modelView);
+    //Adds the command to the command stream of the frame
+    void recordCommand(RenderCommand* command);
+
+    //Transforms the batched quads to world coordinates into `dst`, spread across the JobPool
+    void transformBatchedQuads(V3F_C4B_T2F_Quad* dst);
 
-    std::stack<int> _commandGroupStack;
+    static void convertToWorldCoordinates(const V3F_C4B_T2F_Quad* src, V3F_C4B_T2F_Quad* dst, ssize_t quantity, const kmMat4& modelView);
+
+    // the stacks are backed by vectors to keep their storage from one frame to the next
+    std::stack<int, std::vector<int>> _commandGroupStack;
     
-    std::stack<RenderStackElement> _renderStack;
+    std::stack<RenderStackElement, std::vector<RenderStackElement>> _renderStack;
     std::vector<RenderQueue> _renderGroups;
 
+    struct Recording
+    {
+        std::vector<RecordedRenderCommand>* commands;
+        int renderQueueID;
+        // false once a command of the frame arena was recorded
+        bool replayable;
+    };
+    // active recordings, innermost last
+    std::vector<Recording> _recordings;
+
     uint64_t _lastMaterialID;
 
     std::vector<QuadCommand*> _batchedQuadCommands;
+    // offset of every batched command inside the batch
+    std::vector<ssize_t> _batchedQuadOffsets;
 
-    V3F_C4B_T2F_Quad _quads[VBO_SIZE];
-    GLushort _indices[6 * VBO_SIZE];
+    // transformed quads waiting to be uploaded, only used when the VBO can't be mapped
+    std::vector<V3F_C4B_T2F_Quad> _quads;
     GLuint _quadVAO;
     GLuint _buffersVBO[2]; //0: vertex  1: indices
 
+    // quads per section of the vertex VBO
+    ssize_t _vboSectionCapacity;
+    // section of the vertex VBO used by the current frame, and quads already written in it
+    int _vboSection;
+    ssize_t _vboSectionQuads;
+    // quads uploaded by the current and the previous frame, the sections are sized from the latter
+    ssize_t _vboFrameQuads;
+    ssize_t _vboLastFrameQuads;
+#if CC_RENDERER_USE_MAP_BUFFER_RANGE
+    // signaled once the GPU is done with the matching section
+    GLsync _vboFences[VBO_SECTIONS];
+#endif
+
     int _numQuads;
     
     bool _glViewAssigned;
 
+    FrameArena _frameArena;
+
+    bool _headless;
+
     // stats
-    ssize_t _drawnBatches;
-    ssize_t _drawnVertices;
+    RendererStats _stats;
+    bool _commandStreamEnabled;
+    std::vector<RenderStreamCommand> _commandStream;
     
 #if CC_ENABLE_CACHE_TEXTURE_DATA
     EventListenerCustom* _cacheTextureListener;
@@ -35,14 +35,16 @@ const Data Data::Null;
 
 Data::Data() :
 _bytes(nullptr),
-_size(0)
+_size(0),
+_isView(false)
 {
     CCLOGINFO("In the empty constructor of Data.");
 }
 
 Data::Data(Data&& other) :
 _bytes(nullptr),
-_size(0)
+_size(0),
+_isView(false)
 {
     CCLOGINFO("In the move constructor of Data.");
     move(other);
@@ -50,7 +52,8 @@ _size(0)
 
 Data::Data(const Data& other) :
 _bytes(nullptr),
-_size(0)
+_size(0),
+_isView(false)
 {
     CCLOGINFO("In the copy constructor of Data.");
     copy(other._bytes, other._size);
@@ -80,9 +83,11 @@ void Data::move(Data& other)
 {
     _bytes = other._bytes;
     _size = other._size;
+    _isView = other._isView;
     
     other._bytes = nullptr;
     other._size = 0;
+    other._isView = false;
 }
 
 bool Data::isNull() const
@@ -95,6 +100,11 @@ unsigned char* Data::getBytes() const
     return _bytes;
 }
 
+bool Data::isView() const
+{
+    return _isView;
+}
+
 ssize_t Data::getSize() const
 {
     return _size;
@@ -116,13 +126,27 @@ void Data::fastSet(unsigned char* bytes, const ssize_t size)
 {
     _bytes = bytes;
     _size = size;
+    _isView = false;
+}
+
+void Data::setView(unsigned char* bytes, const ssize_t size)
+{
+    clear();
+    
+    _bytes = bytes;
+    _size = size;
+    _isView = true;
 }
 
 void Data::clear()
 {
-    free(_bytes);
+    if (!_isView)
+    {
+        free(_bytes);
+    }
     _bytes = nullptr;
     _size = 0;
+    _isView = false;
 }
 
 NS_CC_END
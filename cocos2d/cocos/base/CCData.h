@@ -74,18 +74,30 @@ public:
      */
     void fastSet(unsigned char* bytes, const ssize_t size);
     
+    /** Sets the buffer pointer and its size without taking the ownership of 'bytes'.
+     *  @note 1. The buffer is not freed by Data, it has to outlive this object and the objects it is moved to,
+     *        2. Copies of a view allocate and own their buffer,
+     *        3. The buffer is shared, so it should be treated as read only.
+     *  @see Data::fastSet
+     */
+    void setView(unsigned char* bytes, const ssize_t size);
+    
     /** Clears data, free buffer and reset data size */
     void clear();
     
     /** Check whether the data is null. */
     bool isNull() const;
     
+    /** Check whether the data refers to a buffer it doesn't own. */
+    bool isView() const;
+    
 private:
     void move(Data& other);
     
 private:
     unsigned char* _bytes;
     ssize_t _size;
+    bool _isView;
 };
 
 NS_CC_END
@@ -0,0 +1,165 @@
+/****************************************************************************
+ Copyright (c) 2013-2014 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "CCJobPool.h"
+#include "ccMacros.h"
+
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#define CC_JOB_THREAD_LOCAL __declspec(thread)
+#else
+#define CC_JOB_THREAD_LOCAL __thread
+#endif
+
+NS_CC_BEGIN
+
+// set while the thread runs a job, parallelFor can't be called from inside a job
+static CC_JOB_THREAD_LOCAL bool s_runningJob = false;
+
+JobPool::JobPool(int workerCount)
+: _job(nullptr)
+, _count(0)
+, _chunkSize(1)
+, _nextIndex(0)
+, _pendingChunks(0)
+, _generation(0)
+, _activeWorkers(0)
+, _quit(false)
+{
+    if (workerCount < 0)
+    {
+        workerCount = std::max((int)std::thread::hardware_concurrency() - 1, 0);
+    }
+
+    _workers.reserve(workerCount);
+    for (int i = 0; i < workerCount; ++i)
+    {
+        _workers.push_back(std::thread(&JobPool::workerLoop, this));
+    }
+}
+
+JobPool::~JobPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _quit = true;
+    }
+    _wakeCondition.notify_all();
+
+    for (auto& worker : _workers)
+    {
+        worker.join();
+    }
+}
+
+void JobPool::parallelFor(ssize_t count, ssize_t minChunkSize, const RangeJob& job)
+{
+    CCASSERT(!s_runningJob, "JobPool::parallelFor can't be called from inside a job");
+
+    if (count <= 0)
+        return;
+
+    minChunkSize = std::max(minChunkSize, (ssize_t)1);
+
+    if (_workers.empty() || count <= minChunkSize)
+    {
+        s_runningJob = true;
+        job(0, count);
+        s_runningJob = false;
+        return;
+    }
+
+    // A few chunks per thread so that a slow chunk doesn't stall everybody
+    const ssize_t threads = _workers.size() + 1;
+    const ssize_t chunkSize = std::max(minChunkSize, (count + threads * 4 - 1) / (threads * 4));
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _job = &job;
+        _count = count;
+        _chunkSize = chunkSize;
+        _nextIndex = 0;
+        _pendingChunks = (count + chunkSize - 1) / chunkSize;
+        ++_generation;
+    }
+    _wakeCondition.notify_all();
+
+    runChunks();
+
+    // Wait for the chunks taken by the workers, and for the workers to leave
+    // the range before it can be reused
+    std::unique_lock<std::mutex> lock(_mutex);
+    _doneCondition.wait(lock, [this](){ return _pendingChunks == 0 && _activeWorkers == 0; });
+    _job = nullptr;
+}
+
+void JobPool::runChunks()
+{
+    while (true)
+    {
+        ssize_t begin = _nextIndex.fetch_add(_chunkSize);
+        if (begin >= _count)
+            break;
+
+        s_runningJob = true;
+        (*_job)(begin, std::min(begin + _chunkSize, _count));
+        s_runningJob = false;
+
+        if (_pendingChunks.fetch_sub(1) == 1)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _doneCondition.notify_all();
+        }
+    }
+}
+
+void JobPool::workerLoop()
+{
+    unsigned int generation = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wakeCondition.wait(lock, [&](){ return _quit || (_job != nullptr && _generation != generation); });
+            if (_quit)
+                return;
+
+            generation = _generation;
+            ++_activeWorkers;
+        }
+
+        runChunks();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            --_activeWorkers;
+        }
+        _doneCondition.notify_all();
+    }
+}
+
+NS_CC_END
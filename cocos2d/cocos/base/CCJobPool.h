@@ -0,0 +1,95 @@
+/****************************************************************************
+ Copyright (c) 2013-2014 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __CCJOBPOOL_H__
+#define __CCJOBPOOL_H__
+
+#include <thread>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#include "CCPlatformMacros.h"
+
+NS_CC_BEGIN
+
+/** JobPool is a small pool of worker threads used to split data-parallel work
+ (transforming quads, updating independent objects, ...) across the cores.
+
+ The thread that calls `parallelFor` takes part in the work and only returns
+ once every chunk has been processed, so the job can safely reference data
+ living on the caller's stack. `parallelFor` must only be called from one
+ thread at a time, usually the cocos2d thread, and never from inside a job.
+ */
+class CC_DLL JobPool
+{
+public:
+    typedef std::function<void(ssize_t begin, ssize_t end)> RangeJob;
+
+    /** Creates a pool with `workerCount` threads.
+     A negative value uses one thread less than the number of hardware threads,
+     since the calling thread also executes jobs.
+     */
+    explicit JobPool(int workerCount = -1);
+
+    /** Destructor. Stops and joins the worker threads */
+    ~JobPool();
+
+    /** Returns the number of worker threads, not counting the calling thread */
+    int getWorkerCount() const { return (int)_workers.size(); }
+
+    /** Splits `[0, count)` in chunks of at least `minChunkSize` elements and runs `job`
+     on every chunk. Small ranges are run directly on the calling thread.
+     */
+    void parallelFor(ssize_t count, ssize_t minChunkSize, const RangeJob& job);
+
+protected:
+    void workerLoop();
+    void runChunks();
+
+    std::vector<std::thread> _workers;
+
+    std::mutex _mutex;
+    std::condition_variable _wakeCondition;
+    std::condition_variable _doneCondition;
+
+    // current range being processed
+    const RangeJob* _job;
+    ssize_t _count;
+    ssize_t _chunkSize;
+    std::atomic<ssize_t> _nextIndex;
+    std::atomic<ssize_t> _pendingChunks;
+
+    // incremented for every new range, wakes up the workers
+    unsigned int _generation;
+    int _activeWorkers;
+    bool _quit;
+};
+
+NS_CC_END
+
+#endif /* __CCJOBPOOL_H__ */
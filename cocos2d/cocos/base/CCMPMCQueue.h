@@ -0,0 +1,165 @@
+/****************************************************************************
+ Copyright (c) 2013-2014 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+
+#ifndef __CCMPMCQUEUE_H__
+#define __CCMPMCQUEUE_H__
+
+#include <atomic>
+#include <cstddef>
+
+#include "CCPlatformMacros.h"
+
+NS_CC_BEGIN
+
+/** MPMCQueue is a bounded lock-free queue that any number of threads can push to
+ and pop from concurrently.
+
+ Every cell carries a sequence number telling producers and consumers whether it
+ is free or filled, so both ends only need a single compare-and-swap on their own
+ position. The capacity is rounded up to a power of two. `push` fails instead of
+ blocking when the queue is full and `pop` fails when it is empty.
+
+ T must be cheap to copy, it is meant to store pointers or small handles.
+ */
+template <typename T>
+class MPMCQueue
+{
+public:
+    explicit MPMCQueue(size_t capacity)
+    : _cells(nullptr)
+    , _mask(0)
+    {
+        size_t size = 2;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+
+        _cells = new Cell[size];
+        _mask = size - 1;
+        for (size_t i = 0; i < size; ++i)
+        {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        _enqueuePos.store(0, std::memory_order_relaxed);
+        _dequeuePos.store(0, std::memory_order_relaxed);
+    }
+
+    ~MPMCQueue()
+    {
+        delete [] _cells;
+    }
+
+    /** Returns the maximum number of elements the queue can hold */
+    size_t getCapacity() const { return _mask + 1; }
+
+    /** Adds an element at the end of the queue. Returns false if the queue is full */
+    bool push(const T& value)
+    {
+        Cell* cell = nullptr;
+        size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            cell = &_cells[pos & _mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            ptrdiff_t diff = (ptrdiff_t)sequence - (ptrdiff_t)pos;
+            if (diff == 0)
+            {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                //the consumers have not released this cell yet, the queue is full
+                return false;
+            }
+            else
+            {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Removes the first element of the queue and stores it in `value`. Returns false if the queue is empty */
+    bool pop(T& value)
+    {
+        Cell* cell = nullptr;
+        size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            cell = &_cells[pos & _mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            ptrdiff_t diff = (ptrdiff_t)sequence - (ptrdiff_t)(pos + 1);
+            if (diff == 0)
+            {
+                if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                //no producer has filled this cell yet, the queue is empty
+                return false;
+            }
+            else
+            {
+                pos = _dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        value = cell->data;
+        cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+        return true;
+    }
+
+protected:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    // producers and consumers spin on different positions, keep them on separate cache lines
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    Cell* _cells;
+    size_t _mask;
+    char _padding0[CACHE_LINE_SIZE];
+    std::atomic<size_t> _enqueuePos;
+    char _padding1[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> _dequeuePos;
+    char _padding2[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+
+private:
+    CC_DISALLOW_COPY_AND_ASSIGN(MPMCQueue);
+};
+
+NS_CC_END
+
+#endif /* __CCMPMCQUEUE_H__ */
@@ -22,17 +22,24 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
 
+#include <algorithm>
+
 #include "cocostudio/CCArmature.h"
 #include "cocostudio/CCArmatureDataManager.h"
 #include "cocostudio/CCArmatureDefine.h"
 #include "cocostudio/CCDataReaderHelper.h"
 #include "cocostudio/CCDatas.h"
 #include "cocostudio/CCSkin.h"
+#include "cocostudio/CCDisplayFactory.h"
 
 #include "renderer/CCRenderer.h"
 #include "renderer/CCGroupCommand.h"
 #include "CCShaderCache.h"
 #include "CCDrawingPrimitives.h"
+#include "CCDirector.h"
+#include "CCJobPool.h"
+#include "CCEventDispatcher.h"
+#include "CCEventListenerCustom.h"
 
 #if ENABLE_PHYSICS_BOX2D_DETECT
 #include "Box2D/Box2D.h"
@@ -45,6 +52,10 @@ using namespace cocos2d;
 
 namespace cocostudio {
 
+//Top level armatures waiting for their pose to be evaluated, retained until then
+static std::vector<Armature*> s_pendingPoses;
+static EventListenerCustom *s_pendingPosesListener = nullptr;
+
 Armature *Armature::create()
 {
     Armature *armature = new Armature();
@@ -87,6 +98,9 @@ Armature::Armature()
     , _batchNode(nullptr)
     , _parentBone(nullptr)
     , _armatureTransformDirty(true)
+    , _boneOrderDirty(true)
+    , _posePending(false)
+    , _pendingDelta(0)
     , _animation(nullptr)
 {
 }
@@ -256,6 +270,8 @@ void Armature::addBone(Bone *bone, const std::string& parentName)
 
     _boneDic.insert(bone->getName(), bone);
     addChild(bone);
+
+    _boneOrderDirty = true;
 }
 
 
@@ -272,6 +288,8 @@ void Armature::removeBone(Bone *bone, bool recursion)
     }
     _boneDic.erase(bone->getName());
     removeChild(bone, true);
+
+    _boneOrderDirty = true;
 }
 
 
@@ -308,6 +326,8 @@ void Armature::changeBoneParent(Bone *bone, const std::string& parentName)
             _topBoneList.pushBack(bone);
         }
     }
+
+    _boneOrderDirty = true;
 }
 
 const cocos2d::Map<std::string, Bone*>& Armature::getBoneDic() const
@@ -370,13 +390,127 @@ void Armature::update(float dt)
 {
     _animation->update(dt);
 
-    for(const auto &bone : _topBoneList) {
-        bone->update(dt);
+    //The pose of a top level armature is evaluated on the JobPool, together with the other armatures, once all the updates of the frame have run.
+    //Nested armatures are updated by their parent bone's display, so they are evaluated right away
+    if (_parentBone == nullptr && _running)
+    {
+        if (!_posePending)
+        {
+            _posePending = true;
+            retain();
+            s_pendingPoses.push_back(this);
+
+            if (s_pendingPosesListener == nullptr)
+            {
+                s_pendingPosesListener = Director::getInstance()->getEventDispatcher()->addCustomEventListener(Director::EVENT_AFTER_UPDATE, [](EventCustom*){
+                    Armature::updatePendingPoses();
+                });
+            }
+        }
+        _pendingDelta += dt;
+        return;
+    }
+
+    updateBoneOrder();
+    updateBoneTransforms();
+    updateBoneDisplays(dt);
+}
+
+static void appendBones(Bone *bone, std::vector<Bone*> &order)
+{
+    order.push_back(bone);
+
+    for (const auto &child : bone->getChildren())
+    {
+        appendBones(static_cast<Bone*>(child), order);
+    }
+}
+
+void Armature::updateBoneOrder()
+{
+    if (!_boneOrderDirty)
+        return;
+
+    _boneOrder.clear();
+    _boneOrder.reserve(_boneDic.size());
+
+    for(const auto &bone : _topBoneList)
+    {
+        appendBones(bone, _boneOrder);
+    }
+
+    _boneOrderDirty = false;
+}
+
+void Armature::updateBoneTransforms()
+{
+    for (const auto &bone : _boneOrder)
+    {
+        bone->updateWorldTransform();
+    }
+}
+
+void Armature::updateBoneDisplays(float dt)
+{
+    for (const auto &bone : _boneOrder)
+    {
+        DisplayFactory::updateDisplay(bone, dt, bone->isTransformDirty() || _armatureTransformDirty);
+    }
+
+    for (const auto &bone : _boneOrder)
+    {
+        bone->setTransformDirty(false);
     }
 
     _armatureTransformDirty = false;
 }
 
+void Armature::updatePendingPoses()
+{
+    if (s_pendingPoses.empty())
+    {
+        return;
+    }
+
+    //The listener is only needed while there are pending poses
+    Director::getInstance()->getEventDispatcher()->removeEventListener(s_pendingPosesListener);
+    s_pendingPosesListener = nullptr;
+
+    std::vector<Armature*> armatures;
+    armatures.swap(s_pendingPoses);
+
+    for (const auto &armature : armatures)
+    {
+        armature->updateBoneOrder();
+    }
+
+    auto job = [&armatures](ssize_t begin, ssize_t end) {
+        for (ssize_t i = begin; i < end; ++i)
+        {
+            armatures[i]->updateBoneTransforms();
+        }
+    };
+
+    JobPool *jobPool = Director::getInstance()->getJobPool();
+    if (jobPool)
+    {
+        jobPool->parallelFor(armatures.size(), 1, job);
+    }
+    else
+    {
+        job(0, armatures.size());
+    }
+
+    //Displays may create nodes, update particles or child armatures, keep them on the main thread
+    for (const auto &armature : armatures)
+    {
+        armature->updateBoneDisplays(armature->_pendingDelta);
+        armature->_pendingDelta = 0;
+        armature->_posePending = false;
+        armature->release();
+    }
+}
+
 void Armature::draw(cocos2d::Renderer *renderer, const kmMat4 &transform, bool transformUpdated)
 {
     if (_parentBone == nullptr && _batchNode == nullptr)
@@ -384,7 +518,6 @@ void Armature::draw(cocos2d::Renderer *renderer, const kmMat4 &transform, bool t
 //        CC_NODE_DRAW_SETUP();
     }
 
-
     for (auto& object : _children)
     {
         if (Bone *bone = dynamic_cast<Bone *>(object))
@@ -423,9 +556,9 @@ void Armature::draw(cocos2d::Renderer *renderer, const kmMat4 &transform, bool t
             break;
             }
         }
-        else if(Node *node = dynamic_cast<Node *>(object))
+        else
         {
-            node->visit(renderer, transform, transformUpdated);
+            object->visit(renderer, transform, transformUpdated);
 //            CC_NODE_DRAW_SETUP();
         }
     }
@@ -441,6 +574,22 @@ void Armature::onExit()
 {
     Node::onExit();
     unscheduleUpdate();
+
+    //Scenes and the Director going away exit their armatures, so no pending pose nor listener outlives them
+    auto iter = std::find(s_pendingPoses.begin(), s_pendingPoses.end(), this);
+    if (iter != s_pendingPoses.end())
+    {
+        s_pendingPoses.erase(iter);
+        _pendingDelta = 0;
+        _posePending = false;
+
+        if (s_pendingPoses.empty())
+        {
+            Director::getInstance()->getEventDispatcher()->removeEventListener(s_pendingPosesListener);
+            s_pendingPosesListener = nullptr;
+        }
+        release();
+    }
 }
 
 
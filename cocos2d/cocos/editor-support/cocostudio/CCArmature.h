@@ -158,8 +158,16 @@ public:
      */
     virtual void visit(cocos2d::Renderer *renderer, const kmMat4 &parentTransform, bool parentTransformUpdated) override;
     virtual void draw(cocos2d::Renderer *renderer, const kmMat4 &transform, bool transformUpdated) override;
+    /**
+     * Advances the animation. The pose of a top level armature on a running scene is only evaluated
+     * once all the updates of the frame have run, together with the other armatures.
+     * Code calling update() itself and reading the bones right away has to call updatePendingPoses() first.
+     */
     virtual void update(float dt) override;
 
+    /** Evaluates now the poses deferred by update(), it is done by the Director once all the updates of the frame have run */
+    static void updatePendingPoses();
+
     virtual void onEnter() override;
     virtual void onExit() override; 
 
@@ -188,6 +196,12 @@ public:
     
     virtual bool getArmatureTransformDirty() const;
 
+    /**
+     * Marks the depth first list of the bones as outdated, it is rebuilt before the next pose evaluation.
+     * Called whenever the bone hierarchy changes.
+     */
+    void setBoneOrderDirty() { _boneOrderDirty = true; }
+
 
 #if ENABLE_PHYSICS_BOX2D_DETECT || ENABLE_PHYSICS_CHIPMUNK_DETECT
     virtual void setColliderFilter(ColliderFilter *filter);
@@ -251,6 +265,15 @@ protected:
      */
     Bone *createBone(const std::string& boneName );
 
+    //! Rebuilds _boneOrder from _topBoneList, a bone always comes after its parent
+    void updateBoneOrder();
+
+    //! Computes the world transform of every bone. It doesn't touch any shared state, so it can run on the JobPool
+    void updateBoneTransforms();
+
+    //! Updates the displays from the bones' world transforms and resets the dirty flags. Main thread only
+    void updateBoneDisplays(float dt);
+
 protected:
     ArmatureData *_armatureData;
 
@@ -266,6 +289,12 @@ protected:
 
     cocos2d::Vector<Bone*> _topBoneList;
 
+    std::vector<Bone*> _boneOrder;                    //! All the bones in depth first order, weak references
+    bool _boneOrderDirty;
+
+    bool _posePending;                                //! Whether or not the pose is waiting for updatePendingPoses()
+    float _pendingDelta;
+
     cocos2d::BlendFunc _blendFunc;                    //! It's required for CCTextureProtocol inheritance
 
     cocos2d::Point _offsetPoint;
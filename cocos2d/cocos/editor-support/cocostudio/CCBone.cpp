@@ -177,13 +177,27 @@ Armature *Bone::getArmature() const
 }
 
 void Bone::update(float delta)
+{
+    updateWorldTransform();
+
+    DisplayFactory::updateDisplay(this, delta, _boneTransformDirty || _armature->getArmatureTransformDirty());
+
+    for(const auto &obj: _children) {
+        Bone *childBone = static_cast<Bone*>(obj);
+        childBone->update(delta);
+    }
+
+    _boneTransformDirty = false;
+}
+
+void Bone::updateWorldTransform()
 {
     if (_parentBone)
-        _boneTransformDirty = _boneTransformDirty || _parentBone->isTransformDirty();
+        _boneTransformDirty = _boneTransformDirty || _parentBone->_boneTransformDirty;
 
     if (_armatureParentBone && !_boneTransformDirty)
     {
-        _boneTransformDirty = _armatureParentBone->isTransformDirty();
+        _boneTransformDirty = _armatureParentBone->_boneTransformDirty;
     }
 
     if (_boneTransformDirty)
@@ -195,7 +209,8 @@ void Bone::update(float delta)
             _tweenData->scaleY -= 1;
         }
 
-        _worldInfo->copy(_tweenData);
+        //_worldInfo is always a plain BaseData, skip the virtual dispatch
+        _worldInfo->BaseData::copy(_tweenData);
 
         _worldInfo->x = _tweenData->x + _position.x;
         _worldInfo->y = _tweenData->y + _position.y;
@@ -223,15 +238,6 @@ void Bone::update(float delta)
             _worldTransform = TransformConcat(_worldTransform, _armature->getNodeToParentTransform());
         }
     }
-
-    DisplayFactory::updateDisplay(this, delta, _boneTransformDirty || _armature->getArmatureTransformDirty());
-
-    for(const auto &obj: _children) {
-        Bone *childBone = static_cast<Bone*>(obj);
-        childBone->update(delta);
-    }
-
-    _boneTransformDirty = false;
 }
 
 void Bone::applyParentTransform(Bone *parent) 
@@ -305,6 +311,11 @@ void Bone::addChildBone(Bone *child)
     {
         _children.pushBack(child);
         child->setParentBone(this);
+
+        if (_armature)
+        {
+            _armature->setBoneOrderDirty();
+        }
     }
 }
 
@@ -328,6 +339,11 @@ void Bone::removeChildBone(Bone *bone, bool recursion)
         bone->getDisplayManager()->setCurrentDecorativeDisplay(nullptr);
 
         _children.eraseObject(bone);
+
+        if (_armature)
+        {
+            _armature->setBoneOrderDirty();
+        }
     }
 }
 
@@ -134,6 +134,13 @@ public:
 
     void update(float delta) override;
 
+    /**
+     * Computes the world transform of this bone from its tween data and its parent bone.
+     * It only touches the data of this bone, so the bones of different armatures can be updated concurrently,
+     * as long as the parent bone has been updated first. It doesn't reset the transform dirty flag.
+     */
+    void updateWorldTransform();
+
     void updateDisplayedColor(const cocos2d::Color3B &parentColor) override;
     void updateDisplayedOpacity(GLubyte parentOpacity) override;
 
@@ -136,6 +136,163 @@ static const char *COLOR_INFO = "color";
 static const char *CONFIG_FILE_PATH = "config_file_path";
 static const char *CONTENT_SCALE = "content_scale";
 
+/*
+ * Binary format (.csab).
+ * The file is a header followed by sections, each one is an array of fixed size records aligned on 4 bytes,
+ * so the records are decoded straight from the file content, without any text parsing nor intermediate document.
+ * The file content is only used without a copy when it comes from a mounted asset pack, and the decoded datas
+ * are still allocated like the ones of the xml and json files. Every field is 4 bytes, in the little endian order
+ * of all the supported platforms. A record refers to its children with a range in the section of the children,
+ * and to its strings with an index in the string offsets, which point to nul terminated strings.
+ */
+static const char *BINARY_EXTENSION = ".csab";
+static const char BINARY_MAGIC[4] = {'C', 'S', 'A', 'B'};
+static const uint32_t BINARY_VERSION = 1;
+
+enum BinarySection
+{
+    BINARY_STRING_OFFSETS,
+    BINARY_STRING_CHARS,
+    BINARY_ARMATURES,
+    BINARY_BONES,
+    BINARY_DISPLAYS,
+    BINARY_ANIMATIONS,
+    BINARY_MOVEMENTS,
+    BINARY_MOVEMENT_BONES,
+    BINARY_FRAMES,
+    BINARY_EASING_PARAMS,
+    BINARY_TEXTURES,
+    BINARY_CONTOURS,
+    BINARY_VERTICES,
+    BINARY_CONFIG_FILES,
+
+    BINARY_SECTION_COUNT
+};
+
+struct BinaryHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t size;
+    uint32_t offsets[BINARY_SECTION_COUNT];
+    uint32_t counts[BINARY_SECTION_COUNT];
+};
+
+struct BinaryRange
+{
+    uint32_t first;
+    uint32_t count;
+};
+
+struct BinaryNode
+{
+    float x, y;
+    float skewX, skewY;
+    float scaleX, scaleY;
+    float tweenRotate;
+    int32_t zOrder;
+    int32_t isUseColorInfo;
+    int32_t a, r, g, b;
+};
+
+struct BinaryArmature
+{
+    uint32_t name;
+    float dataVersion;
+    BinaryRange bones;
+};
+
+struct BinaryBone
+{
+    BinaryNode node;
+    uint32_t name;
+    uint32_t parentName;
+    BinaryRange displays;
+};
+
+struct BinaryDisplay
+{
+    int32_t displayType;
+    // particle plists are relative to the binary file
+    uint32_t displayName;
+    BinaryNode skinData;
+};
+
+struct BinaryAnimation
+{
+    uint32_t name;
+    BinaryRange movements;
+};
+
+struct BinaryMovement
+{
+    uint32_t name;
+    int32_t duration;
+    float scale;
+    int32_t durationTo;
+    int32_t durationTween;
+    int32_t loop;
+    int32_t tweenEasing;
+    BinaryRange movementBones;
+};
+
+struct BinaryMovementBone
+{
+    uint32_t name;
+    float delay;
+    float scale;
+    float duration;
+    BinaryRange frames;
+};
+
+struct BinaryFrame
+{
+    BinaryNode node;
+    int32_t frameID;
+    int32_t duration;
+    int32_t tweenEasing;
+    BinaryRange easingParams;
+    int32_t isTween;
+    int32_t displayIndex;
+    uint32_t blendSrc;
+    uint32_t blendDst;
+    uint32_t strEvent;
+    uint32_t strMovement;
+    uint32_t strSound;
+    uint32_t strSoundEffect;
+};
+
+struct BinaryTexture
+{
+    uint32_t name;
+    float width, height;
+    float pivotX, pivotY;
+    BinaryRange contours;
+};
+
+struct BinaryVertex
+{
+    float x, y;
+};
+
+// record size of each section
+static const uint32_t BINARY_RECORD_SIZES[BINARY_SECTION_COUNT] = {
+    sizeof(uint32_t),
+    sizeof(char),
+    sizeof(BinaryArmature),
+    sizeof(BinaryBone),
+    sizeof(BinaryDisplay),
+    sizeof(BinaryAnimation),
+    sizeof(BinaryMovement),
+    sizeof(BinaryMovementBone),
+    sizeof(BinaryFrame),
+    sizeof(float),
+    sizeof(BinaryTexture),
+    sizeof(BinaryRange),
+    sizeof(BinaryVertex),
+    sizeof(uint32_t),
+};
+
 namespace cocostudio {
 
 
@@ -183,6 +340,7 @@ void DataReaderHelper::loadData()
         pDataInfo->asyncStruct = pAsyncStruct;
         pDataInfo->filename = pAsyncStruct->filename;
         pDataInfo->baseFilePath = pAsyncStruct->baseFilePath;
+        pDataInfo->binaryDatas = nullptr;
 
         if (pAsyncStruct->configType == DragonBone_XML)
         {
@@ -192,6 +350,10 @@ void DataReaderHelper::loadData()
         {
             DataReaderHelper::addDataFromJsonCache(pAsyncStruct->fileContent.c_str(), pDataInfo);
         }
+        else if(pAsyncStruct->configType == CocoStudio_Binary)
+        {
+            DataReaderHelper::addDataFromBinaryCache((const unsigned char *)pAsyncStruct->fileContent.data(), pAsyncStruct->fileContent.size(), pDataInfo);
+        }
 
         // put the image info into the queue
         _dataInfoMutex.lock();
@@ -292,14 +454,22 @@ void DataReaderHelper::addDataFromFile(const std::string& filePath)
     size_t startPos = filePathStr.find_last_of(".");
     std::string str = &filePathStr[startPos];
 
-    // Read content from file
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
-    std::string contentStr = FileUtils::getInstance()->getStringFromFile(fullPath);
 
     DataInfo dataInfo;
     dataInfo.filename = filePathStr;
     dataInfo.asyncStruct = nullptr;
     dataInfo.baseFilePath = basefilePath;
+    dataInfo.binaryDatas = nullptr;
+    if (str == BINARY_EXTENSION)
+    {
+        Data data = FileUtils::getInstance()->getDataFromFile(fullPath);
+        DataReaderHelper::addDataFromBinaryCache(data.getBytes(), data.getSize(), &dataInfo);
+        return;
+    }
+
+    // Read content from file
+    std::string contentStr = FileUtils::getInstance()->getStringFromFile(fullPath);
     if (str == ".xml")
     {
         DataReaderHelper::addDataFromCache(contentStr, &dataInfo);
@@ -392,7 +562,16 @@ void DataReaderHelper::addDataFromFileAsync(const std::string& imagePath, const
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
 
     // XXX fileContent is being leaked
-    data->fileContent = FileUtils::getInstance()->getStringFromFile(fullPath);
+    if (str == BINARY_EXTENSION)
+    {
+        Data content = FileUtils::getInstance()->getDataFromFile(fullPath);
+        data->fileContent.assign((const char *)content.getBytes(), content.getSize());
+        data->configType = CocoStudio_Binary;
+    }
+    else
+    {
+        data->fileContent = FileUtils::getInstance()->getStringFromFile(fullPath);
+    }
 
     if (str == ".xml")
     {
@@ -511,16 +690,7 @@ void DataReaderHelper::addDataFromCache(const std::string& pFileContent, DataInf
     {
         ArmatureData *armatureData = DataReaderHelper::decodeArmature(armatureXML, dataInfo);
 
-        if (dataInfo->asyncStruct)
-        {
-            _dataReaderHelper->_addDataMutex.lock();
-        }
-        ArmatureDataManager::getInstance()->addArmatureData(armatureData->name.c_str(), armatureData, dataInfo->filename.c_str());
-        armatureData->release();
-        if (dataInfo->asyncStruct)
-        {
-            _dataReaderHelper->_addDataMutex.unlock();
-        }
+        addArmatureData(armatureData, dataInfo);
 
         armatureXML = armatureXML->NextSiblingElement(ARMATURE);
     }
@@ -534,16 +704,7 @@ void DataReaderHelper::addDataFromCache(const std::string& pFileContent, DataInf
     while(animationXML)
     {
         AnimationData *animationData = DataReaderHelper::decodeAnimation(animationXML, dataInfo);
-        if (dataInfo->asyncStruct)
-        {
-            _dataReaderHelper->_addDataMutex.lock();
-        }
-        ArmatureDataManager::getInstance()->addAnimationData(animationData->name.c_str(), animationData, dataInfo->filename.c_str());
-        animationData->release();
-        if (dataInfo->asyncStruct)
-        {
-            _dataReaderHelper->_addDataMutex.unlock();
-        }
+        addAnimationData(animationData, dataInfo);
         animationXML = animationXML->NextSiblingElement(ANIMATION);
     }
 
@@ -557,16 +718,7 @@ void DataReaderHelper::addDataFromCache(const std::string& pFileContent, DataInf
     {
         TextureData *textureData = DataReaderHelper::decodeTexture(textureXML, dataInfo);
 
-        if (dataInfo->asyncStruct)
-        {
-            _dataReaderHelper->_addDataMutex.lock();
-        }
-        ArmatureDataManager::getInstance()->addTextureData(textureData->name.c_str(), textureData, dataInfo->filename.c_str());
-        textureData->release();
-        if (dataInfo->asyncStruct)
-        {
-            _dataReaderHelper->_addDataMutex.unlock();
-        }
+        addTextureData(textureData, dataInfo);
         textureXML = textureXML->NextSiblingElement(SUB_TEXTURE);
     }
 }
@@ -1200,16 +1352,7 @@ void DataReaderHelper::addDataFromJsonCache(const std::string& fileContent, Data
 		const rapidjson::Value &armatureDic = DICTOOL->getSubDictionary_json(json, ARMATURE_DATA, i); 
         ArmatureData *armatureData = decodeArmature(armatureDic, dataInfo);
 
-        if (dataInfo->asyncStruct)
-        {
-            _dataReaderHelper->_addDataMutex.lock();
-        }
-        ArmatureDataManager::getInstance()->addArmatureData(armatureData->name.c_str(), armatureData);
-        armatureData->release();
-        if (dataInfo->asyncStruct)
-        {
-            _dataReaderHelper->_addDataMutex.unlock();
-        }
+        addArmatureData(armatureData, dataInfo);
     }
 
     // Decode animations
@@ -1219,16 +1362,7 @@ void DataReaderHelper::addDataFromJsonCache(const std::string& fileContent, Data
 		const rapidjson::Value &animationDic = DICTOOL->getSubDictionary_json(json, ANIMATION_DATA, i);
         AnimationData *animationData = decodeAnimation(animationDic, dataInfo);
 
-        if (dataInfo->asyncStruct)
-        {
-            _dataReaderHelper->_addDataMutex.lock();
-        }
-        ArmatureDataManager::getInstance()->addAnimationData(animationData->name.c_str(), animationData);
-        animationData->release();
-        if (dataInfo->asyncStruct)
-        {
-            _dataReaderHelper->_addDataMutex.unlock();
-        }
+        addAnimationData(animationData, dataInfo);
     }
 
     // Decode textures
@@ -1238,21 +1372,12 @@ void DataReaderHelper::addDataFromJsonCache(const std::string& fileContent, Data
         const rapidjson::Value &textureDic =  DICTOOL->getSubDictionary_json(json, TEXTURE_DATA, i);
         TextureData *textureData = decodeTexture(textureDic);
 
-        if (dataInfo->asyncStruct)
-        {
-            _dataReaderHelper->_addDataMutex.lock();
-        }
-        ArmatureDataManager::getInstance()->addTextureData(textureData->name.c_str(), textureData);
-        textureData->release();
-        if (dataInfo->asyncStruct)
-        {
-            _dataReaderHelper->_addDataMutex.unlock();
-        }
+        addTextureData(textureData, dataInfo);
     }
 
     // Auto load sprite file
     bool autoLoad = dataInfo->asyncStruct == nullptr ? ArmatureDataManager::getInstance()->isAutoLoadSpriteFile() : dataInfo->asyncStruct->autoLoadSpriteFile;
-    if (autoLoad)
+    if (autoLoad || dataInfo->binaryDatas)
     {
         length =  DICTOOL->getArrayCount_json(json, CONFIG_FILE_PATH); // json[CONFIG_FILE_PATH].IsNull() ? 0 : json[CONFIG_FILE_PATH].Size();
         for (int i = 0; i < length; i++)
@@ -1267,17 +1392,7 @@ void DataReaderHelper::addDataFromJsonCache(const std::string& fileContent, Data
             std::string filePath = path;
             filePath = filePath.erase(filePath.find_last_of("."));
 
-            if (dataInfo->asyncStruct)
-            {
-                dataInfo->configFileQueue.push(filePath);
-            }
-            else
-            {
-                std::string plistPath = filePath + ".plist";
-                std::string pngPath =  filePath + ".png";
-
-                ArmatureDataManager::getInstance()->addSpriteFrameFromFile((dataInfo->baseFilePath + plistPath).c_str(), (dataInfo->baseFilePath + pngPath).c_str());
-            }
+            addConfigFile(filePath, dataInfo);
         }
     }
 }
@@ -1687,4 +1802,761 @@ void DataReaderHelper::decodeNode(BaseData *node, const rapidjson::Value& json,
 
 }
 
+void DataReaderHelper::addArmatureData(ArmatureData *armatureData, DataInfo *dataInfo)
+{
+    if (dataInfo->binaryDatas)
+    {
+        dataInfo->binaryDatas->armatureDatas.pushBack(armatureData);
+    }
+    else
+    {
+        if (dataInfo->asyncStruct)
+        {
+            _dataReaderHelper->_addDataMutex.lock();
+        }
+        ArmatureDataManager::getInstance()->addArmatureData(armatureData->name.c_str(), armatureData, dataInfo->filename.c_str());
+        if (dataInfo->asyncStruct)
+        {
+            _dataReaderHelper->_addDataMutex.unlock();
+        }
+    }
+    armatureData->release();
+}
+
+void DataReaderHelper::addAnimationData(AnimationData *animationData, DataInfo *dataInfo)
+{
+    if (dataInfo->binaryDatas)
+    {
+        dataInfo->binaryDatas->animationDatas.pushBack(animationData);
+    }
+    else
+    {
+        if (dataInfo->asyncStruct)
+        {
+            _dataReaderHelper->_addDataMutex.lock();
+        }
+        ArmatureDataManager::getInstance()->addAnimationData(animationData->name.c_str(), animationData, dataInfo->filename.c_str());
+        if (dataInfo->asyncStruct)
+        {
+            _dataReaderHelper->_addDataMutex.unlock();
+        }
+    }
+    animationData->release();
+}
+
+void DataReaderHelper::addTextureData(TextureData *textureData, DataInfo *dataInfo)
+{
+    if (dataInfo->binaryDatas)
+    {
+        dataInfo->binaryDatas->textureDatas.pushBack(textureData);
+    }
+    else
+    {
+        if (dataInfo->asyncStruct)
+        {
+            _dataReaderHelper->_addDataMutex.lock();
+        }
+        ArmatureDataManager::getInstance()->addTextureData(textureData->name.c_str(), textureData, dataInfo->filename.c_str());
+        if (dataInfo->asyncStruct)
+        {
+            _dataReaderHelper->_addDataMutex.unlock();
+        }
+    }
+    textureData->release();
+}
+
+void DataReaderHelper::addConfigFile(const std::string& filePath, DataInfo *dataInfo)
+{
+    if (dataInfo->binaryDatas)
+    {
+        dataInfo->binaryDatas->configFiles.push_back(filePath);
+    }
+    else if (dataInfo->asyncStruct)
+    {
+        dataInfo->configFileQueue.push(filePath);
+    }
+    else
+    {
+        std::string plistPath = filePath + ".plist";
+        std::string pngPath =  filePath + ".png";
+
+        ArmatureDataManager::getInstance()->addSpriteFrameFromFile((dataInfo->baseFilePath + plistPath).c_str(), (dataInfo->baseFilePath + pngPath).c_str());
+    }
+}
+
+/*
+ * The sections of a binary file, checked once so the records can then be used without any test.
+ */
+class BinaryContent
+{
+public:
+    BinaryContent(const unsigned char *content, ssize_t size)
+        : _content(content)
+        , _header(nullptr)
+    {
+        _valid = validate(size);
+    }
+
+    bool isValid() const { return _valid; }
+
+    template <class T>
+    const T *records(BinarySection section) const
+    {
+        return reinterpret_cast<const T *>(_content + _header->offsets[section]);
+    }
+
+    uint32_t count(BinarySection section) const { return _header->counts[section]; }
+
+    const char *string(uint32_t index) const
+    {
+        return records<char>(BINARY_STRING_CHARS) + records<uint32_t>(BINARY_STRING_OFFSETS)[index];
+    }
+
+private:
+    bool checkRange(const BinaryRange &range, BinarySection section) const
+    {
+        return range.first <= count(section) && range.count <= count(section) - range.first;
+    }
+
+    bool checkString(uint32_t index) const
+    {
+        return index < count(BINARY_STRING_OFFSETS);
+    }
+
+    bool validate(ssize_t size)
+    {
+        if (size < (ssize_t)sizeof(BinaryHeader) || ((uintptr_t)_content & 3) != 0)
+        {
+            return false;
+        }
+
+        _header = reinterpret_cast<const BinaryHeader *>(_content);
+        if (memcmp(_header->magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0 || _header->version != BINARY_VERSION || _header->size != (uint32_t)size)
+        {
+            return false;
+        }
+
+        for (int i = 0; i < BINARY_SECTION_COUNT; i++)
+        {
+            uint32_t offset = _header->offsets[i];
+            if ((offset & 3) != 0 || offset > _header->size || _header->counts[i] > (_header->size - offset) / BINARY_RECORD_SIZES[i])
+            {
+                return false;
+            }
+        }
+
+        // the strings are nul terminated inside the chars
+        uint32_t charCount = count(BINARY_STRING_CHARS);
+        if (charCount > 0 && records<char>(BINARY_STRING_CHARS)[charCount - 1] != '\0')
+        {
+            return false;
+        }
+        const uint32_t *offsets = records<uint32_t>(BINARY_STRING_OFFSETS);
+        for (uint32_t i = 0; i < count(BINARY_STRING_OFFSETS); i++)
+        {
+            if (offsets[i] >= charCount)
+            {
+                return false;
+            }
+        }
+
+        const BinaryArmature *armatures = records<BinaryArmature>(BINARY_ARMATURES);
+        for (uint32_t i = 0; i < count(BINARY_ARMATURES); i++)
+        {
+            if (!checkString(armatures[i].name) || !checkRange(armatures[i].bones, BINARY_BONES))
+                return false;
+        }
+        const BinaryBone *bones = records<BinaryBone>(BINARY_BONES);
+        for (uint32_t i = 0; i < count(BINARY_BONES); i++)
+        {
+            if (!checkString(bones[i].name) || !checkString(bones[i].parentName) || !checkRange(bones[i].displays, BINARY_DISPLAYS))
+                return false;
+        }
+        const BinaryDisplay *displays = records<BinaryDisplay>(BINARY_DISPLAYS);
+        for (uint32_t i = 0; i < count(BINARY_DISPLAYS); i++)
+        {
+            if (!checkString(displays[i].displayName))
+                return false;
+        }
+        const BinaryAnimation *animations = records<BinaryAnimation>(BINARY_ANIMATIONS);
+        for (uint32_t i = 0; i < count(BINARY_ANIMATIONS); i++)
+        {
+            if (!checkString(animations[i].name) || !checkRange(animations[i].movements, BINARY_MOVEMENTS))
+                return false;
+        }
+        const BinaryMovement *movements = records<BinaryMovement>(BINARY_MOVEMENTS);
+        for (uint32_t i = 0; i < count(BINARY_MOVEMENTS); i++)
+        {
+            if (!checkString(movements[i].name) || !checkRange(movements[i].movementBones, BINARY_MOVEMENT_BONES))
+                return false;
+        }
+        const BinaryMovementBone *movementBones = records<BinaryMovementBone>(BINARY_MOVEMENT_BONES);
+        for (uint32_t i = 0; i < count(BINARY_MOVEMENT_BONES); i++)
+        {
+            if (!checkString(movementBones[i].name) || !checkRange(movementBones[i].frames, BINARY_FRAMES))
+                return false;
+        }
+        const BinaryFrame *frames = records<BinaryFrame>(BINARY_FRAMES);
+        for (uint32_t i = 0; i < count(BINARY_FRAMES); i++)
+        {
+            const BinaryFrame &frame = frames[i];
+            if (!checkRange(frame.easingParams, BINARY_EASING_PARAMS) || !checkString(frame.strEvent) || !checkString(frame.strMovement)
+                || !checkString(frame.strSound) || !checkString(frame.strSoundEffect))
+                return false;
+        }
+        const BinaryTexture *textures = records<BinaryTexture>(BINARY_TEXTURES);
+        for (uint32_t i = 0; i < count(BINARY_TEXTURES); i++)
+        {
+            if (!checkString(textures[i].name) || !checkRange(textures[i].contours, BINARY_CONTOURS))
+                return false;
+        }
+        const BinaryRange *contours = records<BinaryRange>(BINARY_CONTOURS);
+        for (uint32_t i = 0; i < count(BINARY_CONTOURS); i++)
+        {
+            if (!checkRange(contours[i], BINARY_VERTICES))
+                return false;
+        }
+        const uint32_t *configFiles = records<uint32_t>(BINARY_CONFIG_FILES);
+        for (uint32_t i = 0; i < count(BINARY_CONFIG_FILES); i++)
+        {
+            if (!checkString(configFiles[i]))
+                return false;
+        }
+
+        return true;
+    }
+
+    const unsigned char *_content;
+    const BinaryHeader *_header;
+    bool _valid;
+};
+
+static void decodeBinaryNode(BaseData *node, const BinaryNode &record)
+{
+    node->x = record.x * s_PositionReadScale;
+    node->y = record.y * s_PositionReadScale;
+    node->skewX = record.skewX;
+    node->skewY = record.skewY;
+    node->scaleX = record.scaleX;
+    node->scaleY = record.scaleY;
+    node->tweenRotate = record.tweenRotate;
+    node->zOrder = record.zOrder;
+    node->isUseColorInfo = record.isUseColorInfo != 0;
+    node->a = record.a;
+    node->r = record.r;
+    node->g = record.g;
+    node->b = record.b;
+}
+
+void DataReaderHelper::addDataFromBinaryCache(const unsigned char *content, ssize_t size, DataInfo *dataInfo)
+{
+    // The records are read from the content, a misaligned content is copied first
+    std::vector<uint32_t> alignedContent;
+    if (((uintptr_t)content & 3) != 0 && size > 0)
+    {
+        alignedContent.resize((size + 3) / 4);
+        memcpy(alignedContent.data(), content, size);
+        content = (const unsigned char *)alignedContent.data();
+    }
+
+    BinaryContent binary(content, size);
+    if (!binary.isValid())
+    {
+        CCLOG("%s is not a valid armature binary file.", dataInfo->filename.c_str());
+        return;
+    }
+
+    const std::string &baseFilePath = dataInfo->asyncStruct ? dataInfo->asyncStruct->baseFilePath : dataInfo->baseFilePath;
+
+    // Decode armatures
+    const BinaryArmature *armatures = binary.records<BinaryArmature>(BINARY_ARMATURES);
+    const BinaryBone *bones = binary.records<BinaryBone>(BINARY_BONES);
+    const BinaryDisplay *displays = binary.records<BinaryDisplay>(BINARY_DISPLAYS);
+    for (uint32_t i = 0; i < binary.count(BINARY_ARMATURES); i++)
+    {
+        const BinaryArmature &armatureRecord = armatures[i];
+
+        ArmatureData *armatureData = new ArmatureData();
+        armatureData->init();
+        armatureData->name = binary.string(armatureRecord.name);
+        armatureData->dataVersion = armatureRecord.dataVersion;
+
+        for (uint32_t j = armatureRecord.bones.first; j < armatureRecord.bones.first + armatureRecord.bones.count; j++)
+        {
+            const BinaryBone &boneRecord = bones[j];
+
+            BoneData *boneData = new BoneData();
+            boneData->init();
+            decodeBinaryNode(boneData, boneRecord.node);
+            boneData->name = binary.string(boneRecord.name);
+            boneData->parentName = binary.string(boneRecord.parentName);
+
+            for (uint32_t k = boneRecord.displays.first; k < boneRecord.displays.first + boneRecord.displays.count; k++)
+            {
+                const BinaryDisplay &displayRecord = displays[k];
+
+                DisplayData *displayData = nullptr;
+                switch (displayRecord.displayType)
+                {
+                case CS_DISPLAY_ARMATURE:
+                    displayData = new ArmatureDisplayData();
+                    displayData->displayName = binary.string(displayRecord.displayName);
+                    break;
+                case CS_DISPLAY_PARTICLE:
+                    displayData = new ParticleDisplayData();
+                    displayData->displayName = baseFilePath + binary.string(displayRecord.displayName);
+                    break;
+                default:
+                {
+                    SpriteDisplayData *spriteDisplayData = new SpriteDisplayData();
+                    spriteDisplayData->displayName = binary.string(displayRecord.displayName);
+                    decodeBinaryNode(&spriteDisplayData->skinData, displayRecord.skinData);
+                    displayData = spriteDisplayData;
+                }
+                    break;
+                }
+                displayData->displayType = (DisplayType)displayRecord.displayType;
+
+                boneData->addDisplayData(displayData);
+                displayData->release();
+            }
+
+            armatureData->addBoneData(boneData);
+            boneData->release();
+        }
+
+        addArmatureData(armatureData, dataInfo);
+    }
+
+    // Decode animations
+    const BinaryAnimation *animations = binary.records<BinaryAnimation>(BINARY_ANIMATIONS);
+    const BinaryMovement *movements = binary.records<BinaryMovement>(BINARY_MOVEMENTS);
+    const BinaryMovementBone *movementBones = binary.records<BinaryMovementBone>(BINARY_MOVEMENT_BONES);
+    const BinaryFrame *frames = binary.records<BinaryFrame>(BINARY_FRAMES);
+    const float *easingParams = binary.records<float>(BINARY_EASING_PARAMS);
+    for (uint32_t i = 0; i < binary.count(BINARY_ANIMATIONS); i++)
+    {
+        const BinaryAnimation &animationRecord = animations[i];
+
+        AnimationData *animationData = new AnimationData();
+        animationData->name = binary.string(animationRecord.name);
+
+        for (uint32_t j = animationRecord.movements.first; j < animationRecord.movements.first + animationRecord.movements.count; j++)
+        {
+            const BinaryMovement &movementRecord = movements[j];
+
+            MovementData *movementData = new MovementData();
+            movementData->name = binary.string(movementRecord.name);
+            movementData->duration = movementRecord.duration;
+            movementData->scale = movementRecord.scale;
+            movementData->durationTo = movementRecord.durationTo;
+            movementData->durationTween = movementRecord.durationTween;
+            movementData->loop = movementRecord.loop != 0;
+            movementData->tweenEasing = (TweenType)movementRecord.tweenEasing;
+
+            for (uint32_t k = movementRecord.movementBones.first; k < movementRecord.movementBones.first + movementRecord.movementBones.count; k++)
+            {
+                const BinaryMovementBone &movementBoneRecord = movementBones[k];
+
+                MovementBoneData *movementBoneData = new MovementBoneData();
+                movementBoneData->init();
+                movementBoneData->name = binary.string(movementBoneRecord.name);
+                movementBoneData->delay = movementBoneRecord.delay;
+                movementBoneData->scale = movementBoneRecord.scale;
+                movementBoneData->duration = movementBoneRecord.duration;
+
+                for (uint32_t f = movementBoneRecord.frames.first; f < movementBoneRecord.frames.first + movementBoneRecord.frames.count; f++)
+                {
+                    const BinaryFrame &frameRecord = frames[f];
+
+                    FrameData *frameData = new FrameData();
+                    decodeBinaryNode(frameData, frameRecord.node);
+                    frameData->frameID = frameRecord.frameID;
+                    frameData->duration = frameRecord.duration;
+                    frameData->tweenEasing = (TweenType)frameRecord.tweenEasing;
+                    frameData->isTween = frameRecord.isTween != 0;
+                    frameData->displayIndex = frameRecord.displayIndex;
+                    frameData->blendFunc.src = frameRecord.blendSrc;
+                    frameData->blendFunc.dst = frameRecord.blendDst;
+                    frameData->strEvent = binary.string(frameRecord.strEvent);
+                    frameData->strMovement = binary.string(frameRecord.strMovement);
+                    frameData->strSound = binary.string(frameRecord.strSound);
+                    frameData->strSoundEffect = binary.string(frameRecord.strSoundEffect);
+
+                    frameData->easingParamNumber = frameRecord.easingParams.count;
+                    if (frameRecord.easingParams.count > 0)
+                    {
+                        frameData->easingParams = new float[frameRecord.easingParams.count];
+                        memcpy(frameData->easingParams, easingParams + frameRecord.easingParams.first, frameRecord.easingParams.count * sizeof(float));
+                    }
+
+                    movementBoneData->addFrameData(frameData);
+                    frameData->release();
+                }
+
+                movementData->addMovementBoneData(movementBoneData);
+                movementBoneData->release();
+            }
+
+            animationData->addMovement(movementData);
+            movementData->release();
+        }
+
+        addAnimationData(animationData, dataInfo);
+    }
+
+    // Decode textures
+    const BinaryTexture *textures = binary.records<BinaryTexture>(BINARY_TEXTURES);
+    const BinaryRange *contours = binary.records<BinaryRange>(BINARY_CONTOURS);
+    const BinaryVertex *vertices = binary.records<BinaryVertex>(BINARY_VERTICES);
+    for (uint32_t i = 0; i < binary.count(BINARY_TEXTURES); i++)
+    {
+        const BinaryTexture &textureRecord = textures[i];
+
+        TextureData *textureData = new TextureData();
+        textureData->init();
+        textureData->name = binary.string(textureRecord.name);
+        textureData->width = textureRecord.width;
+        textureData->height = textureRecord.height;
+        textureData->pivotX = textureRecord.pivotX;
+        textureData->pivotY = textureRecord.pivotY;
+
+        for (uint32_t j = textureRecord.contours.first; j < textureRecord.contours.first + textureRecord.contours.count; j++)
+        {
+            const BinaryRange &contourRecord = contours[j];
+
+            ContourData *contourData = new ContourData();
+            contourData->init();
+            contourData->vertexList.resize(contourRecord.count);
+            for (uint32_t k = 0; k < contourRecord.count; k++)
+            {
+                contourData->vertexList[k].x = vertices[contourRecord.first + k].x;
+                contourData->vertexList[k].y = vertices[contourRecord.first + k].y;
+            }
+
+            textureData->contourDataList.pushBack(contourData);
+            contourData->release();
+        }
+
+        addTextureData(textureData, dataInfo);
+    }
+
+    // Auto load sprite file
+    bool autoLoad = dataInfo->asyncStruct == nullptr ? ArmatureDataManager::getInstance()->isAutoLoadSpriteFile() : dataInfo->asyncStruct->autoLoadSpriteFile;
+    if (autoLoad || dataInfo->binaryDatas)
+    {
+        const uint32_t *configFiles = binary.records<uint32_t>(BINARY_CONFIG_FILES);
+        for (uint32_t i = 0; i < binary.count(BINARY_CONFIG_FILES); i++)
+        {
+            addConfigFile(binary.string(configFiles[i]), dataInfo);
+        }
+    }
+}
+
+/*
+ * Builds the sections of a binary file from the datas.
+ */
+class BinaryWriter
+{
+public:
+    BinaryWriter()
+    {
+        memset(&_header, 0, sizeof(_header));
+    }
+
+    void addArmature(ArmatureData *armatureData)
+    {
+        BinaryArmature record;
+        record.name = addString(armatureData->name);
+        record.dataVersion = armatureData->dataVersion;
+        record.bones.first = (uint32_t)_bones.size();
+        record.bones.count = (uint32_t)armatureData->boneDataDic.size();
+        _armatures.push_back(record);
+
+        for (auto& element : armatureData->boneDataDic)
+        {
+            BoneData *boneData = element.second;
+
+            BinaryBone boneRecord;
+            encodeNode(boneRecord.node, boneData);
+            boneRecord.name = addString(boneData->name);
+            boneRecord.parentName = addString(boneData->parentName);
+            boneRecord.displays.first = (uint32_t)_displays.size();
+            boneRecord.displays.count = (uint32_t)boneData->displayDataList.size();
+            _bones.push_back(boneRecord);
+
+            for (auto& displayData : boneData->displayDataList)
+            {
+                BinaryDisplay displayRecord;
+                displayRecord.displayType = displayData->displayType;
+                displayRecord.displayName = addString(displayData->displayName);
+                if (displayData->displayType == CS_DISPLAY_SPRITE)
+                {
+                    encodeNode(displayRecord.skinData, &static_cast<SpriteDisplayData *>(displayData)->skinData);
+                }
+                else
+                {
+                    BaseData skinData;
+                    encodeNode(displayRecord.skinData, &skinData);
+                }
+                _displays.push_back(displayRecord);
+            }
+        }
+    }
+
+    void addAnimation(AnimationData *animationData)
+    {
+        BinaryAnimation record;
+        record.name = addString(animationData->name);
+        record.movements.first = (uint32_t)_movements.size();
+        record.movements.count = (uint32_t)animationData->movementNames.size();
+        _animations.push_back(record);
+
+        // the movements are saved in their order, not the one of the dictionary
+        for (auto& movementName : animationData->movementNames)
+        {
+            MovementData *movementData = animationData->getMovement(movementName);
+
+            BinaryMovement movementRecord;
+            movementRecord.name = addString(movementData->name);
+            movementRecord.duration = movementData->duration;
+            movementRecord.scale = movementData->scale;
+            movementRecord.durationTo = movementData->durationTo;
+            movementRecord.durationTween = movementData->durationTween;
+            movementRecord.loop = movementData->loop;
+            movementRecord.tweenEasing = movementData->tweenEasing;
+            movementRecord.movementBones.first = (uint32_t)_movementBones.size();
+            movementRecord.movementBones.count = (uint32_t)movementData->movBoneDataDic.size();
+            _movements.push_back(movementRecord);
+
+            for (auto& element : movementData->movBoneDataDic)
+            {
+                MovementBoneData *movementBoneData = element.second;
+
+                BinaryMovementBone movementBoneRecord;
+                movementBoneRecord.name = addString(movementBoneData->name);
+                movementBoneRecord.delay = movementBoneData->delay;
+                movementBoneRecord.scale = movementBoneData->scale;
+                movementBoneRecord.duration = movementBoneData->duration;
+                movementBoneRecord.frames.first = (uint32_t)_frames.size();
+                movementBoneRecord.frames.count = (uint32_t)movementBoneData->frameList.size();
+                _movementBones.push_back(movementBoneRecord);
+
+                for (auto& frameData : movementBoneData->frameList)
+                {
+                    BinaryFrame frameRecord;
+                    encodeNode(frameRecord.node, frameData);
+                    frameRecord.frameID = frameData->frameID;
+                    frameRecord.duration = frameData->duration;
+                    frameRecord.tweenEasing = frameData->tweenEasing;
+                    frameRecord.easingParams.first = (uint32_t)_easingParams.size();
+                    frameRecord.easingParams.count = frameData->easingParams ? frameData->easingParamNumber : 0;
+                    for (uint32_t i = 0; i < frameRecord.easingParams.count; i++)
+                    {
+                        _easingParams.push_back(frameData->easingParams[i]);
+                    }
+                    frameRecord.isTween = frameData->isTween;
+                    frameRecord.displayIndex = frameData->displayIndex;
+                    frameRecord.blendSrc = frameData->blendFunc.src;
+                    frameRecord.blendDst = frameData->blendFunc.dst;
+                    frameRecord.strEvent = addString(frameData->strEvent);
+                    frameRecord.strMovement = addString(frameData->strMovement);
+                    frameRecord.strSound = addString(frameData->strSound);
+                    frameRecord.strSoundEffect = addString(frameData->strSoundEffect);
+                    _frames.push_back(frameRecord);
+                }
+            }
+        }
+    }
+
+    void addTexture(TextureData *textureData)
+    {
+        BinaryTexture record;
+        record.name = addString(textureData->name);
+        record.width = textureData->width;
+        record.height = textureData->height;
+        record.pivotX = textureData->pivotX;
+        record.pivotY = textureData->pivotY;
+        record.contours.first = (uint32_t)_contours.size();
+        record.contours.count = (uint32_t)textureData->contourDataList.size();
+        _textures.push_back(record);
+
+        for (auto& contourData : textureData->contourDataList)
+        {
+            BinaryRange contourRecord;
+            contourRecord.first = (uint32_t)_vertices.size();
+            contourRecord.count = (uint32_t)contourData->vertexList.size();
+            _contours.push_back(contourRecord);
+
+            for (auto& point : contourData->vertexList)
+            {
+                BinaryVertex vertex = { point.x, point.y };
+                _vertices.push_back(vertex);
+            }
+        }
+    }
+
+    void addConfigFile(const std::string& filePath)
+    {
+        _configFiles.push_back(addString(filePath));
+    }
+
+    std::vector<unsigned char> write()
+    {
+        std::vector<unsigned char> content(sizeof(BinaryHeader));
+        memcpy(_header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+        _header.version = BINARY_VERSION;
+
+        writeSection(content, BINARY_STRING_OFFSETS, _stringOffsets);
+        writeSection(content, BINARY_STRING_CHARS, _chars);
+        writeSection(content, BINARY_ARMATURES, _armatures);
+        writeSection(content, BINARY_BONES, _bones);
+        writeSection(content, BINARY_DISPLAYS, _displays);
+        writeSection(content, BINARY_ANIMATIONS, _animations);
+        writeSection(content, BINARY_MOVEMENTS, _movements);
+        writeSection(content, BINARY_MOVEMENT_BONES, _movementBones);
+        writeSection(content, BINARY_FRAMES, _frames);
+        writeSection(content, BINARY_EASING_PARAMS, _easingParams);
+        writeSection(content, BINARY_TEXTURES, _textures);
+        writeSection(content, BINARY_CONTOURS, _contours);
+        writeSection(content, BINARY_VERTICES, _vertices);
+        writeSection(content, BINARY_CONFIG_FILES, _configFiles);
+
+        _header.size = (uint32_t)content.size();
+        memcpy(content.data(), &_header, sizeof(_header));
+        return content;
+    }
+
+private:
+    // the same strings are only saved once
+    uint32_t addString(const std::string& str)
+    {
+        auto it = _strings.find(str);
+        if (it != _strings.end())
+        {
+            return it->second;
+        }
+
+        uint32_t index = (uint32_t)_stringOffsets.size();
+        _stringOffsets.push_back((uint32_t)_chars.size());
+        _chars.insert(_chars.end(), str.c_str(), str.c_str() + str.size() + 1);
+        _strings[str] = index;
+        return index;
+    }
+
+    static void encodeNode(BinaryNode& record, const BaseData *node)
+    {
+        record.x = node->x;
+        record.y = node->y;
+        record.skewX = node->skewX;
+        record.skewY = node->skewY;
+        record.scaleX = node->scaleX;
+        record.scaleY = node->scaleY;
+        record.tweenRotate = node->tweenRotate;
+        record.zOrder = node->zOrder;
+        record.isUseColorInfo = node->isUseColorInfo;
+        record.a = node->a;
+        record.r = node->r;
+        record.g = node->g;
+        record.b = node->b;
+    }
+
+    template <class T>
+    void writeSection(std::vector<unsigned char>& content, BinarySection section, const std::vector<T>& records)
+    {
+        // every section begins on 4 bytes
+        content.resize((content.size() + 3) & ~(size_t)3);
+        _header.offsets[section] = (uint32_t)content.size();
+        _header.counts[section] = (uint32_t)records.size();
+        if (!records.empty())
+        {
+            const unsigned char *bytes = reinterpret_cast<const unsigned char *>(records.data());
+            content.insert(content.end(), bytes, bytes + records.size() * sizeof(T));
+        }
+    }
+
+    BinaryHeader _header;
+    std::unordered_map<std::string, uint32_t> _strings;
+    std::vector<uint32_t> _stringOffsets;
+    std::vector<char> _chars;
+    std::vector<BinaryArmature> _armatures;
+    std::vector<BinaryBone> _bones;
+    std::vector<BinaryDisplay> _displays;
+    std::vector<BinaryAnimation> _animations;
+    std::vector<BinaryMovement> _movements;
+    std::vector<BinaryMovementBone> _movementBones;
+    std::vector<BinaryFrame> _frames;
+    std::vector<float> _easingParams;
+    std::vector<BinaryTexture> _textures;
+    std::vector<BinaryRange> _contours;
+    std::vector<BinaryVertex> _vertices;
+    std::vector<uint32_t> _configFiles;
+};
+
+bool DataReaderHelper::convertToBinaryFile(const std::string& configFilePath, const std::string& binaryFilePath)
+{
+    std::string filePathStr = configFilePath;
+    size_t startPos = filePathStr.find_last_of(".");
+    std::string str = startPos != std::string::npos ? filePathStr.substr(startPos) : "";
+    if (str != ".xml" && str != ".json" && str != ".ExportJson")
+    {
+        CCLOG("%s can't be converted to the binary format.", configFilePath.c_str());
+        return false;
+    }
+
+    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(configFilePath);
+    std::string contentStr = FileUtils::getInstance()->getStringFromFile(fullPath);
+
+    // The particle plists and the sprite files are kept relative to the file
+    BinaryDatas datas;
+    DataInfo dataInfo;
+    dataInfo.filename = filePathStr;
+    dataInfo.asyncStruct = nullptr;
+    dataInfo.baseFilePath = "";
+    dataInfo.binaryDatas = &datas;
+
+    // The positions are saved without the position read scale, it is applied when the binary file is loaded
+    float positionReadScale = s_PositionReadScale;
+    s_PositionReadScale = 1;
+    if (str == ".xml")
+    {
+        DataReaderHelper::addDataFromCache(contentStr, &dataInfo);
+    }
+    else
+    {
+        DataReaderHelper::addDataFromJsonCache(contentStr, &dataInfo);
+    }
+    s_PositionReadScale = positionReadScale;
+
+    BinaryWriter writer;
+    for (auto& armatureData : datas.armatureDatas)
+    {
+        writer.addArmature(armatureData);
+    }
+    for (auto& animationData : datas.animationDatas)
+    {
+        writer.addAnimation(animationData);
+    }
+    for (auto& textureData : datas.textureDatas)
+    {
+        writer.addTexture(textureData);
+    }
+    for (auto& configFile : datas.configFiles)
+    {
+        writer.addConfigFile(configFile);
+    }
+    std::vector<unsigned char> content = writer.write();
+
+    FILE *fp = fopen(binaryFilePath.c_str(), "wb");
+    if (!fp)
+    {
+        CCLOG("can't open %s to write the armature binary file.", binaryFilePath.c_str());
+        return false;
+    }
+    bool written = fwrite(content.data(), 1, content.size(), fp) == content.size();
+    fclose(fp);
+
+    return written;
+}
+
 }
@@ -55,7 +55,8 @@ protected:
 	enum ConfigType
 	{
 		DragonBone_XML,
-		CocoStudio_JSON
+		CocoStudio_JSON,
+		CocoStudio_Binary
 	};
 
 	typedef struct _AsyncStruct
@@ -72,6 +73,14 @@ protected:
         std::string    plistPath;
 	} AsyncStruct;
 
+	typedef struct _BinaryDatas
+	{
+		cocos2d::Vector<ArmatureData*> armatureDatas;
+		cocos2d::Vector<AnimationData*> animationDatas;
+		cocos2d::Vector<TextureData*> textureDatas;
+		std::vector<std::string> configFiles;
+	} BinaryDatas;
+
 	typedef struct _DataInfo
 	{
 		AsyncStruct *asyncStruct;
@@ -81,6 +90,8 @@ protected:
         std::string    baseFilePath;
         float flashToolVersion;
         float cocoStudioVersion;
+        // Set when converting to the binary format, the datas are kept there instead of being added to the ArmatureDataManager
+        BinaryDatas *binaryDatas;
 	} DataInfo;
 
 public:
@@ -172,6 +183,29 @@ public:
 
     static void decodeNode(BaseData *node, const rapidjson::Value& json, DataInfo *dataInfo);
 
+public:
+    /**
+     * Decode the datas of a binary file (.csab) written by convertToBinaryFile().
+     * The file is made of arrays of fixed size records that are read from the content without any text parsing,
+     * the armature, animation and texture datas are then created from them.
+     */
+    static void addDataFromBinaryCache(const unsigned char *content, ssize_t size, DataInfo *dataInfo = nullptr);
+
+    /**
+     * Convert a xml or json file to the binary format, to be done offline or once on the device.
+     * The positions are saved without the position read scale, it is applied when the binary file is loaded.
+     *
+     * @param configFilePath The xml or json file
+     * @param binaryFilePath The full path of the binary file to write, its extension should be .csab
+     */
+    static bool convertToBinaryFile(const std::string& configFilePath, const std::string& binaryFilePath);
+
+protected:
+    static void addArmatureData(ArmatureData *armatureData, DataInfo *dataInfo);
+    static void addAnimationData(AnimationData *animationData, DataInfo *dataInfo);
+    static void addTextureData(TextureData *textureData, DataInfo *dataInfo);
+    static void addConfigFile(const std::string& filePath, DataInfo *dataInfo);
+
 protected:
 	void loadData();
 
@@ -69,7 +69,7 @@ void Skeleton::initialize () {
     
 	setOpacityModifyRGB(true);
 
-    setShaderProgram(ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR));
+    setShaderProgram(ShaderCache::getInstance()->getProgram(GLProgram::SHADER_NAME_POSITION_TEXTURE_COLOR_NO_MVP));
 }
 
 void Skeleton::setSkeletonData (spSkeletonData *skeletonData, bool isOwnsSkeletonData) {
@@ -127,18 +127,6 @@ void Skeleton::update (float deltaTime) {
 
 void Skeleton::draw(cocos2d::Renderer *renderer, const kmMat4 &transform, bool transformUpdated)
 {
-
-    _customCommand.init(_globalZOrder);
-    _customCommand.func = CC_CALLBACK_0(Skeleton::onDraw, this, transform, transformUpdated);
-    renderer->addCommand(&_customCommand);
-}
-    
-void Skeleton::onDraw(const kmMat4 &transform, bool transformUpdated)
-{
-    getShaderProgram()->use();
-    getShaderProgram()->setUniformsForBuiltins(transform);
-
-    GL::blendFunc(blendFunc.src, blendFunc.dst);
 	Color3B color = getColor();
 	skeleton->r = color.r / (float)255;
 	skeleton->g = color.g / (float)255;
@@ -150,92 +138,99 @@ void Skeleton::onDraw(const kmMat4 &transform, bool transformUpdated)
 		skeleton->b *= skeleton->a;
 	}
 
-	int additive = 0;
-	TextureAtlas* textureAtlas = 0;
-	V3F_C4B_T2F_Quad quad;
-	quad.tl.vertices.z = 0;
-	quad.tr.vertices.z = 0;
-	quad.bl.vertices.z = 0;
-	quad.br.vertices.z = 0;
-	for (int i = 0, n = skeleton->slotCount; i < n; i++) {
-		spSlot* slot = skeleton->drawOrder[i];
-		if (!slot->attachment || slot->attachment->type != ATTACHMENT_REGION) continue;
-		spRegionAttachment* attachment = (spRegionAttachment*)slot->attachment;
-		TextureAtlas* regionTextureAtlas = getTextureAtlas(attachment);
-
-		if (slot->data->additiveBlending != additive) {
-			if (textureAtlas) {
-				textureAtlas->drawQuads();
-				textureAtlas->removeAllQuads();
-			}
-			additive = !additive;
-            GL::blendFunc(blendFunc.src, additive ? GL_ONE : blendFunc.dst);
-		} else if (regionTextureAtlas != textureAtlas && textureAtlas) {
-			textureAtlas->drawQuads();
-			textureAtlas->removeAllQuads();
+	// The quads and the commands only live until the end of the frame
+	FrameArena* arena = renderer->getFrameArena();
+	V3F_C4B_T2F_Quad* quads = arena->allocateArray<V3F_C4B_T2F_Quad>(skeleton->slotCount);
+	ssize_t quadCount = 0;
+
+	// A run of consecutive slots with the same texture and blending function is one QuadCommand,
+	// the renderer batches it with the previous commands when they share the same material
+	Texture2D* runTexture = nullptr;
+	BlendFunc runBlendFunc = BlendFunc::DISABLE;
+	ssize_t runStart = 0;
+	for (int i = 0, n = skeleton->slotCount; i <= n; i++) {
+		spSlot* slot = i < n ? skeleton->drawOrder[i] : nullptr;
+		if (slot && (!slot->attachment || slot->attachment->type != ATTACHMENT_REGION)) continue;
+
+		Texture2D* texture = nullptr;
+		BlendFunc func = BlendFunc::DISABLE;
+		spRegionAttachment* attachment = nullptr;
+		if (slot) {
+			attachment = (spRegionAttachment*)slot->attachment;
+			texture = getTextureAtlas(attachment)->getTexture();
+			func = getFittedBlendingFunc(texture, slot->data->additiveBlending != 0);
 		}
-		textureAtlas = regionTextureAtlas;
-        setFittedBlendingFunc(textureAtlas);
-
-		ssize_t quadCount = textureAtlas->getTotalQuads();
-		if (textureAtlas->getCapacity() == quadCount) {
-			textureAtlas->drawQuads();
-			textureAtlas->removeAllQuads();
-			if (!textureAtlas->resizeCapacity(textureAtlas->getCapacity() * 2)) return;
+
+		if (quadCount > runStart && (!slot || texture != runTexture || func.src != runBlendFunc.src || func.dst != runBlendFunc.dst)) {
+			QuadCommand* command = arena->create<QuadCommand>();
+			command->init(_globalZOrder, runTexture->getName(), _shaderProgram, runBlendFunc, quads + runStart, quadCount - runStart, transform);
+			renderer->addCommand(command);
+			runStart = quadCount;
 		}
+		if (!slot) break;
 
+		runTexture = texture;
+		runBlendFunc = func;
+
+		V3F_C4B_T2F_Quad& quad = quads[quadCount++];
+		quad.tl.vertices.z = 0;
+		quad.tr.vertices.z = 0;
+		quad.bl.vertices.z = 0;
+		quad.br.vertices.z = 0;
 		spRegionAttachment_updateQuad(attachment, slot, &quad, premultipliedAlpha);
-		textureAtlas->updateQuad(&quad, quadCount);
-	}
-	if (textureAtlas) {
-		textureAtlas->drawQuads();
-		textureAtlas->removeAllQuads();
 	}
 
-    if(debugBones || debugSlots) {
-        kmGLPushMatrix();
-        kmGLLoadMatrix(&transform);
-
-        if (debugSlots) {
-            // Slots.
-            DrawPrimitives::setDrawColor4B(0, 0, 255, 255);
-            glLineWidth(1);
-            Point points[4];
-            V3F_C4B_T2F_Quad tmpQuad;
-            for (int i = 0, n = skeleton->slotCount; i < n; i++) {
-                spSlot* slot = skeleton->drawOrder[i];
-                if (!slot->attachment || slot->attachment->type != ATTACHMENT_REGION) continue;
-                spRegionAttachment* attachment = (spRegionAttachment*)slot->attachment;
-                spRegionAttachment_updateQuad(attachment, slot, &tmpQuad);
-                points[0] = Point(tmpQuad.bl.vertices.x, tmpQuad.bl.vertices.y);
-                points[1] = Point(tmpQuad.br.vertices.x, tmpQuad.br.vertices.y);
-                points[2] = Point(tmpQuad.tr.vertices.x, tmpQuad.tr.vertices.y);
-                points[3] = Point(tmpQuad.tl.vertices.x, tmpQuad.tl.vertices.y);
-                DrawPrimitives::drawPoly(points, 4, true);
-            }
+	if (debugBones || debugSlots) {
+		_customCommand.init(_globalZOrder);
+		_customCommand.func = CC_CALLBACK_0(Skeleton::onDraw, this, transform, transformUpdated);
+		renderer->addCommand(&_customCommand);
+	}
+}
+    
+void Skeleton::onDraw(const kmMat4 &transform, bool transformUpdated)
+{
+    kmGLPushMatrix();
+    kmGLLoadMatrix(&transform);
+
+    if (debugSlots) {
+        // Slots.
+        DrawPrimitives::setDrawColor4B(0, 0, 255, 255);
+        glLineWidth(1);
+        Point points[4];
+        V3F_C4B_T2F_Quad tmpQuad;
+        for (int i = 0, n = skeleton->slotCount; i < n; i++) {
+            spSlot* slot = skeleton->drawOrder[i];
+            if (!slot->attachment || slot->attachment->type != ATTACHMENT_REGION) continue;
+            spRegionAttachment* attachment = (spRegionAttachment*)slot->attachment;
+            spRegionAttachment_updateQuad(attachment, slot, &tmpQuad);
+            points[0] = Point(tmpQuad.bl.vertices.x, tmpQuad.bl.vertices.y);
+            points[1] = Point(tmpQuad.br.vertices.x, tmpQuad.br.vertices.y);
+            points[2] = Point(tmpQuad.tr.vertices.x, tmpQuad.tr.vertices.y);
+            points[3] = Point(tmpQuad.tl.vertices.x, tmpQuad.tl.vertices.y);
+            DrawPrimitives::drawPoly(points, 4, true);
         }
-        if (debugBones) {
-            // Bone lengths.
-            glLineWidth(2);
-            DrawPrimitives::setDrawColor4B(255, 0, 0, 255);
-            for (int i = 0, n = skeleton->boneCount; i < n; i++) {
-                spBone *bone = skeleton->bones[i];
-                float x = bone->data->length * bone->m00 + bone->worldX;
-                float y = bone->data->length * bone->m10 + bone->worldY;
-                DrawPrimitives::drawLine(Point(bone->worldX, bone->worldY), Point(x, y));
-            }
-            // Bone origins.
-            DrawPrimitives::setPointSize(4);
-            DrawPrimitives::setDrawColor4B(0, 0, 255, 255); // Root bone is blue.
-            for (int i = 0, n = skeleton->boneCount; i < n; i++) {
-                spBone *bone = skeleton->bones[i];
-                DrawPrimitives::drawPoint(Point(bone->worldX, bone->worldY));
-                if (i == 0) DrawPrimitives::setDrawColor4B(0, 255, 0, 255);
-            }
+    }
+    if (debugBones) {
+        // Bone lengths.
+        glLineWidth(2);
+        DrawPrimitives::setDrawColor4B(255, 0, 0, 255);
+        for (int i = 0, n = skeleton->boneCount; i < n; i++) {
+            spBone *bone = skeleton->bones[i];
+            float x = bone->data->length * bone->m00 + bone->worldX;
+            float y = bone->data->length * bone->m10 + bone->worldY;
+            DrawPrimitives::drawLine(Point(bone->worldX, bone->worldY), Point(x, y));
+        }
+        // Bone origins.
+        DrawPrimitives::setPointSize(4);
+        DrawPrimitives::setDrawColor4B(0, 0, 255, 255); // Root bone is blue.
+        for (int i = 0, n = skeleton->boneCount; i < n; i++) {
+            spBone *bone = skeleton->bones[i];
+            DrawPrimitives::drawPoint(Point(bone->worldX, bone->worldY));
+            if (i == 0) DrawPrimitives::setDrawColor4B(0, 255, 0, 255);
         }
-        
-        kmGLPopMatrix();
     }
+    
+    kmGLPopMatrix();
 }
 
 TextureAtlas* Skeleton::getTextureAtlas (spRegionAttachment* regionAttachment) const {
@@ -328,16 +323,14 @@ void Skeleton::setBlendFunc (const cocos2d::BlendFunc& aBlendFunc) {
     this->blendFunc = aBlendFunc;
 }
     
-void Skeleton::setFittedBlendingFunc(cocos2d::TextureAtlas * nextRenderedTexture)
+BlendFunc Skeleton::getFittedBlendingFunc(cocos2d::Texture2D* texture, bool additive) const
 {
-    if(nextRenderedTexture->getTexture() && nextRenderedTexture->getTexture()->hasPremultipliedAlpha())
-    {
-        GL::blendFunc(BlendFunc::ALPHA_PREMULTIPLIED.src, BlendFunc::ALPHA_PREMULTIPLIED.dst);
-    }
-    else
+    BlendFunc func = (texture && texture->hasPremultipliedAlpha()) ? BlendFunc::ALPHA_PREMULTIPLIED : BlendFunc::ALPHA_NON_PREMULTIPLIED;
+    if (additive)
     {
-        GL::blendFunc(BlendFunc::ALPHA_NON_PREMULTIPLIED.src, BlendFunc::ALPHA_NON_PREMULTIPLIED.dst);
+        func.dst = GL_ONE;
     }
+    return func;
 }
 
 }
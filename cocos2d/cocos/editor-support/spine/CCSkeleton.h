@@ -40,11 +40,16 @@
 #include "CCProtocols.h"
 #include "CCTextureAtlas.h"
 #include "renderer/CCCustomCommand.h"
+#include "renderer/CCQuadCommand.h"
 
 namespace spine {
 
 /**
 Draws a skeleton.
+
+The region attachments are drawn with QuadCommands, one for each run of slots sharing a texture and
+a blending function in the draw order, so they are batched with the other quads of the frame: skeletons
+sharing an atlas are drawn together. The quads and the commands live in the renderer's frame arena.
 */
 class Skeleton: public cocos2d::Node, public cocos2d::BlendProtocol {
 public:
@@ -68,6 +73,7 @@ public:
 
 	virtual void update (float deltaTime) override;
 	virtual void draw(cocos2d::Renderer *renderer, const kmMat4 &transform, bool transformUpdated) override;
+    /** Draws the debug slots and bones */
     void onDraw(const kmMat4 &transform, bool transformUpdated);
 	void onEnter() override;
 	void onExit() override;
@@ -108,8 +114,8 @@ private:
 	bool ownsSkeletonData;
 	spAtlas* atlas;
 	void initialize ();
-    // Util function that setting blend-function by nextRenderedTexture's premultiplied flag
-    void setFittedBlendingFunc(cocos2d::TextureAtlas * nextRenderedTexture);
+    // Util function that returns the blend-function fitting the texture's premultiplied flag
+    cocos2d::BlendFunc getFittedBlendingFunc(cocos2d::Texture2D* texture, bool additive) const;
     
     cocos2d::CustomCommand _customCommand;    
 };
@@ -27,6 +27,7 @@
 #include <climits>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 #include "chipmunk.h"
 
@@ -76,7 +77,11 @@ PhysicsBody::PhysicsBody()
 , _positionResetTag(false)
 , _rotationResetTag(false)
 , _rotationOffset(0)
+, _previousRotation(0.0f)
+, _syncedRotation(0.0f)
+, _movingStamp(0)
 {
+    kmMat4Identity(&_syncedParentTransform);
 }
 
 PhysicsBody::~PhysicsBody()
@@ -349,6 +354,9 @@ void PhysicsBody::setPosition(Point position)
     if (!_positionResetTag)
     {
         cpBodySetPos(_info->getBody(), PhysicsHelper::point2cpv(position + _positionOffset));
+        // moved by hand, don't interpolate from the old position
+        _previousPosition = position;
+        _syncedPosition = position;
     }
 }
 
@@ -357,6 +365,8 @@ void PhysicsBody::setRotation(float rotation)
     if (!_rotationResetTag)
     {
         cpBodySetAngle(_info->getBody(), -PhysicsHelper::float2cpfloat((rotation + _rotationOffset) * (M_PI / 180.0f)));
+        _previousRotation = rotation;
+        _syncedRotation = rotation;
     }
 }
 
@@ -767,23 +777,89 @@ void PhysicsBody::update(float delta)
 {
     if (_node != nullptr)
     {
-        Node* parent = _node->getParent();
-        
-        Point position = parent != nullptr ? parent->convertToNodeSpace(getPosition()) : getPosition();
-        _positionResetTag = true;
-        _rotationResetTag = true;
-        _node->setPosition(position);
-        _node->setRotation(getRotation());
-        _positionResetTag = false;
-        _rotationResetTag = false;
-        
-        // damping compute
-        if (_isDamping && _dynamic && !isResting())
+        updateNode(getPosition(), getRotation());
+        applyDamping(delta);
+    }
+}
+
+void PhysicsBody::savePreviousState()
+{
+    _previousPosition = getPosition();
+    _previousRotation = getRotation();
+}
+
+void PhysicsBody::updateNode(float alpha)
+{
+    if (_node != nullptr)
+    {
+        Point position = getPosition();
+        float rotation = getRotation();
+        if (alpha < 1.0f)
         {
-            _info->getBody()->v.x *= cpfclamp(1.0f - delta * _linearDamping, 0.0f, 1.0f);
-            _info->getBody()->v.y *= cpfclamp(1.0f - delta * _linearDamping, 0.0f, 1.0f);
-            _info->getBody()->w *= cpfclamp(1.0f - delta * _angularDamping, 0.0f, 1.0f);
+            position = _previousPosition + (position - _previousPosition) * alpha;
+            rotation = _previousRotation + (rotation - _previousRotation) * alpha;
         }
+        
+        updateNode(position, rotation);
+    }
+}
+
+void PhysicsBody::updateNode(const Point& position, float rotation)
+{
+    Node* parent = _node->getParent();
+    kmMat4 parentTransform;
+    if (parent != nullptr)
+    {
+        parentTransform = parent->getNodeToWorldTransform();
+    }
+    else
+    {
+        kmMat4Identity(&parentTransform);
+    }
+    
+    // don't dirty the transform of nodes whose body didn't move, unless an ancestor moved the node away from the body
+    if (position == _syncedPosition && rotation == _syncedRotation
+        && memcmp(&parentTransform, &_syncedParentTransform, sizeof(kmMat4)) == 0)
+    {
+        return;
+    }
+    _syncedPosition = position;
+    _syncedRotation = rotation;
+    _syncedParentTransform = parentTransform;
+    
+    Point nodePosition = position;
+    if (parent != nullptr)
+    {
+        kmMat4 worldToParent;
+        kmMat4Inverse(&worldToParent, &parentTransform);
+        kmVec3 world = {position.x, position.y, 0};
+        kmVec3 local;
+        kmVec3Transform(&local, &world, &worldToParent);
+        nodePosition = Point(local.x, local.y);
+    }
+    
+    _positionResetTag = true;
+    _rotationResetTag = true;
+    _node->setPosition(nodePosition);
+    _node->setRotation(rotation);
+    _positionResetTag = false;
+    _rotationResetTag = false;
+}
+
+bool PhysicsBody::isAwake() const
+{
+    cpBody* body = _info->getBody();
+    return _dynamic && !cpBodyIsRogue(body) && !cpBodyIsSleeping(body);
+}
+
+void PhysicsBody::applyDamping(float delta)
+{
+    // damping compute
+    if (_isDamping && _dynamic && !isResting())
+    {
+        _info->getBody()->v.x *= cpfclamp(1.0f - delta * _linearDamping, 0.0f, 1.0f);
+        _info->getBody()->v.y *= cpfclamp(1.0f - delta * _linearDamping, 0.0f, 1.0f);
+        _info->getBody()->w *= cpfclamp(1.0f - delta * _angularDamping, 0.0f, 1.0f);
     }
 }
 
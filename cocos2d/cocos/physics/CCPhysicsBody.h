@@ -32,6 +32,7 @@
 #include "CCGeometry.h"
 #include "CCPhysicsShape.h"
 #include "CCVector.h"
+#include "kazmath/kazmath.h"
 
 NS_CC_BEGIN
 
@@ -305,6 +306,14 @@ protected:
     virtual void setRotation(float rotation);
     
     void update(float delta);
+    /** Stores the current position and rotation as the state the node is interpolated from */
+    void savePreviousState();
+    /** Places the node between the saved state (alpha = 0) and the current state of the body (alpha = 1) */
+    void updateNode(float alpha);
+    void updateNode(const Point& position, float rotation);
+    void applyDamping(float delta);
+    /** Whether the body is simulated: dynamic, in a space and not sleeping */
+    bool isAwake() const;
     
     void removeJoint(PhysicsJoint* joint);
     inline void updateDamping() { _isDamping = _linearDamping != 0.0f ||  _angularDamping != 0.0f; }
@@ -343,6 +352,15 @@ protected:
     bool _rotationResetTag;     /// To avoid reset the body rotation when body invoke Node::setRotation().
     Point _positionOffset;
     float _rotationOffset;
+    // state before the last fixed step, used to interpolate the node
+    Point _previousPosition;
+    float _previousRotation;
+    // last state written to the node, it's only updated when the body or an ancestor of the node moved
+    Point _syncedPosition;
+    float _syncedRotation;
+    kmMat4 _syncedParentTransform;
+    // used by the world to collect the moving bodies once per step
+    unsigned int _movingStamp;
     
     friend class PhysicsWorld;
     friend class PhysicsShape;
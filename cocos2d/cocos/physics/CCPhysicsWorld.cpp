@@ -46,6 +46,7 @@
 #include "CCArray.h"
 #include "CCScene.h"
 #include "CCDirector.h"
+#include "CCJobPool.h"
 #include "CCEventDispatcher.h"
 #include "CCEventCustom.h"
 
@@ -392,6 +393,129 @@ void PhysicsWorld::queryPoint(PhysicsQueryPointCallbackFunc func, const Point& p
     }
 }
 
+// minimum number of queries run by a single job of the JobPool
+static const ssize_t QUERIES_PER_JOB = 64;
+
+static void runQueries(ssize_t count, bool parallel, const JobPool::RangeJob& job)
+{
+    if (parallel)
+    {
+        Director::getInstance()->getJobPool()->parallelFor(count, QUERIES_PER_JOB, job);
+    }
+    else
+    {
+        job(0, count);
+    }
+}
+
+void PhysicsWorld::rayCastBatch(const Point* starts, const Point* ends, ssize_t count, PhysicsRayCastResult* results, bool parallel)
+{
+    _info->updateQueryProxies();
+    
+    const PhysicsWorldInfo* info = _info;
+    runQueries(count, parallel, [=](ssize_t begin, ssize_t end){
+        for (ssize_t i = begin; i < end; ++i)
+        {
+            cpVect start = PhysicsHelper::point2cpv(starts[i]);
+            cpVect stop = PhysicsHelper::point2cpv(ends[i]);
+            cpSegmentQueryInfo hit;
+            
+            PhysicsRayCastResult& result = results[i];
+            result.shape = info->segmentQueryFirst(start, stop, &hit);
+            if (result.shape != nullptr)
+            {
+                result.contact = PhysicsHelper::cpv2point(cpSegmentQueryHitPoint(start, stop, hit));
+                result.normal = PhysicsHelper::cpv2point(hit.n);
+                result.fraction = PhysicsHelper::cpfloat2float(hit.t);
+            }
+            else
+            {
+                result.contact = ends[i];
+                result.normal = Vect::ZERO;
+                result.fraction = 1.0f;
+            }
+        }
+    });
+}
+
+// Runs `query(index, output)` for every query twice: once to count the shapes, once to store them at their offset
+template <class Query>
+static void runShapeQueries(ssize_t count, bool parallel, std::vector<PhysicsShape*>& shapes, std::vector<ssize_t>& offsets, Query query)
+{
+    offsets.resize(count + 1);
+    ssize_t* counts = offsets.data() + 1;
+    runQueries(count, parallel, [&](ssize_t begin, ssize_t end){
+        for (ssize_t i = begin; i < end; ++i)
+        {
+            counts[i] = query(i, nullptr);
+        }
+    });
+    
+    offsets[0] = 0;
+    for (ssize_t i = 0; i < count; ++i)
+    {
+        offsets[i + 1] += offsets[i];
+    }
+    
+    shapes.resize(offsets[count]);
+    if (shapes.empty())
+    {
+        return;
+    }
+    
+    PhysicsShape** output = shapes.data();
+    const ssize_t* starts = offsets.data();
+    runQueries(count, parallel, [&](ssize_t begin, ssize_t end){
+        for (ssize_t i = begin; i < end; ++i)
+        {
+            query(i, output + starts[i]);
+        }
+    });
+}
+
+void PhysicsWorld::queryRectBatch(const Rect* rects, ssize_t count, std::vector<PhysicsShape*>& shapes, std::vector<ssize_t>& offsets, bool parallel)
+{
+    _info->updateQueryProxies();
+    
+    const PhysicsWorldInfo* info = _info;
+    runShapeQueries(count, parallel, shapes, offsets, [=](ssize_t index, PhysicsShape** output) -> ssize_t {
+        ssize_t found = 0;
+        info->bbQuery(PhysicsHelper::rect2cpbb(rects[index]), [&](const PhysicsWorldInfo::QueryProxy& proxy){
+            if (output != nullptr)
+            {
+                output[found] = proxy.physicsShape;
+            }
+            ++found;
+        });
+        return found;
+    });
+}
+
+void PhysicsWorld::queryPointBatch(const Point* points, ssize_t count, std::vector<PhysicsShape*>& shapes, std::vector<ssize_t>& offsets, bool parallel)
+{
+    _info->updateQueryProxies();
+    
+    const PhysicsWorldInfo* info = _info;
+    runShapeQueries(count, parallel, shapes, offsets, [=](ssize_t index, PhysicsShape** output) -> ssize_t {
+        ssize_t found = 0;
+        cpVect point = PhysicsHelper::point2cpv(points[index]);
+        info->bbQuery(cpBBNew(point.x, point.y, point.x, point.y), [&](const PhysicsWorldInfo::QueryProxy& proxy){
+            cpNearestPointQueryInfo nearest;
+            cpShapeNearestPointQuery(proxy.shape, point, &nearest);
+            // same test as queryPoint(), the point is inside the shape
+            if (nearest.shape != nullptr && nearest.d < 0)
+            {
+                if (output != nullptr)
+                {
+                    output[found] = proxy.physicsShape;
+                }
+                ++found;
+            }
+        });
+        return found;
+    });
+}
+
 Vector<PhysicsShape*> PhysicsWorld::getShapes(const Point& point) const
 {
     Vector<PhysicsShape*> arr;
@@ -714,6 +838,11 @@ void PhysicsWorld::removeBody(PhysicsBody* body)
     body->_joints.clear();
     
     removeBodyOrDelay(body);
+    auto moving = std::find(_movingBodies.begin(), _movingBodies.end(), body);
+    if (moving != _movingBodies.end())
+    {
+        _movingBodies.erase(moving);
+    }
     _bodies.eraseObject(body);
     body->_world = nullptr;
 }
@@ -957,6 +1086,7 @@ void PhysicsWorld::removeAllBodies()
         child->_world = nullptr;
     }
     
+    _movingBodies.clear();
     _bodies.clear();
 }
 
@@ -1017,16 +1147,30 @@ void PhysicsWorld::update(float delta)
         _delayDirty = !(_delayAddBodies.size() == 0 && _delayRemoveBodies.size() == 0 && _delayAddJoints.size() == 0 && _delayRemoveJoints.size() == 0);
     }
     
-    _updateTime += delta;
-    if (++_updateRateCount >= _updateRate)
+    if (_fixedTimeStep > 0.0f)
     {
-        _info->step(_updateTime * _speed);
-        for (auto& body : _bodies)
+        updateFixed(delta);
+    }
+    else
+    {
+        _updateTime += delta;
+        if (++_updateRateCount >= _updateRate)
         {
-            body->update(_updateTime * _speed);
+            ++_movingStamp;
+            _movingBodies.clear();
+            // bodies awake before the step move during it, even if they fall asleep
+            collectMovingBodies();
+            _info->step(_updateTime * _speed);
+            collectMovingBodies();
+            
+            for (auto& body : _movingBodies)
+            {
+                body->update(_updateTime * _speed);
+            }
+            updateRestingNodes();
+            _updateRateCount = 0;
+            _updateTime = 0.0f;
         }
-        _updateRateCount = 0;
-        _updateTime = 0.0f;
     }
     
     if (_debugDrawMask != DEBUGDRAW_NONE)
@@ -1035,13 +1179,152 @@ void PhysicsWorld::update(float delta)
     }
 }
 
+void PhysicsWorld::updateFixed(float delta)
+{
+    _accumulator += delta * _speed;
+    
+    int steps = 0;
+    if (_accumulator >= _fixedTimeStep)
+    {
+        // keep the bodies of the previous steps until a new step runs, they are still interpolated
+        ++_movingStamp;
+        _movingBodies.clear();
+    }
+    
+    while (_accumulator >= _fixedTimeStep && steps < _maxSubSteps)
+    {
+        collectMovingBodies();
+        
+        if (_interpolationEnabled)
+        {
+            for (auto& body : _movingBodies)
+            {
+                body->savePreviousState();
+            }
+        }
+        
+        _info->step(_fixedTimeStep);
+        for (auto& body : _movingBodies)
+        {
+            body->applyDamping(_fixedTimeStep);
+        }
+        
+        _accumulator -= _fixedTimeStep;
+        ++steps;
+    }
+    
+    if (steps > 0)
+    {
+        collectMovingBodies();
+    }
+    
+    // too slow to catch up, drop the time that couldn't be simulated
+    if (_accumulator >= _fixedTimeStep)
+    {
+        _accumulator = fmodf(_accumulator, _fixedTimeStep);
+    }
+    
+    if (_interpolationEnabled)
+    {
+        _interpolationAlpha = _accumulator / _fixedTimeStep;
+        for (auto& body : _movingBodies)
+        {
+            body->updateNode(_interpolationAlpha);
+        }
+        updateRestingNodes();
+    }
+    else if (steps > 0)
+    {
+        _interpolationAlpha = 1.0f;
+        for (auto& body : _movingBodies)
+        {
+            body->updateNode(1.0f);
+        }
+        updateRestingNodes();
+    }
+}
+
+void PhysicsWorld::collectMovingBodies()
+{
+    for (auto& body : _bodies)
+    {
+        if (body->_movingStamp != _movingStamp && body->isAwake())
+        {
+            body->_movingStamp = _movingStamp;
+            _movingBodies.push_back(body);
+            
+            // a body woken up during a step has no previous state for that step, don't interpolate from a stale one
+            if (_fixedTimeStep > 0.0f && _interpolationEnabled)
+            {
+                body->savePreviousState();
+            }
+        }
+    }
+}
+
+void PhysicsWorld::updateRestingNodes()
+{
+    // the body stays where it is when the parent of its node moves, so the node is placed back over it
+    for (auto& body : _bodies)
+    {
+        if (body->_movingStamp != _movingStamp)
+        {
+            body->updateNode(1.0f);
+        }
+    }
+}
+
+void PhysicsWorld::setSleepTimeThreshold(float time)
+{
+    cpSpaceSetSleepTimeThreshold(_info->getSpace(), PhysicsHelper::float2cpfloat(time));
+}
+
+float PhysicsWorld::getSleepTimeThreshold() const
+{
+    return PhysicsHelper::cpfloat2float(cpSpaceGetSleepTimeThreshold(_info->getSpace()));
+}
+
+void PhysicsWorld::setIdleSpeedThreshold(float speed)
+{
+    cpSpaceSetIdleSpeedThreshold(_info->getSpace(), PhysicsHelper::float2cpfloat(speed));
+}
+
+float PhysicsWorld::getIdleSpeedThreshold() const
+{
+    return PhysicsHelper::cpfloat2float(cpSpaceGetIdleSpeedThreshold(_info->getSpace()));
+}
+
+void PhysicsWorld::setFixedTimeStep(float step)
+{
+    if (step < 0.0f)
+    {
+        return;
+    }
+    
+    _fixedTimeStep = step;
+    _accumulator = 0.0f;
+    _interpolationAlpha = 1.0f;
+    
+    // start interpolating from the current state
+    for (auto& body : _bodies)
+    {
+        body->savePreviousState();
+    }
+}
+
 PhysicsWorld::PhysicsWorld()
 : _gravity(Point(0.0f, -98.0f))
 , _speed(1.0f)
 , _updateRate(1)
 , _updateRateCount(0)
 , _updateTime(0.0f)
+, _fixedTimeStep(0.0f)
+, _maxSubSteps(5)
+, _interpolationEnabled(true)
+, _accumulator(0.0f)
+, _interpolationAlpha(1.0f)
 , _info(nullptr)
+, _movingStamp(0)
 , _scene(nullptr)
 , _delayDirty(false)
 , _debugDraw(nullptr)
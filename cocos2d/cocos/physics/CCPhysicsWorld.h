@@ -33,6 +33,7 @@
 #include "CCGeometry.h"
 
 #include <list>
+#include <vector>
 
 NS_CC_BEGIN
 
@@ -63,6 +64,15 @@ typedef struct PhysicsRayCastInfo
     void* data;
 }PhysicsRayCastInfo;
 
+/** Closest hit of a ray cast by PhysicsWorld::rayCastBatch, shape is nullptr if the ray didn't hit anything */
+typedef struct PhysicsRayCastResult
+{
+    PhysicsShape* shape;
+    Point contact;
+    Vect normal;
+    float fraction;
+}PhysicsRayCastResult;
+
 /**
  * @brief Called for each fixture found in the query. You control how the ray cast
  * proceeds by returning a float:
@@ -110,6 +120,19 @@ public:
     void queryRect(PhysicsQueryRectCallbackFunc func, const Rect& rect, void* data);
     /** Searches for physics shapes that contains the point. */
     void queryPoint(PhysicsQueryPointCallbackFunc func, const Point& point, void* data);
+    /**
+     * Casts `count` rays, from starts[i] to ends[i], and stores the closest shape hit by each ray in results[i].
+     * The batched queries test a snapshot of the shape bounding boxes taken after the last step, they don't call back
+     * for every hit. With `parallel`, the rays are spread across the JobPool; don't use it from a parallel update.
+     */
+    void rayCastBatch(const Point* starts, const Point* ends, ssize_t count, PhysicsRayCastResult* results, bool parallel = false);
+    /**
+     * Searches for the shapes whose bounding box intersects each of the `count` rects.
+     * The shapes found for rects[i] are shapes[offsets[i]] to shapes[offsets[i + 1] - 1], offsets gets count + 1 entries.
+     */
+    void queryRectBatch(const Rect* rects, ssize_t count, std::vector<PhysicsShape*>& shapes, std::vector<ssize_t>& offsets, bool parallel = false);
+    /** Searches for the shapes that contain each of the `count` points, the results are stored like in queryRectBatch(). */
+    void queryPointBatch(const Point* points, ssize_t count, std::vector<PhysicsShape*>& shapes, std::vector<ssize_t>& offsets, bool parallel = false);
     /** Get phsyics shapes that contains the point. */
     Vector<PhysicsShape*> getShapes(const Point& point) const;
     /** return physics shape that contains the point. */
@@ -138,6 +161,47 @@ public:
     /** get the update rate */
     inline int getUpdateRate() { return _updateRate; }
     
+    /**
+     * Set the fixed time step of the physics world, in seconds. 0 (the default) steps the world with the frame time.
+     * With a fixed time step the frame time is accumulated and the world is stepped as many times as needed by steps
+     * of exactly `step` seconds, which keeps the simulation stable when the frame rate changes. The update rate is ignored.
+     */
+    void setFixedTimeStep(float step);
+    /** get the fixed time step, 0 if the world is stepped with the frame time */
+    inline float getFixedTimeStep() const { return _fixedTimeStep; }
+    /**
+     * Set the maximum number of steps done in one frame with a fixed time step. When a frame needs more,
+     * the time left is dropped and the simulation slows down instead of taking longer and longer to catch up.
+     * default value is 5
+     */
+    inline void setMaxSubSteps(int steps) { if(steps > 0) { _maxSubSteps = steps; } }
+    /** get the maximum number of steps done in one frame */
+    inline int getMaxSubSteps() const { return _maxSubSteps; }
+    /**
+     * Enable or disable the interpolation of the nodes with a fixed time step. When enabled, the nodes are placed
+     * between the last two states of their bodies according to the time left in the accumulator, so that they move
+     * smoothly when the frame rate is higher than the physics rate. Otherwise the nodes are only updated on the frames
+     * where the world was stepped. default value is true
+     */
+    inline void setInterpolationEnabled(bool enabled) { _interpolationEnabled = enabled; }
+    /** whether the nodes are interpolated with a fixed time step */
+    inline bool isInterpolationEnabled() const { return _interpolationEnabled; }
+    /** get how far the nodes are between the last two states of their bodies, between 0 and 1 */
+    inline float getInterpolationAlpha() const { return _interpolationAlpha; }
+    
+    /**
+     * Set how long a group of resting bodies must stay idle before falling asleep, in seconds.
+     * Sleeping bodies are not simulated and their nodes are not updated until something wakes them up.
+     * default value is INFINITY, bodies never sleep
+     */
+    void setSleepTimeThreshold(float time);
+    /** get the time before idle bodies fall asleep */
+    float getSleepTimeThreshold() const;
+    /** Set the speed under which a body is considered idle. 0 (the default) derives it from the gravity */
+    void setIdleSpeedThreshold(float speed);
+    /** get the speed under which a body is considered idle */
+    float getIdleSpeedThreshold() const;
+    
     /** set the debug draw mask */
     void setDebugDrawMask(int mask);
     /** get the bebug draw mask */
@@ -151,6 +215,12 @@ protected:
     virtual void addShape(PhysicsShape* shape);
     virtual void removeShape(PhysicsShape* shape);
     virtual void update(float delta);
+    /** Steps the world by fixed steps and updates the nodes, used by update() when a fixed time step is set */
+    virtual void updateFixed(float delta);
+    /** Adds the awake bodies to the bodies whose nodes follow the simulation */
+    void collectMovingBodies();
+    /** Places again the nodes of the other bodies whose ancestors moved, called once the moving bodies are synced */
+    void updateRestingNodes();
     
     virtual void debugDraw();
     
@@ -176,9 +246,17 @@ protected:
     int _updateRate;
     int _updateRateCount;
     float _updateTime;
+    float _fixedTimeStep;
+    int _maxSubSteps;
+    bool _interpolationEnabled;
+    float _accumulator;
+    float _interpolationAlpha;
     PhysicsWorldInfo* _info;
     
     Vector<PhysicsBody*> _bodies;
+    // bodies awake during the last steps, only their nodes are updated
+    std::vector<PhysicsBody*> _movingBodies;
+    unsigned int _movingStamp;
     std::list<PhysicsJoint*> _joints;
     Scene* _scene;
     
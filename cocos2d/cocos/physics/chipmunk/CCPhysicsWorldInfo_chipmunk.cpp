@@ -28,9 +28,12 @@
 #include "CCPhysicsBodyInfo_chipmunk.h"
 #include "CCPhysicsShapeInfo_chipmunk.h"
 #include "CCPhysicsJointInfo_chipmunk.h"
+#include <algorithm>
 NS_CC_BEGIN
 
 PhysicsWorldInfo::PhysicsWorldInfo()
+: _queryProxiesMaxWidth(0)
+, _queryProxiesDirty(true)
 {
     _space = cpSpaceNew();
 }
@@ -67,6 +70,7 @@ void PhysicsWorldInfo::addShape(PhysicsShapeInfo& shape)
     {
         cpSpaceAddShape(_space, cps);
     }
+    _queryProxiesDirty = true;
 }
 
 void PhysicsWorldInfo::removeShape(PhysicsShapeInfo& shape)
@@ -78,6 +82,96 @@ void PhysicsWorldInfo::removeShape(PhysicsShapeInfo& shape)
             cpSpaceRemoveShape(_space, cps);
         }
     }
+    _queryProxiesDirty = true;
+}
+
+static void addQueryProxy(cpShape* shape, std::vector<PhysicsWorldInfo::QueryProxy>* proxies)
+{
+    auto it = PhysicsShapeInfo::getMap().find(shape);
+    CC_ASSERT(it != PhysicsShapeInfo::getMap().end());
+    
+    PhysicsWorldInfo::QueryProxy proxy = { cpShapeGetBB(shape), shape, it->second->getShape() };
+    proxies->push_back(proxy);
+}
+
+static bool lessQueryProxy(const PhysicsWorldInfo::QueryProxy& a, const PhysicsWorldInfo::QueryProxy& b)
+{
+    return a.bb.l < b.bb.l;
+}
+
+static bool lessQueryProxyWidth(const PhysicsWorldInfo::QueryProxy& a, const PhysicsWorldInfo::QueryProxy& b)
+{
+    return a.bb.r - a.bb.l < b.bb.r - b.bb.l;
+}
+
+// shapes wider than this many times the median width are kept out of the sorted proxies
+static const cpFloat OVERSIZED_QUERY_PROXY_FACTOR = 8;
+
+void PhysicsWorldInfo::updateQueryProxies()
+{
+    if (!_queryProxiesDirty)
+    {
+        return;
+    }
+    
+    _queryProxies.clear();
+    _oversizedQueryProxies.clear();
+    cpSpaceEachShape(_space, (cpSpaceShapeIteratorFunc)addQueryProxy, &_queryProxies);
+    
+    if (!_queryProxies.empty())
+    {
+        // move the oversized shapes to the end, the width of a single one would make every query scan from the left
+        auto median = _queryProxies.begin() + _queryProxies.size() / 2;
+        std::nth_element(_queryProxies.begin(), median, _queryProxies.end(), lessQueryProxyWidth);
+        cpFloat maxWidth = (median->bb.r - median->bb.l) * OVERSIZED_QUERY_PROXY_FACTOR;
+        
+        if (maxWidth > 0)
+        {
+            auto oversized = std::partition(_queryProxies.begin(), _queryProxies.end(), [maxWidth](const QueryProxy& proxy){
+                return proxy.bb.r - proxy.bb.l <= maxWidth;
+            });
+            _oversizedQueryProxies.assign(oversized, _queryProxies.end());
+            _queryProxies.erase(oversized, _queryProxies.end());
+        }
+    }
+    
+    std::sort(_queryProxies.begin(), _queryProxies.end(), lessQueryProxy);
+    
+    _queryProxiesMaxWidth = 0;
+    for (const auto& proxy : _queryProxies)
+    {
+        _queryProxiesMaxWidth = cpfmax(_queryProxiesMaxWidth, proxy.bb.r - proxy.bb.l);
+    }
+    
+    _queryProxiesDirty = false;
+}
+
+std::vector<PhysicsWorldInfo::QueryProxy>::const_iterator PhysicsWorldInfo::firstQueryProxy(cpFloat left) const
+{
+    // no box wider than _queryProxiesMaxWidth can reach `left` from further on the left
+    QueryProxy key;
+    key.bb.l = left - _queryProxiesMaxWidth;
+    return std::lower_bound(_queryProxies.begin(), _queryProxies.end(), key, lessQueryProxy);
+}
+
+PhysicsShape* PhysicsWorldInfo::segmentQueryFirst(cpVect start, cpVect end, cpSegmentQueryInfo* info) const
+{
+    PhysicsShape* result = nullptr;
+    info->t = 1.0f;
+    
+    cpBB bb = cpBBNew(cpfmin(start.x, end.x), cpfmin(start.y, end.y), cpfmax(start.x, end.x), cpfmax(start.y, end.y));
+    bbQuery(bb, [&](const QueryProxy& proxy){
+        cpSegmentQueryInfo hit;
+        if (cpBBSegmentQuery(proxy.bb, start, end) < info->t
+            && cpShapeSegmentQuery(proxy.shape, start, end, &hit)
+            && hit.t < info->t)
+        {
+            *info = hit;
+            result = proxy.physicsShape;
+        }
+    });
+    
+    return result;
 }
 
 void PhysicsWorldInfo::addJoint(PhysicsJointInfo& joint)
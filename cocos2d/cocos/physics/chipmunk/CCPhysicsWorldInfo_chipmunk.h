@@ -37,10 +37,20 @@ typedef Point Vect;
 class PhysicsBodyInfo;
 class PhysicsJointInfo;
 class PhysicsShapeInfo;
+class PhysicsShape;
 
 class PhysicsWorldInfo
 {
 public:
+    /** Bounding box of a shape, as seen by the batched queries */
+    struct QueryProxy
+    {
+        cpBB bb;
+        cpShape* shape;
+        PhysicsShape* physicsShape;
+    };
+    
+
     cpSpace* getSpace() const { return _space; }
     void addShape(PhysicsShapeInfo& shape);
     void removeShape(PhysicsShapeInfo& shape);
@@ -50,15 +60,52 @@ public:
     void removeJoint(PhysicsJointInfo& joint);
     void setGravity(const Vect& gravity);
     inline bool isLocked() { return 0 == _space->locked_private ? false : true; }
-    inline void step(float delta) { cpSpaceStep(_space, delta); }
+    inline void step(float delta) { cpSpaceStep(_space, delta); _queryProxiesDirty = true; }
+    
+    /** Snapshots the bounding boxes of the shapes if the space changed since the last call */
+    void updateQueryProxies();
+    /** Returns the closest shape hit by the segment and fills `info`, nullptr if nothing is hit.
+     Only reads the snapshot, so it can run on several threads at once while the space isn't modified.
+     */
+    PhysicsShape* segmentQueryFirst(cpVect start, cpVect end, cpSegmentQueryInfo* info) const;
+    /** Calls `func(const QueryProxy&)` for every shape whose bounding box intersects `bb`. Same threading rules as segmentQueryFirst */
+    template <class Func>
+    void bbQuery(cpBB bb, Func func) const
+    {
+        for (auto it = firstQueryProxy(bb.l); it != _queryProxies.end() && it->bb.l <= bb.r; ++it)
+        {
+            if (cpBBIntersects(bb, it->bb))
+            {
+                func(*it);
+            }
+        }
+        
+        for (const auto& proxy : _oversizedQueryProxies)
+        {
+            if (cpBBIntersects(bb, proxy.bb))
+            {
+                func(proxy);
+            }
+        }
+    }
     
 private:
     PhysicsWorldInfo();
     ~PhysicsWorldInfo();
     
+    // first proxy that can intersect a box starting at `left`
+    std::vector<QueryProxy>::const_iterator firstQueryProxy(cpFloat left) const;
+    
 private:
     cpSpace* _space;
     
+    // shapes sorted by the left side of their bounding box
+    std::vector<QueryProxy> _queryProxies;
+    cpFloat _queryProxiesMaxWidth;
+    // shapes much wider than the others (terrain, walls), always tested so that they don't widen the search of _queryProxies
+    std::vector<QueryProxy> _oversizedQueryProxies;
+    bool _queryProxiesDirty;
+    
     friend class PhysicsWorld;
 };
 
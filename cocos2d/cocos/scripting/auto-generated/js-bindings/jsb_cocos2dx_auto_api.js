@@ -6382,13 +6382,6 @@ setTotalParticles : function () {},
  */
 setEndColorVar : function () {},
 
-/**
- * @method updateQuadWithParticle
- * @param {cocos2d::tParticle*}
- * @param {const cocos2d::Point&}
- */
-updateQuadWithParticle : function () {},
-
 /**
  * @method getAtlasIndex
  * @return A value converted from C/C++ "int"
@@ -6478,12 +6471,6 @@ getStartSpin : function () {},
  */
 getRotatePerSecond : function () {},
 
-/**
- * @method initParticle
- * @param {cocos2d::tParticle*}
- */
-initParticle : function () {},
-
 /**
  * @method setEmitterMode
  * @param {cocos2d::ParticleSystem::Mode}
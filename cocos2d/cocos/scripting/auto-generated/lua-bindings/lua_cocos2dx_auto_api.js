@@ -6696,13 +6696,6 @@ setTotalParticles : function () {},
  */
 setEndColorVar : function () {},
 
-/**
- * @method updateQuadWithParticle
- * @param {cocos2d::tParticle*}
- * @param {const cocos2d::Point&}
- */
-updateQuadWithParticle : function () {},
-
 /**
  * @method getAtlasIndex
  * @return A value converted from C/C++ "int"
@@ -6792,12 +6785,6 @@ getStartSpin : function () {},
  */
 getRotatePerSecond : function () {},
 
-/**
- * @method initParticle
- * @param {cocos2d::tParticle*}
- */
-initParticle : function () {},
-
 /**
  * @method setEmitterMode
  * @param {cocos2d::ParticleSystem::Mode}